@@ -1,16 +1,18 @@
 #include "Os.h"
-#include <stdio.h>
+#include "Log.h"
+#include "IoHwAb_Adc.h"
 
 /* Các hook này do OS gọi; có thể bỏ nội dung nếu không cần log */
 
 void StartupHook(void)
 {
-    printf("[OS] StartupHook()\n");
+    LOG("[OS] StartupHook()\n");
 }
 
 void ShutdownHook(StatusType e)
 {
-    printf("[OS] ShutdownHook(e=%u)\n", (unsigned)e);
+    LOG("[OS] ShutdownHook(e=%u)\n", e);
+    Log_Flush();    /* Task_Idle không còn chạy */
 }
 
 void PreTaskHook(void)
@@ -22,3 +24,11 @@ void PostTaskHook(void)
 {
     /* Tương tự PreTaskHook */
 }
+
+void AlarmExpiryHook(AlarmType alarm)
+{
+    /* SysTick vừa nhả Task_A: khoá pha lấy mẫu ADC vào nhịp này */
+    if (alarm == ALARM_A) {
+        IoHwAb_Adc_SyncSampling();
+    }
+}
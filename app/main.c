@@ -1,12 +1,13 @@
-#include "os.h"
+#include "Os.h"
 #include "stm32f10x.h"
 #include <stdio.h>
 #include "EcuM.h"   
 #include "core_cm3.h" 
+#include "Log.h"
 
 int main(void)
 {   
-
+    Log_Init();
     EcuM_Init();
     /* Vào OS → autostart InitTask */
     StartOS(OSDEFAULTAPPMODE) ;// chế độ bình thường;
@@ -2,7 +2,7 @@
  * @file    InitTask.c
  * @brief   Task khởi tạo hệ thống (autostart)
  * @details - Khởi tạo RTE, SWC, COM (nếu COM chưa được BSW init)
- *          - Cấu hình các Alarm chu kỳ (10ms/100ms)
+ *          - Cấu hình các Alarm chu kỳ (10ms/100ms, nhịp COM)
  *          - Kết thúc bản thân (TerminateTask)
  * @version 1.0
  * @date    2025-09-10
@@ -44,10 +44,10 @@ TASK(Task_Init)
     Swc_SafetyManager_Init();
     Swc_CmdComposer_Init();
 
-    //Ioc_Init(Ioc_CH_1, 2, Rec_list);
     //StartScheduleTableRel(0,50);
     SetRelAlarm(0u, 10u,  10u);
     SetRelAlarm(1u, 60u,  70u);
+    SetRelAlarm(ALARM_COM, COM_MAINFUNCTION_PERIOD_MS, COM_MAINFUNCTION_PERIOD_MS);
     // SetRelAlarm(2u, 700u,  500u);
     TerminateTask();
 }
@@ -19,15 +19,25 @@
 #include <stdio.h>
 #include "IoHwAb_Digital.h"
 #include "IoHwAb_Digital_Cfg.h"
+#include "Rte_Cfg.h"
+#include "Rte_Main.h"
 TASK(Task_A)
 {
+    Rte_Task_Begin();   /* ảnh dữ liệu implicit cho chu kỳ này */
+
+     /* 0) Lấy mẫu + debounce mọi đầu vào số (mỗi cổng GPIO đọc một lần) */
+    IoHwAb_Digital_MainFunction();
+
      /* 1) Thu nhận tín hiệu đầu vào từ phần cứng (qua IoHwAb → RTE) */
     Swc_PedalAcq_Run10ms();
     Swc_DriveModeMgr_Run10ms();
     Swc_BrakeAcq_Run10ms();
     Swc_GearSelector_Run10ms();
-     /* 2) An toàn: hợp nhất & kiểm tra điều kiện (ghi Safe_s vào RTE) */
+#if (RTE_EVENT_DRIVEN == 0u)
+     /* 2) An toàn: hợp nhất & kiểm tra điều kiện (ghi Safe_s vào RTE)
+      *    (RTE_EVENT_DRIVEN = 1: chạy trong Task_C khi đầu vào đổi) */
     Swc_SafetyManager_Run10ms();
+#endif
 
     // IoHwAb_Init1(&IoHwAb1_Config);
     // // if(IoHwAb_Digital_ReadSignal(IoHwAb_CHANNEL_Button, &btn) == E_OK && !btn){
@@ -57,9 +67,10 @@ TASK(Task_A)
     //     accA = accB = 0;
     //     break;
     // }
-    // Ioc_Send(Ioc_CH_1, &speed);
+    // IocSend_Speed(&speed);
     // printf("Send Speed:%d\n",speed);
     // TerminateTask(
     // printf("Task_A running...\n");
+    Rte_Task_End();     /* công bố Rte_IWrite_* */
     TerminateTask();
 }
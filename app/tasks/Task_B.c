@@ -1,18 +1,25 @@
 #include "Os.h"
-#include <stdio.h> 
+#include "Log.h"
 #include "Swc_CmdComposer.h"
 #include "Rte.h"
 #include "stm32f10x.h"
 #include "stm32f10x_can.h"
+#include "Rte_Cfg.h"
+#include "Rte_Main.h"
 /* Task chu kỳ 100 ms: BSW & SWC ít thường xuyên hơn */
 TASK(Task_B)
 {
-    /* Tổng hợp lệnh VCU_Command (ghi từng signal vào COM qua RTE) */
+#if (RTE_EVENT_DRIVEN == 0u)
+    /* Tổng hợp lệnh VCU_Command (ghi từng signal vào COM qua RTE)
+     * (RTE_EVENT_DRIVEN = 1: chạy trong Task_C khi Safe_s đổi) */
+    Rte_Task_Begin();
     Swc_CmdComposer_Run10ms(); 
-    //Ioc_Receive(Ioc_CH_1, &data, TASK_B);
+    Rte_Task_End();
+#endif
+    //IocReceive_Speed(IOC_RX_Speed_TASK_B, &data);
     // printf("[Task_B] Data Receceive:%d\n",data);
     uint16_t data;
     Swc_CmdComposer_ReadEngineRPM(&data);
-    printf("[Task_B] Engine Speed:%d\n",data);
+    LOG("[Task_B] Engine Speed:%d\n", data);
     TerminateTask();
 }
@@ -1,13 +1,18 @@
 #include "Os.h"
 #include <stdio.h> 
 // #include "Rte.h"
+#include "Rte_Main.h"
+#include "Rte_Cfg.h"
 
-/* Task chu kỳ 100 ms: BSW & SWC ít thường xuyên hơn */
+/* Task RTE hướng sự kiện (RTE_EVENT_TASK): Rte_StartTiming() kích hoạt,
+ * chạy runnable consumer khi cổng SR đổi giá trị hoặc timeout */
 TASK(Task_C)
 {
-    uint16_t data;
+#if (RTE_EVENT_DRIVEN == 1u)
+    Rte_EventTask();   /* không quay lại */
+#endif
 
-    //Ioc_Receive(Ioc_CH_1, &data, TASK_C);
+    //IocReceive_Speed(IOC_RX_Speed_TASK_C, &data);
     // printf("[Task_C] Data Receive:%d\n",data);
 
     TerminateTask();
@@ -0,0 +1,25 @@
+/**********************************************************
+ * @file    Task_Com.c
+ * @brief   Task nền của COM, chu kỳ COM_MAINFUNCTION_PERIOD_MS
+ * @details Basic Task ưu tiên cao nhất, kích hoạt bởi ALARM_COM:
+ *          1) CanIf_MainFunctionRx: đưa frame ISR RX đã xếp vào vòng RX
+ *             lên PduR → COM (ngoài ngữ cảnh ngắt)
+ *          2) Com_MainFunctionRx: giám sát deadline I-PDU RX
+ *          3) Com_MainFunctionTx: phát I-PDU chu kỳ / trigger đã tới hạn
+ *          Mỗi main function chỉ xét gốc hàng đợi tới hạn của nó,
+ *          nên khi chưa có I-PDU nào tới hạn task kết thúc ngay.
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Os.h"
+#include "Com.h"
+#include "CanIf.h"
+
+TASK(Task_Com)
+{
+    CanIf_MainFunctionRx();
+    Com_MainFunctionRx();
+    Com_MainFunctionTx();
+    TerminateTask();
+}
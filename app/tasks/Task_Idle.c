@@ -1,13 +1,16 @@
 #include "Os.h"
 #include "stm32f10x.h"
-#include <stdio.h> 
+#include "Log.h"
 
 
-/* Task chu kỳ 100 ms: BSW & SWC ít thường xuyên hơn */
+/* Task ưu tiên thấp nhất: đẩy log trì hoãn (LOG) rồi ngủ tickless.
+ * Transport (ITM, UART) chỉ chạy ở đây nên task chu kỳ và ngắt luôn
+ * chen được; riêng semihosting vẫn dừng lõi khi có debugger. */
 TASK(Task_Idle)
 {
     for (;;)
     {
-        __WFI();
+        Log_Flush();
+        Os_IdleSleep();
     }
 }
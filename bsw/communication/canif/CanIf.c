@@ -4,6 +4,19 @@
  * @details File này chứa logic hoạt động của các hàm API được định nghĩa trong CanIf.h.
  *          Nó quản lý trạng thái, định tuyến PDU, và là cầu nối giữa lớp PduR và CanDrv.
  *
+ *          Tra cứu định tuyến không duyệt bảng mỗi frame: CanIf_Init() dựng
+ *          - TxRouteIdx[]     : TxPduId → mục định tuyến (O(1)),
+ *          - RxRouteByCanId[] : mục Rx sắp tăng dần theo CAN ID → tìm nhị
+ *            phân (O(log n)) trong RxIndication.
+ *          TxConfirmation đến từ ngắt TX của CanDrv kèm swPduHandle (= TxPduId)
+ *          nên không cần tra CAN ID.
+ *
+ *          Đường nhận tách khỏi ISR: CanIf_RxIndication() (ISR RX, đã vét hết
+ *          FIFO) chỉ chép frame vào vòng RX một-ghi-một-đọc không khoá;
+ *          CanIf_MainFunctionRx() (task) tra định tuyến và gọi PduR → COM.
+ *          CanIf_Init() nạp bộ lọc phần cứng từ các CAN ID Rx (Can_SetRxFilter)
+ *          nên frame không có định tuyến hầu như không tới được đây.
+ *
  * @version 1.0
  * @date    2025-09-10
  * @author  Nguyễn Tuấn Khoa
@@ -38,6 +51,86 @@ CanIf_TxConfirmationCallback txConfirmationCallback = NULL;
 CanIf_RxIndicationCallback rxIndicationCallback = NULL;
 extern CanIf_RoutingEntry RoutingTable[CANIF_NUM_TX_PDUS+CANIF_NUM_RX_PDUS];
 
+// Chỉ mục tra nhanh vào bảng định tuyến (dựng ở CanIf_Init).
+#define CANIF_NO_ROUTE 0xFFu
+static const CanIf_RoutingEntry* routingTable = NULL;
+static uint8_t TxRouteIdx[CANIF_MAX_TX_PDUS];
+static uint8_t RxRouteByCanId[CANIF_MAX_ROUTING_ENTRIES];
+static uint8_t numRxRoutes;
+
+// Vòng RX: ISR (RxIndication) chỉ ghi rxRingHead, task (MainFunctionRx) chỉ
+// ghi rxRingTail → không cần khoá; __DMB() giữ thứ tự dữ liệu/chỉ số.
+typedef struct{
+    Can_IdType CanId;
+    uint8_t    length;
+    uint8_t    data[CANIF_MAX_RX_BUF_SIZE];
+} CanIf_RxFrameType;
+
+static CanIf_RxFrameType rxRing[CANIF_RX_RING_SIZE];
+static volatile uint32_t rxRingHead;
+static volatile uint32_t rxRingTail;
+static volatile uint32_t rxRingReceived;
+static volatile uint32_t rxRingDrops;
+static uint16_t rxRingHighWater;
+
+/* ================================================================================================================== */
+/*                                          HÀM NỘI BỘ: CHỈ MỤC ĐỊNH TUYẾN                                            */
+/* ================================================================================================================== */
+
+/**
+ * @brief Chèn một mục định tuyến vào chỉ mục, giữ thứ tự CAN ID tăng dần.
+ * @details Chỉ chạy ở CanIf_Init (insertion sort, n nhỏ).
+ */
+static void prv_insert_by_canid(uint8_t* idx, uint8_t* count, uint8_t entry){
+    uint8_t i = *count;
+    while((i > 0u) && (routingTable[idx[i - 1u]].CanId > routingTable[entry].CanId)){
+        idx[i] = idx[i - 1u];
+        i--;
+    }
+    idx[i] = entry;
+    (*count)++;
+}
+
+/**
+ * @brief Tìm nhị phân mục định tuyến theo CAN ID trong chỉ mục đã sắp.
+ * @return Chỉ số trong bảng định tuyến, hoặc CANIF_NO_ROUTE.
+ */
+static uint8_t prv_find_by_canid(const uint8_t* idx, uint8_t count, Can_IdType CanId){
+    uint8_t lo = 0u;
+    uint8_t hi = count;
+    while(lo < hi){
+        const uint8_t mid = (uint8_t)((lo + hi) >> 1);
+        if(routingTable[idx[mid]].CanId < CanId){
+            lo = (uint8_t)(mid + 1u);
+        } else {
+            hi = mid;
+        }
+    }
+    if((lo < count) && (routingTable[idx[lo]].CanId == CanId)){
+        return idx[lo];
+    }
+    return CANIF_NO_ROUTE;
+}
+
+static void prv_build_route_index(void){
+    memset(TxRouteIdx, CANIF_NO_ROUTE, sizeof(TxRouteIdx));
+    numRxRoutes = 0u;
+    if(routingTable == NULL) return;
+
+    if(numRoutingEntries > CANIF_MAX_ROUTING_ENTRIES){
+        numRoutingEntries = CANIF_MAX_ROUTING_ENTRIES;
+    }
+    for(uint8_t i = 0u; i < numRoutingEntries; i++){
+        if(routingTable[i].isTX == 1){
+            if((routingTable[i].id < CANIF_MAX_TX_PDUS) && (TxRouteIdx[routingTable[i].id] == CANIF_NO_ROUTE)){
+                TxRouteIdx[routingTable[i].id] = i;
+            }
+        } else {
+            prv_insert_by_canid(RxRouteByCanId, &numRxRoutes, i);
+        }
+    }
+}
+
 /* ================================================================================================================== */
 /*                                          TRIỂN KHAI CÁC HÀM API                                                     */
 /* ================================================================================================================== */
@@ -55,6 +148,16 @@ void CanIf_Init(const CanIf_ConfigType* config){
     numTxPdus = config->numTxPdus;
     numRxPdus = config->numRxPdus;
     numRoutingEntries = config->numRoutingEntries;
+    routingTable = config->routingTable;
+    prv_build_route_index();
+
+    // Bộ lọc phần cứng chỉ nhận các CAN ID có định tuyến Rx: frame khác
+    // bị loại ở filter bank, không vào FIFO, không gây ngắt RX.
+    Can_IdType rxIds[CANIF_MAX_ROUTING_ENTRIES];
+    for(uint8_t i = 0u; i < numRxRoutes; i++){
+        rxIds[i] = routingTable[RxRouteByCanId[i]].CanId;
+    }
+    (void)Can_SetRxFilter(rxIds, numRxRoutes);
 
     // Sao chép toàn bộ nội dung của các mảng cấu hình.
     memcpy(ControllerMode, config->controllerMode, sizeof(ControllerMode));
@@ -63,8 +166,17 @@ void CanIf_Init(const CanIf_ConfigType* config){
     // Lưu lại các con trỏ hàm callback.
     txConfirmationCallback = config->txConfirmationCallback;
     rxIndicationCallback = config->rxIndicationCallback;
+    for(uint8_t i = 0u; i < CANIF_MAX_TX_PDUS; i++){
+        txConfirmationState[i] = CANIF_TX_CONF_NOT_PENDING;
+    }
+
+    rxRingTail = rxRingHead;
+    rxRingReceived = 0u;
+    rxRingDrops = 0u;
+    rxRingHighWater = 0u;
 
     Can_RegisterRxCallback(&CanIf_RxIndication);
+    Can_RegisterTxCallback(&CanIf_TxConfirmation);
     // printf("CanIf_Init\n");
 }
 
@@ -100,6 +212,8 @@ void CanIf_DeInit(void){
     numTxPdus = 0;
     numRxPdus = 0;
     numRoutingEntries = 0;
+    routingTable = NULL;
+    prv_build_route_index();
 
     // Reset các con trỏ callback.
     txConfirmationCallback = NULL;
@@ -172,19 +286,12 @@ Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfo){
     if(TxPduMode[TxPduId] == CANIF_OFFLINE) 
         return E_NOT_OK;
 
-    Can_IdType CanId = 0;
-    Can_HwHandleType Hth = 0;
-    // Tìm kiếm CAN ID tương ứng với TxPduId trong bảng định tuyến.
-    for(int i=0; i< numRoutingEntries; i++){
-
-        if(RoutingTable[i].id == TxPduId && RoutingTable[i].isTX == 1){
-            CanId = RoutingTable[i].CanId;
-            Hth = RoutingTable[i].Hth;
-            break; // Thoát khỏi vòngh lặp ngay khi tìm thấy.
-        }
-    }
-    // Nếu không tìm thấy CanId hợp lệ, trả về lỗi.
-    if(CanId == 0xFFFFFFFF) return E_NOT_OK;
+    // Tra trực tiếp mục định tuyến của TxPduId (chỉ mục dựng ở CanIf_Init).
+    const uint8_t route = (TxPduId < CANIF_MAX_TX_PDUS) ? TxRouteIdx[TxPduId] : CANIF_NO_ROUTE;
+    // Nếu không có đường định tuyến, trả về lỗi.
+    if(route == CANIF_NO_ROUTE) return E_NOT_OK;
+    const Can_IdType CanId = routingTable[route].CanId;
+    const Can_HwHandleType Hth = routingTable[route].Hth;
 
     // Chuẩn bị cấu trúc Can_PduType để truyền xuống cho CanDrv.
     Can_PduType frame;
@@ -195,8 +302,13 @@ Std_ReturnType CanIf_Transmit(PduIdType TxPduId, const PduInfoType* PduInfo){
     frame.swPduHandle = TxPduId;
 
     // Gọi hàm của CanDrv để ghi PDU vào hàng đợi truyền của phần cứng.
-     if(Can_Write(Hth, &frame) != E_OK) return E_NOT_OK;
-    
+    // Đặt PENDING trước: TxConfirmation (ISR TX) có thể đến ngay sau Can_Write().
+    txConfirmationState[TxPduId] = CANIF_TX_CONF_PENDING;
+    if(Can_Write(Hth, &frame) != E_OK){
+        txConfirmationState[TxPduId] = CANIF_TX_CONF_NOT_PENDING;
+        return E_NOT_OK;
+    }
+
     return E_OK;
 }
 
@@ -350,3 +462,82 @@ Std_ReturnType CanIf_SetBaudrate(uint8_t ControllerId, uint16_t BaudRateConfigID
     return E_OK;
 }
 
+/**
+ * @brief Callback xác nhận truyền, được gọi bởi lớp CanDrv (ngữ cảnh ISR TX).
+ * @details swPduHandle mà CanIf_Transmit() gửi xuống chính là TxPduId: cập nhật
+ *          trạng thái xác nhận rồi gọi callback lớp trên (PduR) trực tiếp.
+ * @param[in] CanTxPduId TxPduId của frame vừa được truyền thành công.
+ */
+void CanIf_TxConfirmation(PduIdType CanTxPduId){
+    if(CanTxPduId >= numTxPdus) return;
+
+    txConfirmationState[CanTxPduId] = CANIF_TX_CONF_NOT_PENDING;
+    if(txConfirmationCallback) {
+        txConfirmationCallback(CanTxPduId);
+    }
+}
+
+/**
+ * @brief Callback chỉ báo nhận dữ liệu, được gọi bởi lớp CanDrv (ngữ cảnh ISR RX).
+ * @details Chỉ chép frame vào vòng RX (vài chục lệnh mỗi frame); định tuyến và
+ *          chuỗi PduR → COM chạy sau trong CanIf_MainFunctionRx(). Vòng đầy →
+ *          bỏ frame mới và tăng rxRingDrops.
+ * @param[in] Mailbox Con trỏ tới cấu trúc mô tả phần cứng đã nhận frame (CanId).
+ * @param[in] PduInfoPtr Con trỏ tới thông tin PDU (data, length) đã nhận.
+ */
+void CanIf_RxIndication(const Can_HwType* Mailbox, const PduInfoType *PduInfoPtr) {
+    if((Mailbox == NULL) || (PduInfoPtr == NULL) || (PduInfoPtr->SduDataPtr == NULL)) return;
+
+    const uint32_t head = rxRingHead;
+    const uint32_t used = head - rxRingTail;
+    if(used >= CANIF_RX_RING_SIZE){
+        rxRingDrops++;
+        return;
+    }
+    CanIf_RxFrameType* f = &rxRing[head & (CANIF_RX_RING_SIZE - 1u)];
+    f->CanId = Mailbox->CanId;
+    f->length = (PduInfoPtr->SduLength < CANIF_MAX_RX_BUF_SIZE) ? (uint8_t)PduInfoPtr->SduLength : CANIF_MAX_RX_BUF_SIZE;
+    memcpy(f->data, PduInfoPtr->SduDataPtr, f->length);
+    __DMB();                    // dữ liệu vào vòng trước khi công bố head
+    rxRingHead = head + 1u;
+
+    rxRingReceived++;
+    if((used + 1u) > rxRingHighWater){
+        rxRingHighWater = (uint16_t)(used + 1u);
+    }
+}
+
+/**
+ * @brief Xử lý các frame trong vòng RX (ngữ cảnh task).
+ * @details Tìm nhị phân PDU ID theo CAN ID trong các mục Rx (O(log n)) rồi gọi
+ *          callback lớp trên (PduR). Frame không có định tuyến bị bỏ qua.
+ *          Slot chỉ được trả lại cho ISR sau khi lớp trên đã chép dữ liệu.
+ */
+void CanIf_MainFunctionRx(void){
+    uint32_t tail = rxRingTail;
+
+    while(tail != rxRingHead){
+        __DMB();                // đọc head trước khi đọc dữ liệu slot
+        const CanIf_RxFrameType* f = &rxRing[tail & (CANIF_RX_RING_SIZE - 1u)];
+        const uint8_t route = prv_find_by_canid(RxRouteByCanId, numRxRoutes, f->CanId);
+
+        if((rxIndicationCallback) && (route != CANIF_NO_ROUTE)) {
+            PduInfoType info;
+            info.SduDataPtr = (uint8_t*)f->data;
+            info.SduLength = f->length;
+            rxIndicationCallback(routingTable[route].id, &info);
+        }
+        __DMB();                // xong slot rồi mới trả cho ISR
+        rxRingTail = ++tail;
+    }
+}
+
+Std_ReturnType CanIf_GetRxStats(CanIf_RxStatsType *StatsPtr){
+    if(StatsPtr == NULL) return E_NOT_OK;
+
+    StatsPtr->received = rxRingReceived;
+    StatsPtr->ringDrops = rxRingDrops;
+    StatsPtr->fifoOverruns = Can_GetRxOverrunCount(CAN_FIFO0) + Can_GetRxOverrunCount(CAN_FIFO1);
+    StatsPtr->ringHighWater = rxRingHighWater;
+    return E_OK;
+}
@@ -46,6 +46,8 @@
 #define CANIF_MAX_TX_PDUS      4
 #define CANIF_MAX_RX_PDUS      4
 #define CANIF_MAX_RX_BUF_SIZE  8
+#define CANIF_MAX_ROUTING_ENTRIES  (CANIF_MAX_TX_PDUS + CANIF_MAX_RX_PDUS)
+#define CANIF_RX_RING_SIZE     32u  /**< Vòng RX ISR → CanIf_MainFunctionRx, lũy thừa của 2. */
 /** @} */
 
 /**
@@ -110,6 +112,17 @@ typedef struct{
     uint8_t hasData;                       /**< Cờ báo hiệu có dữ liệu mới hay không. */
 } CanIf_RxBufferType;
 
+/**
+ * @struct CanIf_RxStatsType
+ * @brief  Thống kê đường nhận (CanIf_GetRxStats).
+ */
+typedef struct{
+    uint32_t received;      /**< Số frame ISR đã đẩy vào vòng RX. */
+    uint32_t ringDrops;     /**< Số frame bị bỏ vì vòng RX đầy. */
+    uint32_t fifoOverruns;  /**< Số lần FIFO0/FIFO1 phần cứng tràn (FOVRx). */
+    uint16_t ringHighWater; /**< Số phần tử lớn nhất từng nằm trong vòng RX. */
+} CanIf_RxStatsType;
+
 /**********************************************************************
  * @brief Con trỏ hàm cho callback xác nhận truyền (Tx Confirmation).
  * @details CanIf sẽ gọi hàm này để thông báo cho lớp trên (PduR) khi một PDU đã được truyền thành công.
@@ -283,4 +296,18 @@ Std_ReturnType CanIf_GetControllerRxErrorCounter(uint8_t ControllerId, uint8_t *
  */
 Std_ReturnType CanIf_GetControllerTxErrorCounter(uint8_t ControllerId, uint8_t *TxErrorCounterPtr);
 
+/**
+ * @brief Xử lý các frame ISR RX đã đẩy vào vòng RX.
+ * @details Gọi định kỳ từ task (Task_Com, trước Com_MainFunctionRx): tra định
+ *          tuyến theo CAN ID rồi chuyển lên PduR → COM ngoài ngữ cảnh ngắt.
+ */
+void CanIf_MainFunctionRx(void);
+
+/**
+ * @brief Đọc thống kê đường nhận (frame nhận, bỏ do vòng đầy, tràn FIFO).
+ * @param[out] StatsPtr Con trỏ để lưu thống kê.
+ * @return Std_ReturnType E_OK nếu thành công, E_NOT_OK nếu StatsPtr NULL.
+ */
+Std_ReturnType CanIf_GetRxStats(CanIf_RxStatsType *StatsPtr);
+
 #endif /* CANIF_H */
@@ -3,15 +3,28 @@
  * @brief   AUTOSAR COM (phiên bản tối giản chạy trên MCU)
  * @details Thực thi các dịch vụ COM cốt lõi để gói/mở gói tín hiệu:
  *          - TX: Com_SendSignal() ghi vào shadow của I-PDU; với
- *                IPDU chế độ Triggered thì ứng dụng gọi thêm
- *                Com_TriggerIPDUSend() để phát ngay qua PduR.
+ *                IPDU DIRECT/MIXED ứng dụng gọi thêm
+ *                Com_TriggerIPDUSend() để xếp lịch phát.
  *          - RX: Com_RxIndication() (do PduR gọi) cập nhật buffer,
  *                ứng dụng đọc bằng Com_ReceiveSignal().
+ *          - Main function (Task_Com, mỗi COM_MAINFUNCTION_PERIOD_MS):
+ *                Com_MainFunctionTx() phát I-PDU PERIODIC/MIXED đúng
+ *                chu kỳ và I-PDU đã trigger, giữ MDT giữa hai lần phát;
+ *                Com_MainFunctionRx() giám sát deadline I-PDU RX.
+ *                Mỗi hướng có một min-heap I-PDU theo thời điểm tới
+ *                hạn: mỗi lần gọi chỉ so sánh gốc heap, không duyệt
+ *                toàn bộ bảng I-PDU.
+ *          - Pack/unpack theo bảng: Com_Init() dịch cấu hình signal
+ *            (bit position, độ dài, byte order) thành bảng layout
+ *            (byte LSB, shift, mask, số byte, hướng); mỗi signal chỉ
+ *            còn một vòng lặp ngắn trên các byte nó trải qua.
+ *          - Signal group (TX): Com_UpdateShadowSignal() pack vào ảnh
+ *            riêng của nhóm, Com_SendSignalGroup() chép cả ảnh vào
+ *            I-PDU trong một lần → các signal luôn đi cùng một frame.
  *
  *          Phạm vi/giới hạn:
- *            • Không in log, không cấp phát động, không DM/MDT/Filter,
- *              không TxMode periodic. Đủ dùng cho pattern
- *              Rte_Write_*() + Com_TriggerIPDUSend().
+ *            • Không in log, không cấp phát động, không Filter,
+ *              không lặp lại (NumberOfRepetitions) ở chế độ DIRECT.
  *            • Cấu hình (symbolic IDs, mapping signal↔IPDU, bit/byte)
  *              thường nằm ở Com_Cfg.c/h; ở bản demo này đặt cục bộ
  *              để đơn giản hoá.
@@ -23,16 +36,63 @@
  **********************************************************/
 
 #include "Com.h"
+#include "Os.h"       /* __disable_irq/__enable_irq */
 #include <string.h>   /* memset, memcpy */
 #include <stdio.h>
 
-/**
- * @brief RPM tối đa tương ứng với 100% tốc độ nhận được.
- */
-static uint16_t Speed;
-static bool Speed_is_Received = FALSE;
-static bool Stop;
-static bool Stop_is_Received = FALSE;
+/* -------- Layout tính sẵn cho từng signal (Com_Init) ----------------
+ *  Byte thứ i (0 = byte chứa LSB) nằm ở lsbByte + i*step và mang
+ *  các bit [8i - shift, 8i - shift + 7] của giá trị thô.
+ * ------------------------------------------------------------------ */
+typedef struct {
+    uint64_t mask;       /* bitLength bit thấp = 1 */
+    uint8_t* pdu;        /* buffer I-PDU (tra một lần ở Com_Init) */
+    uint16_t lsbByte;    /* byte chứa LSB */
+    uint8_t  shift;      /* vị trí LSB trong lsbByte (0..7) */
+    uint8_t  nBytes;     /* số byte tín hiệu trải qua (1..9) */
+    int8_t   step;       /* +1 Intel, -1 Motorola */
+    boolean  valid;      /* nằm trọn trong I-PDU */
+    uint8_t  group;      /* Com_SignalGroupIdType hoặc COM_NO_GROUP */
+} Com_SignalLayoutType;
+
+#define COM_NO_GROUP   0xFFu
+
+static Com_SignalLayoutType Com_SignalLayout[COM_NUM_SIGNALS];
+
+/* -------- Trạng thái động của từng I-PDU -----------------------------
+ *  Thời gian tính bằng ms theo đồng hồ của main function tương ứng
+ *  (Com_TxTime / Com_RxTime), so sánh an toàn khi tràn 32-bit.
+ * ------------------------------------------------------------------ */
+typedef struct {
+    uint32_t          nextPeriod;   /* TX: lần phát chu kỳ kế tiếp */
+    uint32_t          trigTime;     /* TX: thời điểm Com_TriggerIPDUSend() */
+    uint32_t          lastTx;       /* TX: lần phát gần nhất */
+    volatile uint32_t lastRx;       /* RX: lần nhận gần nhất (Com_RxIndication ghi) */
+    boolean           sent;         /* TX: lastTx hợp lệ */
+    boolean           pending;      /* TX: có trigger chờ phát */
+} Com_IPduStateType;
+
+/* -------- Hàng đợi tới hạn: min-heap I-PDU theo Com_Due[] -----------
+ *  - item[0] là I-PDU tới hạn sớm nhất
+ *  - Com_HeapPos[id]: vị trí trong heap (COM_HEAP_NONE = không có mặt)
+ *  Một I-PDU chỉ thuộc một heap (TX hoặc RX) nên Com_Due/Com_HeapPos
+ *  dùng chung cho cả hai.
+ * ------------------------------------------------------------------ */
+typedef struct {
+    PduIdType item[COM_NUM_IPDUS];
+    uint8_t   len;
+} Com_DueHeapType;
+
+#define COM_HEAP_NONE  0xFFu
+
+static Com_StatusType    Com_Status = COM_UNINIT;
+static Com_IPduStateType Com_IPduState[COM_NUM_IPDUS];
+static uint32_t          Com_Due[COM_NUM_IPDUS];
+static uint8_t           Com_HeapPos[COM_NUM_IPDUS];
+static Com_DueHeapType   Com_TxHeap;
+static Com_DueHeapType   Com_RxHeap;
+static uint32_t          Com_TxTime;
+static volatile uint32_t Com_RxTime;
 /* --------------------------------------------------------------------
  * Lower layer (chuẩn AUTOSAR):
  *  - COM gọi PduR_ComTransmit() để yêu cầu truyền I-PDU TX.
@@ -41,148 +101,440 @@ static bool Stop_is_Received = FALSE;
 extern Std_ReturnType PduR_ComTransmit(PduIdType TxPduId, const PduInfoType* info);
 
 /* -------- Truy cập bộ đệm theo PduId --------------------------------
+ *  Com_IPduCfg[] đánh chỉ số theo PduId: tra O(1), không duyệt bảng.
  *  Trả về con trỏ buffer nội bộ và (tuỳ chọn) chiều & độ dài.
  * ------------------------------------------------------------------ */
 static uint8_t* prv_get_pdu_buf(PduIdType pduId, PduLengthType* len, Com_PduDirection_e* dir)
 {
-    for (uint16_t i = 0u; i < COM_NUM_IPDUS; ++i)
+    if ((pduId >= COM_NUM_IPDUS) || (Com_IPduCfg[pduId].PduId != pduId))
     {
-        if (Com_IPduCfg[i].PduId == pduId)
-        {
-            if (len) *len = Com_IPduCfg[i].Length;
-            if (dir) *dir = Com_IPduCfg[i].direction;
+        return NULL;
+    }
+    if (len) *len = Com_IPduCfg[pduId].Length;
+    if (dir) *dir = Com_IPduCfg[pduId].direction;
+    return Com_IPduCfg[pduId].buffer;
+}
 
-            if (pduId == ComConf_ComIPdu_VCU_Command)   { return s_TxBuf_VcuCommand; }
-            if (pduId == ComConf_ComIPdu_Engine_Status) { return s_RxBuf_EngStatus;  }
-            break;
-        }
+/* ====================================================================
+ * 2) PACK/UNPACK THEO BẢNG LAYOUT
+ * ===================================================================*/
+static boolean prv_build_layout(const Com_SignalCfgType* cfg, Com_SignalLayoutType* l)
+{
+    PduLengthType len = 0u;
+    Com_PduDirection_e d;
+
+    l->valid = FALSE;
+    l->group = COM_NO_GROUP;
+    l->pdu   = prv_get_pdu_buf(cfg->PduId, &len, &d);
+    if ((cfg->bitLength == 0u) || (cfg->bitLength > 64u) ||
+        (l->pdu == NULL) || (d != cfg->direction))
+    {
+        return FALSE;
+    }
+
+    const uint16_t lsb = (uint16_t)(cfg->bitPosition >> 3);
+    l->shift   = (uint8_t)(cfg->bitPosition & 7u);
+    l->nBytes  = (uint8_t)((l->shift + cfg->bitLength + 7u) >> 3);
+    l->lsbByte = lsb;
+    l->mask    = (cfg->bitLength == 64u) ? ~(uint64_t)0u : (((uint64_t)1u << cfg->bitLength) - 1u);
+
+    if (cfg->endianness == COM_BIG_ENDIAN)
+    {
+        l->step = -1;
+        if ((lsb >= len) || (lsb < (uint16_t)(l->nBytes - 1u))) { return FALSE; }
+    }
+    else
+    {
+        l->step = 1;
+        if (((uint32_t)lsb + l->nBytes) > len) { return FALSE; }
+    }
+    l->valid = TRUE;
+    return TRUE;
+}
+
+static void prv_pack(uint8_t* pdu, const Com_SignalLayoutType* l, uint64_t raw)
+{
+    uint8_t* p = &pdu[l->lsbByte];
+    uint8_t bm = (uint8_t)(l->mask << l->shift);
+
+    *p = (uint8_t)((*p & (uint8_t)~bm) | ((uint8_t)(raw << l->shift) & bm));
+    for (uint8_t i = 1u; i < l->nBytes; ++i)
+    {
+        const uint8_t sh = (uint8_t)((8u * i) - l->shift);
+        p += l->step;
+        bm = (uint8_t)(l->mask >> sh);
+        *p = (uint8_t)((*p & (uint8_t)~bm) | ((uint8_t)(raw >> sh) & bm));
+    }
+}
+
+static uint64_t prv_unpack(const uint8_t* pdu, const Com_SignalLayoutType* l)
+{
+    const uint8_t* p = &pdu[l->lsbByte];
+    uint64_t raw = (uint64_t)(*p >> l->shift);
+
+    for (uint8_t i = 1u; i < l->nBytes; ++i)
+    {
+        p += l->step;
+        raw |= (uint64_t)*p << ((8u * i) - l->shift);
+    }
+    return raw & l->mask;
+}
+
+static boolean prv_is_signed(Com_SignalType_e t)
+{
+    return (t == COM_SIGTYPE_SINT8) || (t == COM_SIGTYPE_SINT16) ||
+           (t == COM_SIGTYPE_SINT32) || (t == COM_SIGTYPE_SINT64);
+}
+
+/* Giá trị ứng dụng (*dataPtr, kiểu cfg->type) → giá trị thô */
+static uint64_t prv_to_raw(const Com_SignalCfgType* cfg, const void* dataPtr)
+{
+    int64_t v;
+    switch (cfg->type)
+    {
+        case COM_SIGTYPE_BOOLEAN: v = (*(const boolean*)dataPtr) ? 1 : 0;    break;
+        case COM_SIGTYPE_UINT16:  v = (int64_t)*(const uint16_t*)dataPtr;    break;
+        case COM_SIGTYPE_UINT32:  v = (int64_t)*(const uint32_t*)dataPtr;    break;
+        case COM_SIGTYPE_UINT64:  v = (int64_t)*(const uint64_t*)dataPtr;    break;
+        case COM_SIGTYPE_SINT8:   v = (int64_t)*(const int8_t*)dataPtr;      break;
+        case COM_SIGTYPE_SINT16:  v = (int64_t)*(const int16_t*)dataPtr;     break;
+        case COM_SIGTYPE_SINT32:  v = (int64_t)*(const int32_t*)dataPtr;     break;
+        case COM_SIGTYPE_SINT64:  v = *(const int64_t*)dataPtr;              break;
+        case COM_SIGTYPE_UINT8:
+        default:                  v = (int64_t)*(const uint8_t*)dataPtr;     break;
+    }
+    if ((cfg->factor > 1) || (cfg->factor < 0) || (cfg->offset != 0))
+    {
+        const int64_t f = (cfg->factor == 0) ? 1 : (int64_t)cfg->factor;
+        v = (v - (int64_t)cfg->offset) / f;
+    }
+    return (uint64_t)v;
+}
+
+/* Giá trị thô → giá trị ứng dụng (*dataPtr, kiểu cfg->type) */
+static void prv_from_raw(const Com_SignalCfgType* cfg, uint64_t raw, void* dataPtr)
+{
+    if (prv_is_signed(cfg->type) && (cfg->bitLength < 64u) &&
+        (((raw >> (cfg->bitLength - 1u)) & 1u) != 0u))
+    {
+        raw |= ~(((uint64_t)1u << cfg->bitLength) - 1u);   /* mở rộng dấu */
+    }
+    int64_t v = (int64_t)raw;
+    if ((cfg->factor > 1) || (cfg->factor < 0) || (cfg->offset != 0))
+    {
+        const int64_t f = (cfg->factor == 0) ? 1 : (int64_t)cfg->factor;
+        v = (v * f) + (int64_t)cfg->offset;
+    }
+    switch (cfg->type)
+    {
+        case COM_SIGTYPE_BOOLEAN: *(boolean*)dataPtr  = (v != 0) ? TRUE : FALSE; break;
+        case COM_SIGTYPE_UINT16:  *(uint16_t*)dataPtr = (uint16_t)v;             break;
+        case COM_SIGTYPE_UINT32:  *(uint32_t*)dataPtr = (uint32_t)v;             break;
+        case COM_SIGTYPE_UINT64:  *(uint64_t*)dataPtr = (uint64_t)v;             break;
+        case COM_SIGTYPE_SINT8:   *(int8_t*)dataPtr   = (int8_t)v;               break;
+        case COM_SIGTYPE_SINT16:  *(int16_t*)dataPtr  = (int16_t)v;              break;
+        case COM_SIGTYPE_SINT32:  *(int32_t*)dataPtr  = (int32_t)v;              break;
+        case COM_SIGTYPE_SINT64:  *(int64_t*)dataPtr  = v;                       break;
+        case COM_SIGTYPE_UINT8:
+        default:                  *(uint8_t*)dataPtr  = (uint8_t)v;              break;
     }
-    return NULL;
 }
 
 /* ====================================================================
- * 2) TIỆN ÍCH PACK/UNPACK TRONG MIỀN BYTE
+ * 3) HÀNG ĐỢI TỚI HẠN (min-heap)
  * ===================================================================*/
-static inline void put_u8(uint8_t* dst, uint16_t byteIndex, uint8_t v)
+static inline boolean prv_time_before(uint32_t a, uint32_t b)
 {
-    dst[byteIndex] = v;
+    return ((int32_t)(a - b) < 0) ? TRUE : FALSE;
 }
 
-static inline uint8_t get_u8(const uint8_t* src, uint16_t byteIndex)
+static inline void prv_heap_set(Com_DueHeapType* h, uint8_t i, PduIdType id)
 {
-    return src[byteIndex];
+    h->item[i] = id;
+    Com_HeapPos[id] = i;
+}
+
+static void prv_heap_sift_up(Com_DueHeapType* h, uint8_t i)
+{
+    const PduIdType id = h->item[i];
+    while (i > 0u)
+    {
+        const uint8_t parent = (uint8_t)((i - 1u) >> 1);
+        if (prv_time_before(Com_Due[id], Com_Due[h->item[parent]]) == FALSE) { break; }
+        prv_heap_set(h, i, h->item[parent]);
+        i = parent;
+    }
+    prv_heap_set(h, i, id);
 }
 
-/* Ghi nibble (4 bit) vào vị trí bitOffset (0..3) trong một byte */
-static void put_nibble(uint8_t* dst, uint16_t byteIndex, uint8_t bitOffset, uint8_t v4)
+static void prv_heap_sift_down(Com_DueHeapType* h, uint8_t i)
 {
-    const uint8_t mask = (uint8_t)(0x0Fu << bitOffset);
-    const uint8_t val  = (uint8_t)((v4 & 0x0Fu) << bitOffset);
-    dst[byteIndex] = (uint8_t)((dst[byteIndex] & (uint8_t)(~mask)) | val);
+    const PduIdType id = h->item[i];
+    for (;;)
+    {
+        const uint8_t l = (uint8_t)((2u * i) + 1u);
+        const uint8_t r = (uint8_t)(l + 1u);
+        uint8_t m;
+        if (l >= h->len) { break; }
+        m = l;
+        if ((r < h->len) && prv_time_before(Com_Due[h->item[r]], Com_Due[h->item[l]])) { m = r; }
+        if (prv_time_before(Com_Due[h->item[m]], Com_Due[id]) == FALSE) { break; }
+        prv_heap_set(h, i, h->item[m]);
+        i = m;
+    }
+    prv_heap_set(h, i, id);
 }
 
-/* Ghi 1 bit (bitLength=1) tại bitOffset (0..7) */
-static void put_bit(uint8_t* dst, uint16_t byteIndex, uint8_t bitOffset, boolean b)
+/* Đặt thời điểm tới hạn mới cho id (thêm vào heap nếu chưa có) */
+static void prv_heap_schedule(Com_DueHeapType* h, PduIdType id, uint32_t due)
 {
-    const uint8_t mask = (uint8_t)(1u << bitOffset);
-    if (b) { dst[byteIndex] = (uint8_t)(dst[byteIndex] |  mask); }
-    else   { dst[byteIndex] = (uint8_t)(dst[byteIndex] & (uint8_t)(~mask)); }
+    Com_Due[id] = due;
+    if (Com_HeapPos[id] == COM_HEAP_NONE)
+    {
+        const uint8_t i = h->len++;
+        prv_heap_set(h, i, id);
+        prv_heap_sift_up(h, i);
+    }
+    else
+    {
+        prv_heap_sift_up(h, Com_HeapPos[id]);
+        prv_heap_sift_down(h, Com_HeapPos[id]);
+    }
 }
 
-/* Đọc big-endian 16-bit: (b0<<8) | b1 */
-static inline uint16_t get_be16(const uint8_t* src, uint16_t byteIndex)
+static void prv_heap_remove(Com_DueHeapType* h, PduIdType id)
 {
-    return (uint16_t)((((uint16_t)src[byteIndex]) << 8) | (uint16_t)src[byteIndex + 1u]);
+    const uint8_t i = Com_HeapPos[id];
+    if (i == COM_HEAP_NONE) { return; }
+
+    Com_HeapPos[id] = COM_HEAP_NONE;
+    h->len--;
+    if (i == h->len) { return; }
+    const PduIdType moved = h->item[h->len];
+    prv_heap_set(h, i, moved);
+    prv_heap_sift_down(h, i);
+    if (Com_HeapPos[moved] == i)
+    {
+        prv_heap_sift_up(h, i);
+    }
+}
+
+/* TX: thời điểm tới hạn = sớm nhất(chu kỳ kế, trigger đang chờ),
+ * không sớm hơn lastTx + MDT. Không còn gì để phát → rời heap.
+ * Gọi trong vùng găng (Com_TriggerIPDUSend chạy ở task khác). */
+static void prv_tx_reschedule(PduIdType id)
+{
+    const Com_IPduCfgType* cfg = &Com_IPduCfg[id];
+    const Com_IPduStateType* st = &Com_IPduState[id];
+    const boolean periodic = (cfg->txMode != COM_TX_MODE_DIRECT) && (cfg->periodMs != 0u);
+    uint32_t due;
+
+    if (periodic == TRUE)
+    {
+        due = st->nextPeriod;
+        if ((st->pending == TRUE) && prv_time_before(st->trigTime, due)) { due = st->trigTime; }
+    }
+    else if (st->pending == TRUE)
+    {
+        due = st->trigTime;
+    }
+    else
+    {
+        prv_heap_remove(&Com_TxHeap, id);
+        return;
+    }
+    if ((st->sent == TRUE) && prv_time_before(due, st->lastTx + cfg->mdtMs))
+    {
+        due = st->lastTx + cfg->mdtMs;
+    }
+    prv_heap_schedule(&Com_TxHeap, id, due);
 }
 
 /* ====================================================================
- * 3) LIFECYCLE
+ * 4) LIFECYCLE
  * ===================================================================*/
 void Com_Init(void)
 {
-    (void)memset(s_TxBuf_VcuCommand, 0, sizeof(s_TxBuf_VcuCommand));
-    (void)memset(s_RxBuf_EngStatus,  0, sizeof(s_RxBuf_EngStatus));
+    for (PduIdType p = 0u; p < COM_NUM_IPDUS; ++p)
+    {
+        (void)memset(Com_IPduCfg[p].buffer, 0, Com_IPduCfg[p].Length);
+    }
+    for (Com_SignalIdType id = 0u; id < COM_NUM_SIGNALS; ++id)
+    {
+        (void)prv_build_layout(&Com_SignalCfg[id], &Com_SignalLayout[id]);
+    }
+
+    /* Signal group: gắn signal vào nhóm, mask = hợp các bit của nhóm */
+    for (Com_SignalGroupIdType g = 0u; g < COM_NUM_SIGNAL_GROUPS; ++g)
+    {
+        const Com_SignalGroupCfgType* grp = &Com_SignalGroupCfg[g];
+        PduLengthType len = 0u;
+        if (prv_get_pdu_buf(grp->PduId, &len, NULL) == NULL) { continue; }
+
+        (void)memset(grp->shadow, 0, len);
+        (void)memset(grp->mask,   0, len);
+        for (uint8_t i = 0u; i < grp->numSignals; ++i)
+        {
+            const Com_SignalIdType id = grp->signals[i];
+            Com_SignalLayoutType* l = &Com_SignalLayout[id];
+            if ((id < COM_NUM_SIGNALS) && (l->valid == TRUE) &&
+                (Com_SignalCfg[id].PduId == grp->PduId))
+            {
+                l->group = (uint8_t)g;
+                prv_pack(grp->mask, l, l->mask);
+            }
+        }
+    }
+
+    /* Lịch main function: I-PDU chu kỳ phát lần đầu ở offsetMs,
+     * I-PDU RX có deadline bắt đầu đếm từ Com_Init() */
+    Com_TxTime = 0u;
+    Com_RxTime = 0u;
+    Com_TxHeap.len = 0u;
+    Com_RxHeap.len = 0u;
+    for (PduIdType p = 0u; p < COM_NUM_IPDUS; ++p)
+    {
+        const Com_IPduCfgType* cfg = &Com_IPduCfg[p];
+        (void)memset(&Com_IPduState[p], 0, sizeof(Com_IPduState[p]));
+        Com_HeapPos[p] = COM_HEAP_NONE;
+
+        if (cfg->direction == COM_PDU_DIR_TX)
+        {
+            Com_IPduState[p].nextPeriod = cfg->offsetMs;
+            prv_tx_reschedule(p);
+        }
+        else if (cfg->timeoutMs != 0u)
+        {
+            prv_heap_schedule(&Com_RxHeap, p, cfg->timeoutMs);
+        }
+    }
+    Com_Status = COM_INIT;
     //printf("Com_Init\n");
 }
 
 void Com_DeInit(void)
 {
-    /* Không giữ trạng thái động; không cần xử lý gì thêm. */
+    /* Dừng lịch main function; buffer giữ nguyên tới Com_Init() kế */
+    Com_Status = COM_UNINIT;
+    Com_TxHeap.len = 0u;
+    Com_RxHeap.len = 0u;
 }
 
 /* ====================================================================
- * 4) API TX
+ * 5) API TX
  * ===================================================================*/
 Std_ReturnType Com_SendSignal(Com_SignalIdType id, const void* dataPtr)
 {
-    if (dataPtr == NULL)  return E_NOT_OK; 
+    if ((dataPtr == NULL) || (id >= COM_NUM_SIGNALS)) { return E_NOT_OK; }
 
-    /* Tra cấu hình signal theo id (demo: id là chỉ số tuyến tính) */
     const Com_SignalCfgType* cfg = &Com_SignalCfg[id];
+    const Com_SignalLayoutType* l = &Com_SignalLayout[id];
+    if ((cfg->direction != COM_PDU_DIR_TX) || (l->valid == FALSE)) { return E_NOT_OK; }
 
-    if ((cfg == NULL) || (cfg->direction != COM_PDU_DIR_TX)) { return E_NOT_OK; }
+    prv_pack(l->pdu, l, prv_to_raw(cfg, dataPtr));
+    return E_OK;
+}
 
-    PduLengthType len = 0u; 
-    Com_PduDirection_e d;
+Std_ReturnType Com_UpdateShadowSignal(Com_SignalIdType id, const void* dataPtr)
+{
+    if ((dataPtr == NULL) || (id >= COM_NUM_SIGNALS)) { return E_NOT_OK; }
 
-    uint8_t* pdu = prv_get_pdu_buf(cfg->PduId, &len, &d);
-    if ((pdu == NULL) || (d != COM_PDU_DIR_TX)) { return E_NOT_OK; }
-    if (cfg->byteIndex >= len) { return E_NOT_OK; }
+    const Com_SignalLayoutType* l = &Com_SignalLayout[id];
+    if (l->group == COM_NO_GROUP) { return E_NOT_OK; }
 
-    switch (cfg->bitLength)
-    {
-        case 8u:
-        {
-            if (cfg->type == COM_SIGTYPE_BOOLEAN)
-            {
-                const uint8_t v = (*(const boolean*)dataPtr) ? 1u : 0u;
-                put_u8(pdu, cfg->byteIndex, v);
-            }
-            else
-            {
-                put_u8(pdu, cfg->byteIndex, *(const uint8_t*)dataPtr);
-            }
-        } break;
+    prv_pack(Com_SignalGroupCfg[l->group].shadow, l, prv_to_raw(&Com_SignalCfg[id], dataPtr));
+    return E_OK;
+}
 
-        case 4u:
-        {
-            const uint8_t v4 = (uint8_t)(*(const uint8_t*)dataPtr & 0x0Fu);
-            put_nibble(pdu, cfg->byteIndex, cfg->bitOffset, v4);
-        } break;
+Std_ReturnType Com_SendSignalGroup(Com_SignalGroupIdType id)
+{
+    if (id >= COM_NUM_SIGNAL_GROUPS) { return E_NOT_OK; }
 
-        case 1u:
-        {
-            const boolean b = (*(const boolean*)dataPtr) ? TRUE : FALSE;
-            put_bit(pdu, cfg->byteIndex, cfg->bitOffset, b);
-        } break;
+    const Com_SignalGroupCfgType* grp = &Com_SignalGroupCfg[id];
+    PduLengthType len = 0u;
+    Com_PduDirection_e d;
+    uint8_t* pdu = prv_get_pdu_buf(grp->PduId, &len, &d);
+    if ((pdu == NULL) || (d != COM_PDU_DIR_TX)) { return E_NOT_OK; }
 
-        default:
-            /* Demo này chỉ hỗ trợ 1/4/8 bit (và 16 bit cho RX) */
-            return E_NOT_OK;
+    __disable_irq();
+    for (PduLengthType i = 0u; i < len; ++i)
+    {
+        pdu[i] = (uint8_t)((pdu[i] & (uint8_t)~grp->mask[i]) | (grp->shadow[i] & grp->mask[i]));
     }
-
+    __enable_irq();
     return E_OK;
 }
 
 /**
- * @brief  Kích phát gửi I-PDU ngay (đường TX).
- * @note   Dùng cho IPDU chế độ Triggered/Direct. Với Periodic, việc gửi do
- *         nền tảng lập lịch riêng đảm nhiệm (không hiện thực ở demo này).
+ * @brief  Xếp lịch phát I-PDU (đường TX).
+ * @note   Chỉ ghi nhận yêu cầu; việc phát do Com_MainFunctionTx() thực
+ *         hiện ở lần gọi kế tiếp (hoặc khi hết MDT). Nhiều trigger trước
+ *         lần phát đó gộp thành một frame mang dữ liệu mới nhất.
  */
 Std_ReturnType Com_TriggerIPDUSend(PduIdType pduId)
 {
-    PduLengthType len = 0u; Com_PduDirection_e d;
-    uint8_t* buf = prv_get_pdu_buf(pduId, &len, &d);
-    if ((buf == NULL) || (d != COM_PDU_DIR_TX)) { return E_NOT_OK; }
+    Com_PduDirection_e d;
+    if ((Com_Status != COM_INIT) ||
+        (prv_get_pdu_buf(pduId, NULL, &d) == NULL) || (d != COM_PDU_DIR_TX))
+    {
+        return E_NOT_OK;
+    }
+    if (Com_IPduCfg[pduId].txMode == COM_TX_MODE_PERIODIC) { return E_OK; }
+
+    __disable_irq();
+    Com_IPduStateType* st = &Com_IPduState[pduId];
+    if (st->pending == FALSE)
+    {
+        st->pending  = TRUE;
+        st->trigTime = Com_TxTime;
+        prv_tx_reschedule(pduId);
+    }
+    __enable_irq();
+    return E_OK;
+}
+
+void Com_MainFunctionTx(void)
+{
+    if (Com_Status != COM_INIT) { return; }
 
-    PduInfoType info;
-    info.SduDataPtr = buf;
-    info.SduLength  = len;
+    Com_TxTime += COM_MAINFUNCTION_PERIOD_MS;
+    const uint32_t now = Com_TxTime;
+
+    for (;;)
+    {
+        __disable_irq();
+        if ((Com_TxHeap.len == 0u) || prv_time_before(now, Com_Due[Com_TxHeap.item[0]]))
+        {
+            __enable_irq();
+            break;
+        }
+        const PduIdType id = Com_TxHeap.item[0];
+        const Com_IPduCfgType* cfg = &Com_IPduCfg[id];
+        Com_IPduStateType* st = &Com_IPduState[id];
+
+        /* Gốc heap đã tôn trọng MDT (prv_tx_reschedule) → phát.
+         * Chu kỳ bị lỡ (task trễ) được bỏ qua, không phát dồn. */
+        st->sent    = TRUE;
+        st->lastTx  = now;
+        st->pending = FALSE;
+        if ((cfg->txMode != COM_TX_MODE_DIRECT) && (cfg->periodMs != 0u))
+        {
+            while (prv_time_before(now, st->nextPeriod) == FALSE)
+            {
+                st->nextPeriod += cfg->periodMs;
+            }
+        }
+        prv_tx_reschedule(id);
+        __enable_irq();
 
-    return PduR_ComTransmit(pduId, &info);
+        PduInfoType info;
+        info.SduDataPtr = cfg->buffer;
+        info.SduLength  = cfg->Length;
+        (void)PduR_ComTransmit(id, &info);
+    }
 }
 /* ====================================================================
- * 5) API RX
+ * 6) API RX
  * ===================================================================*/
 
 void Com_RxIndication(PduIdType ComRxPduId, const PduInfoType* PduInfoPtr){
@@ -197,29 +549,72 @@ void Com_RxIndication(PduIdType ComRxPduId, const PduInfoType* PduInfoPtr){
         return;
     }
 
-    /* Sao chép dữ liệu nhận được vào buffer nội bộ của COM */
+    /* Sao chép dữ liệu nhận được vào buffer nội bộ của COM;
+     * tín hiệu được unpack khi ứng dụng gọi Com_ReceiveSignal() */
     PduLengthType bytes_to_copy = (PduInfoPtr->SduLength < len) ? PduInfoPtr->SduLength : len;
     (void)memcpy(buf, PduInfoPtr->SduDataPtr, bytes_to_copy);
 
-    /* Xử lý các tín hiệu trong PDU vừa nhận (ví dụ) */
-    if (ComRxPduId == ComConf_ComIPdu_Engine_Status)
+    /* Deadline: chỉ ghi mốc nhận, Com_MainFunctionRx() dời lịch sau */
+    Com_IPduState[ComRxPduId].lastRx = Com_RxTime;
+}
+
+void Com_MainFunctionRx(void)
+{
+    if (Com_Status != COM_INIT) { return; }
+
+    Com_RxTime += COM_MAINFUNCTION_PERIOD_MS;
+    const uint32_t now = Com_RxTime;
+
+    while ((Com_RxHeap.len != 0u) && (prv_time_before(now, Com_Due[Com_RxHeap.item[0]]) == FALSE))
     {
-        /* Giả sử tín hiệu tốc độ động cơ được mã hóa trong 2 byte đầu tiên (big-endian) */
-        Speed = get_u8(buf, 0); /* Đọc 2 byte từ đầu buffer */
+        const PduIdType id = Com_RxHeap.item[0];
+        const Com_IPduCfgType* cfg = &Com_IPduCfg[id];
+
+        /* Có frame sau lần xét trước → dời deadline theo mốc nhận mới;
+         * không có → quá hạn, nạp lại bộ đếm cho lần báo kế tiếp */
+        __disable_irq();
+        const uint32_t due = Com_IPduState[id].lastRx + cfg->timeoutMs;
+        if (prv_time_before(now, due))
+        {
+            __enable_irq();
+            prv_heap_schedule(&Com_RxHeap, id, due);
+            continue;
+        }
+        if (cfg->timeoutAction == COM_RX_TIMEOUT_REPLACE)
+        {
+            (void)memset(cfg->buffer, 0, cfg->Length);
+        }
+        __enable_irq();
+        prv_heap_schedule(&Com_RxHeap, id, now + cfg->timeoutMs);
+
+        if (cfg->timeoutNotification != NULL)
+        {
+            cfg->timeoutNotification();
+        }
     }
 }
 void Com_TxConfirmation(PduIdType ComTxPduId){
-    (void)ComTxPduId;
+    Com_PduDirection_e dir;
+
+    /* Gọi từ ISR TX qua CanIf → PduR: frame đã thực sự lên bus */
+    if ((prv_get_pdu_buf(ComTxPduId, NULL, &dir) == NULL) || (dir != COM_PDU_DIR_TX)) { return; }
+    if (Com_IPduCfg[ComTxPduId].txNotification != NULL)
+    {
+        Com_IPduCfg[ComTxPduId].txNotification();
+    }
 }
 Std_ReturnType Com_ReceiveSignal(Com_SignalIdType id, void* dataPtr){
-    if (dataPtr == NULL)  return E_NOT_OK;
+    if ((dataPtr == NULL) || (id >= COM_NUM_SIGNALS)) { return E_NOT_OK; }
 
     const Com_SignalCfgType* cfg = &Com_SignalCfg[id];
-    if ((id > COM_NUM_SIGNALS) || (cfg->direction != COM_PDU_DIR_RX)) return E_NOT_OK;
+    const Com_SignalLayoutType* l = &Com_SignalLayout[id];
+    if ((cfg->direction != COM_PDU_DIR_RX) || (l->valid == FALSE)) { return E_NOT_OK; }
 
-    if(id == ComConf_ComSignal_EngineSpeedRpm){
-        *(uint16_t*)dataPtr = Speed;
-        return E_OK;
-    }
-    else return E_NOT_OK;
+    /* Com_RxIndication chạy ở Task_Com (ưu tiên cao hơn): không để nó ghi đè giữa chừng */
+    __disable_irq();
+    const uint64_t raw = prv_unpack(l->pdu, l);
+    __enable_irq();
+
+    prv_from_raw(cfg, raw, dataPtr);
+    return E_OK;
 }
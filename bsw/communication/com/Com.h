@@ -29,13 +29,6 @@ extern "C" {
 #include "Std_Types.h"        /* Std_ReturnType, boolean, uint8/16... */
 #include "ComStack_Types.h"   /* PduIdType, PduInfoType */
 
-/* =========================================================
- * 1) ID typedef (rút gọn)
- *    - Trong dự án thực tế, các kiểu này có thể do tool sinh
- *      ra với độ rộng phù hợp. Ở đây dùng uint16 cho gọn.
- * =======================================================*/
-typedef uint16_t Com_SignalIdType;      /**< Kiểu dữ liệu cho ID của Signal. */
-
 #include "Com_Cfg.h"          /* Com_SignalIdType, Com_SignalGroupIdType, symbolic IDs */
 
 typedef enum {
@@ -59,8 +52,23 @@ void Com_Init(void);
  */
 void Com_DeInit(void);
 
-void Com_MainFunction(void);
-/**)
+/**
+ * @brief   Main function RX: giám sát deadline các I-PDU RX.
+ * @details Gọi mỗi COM_MAINFUNCTION_PERIOD_MS (Task_Com). Chỉ xét gốc
+ *          hàng đợi tới hạn; I-PDU quá timeoutMs mà chưa nhận được
+ *          frame nào sẽ chịu timeoutAction và timeoutNotification.
+ */
+void Com_MainFunctionRx(void);
+
+/**
+ * @brief   Main function TX: phát các I-PDU đã tới hạn.
+ * @details Gọi mỗi COM_MAINFUNCTION_PERIOD_MS (Task_Com). Phát I-PDU
+ *          PERIODIC/MIXED theo chu kỳ và I-PDU đã được
+ *          Com_TriggerIPDUSend(), luôn tôn trọng MDT. Mọi lần phát của
+ *          COM đều đi từ đây → một ngữ cảnh gọi PduR_ComTransmit().
+ */
+void Com_MainFunctionTx(void);
+
 /* =========================================================
  * 2) TX API
  * =======================================================*/
@@ -77,15 +85,39 @@ void Com_MainFunction(void);
 Std_ReturnType Com_SendSignal(Com_SignalIdType id, const void* dataPtr);
 
 /**
- * @brief   Kích phát gửi một I-PDU ngay lập tức.
- * @details Dành cho IPDU cấu hình chế độ truyền “Triggered” hoặc
- *          khi ứng dụng cần phát hiện thời điểm gửi.
+ * @brief   Yêu cầu phát một I-PDU.
+ * @details I-PDU DIRECT/MIXED được xếp lịch phát ở lần
+ *          Com_MainFunctionTx() kế tiếp (hoãn tới khi hết MDT nếu vừa
+ *          phát). I-PDU PERIODIC bỏ qua yêu cầu: dữ liệu mới đi theo
+ *          chu kỳ kế tiếp.
  *
  * @param   pduId  ID tượng trưng của I-PDU (TX).
- * @return  E_OK nếu đã xếp lịch/đẩy xuống PduR; E_NOT_OK nếu lỗi tham số/ID.
+ * @return  E_OK nếu đã xếp lịch; E_NOT_OK nếu lỗi tham số/ID hoặc COM chưa init.
  */
 Std_ReturnType Com_TriggerIPDUSend(PduIdType pduId);
 
+/**
+ * @brief   Ghi một group signal vào shadow buffer của signal group.
+ * @details Chỉ pack vào ảnh I-PDU riêng của nhóm; I-PDU thật không đổi
+ *          cho tới Com_SendSignalGroup().
+ *
+ * @param   id       ID của signal thuộc một signal group (TX).
+ * @param   dataPtr  Con trỏ tới giá trị nguồn (kiểu đúng với cấu hình).
+ * @return  E_OK nếu ghi thành công; E_NOT_OK nếu signal không thuộc nhóm.
+ */
+Std_ReturnType Com_UpdateShadowSignal(Com_SignalIdType id, const void* dataPtr);
+
+/**
+ * @brief   Chép nguyên shadow buffer của nhóm vào I-PDU.
+ * @details Một lần chép có mask trong vùng găng ngắn: mọi group signal
+ *          rời đi trong cùng một frame nhất quán. Với IPDU Triggered,
+ *          gọi tiếp Com_TriggerIPDUSend().
+ *
+ * @param   id  ID của signal group (TX).
+ * @return  E_OK nếu thành công; E_NOT_OK nếu ID không hợp lệ.
+ */
+Std_ReturnType Com_SendSignalGroup(Com_SignalGroupIdType id);
+
 /* =========================================================
  * 3) RX API
  * =======================================================*/
@@ -100,15 +132,22 @@ Std_ReturnType Com_TriggerIPDUSend(PduIdType pduId);
 Std_ReturnType Com_ReceiveSignal(Com_SignalIdType id, void* dataPtr);
 /**
  * @brief   Callback được gọi bởi PduR khi có một I-PDU RX được nhận.
- * @details Hàm này có vai trò chính là nhận dữ liệu thô từ lớp dưới (PduR)
- *          .Trong phiên bản demo này, logic được đơn giản hóa bằng cách xử 
- *          lý trực tiếp một số lệnh (command) thay vì thực hiện giải mã tín hiệu chung.
+ * @details Sao chép dữ liệu thô từ lớp dưới (PduR) vào buffer I-PDU của
+ *          COM; các signal được unpack theo bảng layout khi ứng dụng gọi
+ *          Com_ReceiveSignal().
  *
  * @param   ComRxPduId ID của I-PDU nhận được (do PduR cung cấp).
  * @param   PduInfoPtr Con trỏ chứa dữ liệu và độ dài của PDU.
  */
 void Com_RxIndication(PduIdType ComRxPduId, const PduInfoType* PduInfoPtr);
 
+/**
+ * @brief   Callback được gọi bởi PduR khi một I-PDU TX đã lên bus.
+ * @details Chuỗi ISR TX → Can_MainFunction_Write → CanIf → PduR → COM;
+ *          gọi txNotification của I-PDU nếu có cấu hình.
+ *
+ * @param   ComTxPduId ID của I-PDU TX (do PduR cung cấp).
+ */
 void Com_TxConfirmation(PduIdType ComTxPduId);
 
 #ifdef __cplusplus
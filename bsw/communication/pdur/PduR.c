@@ -52,20 +52,18 @@ static PduR_PBConfigType* PduR_PBConfig = NULL;
 static boolean Routing_Enable = FALSE;
 
 /**
- * @brief   Hàm nội bộ để tìm kiếm một đường định tuyến trong bảng.
- * @details Duyệt qua bảng định tuyến (`tbl`) để tìm mục có `srcPduId` khớp với
- *          ID được cung cấp.
- * @param[in] tbl       Con trỏ tới bảng định tuyến cần tìm kiếm.
+ * @brief   Hàm nội bộ để tìm một đường định tuyến trong bảng.
+ * @details Bảng đánh chỉ số trực tiếp theo PDU ID nguồn (PduR_Cfg.c):
+ *          tra O(1), chi phí mỗi frame không phụ thuộc số đường định tuyến.
+ * @param[in] tbl       Con trỏ tới bảng định tuyến.
  * @param[in] n         Số lượng mục trong bảng.
  * @param[in] srcPduId  PDU ID nguồn cần tìm.
  * @return  Chỉ số của mục tìm thấy trong bảng nếu thành công.
- *          -1 nếu không tìm thấy.
+ *          -1 nếu không có đường (ngoài bảng hoặc PDUR_NO_ROUTE).
  */
 static inline sint32_t prv_find_route(const PduR_Route_1to1_Type* tbl, uint16_t n, PduIdType srcPduId){
-    for(uint16_t i = 0; i < n; ++i){
-        if(tbl[i].srcPduId == srcPduId){
-            return i;
-        }
+    if((srcPduId < n) && (tbl[srcPduId].srcPduId == srcPduId)){
+        return (sint32_t)srcPduId;
     }
     return -1;
 }
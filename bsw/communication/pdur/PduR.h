@@ -68,6 +68,14 @@ typedef struct {
     PduIdType desPduId; /**< PDU ID tại module đích. */
 }PduR_Route_1to1_Type;
 
+/**
+ * @brief  Mã PDU không hợp lệ và mục "không có đường" cho bảng định tuyến.
+ * @details Bảng định tuyến đánh chỉ số trực tiếp theo srcPduId
+ *          (tbl[id].srcPduId == id); chỗ trống điền PDUR_NO_ROUTE.
+ */
+#define PDUR_INVALID_PDUID  ((PduIdType)0xFFFFu)
+#define PDUR_NO_ROUTE       { .srcPduId = PDUR_INVALID_PDUID, .desPduId = PDUR_INVALID_PDUID }
+
 /**
  * @struct PduR_PBConfigType
  * @brief  Cấu trúc cấu hình chính (post-build) cho PduR.
@@ -36,7 +36,8 @@ extern "C" {
 #include "Rte_Types.h"    /* Gear_e, DriveMode_e (tách riêng để tránh vòng include) */
 #include <stddef.h>
 
-#define ADC_GROUP_PEDAL 0u
+#define ADC_GROUP_PEDAL 0u   /* nhóm ưu tiên: chuỗi injected, chen ngang quét nền */
+#define ADC_GROUP_TEMP  1u   /* cảm biến nhiệt nội MCU (chuỗi quét nền) */
 /* =========================================================
  * 1) Pedal – % đạp ga (0..100)
  * ---------------------------------------------------------
@@ -49,6 +50,16 @@ extern "C" {
  * =======================================================*/
 Std_ReturnType IoHwAb_Pedal_ReadPct(uint8_t* pct);
 
+/* ---------------------------------------------------------
+ * Tuổi (ms) của mẫu ADC mà IoHwAb_Pedal_ReadPct trả về lần gần
+ * nhất, tính tới thời điểm gọi. Mẫu lấy khoá pha với Task_A nên
+ * bình thường ≤ 1 tick; tăng dần khi ADC dừng hoặc đọc lỗi.
+ *
+ * @param[out] ageMs  Con trỏ nhận tuổi mẫu (ms)
+ * @return     E_OK; E_NOT_OK nếu chưa từng có mẫu/NULL
+ * ---------------------------------------------------------*/
+Std_ReturnType IoHwAb_Pedal_GetSampleAge(uint32_t* ageMs);
+
 /* =========================================================
  * 2) Brake – trạng thái bàn đạp phanh
  * ---------------------------------------------------------
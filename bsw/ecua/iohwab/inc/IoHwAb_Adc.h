@@ -52,4 +52,10 @@ Std_ReturnType IoHwAb_ReadRaw_0(uint16_t *value);
  *************************************/
 Std_ReturnType IoHwAb_ReadScaleValue_0(uint16_t *temperature);
 
+/*************************************
+ * @brief: Khoá pha lấy mẫu analog (timer kích ADC) vào thời điểm gọi
+ * @note : Gọi từ AlarmExpiryHook khi SysTick nhả Task_A (ngữ cảnh ISR)
+ *************************************/
+void IoHwAb_Adc_SyncSampling(void);
+
 #endif /* __IOHWAB_ADC_H__ */
\ No newline at end of file
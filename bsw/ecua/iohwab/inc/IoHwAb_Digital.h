@@ -18,6 +18,11 @@
  *            - Khuyến nghị gọi từ Task định kỳ (ví dụ 10 ms), không gọi
  *              từ ISR trừ khi driver đảm bảo đủ nhanh/an toàn.
  *
+ *          Đầu vào có debounce: IoHwAb_Digital_MainFunction() đọc IDR mỗi
+ *          cổng một lần và lọc đồng thời tối đa 32 kênh (bộ đếm dọc);
+ *          SWC/IoHwAb_Brake/Gear/Mode lấy mức ổn định qua
+ *          IoHwAb_Digital_GetDebounced().
+ *
  * @version 1.0
  * @date    2025-09-10
  * @author  Nguyễn Tuấn Khoa
@@ -44,6 +49,28 @@ void IoHwAb_Init1(const IoHwAb1_ConfigType *cfg);
 
 Std_ReturnType IoHwAb_Digital_ReadChannel(IoHwAb_SignalType id,Dio_LevelType *Value);
 
+/**********************************************
+ * @details: Lấy mẫu tất cả đầu vào cấu hình & cập nhật debounce.
+ *           Gọi định kỳ IOHWAB_DIG_SAMPLE_PERIOD_MS (Task_A), trước
+ *           các runnable đọc đầu vào.
+ * @return : Void
+ **********************************************/
+void IoHwAb_Digital_MainFunction(void);
+
+/**********************************************
+ * @details: Mức ổn định (đã debounce) của một đầu vào.
+ * @param[in]  input: chỉ số IoHwAb_DigInType
+ * @param[out] level: TRUE = HIGH
+ * @return : E_OK; E_NOT_OK nếu chưa khởi tạo/sai chỉ số/NULL
+ **********************************************/
+Std_ReturnType IoHwAb_Digital_GetDebounced(uint8_t input, boolean *level);
+
+/**********************************************
+ * @details: TRUE nếu mẫu thô đang khác mức ổn định (đang đếm debounce).
+ * @param[in] input: chỉ số IoHwAb_DigInType
+ **********************************************/
+boolean IoHwAb_Digital_IsSettling(uint8_t input);
+
 /**********************************************
  * @details: Hàm ghi tín hiệu Digital ra chân
  * @param[in] Value : Giá trị cần ghi ra chân
@@ -1,10 +1,10 @@
 #ifndef __IOHWAB_TYPES_H__
 #define __IOHWAB_TYPES_H__
 #include "Std_Types.h"
-#include "DIO.h"
+#include "Dio.h"
 #include "Port.h"
 #include "Adc.h"
-#include "PWM.h"
+#include "Pwm.h"
 /*=============================
      VERSION INFORMATION
 ===============================*/
@@ -6,7 +6,7 @@
  * @date 09-09-2025
  * @author Nguyễn Tuấn Khoa
  **************************************/
-#include "IoHwAb_adc.h"
+#include "IoHwAb_Adc.h"
 
 static uint16_t Temperature_RawValue = 0;
 static uint16_t Temperature_ScaledValue = 0;
@@ -51,4 +51,9 @@ Std_ReturnType IoHwAb_ReadScaleValue_0(uint16_t *Temperature_ScaledValue)
         *Temperature_ScaledValue = (Temperature_RawValue * 165) / 1023 - 40;
         return E_OK;
     }
-}
\ No newline at end of file
+}
+
+void IoHwAb_Adc_SyncSampling(void)
+{
+    Adc_SyncTrigger();
+}
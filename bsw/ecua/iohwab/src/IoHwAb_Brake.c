@@ -1,7 +1,8 @@
 /**********************************************************
  * @file    IoHwAb_Brake.c
  * @brief   IoHwAb – Brake (trạng thái phanh)
- * @details Đọc mức logic qua MCAL Dio và quy về boolean:
+ * @details Lấy mức đã debounce (IoHwAb_Digital, IOHWAB_DIN_BRAKE)
+ *          và quy về boolean:
  *          - TRUE  : đang đạp phanh
  *          - FALSE : không đạp
  *
@@ -11,9 +12,8 @@
  **********************************************************/
 
 #include "IoHwAb.h"
-#include "Dio.h"
+#include "IoHwAb_Digital.h"
 #include <stddef.h>
-#define IOHWAB_DIO_BRAKE 16
 
 
 Std_ReturnType IoHwAb_Brake_Get(boolean* pressed)
@@ -22,11 +22,14 @@ Std_ReturnType IoHwAb_Brake_Get(boolean* pressed)
         return E_NOT_OK;
     }
 
-    Dio_LevelType lv = DIO_ReadChannel(IOHWAB_DIO_BRAKE);
+    boolean lv = FALSE;
+    if (IoHwAb_Digital_GetDebounced(IOHWAB_DIN_BRAKE, &lv) != E_OK) {
+        return E_NOT_OK;
+    }
       // Nếu hệ thống định nghĩa HIGH = đang đạp:
-    *pressed = (lv != STD_LOW) ? TRUE : FALSE;
+    *pressed = (lv != FALSE) ? TRUE : FALSE;
         // Nếu LOW = đang đạp thì đảo lại:
-        // *pressed = (lv == STD_LOW) ? TRUE : FALSE;
+        // *pressed = (lv == FALSE) ? TRUE : FALSE;
 
     return E_OK;
 }
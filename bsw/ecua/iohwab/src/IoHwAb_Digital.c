@@ -2,13 +2,98 @@
  * @file   IoHwAb_Digital.c
  * @brief  IoHwAb Digital Driver Source File (AUTOSAR)
  * @details: Cài đặt các hàm cho IoHwAb Digital.
+ *           Debounce đầu vào kiểu bộ đếm dọc (vertical counter):
+ *             - Mỗi chu kỳ đọc IDR của mỗi làn (cổng) đúng một lần,
+ *               ghép thành vector 32 bit (bit = làn*16 + chân).
+ *             - Bộ đếm 3 bit của 32 kênh nằm trong 3 word dig_cnt[],
+ *               word b là bit b của mọi bộ đếm → một phép trừ/so sánh
+ *               trên word xử lý cả 32 kênh cùng lúc.
+ *             - Kênh có mẫu khác mức ổn định: đếm xuống; về 0 thì lật
+ *               mức ổn định. Kênh trùng mức ổn định (hoặc vừa lật):
+ *               nạp lại ngưỡng riêng của kênh (dig_reload[]).
  * @version: 1.0
  * @date   : 2024-06-27
  * @author : Nguyễn Tuấn Khoa
  *************************************************************/
 
 #include "IoHwAb_Digital.h"
-#include <stdio.h>>
+#include <stdio.h>
+
+/* =========================================================
+ * 1) Trạng thái debounce (vector 32 bit)
+ * =======================================================*/
+#define IOHWAB_DIG_BIT_NONE   0xFFu
+
+static const IoHwAb_DigCfgType *dig_cfg;
+static uint32_t dig_used;                           /* bit có kênh cấu hình */
+static uint32_t dig_stable;                         /* mức ổn định */
+static uint32_t dig_pending;                        /* mẫu thô khác mức ổn định */
+static uint32_t dig_cnt[IOHWAB_DIG_CNT_BITS];       /* mặt phẳng bit của bộ đếm */
+static uint32_t dig_reload[IOHWAB_DIG_CNT_BITS];    /* ngưỡng theo kênh, cùng dạng */
+static uint8_t  dig_bit[32];                        /* chỉ số đầu vào → vị trí bit */
+
+/* Ảnh chụp các làn: mỗi cổng một lần đọc IDR */
+static uint32_t prv_snapshot(void)
+{
+    uint32_t raw = 0u;
+
+    for (uint32_t l = 0u; l < IOHWAB_DIG_LANES; l++) {
+        if (dig_cfg->lanePort[l] != IOHWAB_DIG_LANE_NONE) {
+            raw |= (uint32_t)DIO_ReadPort(dig_cfg->lanePort[l]) << (16u * l);
+        }
+    }
+    return raw & dig_used;
+}
+
+static void IoHwAb_Digital_Init(const IoHwAb_DigCfgType *cfg)
+{
+    dig_cfg = NULL;
+    dig_used = 0u;
+    for (uint32_t b = 0u; b < IOHWAB_DIG_CNT_BITS; b++) {
+        dig_reload[b] = 0u;
+    }
+    for (uint32_t i = 0u; i < 32u; i++) {
+        dig_bit[i] = IOHWAB_DIG_BIT_NONE;
+    }
+    if ((cfg == NULL) || (cfg->inputs == NULL) || (cfg->numInputs > 32u)) {
+        return;
+    }
+
+    for (uint32_t i = 0u; i < cfg->numInputs; i++) {
+        const IoHwAb_DigInCfgType *in = &cfg->inputs[i];
+        uint32_t ticks = in->debounceTicks;
+
+        if (ticks == 0u) {
+            ticks = 1u;
+        } else if (ticks > IOHWAB_DIG_MAX_TICKS) {
+            ticks = IOHWAB_DIG_MAX_TICKS;
+        }
+        for (uint32_t l = 0u; l < IOHWAB_DIG_LANES; l++) {
+            if ((cfg->lanePort[l] != IOHWAB_DIG_LANE_NONE) &&
+                ((in->channel / 16u) == cfg->lanePort[l])) {
+                uint32_t bit = (16u * l) + (in->channel % 16u);
+                dig_bit[i] = (uint8_t)bit;
+                dig_used |= (1uL << bit);
+                for (uint32_t b = 0u; b < IOHWAB_DIG_CNT_BITS; b++) {
+                    if ((ticks & (1u << b)) != 0u) {
+                        dig_reload[b] |= (1uL << bit);
+                    }
+                }
+                break;
+            }
+        }
+        /* Kênh không thuộc làn nào: dig_bit = NONE → GetDebounced trả E_NOT_OK */
+    }
+
+    /* Seed mức ổn định từ ảnh chụp đầu tiên (SWC Init đọc được ngay) */
+    dig_cfg = cfg;
+    dig_stable = prv_snapshot();
+    dig_pending = 0u;
+    for (uint32_t b = 0u; b < IOHWAB_DIG_CNT_BITS; b++) {
+        dig_cnt[b] = dig_reload[b];
+    }
+}
+
 void IoHwAb_Init1(const IoHwAb1_ConfigType *cfg)
 {
     //printf("IoHwAb_Init1\n");
@@ -18,8 +103,62 @@ void IoHwAb_Init1(const IoHwAb1_ConfigType *cfg)
     Adc_Init(cfg->adcConfig);
     // Khởi tạo CAN
     Can_Init(cfg->canConfig);
+    // Khởi tạo lấy mẫu/debounce đầu vào số (sau Port_Init)
+    IoHwAb_Digital_Init(cfg->digConfig);
+}
+
+/* =========================================================
+ * 2) Lấy mẫu & debounce: vài phép toán word cho cả 32 kênh
+ * =======================================================*/
+void IoHwAb_Digital_MainFunction(void)
+{
+    if (dig_cfg == NULL) {
+        return;
+    }
+
+    uint32_t delta  = prv_snapshot() ^ dig_stable;   /* kênh khác mức ổn định */
+    uint32_t borrow = delta;                         /* chỉ các kênh đó đếm xuống */
+    uint32_t nz     = 0u;
+
+    for (uint32_t b = 0u; b < IOHWAB_DIG_CNT_BITS; b++) {
+        uint32_t c = dig_cnt[b];
+        dig_cnt[b] = c ^ borrow;                     /* trừ 1 song song */
+        borrow &= ~c;
+        nz |= dig_cnt[b];
+    }
+
+    uint32_t toggle = delta & ~nz;                   /* đếm về 0: đủ ngưỡng */
+    uint32_t reload = ~delta | toggle;
+
+    dig_stable ^= toggle;
+    for (uint32_t b = 0u; b < IOHWAB_DIG_CNT_BITS; b++) {
+        dig_cnt[b] = (dig_cnt[b] & ~reload) | (dig_reload[b] & reload);
+    }
+    dig_pending = delta & ~toggle;
 }
 
+Std_ReturnType IoHwAb_Digital_GetDebounced(uint8_t input, boolean *level)
+{
+    if ((level == NULL) || (dig_cfg == NULL) || (input >= dig_cfg->numInputs) ||
+        (dig_bit[input] == IOHWAB_DIG_BIT_NONE)) {
+        return E_NOT_OK;
+    }
+    *level = ((dig_stable >> dig_bit[input]) & 1u) ? TRUE : FALSE;
+    return E_OK;
+}
+
+boolean IoHwAb_Digital_IsSettling(uint8_t input)
+{
+    if ((dig_cfg == NULL) || (input >= dig_cfg->numInputs) ||
+        (dig_bit[input] == IOHWAB_DIG_BIT_NONE)) {
+        return FALSE;
+    }
+    return ((dig_pending >> dig_bit[input]) & 1u) ? TRUE : FALSE;
+}
+
+/* =========================================================
+ * 3) Truy cập trực tiếp (không debounce)
+ * =======================================================*/
 Std_ReturnType IoHwAb_Digital_ReadChannel(IoHwAb_SignalType id,Dio_LevelType *Value)
 {
 
@@ -27,16 +166,8 @@ Std_ReturnType IoHwAb_Digital_ReadChannel(IoHwAb_SignalType id,Dio_LevelType *Va
     {
         return E_NOT_OK;
     }
+    /* Một lần đọc: lọc nhiễu dùng IoHwAb_Digital_GetDebounced() */
     *Value = DIO_ReadChannel(id);
-
-    for (int i = 0; i < 10; i++)
-    {
-        if (DIO_ReadChannel(id) != *Value)
-        {
-            *Value = FALSE;
-            break;
-        }
-    }
     return E_OK;
 }
 
@@ -1,8 +1,10 @@
 /**********************************************************
  * @file    IoHwAb_Gear.c
  * @brief   IoHwAb – Gear (P/R/N/D)
- * @details Đọc mã hoá vị trí cần số qua 2 kênh DIO (B1:B0) bằng MCAL,
- *          rồi ánh xạ: 00=P, 01=R, 10=N, 11=D. Trả kèm cờ hợp lệ.
+ * @details Đọc mã hoá vị trí cần số qua 2 kênh DIO (B1:B0) đã debounce
+ *          (IoHwAb_Digital), rồi ánh xạ: 00=P, 01=R, 10=N, 11=D.
+ *          Hai bit debounce độc lập: khi một bit còn đang đếm thì mã
+ *          có thể là vị trí trung gian → báo valid = FALSE.
  *
  * @version 1.0
  * @date    2025-09-10
@@ -11,9 +13,7 @@
 
 #include "IoHwAb.h"
 #include <stddef.h>
-#include "Dio.h"
-#define IOHWAB_DIO_GEAR_B0 8
-#define IOHWAB_DIO_GEAR_B1 10
+#include "IoHwAb_Digital.h"
 
 Std_ReturnType IoHwAb_Gear_Get(Gear_e* gear, boolean* valid)
 {
@@ -21,10 +21,13 @@ Std_ReturnType IoHwAb_Gear_Get(Gear_e* gear, boolean* valid)
         return E_NOT_OK;
     }
 
-    
-    Dio_LevelType b0 = DIO_ReadChannel(IOHWAB_DIO_GEAR_B0);
-    Dio_LevelType b1 = DIO_ReadChannel(IOHWAB_DIO_GEAR_B1);
-    uint8_t bits = ((b1 != STD_LOW) ? 2u : 0u) | ((b0 != STD_LOW) ? 1u : 0u);
+    boolean b0 = FALSE;
+    boolean b1 = FALSE;
+    if ((IoHwAb_Digital_GetDebounced(IOHWAB_DIN_GEAR_B0, &b0) != E_OK) ||
+        (IoHwAb_Digital_GetDebounced(IOHWAB_DIN_GEAR_B1, &b1) != E_OK)) {
+        return E_NOT_OK;
+    }
+    uint8_t bits = ((b1 != FALSE) ? 2u : 0u) | ((b0 != FALSE) ? 1u : 0u);
     switch (bits & 0x3u) {
         case 0u: *gear = GEAR_P; *valid = TRUE;  break;
         case 1u: *gear = GEAR_R; *valid = TRUE;  break;
@@ -32,5 +35,9 @@ Std_ReturnType IoHwAb_Gear_Get(Gear_e* gear, boolean* valid)
         case 3u: *gear = GEAR_D; *valid = TRUE;  break;
         default: *gear = GEAR_P; *valid = FALSE; break;
     }
+    if ((IoHwAb_Digital_IsSettling(IOHWAB_DIN_GEAR_B0) != FALSE) ||
+        (IoHwAb_Digital_IsSettling(IOHWAB_DIN_GEAR_B1) != FALSE)) {
+        *valid = FALSE;
+    }
     return E_OK;
 }
@@ -1,8 +1,8 @@
 /**********************************************************
  * @file    IoHwAb_Mode.c
  * @brief   IoHwAb – Drive Mode (ECO/NORMAL)
- * @details Đọc chế độ lái qua MCAL Dio hoặc lấy từ lớp COM (MCAL/COM),
- *          rồi ánh xạ về DRIVEMODE_ECO / DRIVEMODE_NORMAL.
+ * @details Đọc chế độ lái qua kênh DIO đã debounce (IoHwAb_Digital)
+ *          hoặc lấy từ lớp COM, rồi ánh xạ về DRIVEMODE_ECO / DRIVEMODE_NORMAL.
  *
  * @version 1.0
  * @date    2025-09-10
@@ -11,8 +11,7 @@
 
 #include "IoHwAb.h"
 #include <stddef.h>
-#include "Dio.h"
-#define IOHWAB_DIO_MODE 17
+#include "IoHwAb_Digital.h"
 
 /* Skeleton: trả ECO để chạy được ngay.
  * Khi tích hợp, thay phần TODO bằng đọc DIO hoặc COM qua MCAL.
@@ -23,9 +22,12 @@ Std_ReturnType IoHwAb_Mode_Get(DriveMode_e* mode)
         return E_NOT_OK;            
     }
 
-     Dio_LevelType lv = DIO_ReadChannel(IOHWAB_DIO_MODE);
+     boolean lv = FALSE;
+     if (IoHwAb_Digital_GetDebounced(IOHWAB_DIN_MODE, &lv) != E_OK) {
+         return E_NOT_OK;
+     }
     // Nếu HIGH = NORMAL:
-     *mode = (lv != STD_LOW) ? DRIVEMODE_NORMAL : DRIVEMODE_ECO;
+     *mode = (lv != FALSE) ? DRIVEMODE_NORMAL : DRIVEMODE_ECO;
     // Nếu LOW = NORMAL thì đảo lại.
     return E_OK;
 }
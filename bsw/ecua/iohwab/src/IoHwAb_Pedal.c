@@ -3,6 +3,11 @@
  * @brief   IoHwAb – Pedal (đọc % đạp ga 0..100)
  * @details Lớp trừu tượng phần cứng cho bàn đạp ga:
  *          - Đọc ADC qua MCAL → chuẩn hoá về phần trăm 0..100.
+ *          - Nhóm ưu tiên trên chuỗi injected (Adc_cfg.c): chen ngang quét
+ *            nền nên độ trễ lấy mẫu có chặn; đọc trung bình mới nhất
+ *            ngay, không khởi động chuyển đổi/chờ.
+ *          - Giữ dấu thời gian của mẫu vừa trả về → IoHwAb_Pedal_GetSampleAge
+ *            cho SafetyManager loại dữ liệu cũ (ADC dừng, đọc lỗi liên tiếp).
  *          - Không dùng float, chỉ số nguyên (tuỳ bạn khi tích hợp).
  *
  * @version 1.0
@@ -12,12 +17,15 @@
 
 #include "IoHwAb.h"
 #include "Adc.h"
+#include "Os.h"
 
 // Định nghĩa các giá trị thô (raw) tối thiểu và tối đa của ADC
 // Cần điều chỉnh các giá trị này dựa trên kết quả đo thực tế từ cảm biến và ADC của bạn.
 #define PEDAL_RAW_MIN    0u // Ví dụ: giá trị ADC khi bàn đạp không nhấn (0%)
 #define PEDAL_RAW_MAX    4029u // Ví dụ: giá trị ADC khi bàn đạp nhấn hết cỡ (100%)
 
+static uint32_t pedal_ts;       // OS_TickCount() của mẫu trả về gần nhất
+static boolean  pedal_have_ts;
 
 Std_ReturnType IoHwAb_Pedal_ReadPct(uint8_t* pct)
 {
@@ -27,17 +35,29 @@ Std_ReturnType IoHwAb_Pedal_ReadPct(uint8_t* pct)
 
     uint16_t raw = 0u;
 
-    // Bắt đầu chuyển đổi cho nhóm ADC của bàn đạp
+    // Injected kích phần mềm: JSWSTART cho lần đọc sau (kích timer: không làm gì)
     Adc_StartGroupConversion(ADC_GROUP_PEDAL);
 
-    // Chờ cho đến khi quá trình chuyển đổi hoàn tất
-    //while (Adc_GetGroupStatus(ADC_GROUP_PEDAL) == ADC_BUSY) 
-
+    // Kết quả injected mới nhất (chưa có chuỗi nào → E_NOT_OK)
     Adc_ValueGroupType buf[1] = {0};
-    if (Adc_ReadGroup(ADC_GROUP_PEDAL, buf) == E_OK) {
-        raw = (uint16_t)buf[0];          // Giá trị thô từ ADC (ví dụ: 0..4095 cho 12-bit)
+    uint32_t ts = 0u;
+    if (Adc_ReadGroupTimestamp(ADC_GROUP_PEDAL, buf, &ts) != E_OK) {
+        return E_NOT_OK;
+    }
+    raw = (uint16_t)buf[0];          // Giá trị thô từ ADC (ví dụ: 0..4095 cho 12-bit)
+    pedal_ts = ts;
+    pedal_have_ts = TRUE;
 
-        // Quy đổi giá trị thô về phần trăm (0-100%)
-        *pct = (uint8_t)(((uint32_t)(raw - PEDAL_RAW_MIN) * 100u) / (PEDAL_RAW_MAX - PEDAL_RAW_MIN));    }
+    // Quy đổi giá trị thô về phần trăm (0-100%)
+    *pct = (uint8_t)(((uint32_t)(raw - PEDAL_RAW_MIN) * 100u) / (PEDAL_RAW_MAX - PEDAL_RAW_MIN));
+    return E_OK;
+}
+
+Std_ReturnType IoHwAb_Pedal_GetSampleAge(uint32_t* ageMs)
+{
+    if ((ageMs == NULL) || (pedal_have_ts == FALSE)) {
+        return E_NOT_OK;
+    }
+    *ageMs = (uint32_t)(OS_TickCount() - pedal_ts);
     return E_OK;
 }
@@ -1,81 +1,327 @@
 #include "Adc.h"
 #include "Std_Types.h"
-#include "Adc_cfg.h"
+#include "Adc_Cfg.h"
+#include "Os.h"
+
+/* Timer kích ADC (TriggerSource ≠ SOFTWARE): đếm 1 MHz, kích mỗi
+ * TriggerPeriodUs. Điểm kích trong chu kỳ: CNT = 0 (update → TRGO)
+ * hoặc CNT = 1 (PWM2, CCR = 1: cạnh lên OCxREF trùng sự kiện so sánh). */
+static TIM_TypeDef *adc_trig_tim;
+static uint16_t adc_trig_sync;      /* CNT nạp lúc Adc_SyncTrigger */
+static uint32_t adc_inj_trig;       /* JEXTSEL của chuỗi injected, None = JSWSTART */
+
+static uint32_t Adc_TriggerInit(const Adc_ConfigType *cfg)
+{
+    uint32_t conv;
+    uint16_t ch = 0u;           /* 0 = TRGO */
+
+    adc_trig_tim = NULL;
+    switch (cfg->TriggerSource)
+    {
+    case ADC_TRIGGER_TIM1_CC1:
+        adc_trig_tim = TIM1; ch = TIM_Channel_1; conv = ADC_ExternalTrigConv_T1_CC1;
+        break;
+    case ADC_TRIGGER_TIM1_CC2:
+        adc_trig_tim = TIM1; ch = TIM_Channel_2; conv = ADC_ExternalTrigConv_T1_CC2;
+        break;
+    case ADC_TRIGGER_TIM1_CC3:
+        adc_trig_tim = TIM1; ch = TIM_Channel_3; conv = ADC_ExternalTrigConv_T1_CC3;
+        break;
+    case ADC_TRIGGER_TIM2_CC2:
+        adc_trig_tim = TIM2; ch = TIM_Channel_2; conv = ADC_ExternalTrigConv_T2_CC2;
+        break;
+    case ADC_TRIGGER_TIM3_TRGO:
+        adc_trig_tim = TIM3; conv = ADC_ExternalTrigConv_T3_TRGO;
+        break;
+    default:
+        return ADC_ExternalTrigConv_None;
+    }
+    if ((cfg->TriggerPeriodUs < 2u) || (cfg->TriggerLeadUs + 1u >= cfg->TriggerPeriodUs))
+    {
+        adc_trig_tim = NULL;    /* cấu hình sai: về kích phần mềm */
+        return ADC_ExternalTrigConv_None;
+    }
+
+    if (adc_trig_tim == TIM1)
+        RCC_APB2PeriphClockCmd(RCC_APB2Periph_TIM1, ENABLE);
+    else if (adc_trig_tim == TIM2)
+        RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM2, ENABLE);
+    else
+        RCC_APB1PeriphClockCmd(RCC_APB1Periph_TIM3, ENABLE);
+
+    // Clock timer = SystemCoreClock (APB2, hoặc APB1 chia 2 → nhân 2)
+    TIM_TimeBaseInitTypeDef TIM_TimeBaseStructure;
+    TIM_TimeBaseStructInit(&TIM_TimeBaseStructure);
+    TIM_TimeBaseStructure.TIM_Prescaler = (uint16_t)((SystemCoreClock / 1000000u) - 1u);
+    TIM_TimeBaseStructure.TIM_Period = (uint16_t)(cfg->TriggerPeriodUs - 1u);
+    TIM_TimeBaseStructure.TIM_CounterMode = TIM_CounterMode_Up;
+    TIM_TimeBaseInit(adc_trig_tim, &TIM_TimeBaseStructure);
+
+    if (ch == 0u)
+    {
+        TIM_SelectOutputTrigger(adc_trig_tim, TIM_TRGOSource_Update);
+        adc_trig_sync = cfg->TriggerLeadUs;
+    }
+    else
+    {
+        TIM_OCInitTypeDef TIM_OCInitStructure;
+        TIM_OCStructInit(&TIM_OCInitStructure);
+        TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_PWM2;
+        TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Enable;
+        TIM_OCInitStructure.TIM_Pulse = 1u;
+        if (ch == TIM_Channel_1)
+            TIM_OC1Init(adc_trig_tim, &TIM_OCInitStructure);
+        else if (ch == TIM_Channel_2)
+            TIM_OC2Init(adc_trig_tim, &TIM_OCInitStructure);
+        else
+            TIM_OC3Init(adc_trig_tim, &TIM_OCInitStructure);
+        adc_trig_sync = (uint16_t)(cfg->TriggerLeadUs + 1u);
+    }
+    // Timer chưa chạy: Adc_SyncTrigger() khởi động đúng pha
+    return conv;
+}
+
+void Adc_SyncTrigger(void)
+{
+    if (adc_trig_tim == NULL)
+        return;
+
+    /* Lần kích kế tiếp sau TriggerPeriodUs - TriggerLeadUs. Cùng nguồn
+     * clock với SysTick nên không trôi; nạp lại mỗi nhịp chỉ xoá jitter
+     * vào ngắt (nhỏ hơn nhiều so với khoảng cách tới lần kích kế). */
+    TIM_SetCounter(adc_trig_tim, adc_trig_sync);
+    if ((adc_trig_tim->CR1 & TIM_CR1_CEN) == 0u)
+        TIM_Cmd(adc_trig_tim, ENABLE);
+}
+
+/* Kích injected bằng một kênh CC khác của chính timer kích regular: cùng
+ * được Adc_SyncTrigger nạp CNT nên lần kích injected nằm cố định
+ * InjTriggerLeadUs trước nhịp nhả task, dù chuỗi regular đang chạy hay không. */
+static uint32_t Adc_InjTriggerInit(const Adc_ConfigType *cfg)
+{
+    TIM_TypeDef *tim;
+    uint16_t ch;
+    uint32_t conv;
+
+    switch (cfg->InjTriggerSource)
+    {
+    case ADC_INJ_TRIGGER_TIM1_CC4:
+        tim = TIM1; ch = TIM_Channel_4; conv = ADC_ExternalTrigInjecConv_T1_CC4;
+        break;
+    case ADC_INJ_TRIGGER_TIM2_CC1:
+        tim = TIM2; ch = TIM_Channel_1; conv = ADC_ExternalTrigInjecConv_T2_CC1;
+        break;
+    case ADC_INJ_TRIGGER_TIM3_CC4:
+        tim = TIM3; ch = TIM_Channel_4; conv = ADC_ExternalTrigInjecConv_T3_CC4;
+        break;
+    default:
+        return ADC_ExternalTrigInjecConv_None;
+    }
+    // Timer khác (hoặc chưa cấu hình) thì không khoá pha được: về JSWSTART
+    if ((adc_trig_tim == NULL) || (tim != adc_trig_tim) || (cfg->InjTriggerLeadUs >= cfg->TriggerPeriodUs))
+        return ADC_ExternalTrigInjecConv_None;
+
+    // Nhịp đồng bộ nạp CNT = adc_trig_sync → kích sau (period - lead): CCR = sync - lead (mod period)
+    uint16_t ccr = (uint16_t)(((uint32_t)adc_trig_sync + cfg->TriggerPeriodUs - cfg->InjTriggerLeadUs) %
+                              cfg->TriggerPeriodUs);
+    if (ccr == 0u)
+        return ADC_ExternalTrigInjecConv_None;
+
+    TIM_OCInitTypeDef TIM_OCInitStructure;
+    TIM_OCStructInit(&TIM_OCInitStructure);
+    TIM_OCInitStructure.TIM_OCMode = TIM_OCMode_PWM2;
+    TIM_OCInitStructure.TIM_OutputState = TIM_OutputState_Enable;
+    TIM_OCInitStructure.TIM_Pulse = ccr;
+    if (ch == TIM_Channel_1)
+        TIM_OC1Init(tim, &TIM_OCInitStructure);
+    else
+        TIM_OC4Init(tim, &TIM_OCInitStructure);
+    return conv;
+}
+
+/* Chuỗi injected của nhóm ưu tiên (Adc_Inj.c): JEOC → ADC1_2_IRQHandler
+ * (Adc_cfg.c). Sự kiện kích ngắt ngang chuyển đổi regular đang chạy. */
+static void Adc_InjStart(const Adc_ConfigType *cfg)
+{
+    Adc_ChannelType ch[ADC_INJ_MAX_CHANNELS];
+    uint8_t n = Adc_Inj_Sequence(ch);
+
+    if (n == 0u)
+        return;
+
+    // JL trước: ADC_InjectedChannelConfig tính vị trí JSQ theo JL hiện tại
+    ADC_InjectedSequencerLengthConfig(ADC1, n);
+    for (uint8_t r = 0; r < n; r++)
+    {
+        ADC_InjectedChannelConfig(ADC1, (uint8_t)ch[r], (uint8_t)(r + 1u), cfg->InjSamplingTime);
+        if ((ch[r] == ADC_Channel_16) || (ch[r] == ADC_Channel_17))
+            ADC_TempSensorVrefintCmd(ENABLE);
+    }
+    ADC_ExternalTrigInjectedConvConfig(ADC1, adc_inj_trig);
+    ADC_ExternalTrigInjectedConvCmd(ADC1, ENABLE);
+
+    ADC_ClearITPendingBit(ADC1, ADC_IT_JEOC);
+    ADC_ITConfig(ADC1, ADC_IT_JEOC, ENABLE);
+    NVIC_EnableIRQ(ADC1_2_IRQn);
+}
+
+/* Quét liên tục + DMA vòng: DMA1 Channel1 trỏ vào buffer của Adc_Scan.c,
+ * ngắt HT/TC báo từng nửa buffer (DMA1_Channel1_IRQHandler, Adc_cfg.c). */
+static void Adc_ScanStart(boolean hwTrigger)
+{
+    uint32_t n = 0u;
+    Adc_ValueGroupType *buf = Adc_Scan_DmaBuffer(&n);
+
+    RCC_AHBPeriphClockCmd(RCC_AHBPeriph_DMA1, ENABLE);
+    DMA_DeInit(DMA1_Channel1);
+
+    DMA_InitTypeDef DMA_InitStruct;
+    DMA_InitStruct.DMA_PeripheralBaseAddr = (uint32_t)&ADC1->DR;
+    DMA_InitStruct.DMA_MemoryBaseAddr = (uint32_t)buf;
+    DMA_InitStruct.DMA_DIR = DMA_DIR_PeripheralSRC;
+    DMA_InitStruct.DMA_BufferSize = n;
+    DMA_InitStruct.DMA_PeripheralInc = DMA_PeripheralInc_Disable;
+    DMA_InitStruct.DMA_MemoryInc = DMA_MemoryInc_Enable;
+    DMA_InitStruct.DMA_PeripheralDataSize = DMA_PeripheralDataSize_HalfWord;
+    DMA_InitStruct.DMA_MemoryDataSize = DMA_MemoryDataSize_HalfWord;
+    DMA_InitStruct.DMA_Mode = DMA_Mode_Circular;
+    DMA_InitStruct.DMA_Priority = DMA_Priority_High;
+    DMA_InitStruct.DMA_M2M = DMA_M2M_Disable;
+    DMA_Init(DMA1_Channel1, &DMA_InitStruct);
+
+    DMA_ClearITPendingBit(DMA1_IT_GL1);
+    DMA_ITConfig(DMA1_Channel1, DMA_IT_HT | DMA_IT_TC, ENABLE);
+    NVIC_EnableIRQ(DMA1_Channel1_IRQn);
+    DMA_Cmd(DMA1_Channel1, ENABLE);
+
+    /* Hiệu chuẩn trước lần chuyển đổi đầu; sau đó quét chạy mãi,
+     * mẫu đầu tiên luôn là Rank 1 → khớp bố trí buffer */
+    ADC_ResetCalibration(ADC1);
+    while (ADC_GetResetCalibrationStatus(ADC1) == SET) { }
+    ADC_StartCalibration(ADC1);
+    while (ADC_GetCalibrationStatus(ADC1) == SET) { }
+
+    ADC_DMACmd(ADC1, ENABLE);
+    if (hwTrigger)
+        ADC_ExternalTrigConvCmd(ADC1, ENABLE); // mỗi lần kích timer = cả chuỗi = một nửa buffer
+    else
+        ADC_SoftwareStartConvCmd(ADC1, ENABLE);
+}
 
 void Adc_Init(const Adc_ConfigType *ConfigPtr)
 {
     const Adc_ConfigType *cfg = ConfigPtr;
-    for (uint8_t i = 0; i < ConfigPtr->NumChannels; i++)
+    boolean scan = (Adc_Scan_Init(cfg) == E_OK) && (cfg->ScanMode == ADC_SCAN_DMA_CIRCULAR);
+    uint32_t extTrig = Adc_TriggerInit(cfg);
+    boolean hwTrigger = (extTrig != ADC_ExternalTrigConv_None) ? TRUE : FALSE;
+    Adc_ChannelType injCh[ADC_INJ_MAX_CHANNELS];
+    (void)Adc_Inj_Init(cfg);
+    uint8_t injLen = Adc_Inj_Sequence(injCh);
+    adc_inj_trig = (injLen != 0u) ? Adc_InjTriggerInit(cfg) : ADC_ExternalTrigInjecConv_None;
+
+    // 2. Clock cho ADC
+    if (cfg->AdcInstance == ADC_INSTANCE_1)
+        RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC1, ENABLE);
+    else if (cfg->AdcInstance == ADC_INSTANCE_2)
+        RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC2, ENABLE);
+
+    // 3. Init ADC
+    switch (cfg->ClockPrescaler)
     {
-        // 2. Clock cho ADC
-        if (cfg->AdcInstance == ADC_INSTANCE_1)
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC1, ENABLE);
-        else if (cfg->AdcInstance == ADC_INSTANCE_2)
-            RCC_APB2PeriphClockCmd(RCC_APB2Periph_ADC2, ENABLE);
-
-        // 3. Init ADC
-        switch (cfg->ClockPrescaler)
-        {
-        case 2:
-            RCC_ADCCLKConfig(RCC_PCLK2_Div2);
-            break;
-        case 4:
-            RCC_ADCCLKConfig(RCC_PCLK2_Div4);
-            break;
-        case 6:
-            RCC_ADCCLKConfig(RCC_PCLK2_Div6);
-            break;
-        case 8:
-            RCC_ADCCLKConfig(RCC_PCLK2_Div8);
-            break;
-        default:
-            RCC_ADCCLKConfig(RCC_PCLK2_Div2); // Mặc định
-            break;
-        }
-        ADC_InitTypeDef ADC_InitStructure;
-        ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
+    case 2:
+        RCC_ADCCLKConfig(RCC_PCLK2_Div2);
+        break;
+    case 4:
+        RCC_ADCCLKConfig(RCC_PCLK2_Div4);
+        break;
+    case 6:
+        RCC_ADCCLKConfig(RCC_PCLK2_Div6);
+        break;
+    case 8:
+        RCC_ADCCLKConfig(RCC_PCLK2_Div8);
+        break;
+    default:
+        RCC_ADCCLKConfig(RCC_PCLK2_Div2); // Mặc định
+        break;
+    }
+    ADC_InitTypeDef ADC_InitStructure;
+    ADC_InitStructure.ADC_Mode = ADC_Mode_Independent;
+    // Quét kích bằng timer: mỗi sự kiện một chuỗi, không chạy liên tục
+    if (scan)
+        ADC_InitStructure.ADC_ContinuousConvMode = hwTrigger ? DISABLE : ENABLE;
+    else
         ADC_InitStructure.ADC_ContinuousConvMode = (cfg->ConversionMode == ADC_CONV_MODE_CONTINUOUS) ? ENABLE : DISABLE;
-        // ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;
-        ADC_InitStructure.ADC_ScanConvMode = DISABLE;
-        ADC_InitStructure.ADC_ExternalTrigConv = (cfg->TriggerSource == ADC_TRIGGER_SOFTWARE) ? ADC_ExternalTrigConv_None : cfg->TriggerSource;
+    // ADC_InitStructure.ADC_ContinuousConvMode = DISABLE;
+    // Chuỗi injected > 1 rank cũng cần SCAN
+    ADC_InitStructure.ADC_ScanConvMode = (scan || (injLen > 1u)) ? ENABLE : DISABLE;
+    ADC_InitStructure.ADC_ExternalTrigConv = extTrig;
 
-        if (cfg->ResultAlignment == ADC_RESULT_ALIGNMENT_RIGHT)
-            ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
-        else
-            ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Left;
+    if (cfg->ResultAlignment == ADC_RESULT_ALIGNMENT_RIGHT)
+        ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Right;
+    else
+        ADC_InitStructure.ADC_DataAlign = ADC_DataAlign_Left;
 
-        ADC_InitStructure.ADC_NbrOfChannel = cfg->NumChannels;
+    // Quét kích timer: chuỗi = Rank lặp Oversampling lần (một nửa buffer DMA)
+    uint8_t repeat = 1u;
+    if (scan && hwTrigger)
+    {
+        uint32_t n = 0u;
+        (void)Adc_Scan_DmaBuffer(&n);
+        repeat = (uint8_t)((n / 2u) / cfg->NumChannels);
+    }
+    ADC_InitStructure.ADC_NbrOfChannel = (uint8_t)(cfg->NumChannels * repeat);
 
-        if (cfg->AdcInstance == ADC_INSTANCE_1)
-        {
-            ADC_Init(ADC1, &ADC_InitStructure);
-            ADC_Cmd(ADC1, ENABLE);
-        }
-        else
-        {
-            ADC_Init(ADC2, &ADC_InitStructure);
-            ADC_Cmd(ADC2, ENABLE);
-        }
-        // 4. Setup kênh
-        for (uint8_t ch = 0; ch < cfg->NumChannels; ch++)
+    if (cfg->AdcInstance == ADC_INSTANCE_1)
+    {
+        ADC_Init(ADC1, &ADC_InitStructure);
+        ADC_Cmd(ADC1, ENABLE);
+    }
+    else
+    {
+        ADC_Init(ADC2, &ADC_InitStructure);
+        ADC_Cmd(ADC2, ENABLE);
+    }
+    // 4. Setup kênh
+    for (uint8_t ch = 0; ch < cfg->NumChannels; ch++)
+    {
+        for (uint8_t r = 0; r < repeat; r++)
         {
+            uint8_t rank = (uint8_t)(cfg->Channels[ch].Rank + (r * cfg->NumChannels));
             if (cfg->AdcInstance == ADC_INSTANCE_1)
-                ADC_RegularChannelConfig(ADC1, cfg->Channels[ch].Channel, cfg->Channels[ch].Rank, cfg->Channels[ch].SamplingTime);
+                ADC_RegularChannelConfig(ADC1, cfg->Channels[ch].Channel, rank, cfg->Channels[ch].SamplingTime);
             else
-                ADC_RegularChannelConfig(ADC2, cfg->Channels[ch].Channel, cfg->Channels[ch].Rank, cfg->Channels[ch].SamplingTime);
+                ADC_RegularChannelConfig(ADC2, cfg->Channels[ch].Channel, rank, cfg->Channels[ch].SamplingTime);
         }
 
-        // 6. Enable
-        for (uint8_t i = 0; i < ADC_MAX_GROUPS; i++)
-        {
-            Adc_GroupConfigs[i].Status = ADC_IDLE;
-            Adc_GroupConfigs[i].Result = NULL;
-        }
+        // Cảm biến nhiệt độ / Vrefint nội (chỉ ADC1)
+        if ((cfg->Channels[ch].Channel == ADC_Channel_16) || (cfg->Channels[ch].Channel == ADC_Channel_17))
+            ADC_TempSensorVrefintCmd(ENABLE);
+    }
+
+    // 6. Enable
+    for (uint8_t i = 0; i < ADC_MAX_GROUPS; i++)
+    {
+        Adc_GroupConfigs[i].Status = ADC_IDLE;
+        Adc_GroupConfigs[i].Result = NULL;
     }
+
+    // 7. Nhóm ưu tiên: chuỗi injected (kích timer chạy từ Adc_SyncTrigger đầu tiên)
+    if (injLen != 0u)
+        Adc_InjStart(cfg);
+
+    // 8. Quét liên tục: chạy ngay, không cần Adc_StartGroupConversion
+    if (scan)
+        Adc_ScanStart(hwTrigger);
 }
 
 void Adc_DeInit(void)
 {
+    if (adc_trig_tim != NULL)
+        TIM_Cmd(adc_trig_tim, DISABLE); // dừng timer kích
+    adc_trig_tim = NULL;
+    DMA_Cmd(DMA1_Channel1, DISABLE); // dừng quét DMA vòng (nếu có)
+    (void)Adc_Scan_Init(NULL);
+    (void)Adc_Inj_Init(NULL);
     ADC_DeInit(ADC1);
     ADC_DeInit(ADC2);
     for (uint8_t i = 0; i < ADC_MAX_GROUPS; i++)
@@ -87,6 +333,15 @@ void Adc_DeInit(void)
 
 void Adc_StartGroupConversion(Adc_GroupType Group)
 {
+    if (Adc_Inj_OwnsGroup(Group))
+    {
+        if (adc_inj_trig == ADC_ExternalTrigInjecConv_None)
+            ADC_SoftwareStartInjectedConvCmd(ADC1, ENABLE); // JSWSTART: chen ngang chuỗi regular
+        return; // kích timer: chạy từ Adc_Init
+    }
+    if (Adc_Scan_OwnsGroup(Group))
+        return; // quét liên tục đã chạy từ Adc_Init
+
     Adc_GroupDefType *grp = &Adc_GroupConfigs[Group];
     grp->Status = ADC_BUSY;
 
@@ -136,6 +391,11 @@ void Adc_StartGroupConversion(Adc_GroupType Group)
 
 void Adc_StopGroupConversion(Adc_GroupType Group)
 {
+    if (Adc_Inj_OwnsGroup(Group))
+        return; // chuỗi injected dừng cùng Adc_DeInit
+    if (Adc_Scan_OwnsGroup(Group))
+        return; // dừng quét sẽ dừng mọi nhóm: dùng Adc_DeInit
+
     Adc_GroupDefType *grp = &Adc_GroupConfigs[Group];
 
     if (grp->AdcInstance == ADC_INSTANCE_1)
@@ -148,6 +408,11 @@ void Adc_StopGroupConversion(Adc_GroupType Group)
 
 Std_ReturnType Adc_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr)
 {
+    if (Adc_Inj_OwnsGroup(Group))
+        return Adc_Inj_ReadGroup(Group, DataBufferPtr, NULL); // kết quả JEOC mới nhất
+    if (Adc_Scan_OwnsGroup(Group))
+        return Adc_Scan_ReadGroup(Group, DataBufferPtr, NULL); // bộ mới nhất, không chờ
+
     Adc_GroupDefType *grp = &Adc_GroupConfigs[Group];
     Adc_ConfigType *cfg = &Adc_Configs[grp->AdcInstance];
 
@@ -170,6 +435,23 @@ Std_ReturnType Adc_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBuffer
     return E_OK;
 }
 
+Std_ReturnType Adc_ReadGroupTimestamp(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                      uint32_t *TimestampPtr)
+{
+    if (TimestampPtr == NULL)
+        return E_NOT_OK;
+    if (Adc_Inj_OwnsGroup(Group))
+        return Adc_Inj_ReadGroup(Group, DataBufferPtr, TimestampPtr);
+    if (Adc_Scan_OwnsGroup(Group))
+        return Adc_Scan_ReadGroup(Group, DataBufferPtr, TimestampPtr);
+
+    // Chế độ theo nhóm: kết quả vừa chuyển đổi, lấy thời điểm đọc
+    if (Adc_ReadGroup(Group, DataBufferPtr) != E_OK)
+        return E_NOT_OK;
+    *TimestampPtr = OS_TickCount();
+    return E_OK;
+}
+
 Std_ReturnType Adc_SetupResultBuffer(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr)
 {
     if (Group >= ADC_MAX_GROUPS || DataBufferPtr == NULL)
@@ -179,8 +461,37 @@ Std_ReturnType Adc_SetupResultBuffer(Adc_GroupType Group, Adc_ValueGroupType *Da
     return E_OK;
 }
 
-void Adc_EnableHardwareTrigger(Adc_GroupType Group) { (void)Group; }
-void Adc_DisableHardwareTrigger(Adc_GroupType Group) { (void)Group; }
+void Adc_EnableHardwareTrigger(Adc_GroupType Group)
+{
+    if (Adc_Inj_OwnsGroup(Group))
+    {
+        if (adc_inj_trig != ADC_ExternalTrigInjecConv_None)
+            ADC_ExternalTrigInjectedConvCmd(ADC1, ENABLE);
+        return;
+    }
+    if (Adc_Scan_OwnsGroup(Group) || (adc_trig_tim == NULL))
+        return; // quét DMA: trigger đã bật từ Adc_Init
+
+    Adc_GroupDefType *grp = &Adc_GroupConfigs[Group];
+    grp->Status = ADC_BUSY;
+    ADC_ExternalTrigConvCmd((grp->AdcInstance == ADC_INSTANCE_1) ? ADC1 : ADC2, ENABLE);
+}
+
+void Adc_DisableHardwareTrigger(Adc_GroupType Group)
+{
+    if (Adc_Inj_OwnsGroup(Group))
+    {
+        if (adc_inj_trig != ADC_ExternalTrigInjecConv_None)
+            ADC_ExternalTrigInjectedConvCmd(ADC1, DISABLE);
+        return;
+    }
+    if (Adc_Scan_OwnsGroup(Group) || (adc_trig_tim == NULL))
+        return;
+
+    Adc_GroupDefType *grp = &Adc_GroupConfigs[Group];
+    ADC_ExternalTrigConvCmd((grp->AdcInstance == ADC_INSTANCE_1) ? ADC1 : ADC2, DISABLE);
+    grp->Status = ADC_IDLE;
+}
 
 void Adc_EnableGroupNotification(Adc_GroupType Group)
 {
@@ -212,6 +523,11 @@ void Adc_DisableGroupNotification(Adc_GroupType Group)
 
 Adc_StatusType Adc_GetGroupStatus(Adc_GroupType Group)
 {
+    if (Adc_Inj_OwnsGroup(Group))
+        return (Adc_Inj_GetCount() != 0u) ? ADC_COMPLETED : ADC_BUSY;
+    if (Adc_Scan_OwnsGroup(Group))
+        return (Adc_Scan_GetCount() != 0u) ? ADC_COMPLETED : ADC_BUSY;
+
     return Adc_GroupConfigs[Group].Status;
 }
 
@@ -35,6 +35,17 @@
 /** @brief Định danh cho nhóm ADC 2. */
 #define ADC_GROUP_2 1
 
+/** @brief Số kênh tối đa trong chuỗi quét DMA vòng (ScanMode). */
+#define ADC_SCAN_MAX_CHANNELS 4u
+/** @brief Số lần quét tối đa cộng trung bình trong một nửa buffer DMA. */
+#define ADC_SCAN_MAX_OVERSAMPLE 16u
+/** @brief Độ dài tối đa chuỗi regular (SQR1..3); quét kích timer lặp Rank Oversampling lần. */
+#define ADC_SCAN_MAX_SEQUENCE 16u
+/** @brief Độ dài tối đa chuỗi injected (JSQR); nhóm ưu tiên lặp kênh cho đủ. */
+#define ADC_INJ_MAX_CHANNELS 4u
+/** @brief Priority của nhóm nền (chuỗi regular/quét); > 0 = nhóm được phép chen ngang. */
+#define ADC_GROUP_PRIORITY_BACKGROUND 0u
+
 /* ============================= */
 /* ==== ENUM & STRUCT TYPE ==== */
 /* ============================= */
@@ -107,10 +118,26 @@ typedef enum
  */
 typedef enum
 {
-    ADC_TRIGGER_SOFTWARE = 0, /**< Kích hoạt bằng lời gọi hàm (software trigger). */
-    ADC_TRIGGER_HARDWARE = 1  /**< Kích hoạt bằng tín hiệu phần cứng bên ngoài (ví dụ: timer). */
+    ADC_TRIGGER_SOFTWARE = 0,  /**< Kích hoạt bằng lời gọi hàm (software trigger). */
+    ADC_TRIGGER_TIM1_CC1 = 1,  /**< Sự kiện so sánh TIM1 CH1. */
+    ADC_TRIGGER_TIM1_CC2 = 2,  /**< Sự kiện so sánh TIM1 CH2. */
+    ADC_TRIGGER_TIM1_CC3 = 3,  /**< Sự kiện so sánh TIM1 CH3. */
+    ADC_TRIGGER_TIM2_CC2 = 4,  /**< Sự kiện so sánh TIM2 CH2 (TIM2 TRGO chỉ kích nhóm injected trên F1). */
+    ADC_TRIGGER_TIM3_TRGO = 5  /**< TRGO của TIM3 (sự kiện update). */
 } Adc_TriggerSourceType;
 
+/** @enum Adc_InjTriggerSourceType
+ *  @brief Nguồn kích chuỗi injected (nhóm ưu tiên). Timer phải trùng timer
+ *         của TriggerSource để cùng được khoá pha bởi Adc_SyncTrigger.
+ */
+typedef enum
+{
+    ADC_INJ_TRIGGER_SOFTWARE = 0, /**< JSWSTART qua Adc_StartGroupConversion. */
+    ADC_INJ_TRIGGER_TIM1_CC4 = 1, /**< Sự kiện so sánh TIM1 CH4 (đi với TIM1 CCx). */
+    ADC_INJ_TRIGGER_TIM2_CC1 = 2, /**< Sự kiện so sánh TIM2 CH1 (đi với TIM2 CC2). */
+    ADC_INJ_TRIGGER_TIM3_CC4 = 3  /**< Sự kiện so sánh TIM3 CH4 (đi với TIM3 TRGO). */
+} Adc_InjTriggerSourceType;
+
 /** @enum Adc_GroupConvModeType
  *  @brief Xác định chế độ chuyển đổi của một nhóm ADC.
  */
@@ -120,6 +147,15 @@ typedef enum
     ADC_CONV_MODE_CONTINUOUS = 1  /**< Tự động chuyển đổi liên tục sau lần trigger đầu tiên. */
 } Adc_GroupConvModeType;
 
+/** @enum Adc_ScanModeType
+ *  @brief Chế độ quét của một ngoại vi ADC.
+ */
+typedef enum
+{
+    ADC_SCAN_DISABLED = 0,     /**< Chuyển đổi theo nhóm, khởi động bằng Adc_StartGroupConversion. */
+    ADC_SCAN_DMA_CIRCULAR = 1  /**< Quét liên tục mọi kênh cấu hình vào DMA vòng (chỉ ADC1). */
+} Adc_ScanModeType;
+
 /** @enum Adc_ResultAlignmentType
  *  @brief Xác định cách căn lề cho kết quả chuyển đổi trong thanh ghi dữ liệu.
  */
@@ -176,13 +212,20 @@ typedef struct
     uint32_t ClockPrescaler;                   /**< Bộ chia tần số cho clock ADC. */
     Adc_ResolutionType Resolution;             /**< Độ phân giải của ADC (không dùng trên STM32F1). */
     Adc_GroupConvModeType ConversionMode;      /**< Chế độ chuyển đổi (một lần/liên tục). */
-    Adc_TriggerSourceType TriggerSource;       /**< Nguồn trigger (phần mềm/phần cứng). */
+    Adc_TriggerSourceType TriggerSource;       /**< Nguồn trigger (phần mềm/timer). */
     Adc_NotificationType NotificationEnabled;  /**< Bật/tắt thông báo khi hoàn thành. */
     uint8_t NumChannels;                       /**< Tổng số kênh được cấu hình. */
     Adc_InstanceType AdcInstance;              /**< Ngoại vi ADC được sử dụng (ADC1/ADC2). */
     Adc_ChannelConfigType Channels[16];        /**< Mảng cấu hình cho từng kênh. */
     Adc_ResultAlignmentType ResultAlignment;   /**< Căn lề kết quả (trái/phải). */
     void (*InitCallback)(void);                /**< Con trỏ hàm callback khi có thông báo. */
+    Adc_ScanModeType ScanMode;                 /**< Quét liên tục + DMA vòng hay theo nhóm. */
+    uint8_t Oversampling;                      /**< ScanMode: số lần quét lấy trung bình mỗi nửa buffer (1..ADC_SCAN_MAX_OVERSAMPLE). */
+    uint16_t TriggerPeriodUs;                  /**< Trigger timer: chu kỳ kích (µs, timer đếm 1 MHz), thường = chu kỳ task. */
+    uint16_t TriggerLeadUs;                    /**< Trigger timer: kích sớm hơn nhịp đồng bộ bao nhiêu µs (≥ thời gian một nửa buffer). */
+    Adc_InjTriggerSourceType InjTriggerSource; /**< Nguồn kích chuỗi injected của nhóm ưu tiên. */
+    uint16_t InjTriggerLeadUs;                 /**< Kích injected sớm hơn nhịp đồng bộ bao nhiêu µs (< TriggerPeriodUs). */
+    Adc_SamplingTimeType InjSamplingTime;      /**< Thời gian lấy mẫu các kênh injected (ghi đè SMPR nếu kênh cũng ở regular). */
 } Adc_ConfigType;
 
 /** @struct Adc_GroupDefType
@@ -193,7 +236,7 @@ typedef struct
     Adc_GroupType id;                              /**< ID của nhóm kênh ADC */
     Adc_InstanceType AdcInstance;                  /**< ID cơ bản của mô-đun ADC */
     Adc_ChannelType Channels[16];                  /**< Danh sách kênh trong nhóm */
-    Adc_GroupPriorityType Priority;                /**< Mức độ ưu tiên của nhóm */
+    Adc_GroupPriorityType Priority;                /**< Mức độ ưu tiên (0 = nền; cao nhất > 0 → chuỗi injected) */
     uint8_t NumChannels;                           /**< Số kênh trong nhóm */
     Adc_StatusType Status;                         /**< Trạng thái hiện tại của nhóm */
     Adc_ValueGroupType *Result;                    /**< Con trỏ buffer kết quả */
@@ -265,6 +308,26 @@ void Adc_StopGroupConversion(Adc_GroupType Group);
  **********************************************************/
 Std_ReturnType Adc_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr);
 
+/**********************************************************
+ * @brief Như Adc_ReadGroup, kèm thời điểm có kết quả.
+ * @param[out] TimestampPtr OS_TickCount() (ms) lúc bộ kết quả được công
+ *             bố (quét DMA) hoặc lúc đọc (chế độ theo nhóm).
+ * @return Std_ReturnType E_OK nếu đọc thành công, E_NOT_OK nếu thất bại.
+ **********************************************************/
+Std_ReturnType Adc_ReadGroupTimestamp(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                      uint32_t *TimestampPtr);
+
+/**********************************************************
+ * @brief Khoá pha timer kích ADC (TriggerSource ≠ SOFTWARE) vào thời điểm gọi.
+ * @details Gọi trong SysTick, đúng nhịp nhả task tiêu thụ mẫu (hook
+ *          AlarmExpiryHook): lần kích kế tiếp sau TriggerPeriodUs -
+ *          TriggerLeadUs. Mỗi lần kích chạy cả chuỗi regular (Rank lặp
+ *          Oversampling lần) = một nửa buffer, nên với TriggerPeriodUs
+ *          bằng chu kỳ task, bộ kết quả xong ngay trước nhịp nhả task
+ *          tiếp theo. Lần gọi đầu khởi động timer.
+ **********************************************************/
+void Adc_SyncTrigger(void);
+
 /**********************************************************
  * @brief Bật kích hoạt phần cứng cho nhóm ADC.
  * @details Kích hoạt nguồn phần cứng cho nhóm kênh được chỉ định.
@@ -332,4 +395,100 @@ void Adc_GetVersionInfo(Std_VersionInfoType *VersionInfo);
  **********************************************************/
 Std_ReturnType Adc_SetPowerState(Adc_GroupType Group, Adc_PowerStateType PowerState);
 
+/* ============================= */
+/* == QUÉT LIÊN TỤC + DMA VÒNG = */
+/* ============================= */
+/* Adc_Scan.c (không phụ thuộc SPL, dùng chung target/host):
+ *   buffer DMA gồm 2 nửa, mỗi nửa Oversampling lần quét × NumChannels.
+ *   Ngắt HT báo nửa 0 đầy, TC báo nửa 1 đầy (DMA đã ghi sang nửa kia):
+ *   ISR lấy trung bình từng kênh rồi công bố vào một trong hai bộ kết
+ *   quả (double buffer) kèm số thứ tự → Adc_ReadGroup đọc bộ mới nhất
+ *   nhất quán, không chờ, không khởi động chuyển đổi. */
+
+/**********************************************************
+ * @brief Khởi tạo trạng thái quét cho cấu hình ScanMode.
+ * @param[in] ConfigPtr Cấu hình ADC (NULL = tắt quét).
+ * @return E_OK nếu cấu hình hợp lệ (ADC1, 1..ADC_SCAN_MAX_CHANNELS kênh).
+ **********************************************************/
+Std_ReturnType Adc_Scan_Init(const Adc_ConfigType *ConfigPtr);
+
+/**********************************************************
+ * @brief Buffer DMA vòng và tổng số mẫu (cả hai nửa).
+ **********************************************************/
+Adc_ValueGroupType *Adc_Scan_DmaBuffer(uint32_t *NumSamples);
+
+/**********************************************************
+ * @brief Xử lý một nửa buffer vừa đầy (gọi từ ISR DMA).
+ * @param[in] Half 0 = nửa đầu (HT), 1 = nửa sau (TC).
+ **********************************************************/
+void Adc_Scan_OnDmaHalf(uint8_t Half);
+
+/**********************************************************
+ * @brief TRUE nếu nhóm được phục vụ bởi chuỗi quét đang chạy.
+ **********************************************************/
+boolean Adc_Scan_OwnsGroup(Adc_GroupType Group);
+
+/**********************************************************
+ * @brief Chép bộ kết quả mới nhất của các kênh trong nhóm.
+ * @param[out] Timestamp OS_TickCount() lúc công bố bộ đó (NULL = bỏ qua).
+ * @return E_NOT_OK nếu chưa có bộ kết quả nào.
+ **********************************************************/
+Std_ReturnType Adc_Scan_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                  uint32_t *Timestamp);
+
+/**********************************************************
+ * @brief Số bộ kết quả đã công bố kể từ Adc_Scan_Init.
+ **********************************************************/
+uint32_t Adc_Scan_GetCount(void);
+
+/* ============================= */
+/* == NHÓM ƯU TIÊN (INJECTED) == */
+/* ============================= */
+/* Adc_Inj.c (không phụ thuộc SPL, dùng chung target/host):
+ *   nhóm có Priority cao nhất (> ADC_GROUP_PRIORITY_BACKGROUND) của ADC1
+ *   chạy trên bộ tuần tự injected, kênh lặp cho đủ ADC_INJ_MAX_CHANNELS
+ *   rank. Sự kiện kích injected ngắt ngang chuyển đổi regular đang chạy
+ *   (phần cứng huỷ chuyển đổi dở, chạy chuỗi injected rồi làm lại từ
+ *   rank bị ngắt) → độ trễ kích → JEOC không phụ thuộc chuỗi quét nền:
+ *   tối đa ADC_INJ_MAX_CHANNELS × (InjSamplingTime + 12.5) chu kỳ ADCCLK.
+ *   ISR JEOC lấy trung bình từng kênh, công bố như Adc_Scan.c. */
+
+/**********************************************************
+ * @brief Chọn nhóm ưu tiên và dựng chuỗi injected.
+ * @param[in] ConfigPtr Cấu hình ADC (NULL = tắt chuỗi injected).
+ * @return E_OK (kể cả khi không có nhóm nào Priority > 0).
+ **********************************************************/
+Std_ReturnType Adc_Inj_Init(const Adc_ConfigType *ConfigPtr);
+
+/**********************************************************
+ * @brief Chuỗi injected theo rank (JSQR).
+ * @param[out] Channels Kênh của từng rank (ít nhất ADC_INJ_MAX_CHANNELS phần tử).
+ * @return Độ dài chuỗi, 0 nếu không có nhóm ưu tiên.
+ **********************************************************/
+uint8_t Adc_Inj_Sequence(Adc_ChannelType *Channels);
+
+/**********************************************************
+ * @brief Xử lý chuỗi injected vừa xong (gọi từ ISR JEOC).
+ * @param[in] Jdr Giá trị JDR1..JDRn theo rank.
+ **********************************************************/
+void Adc_Inj_OnJeoc(const Adc_ValueGroupType *Jdr);
+
+/**********************************************************
+ * @brief TRUE nếu nhóm chạy trên chuỗi injected.
+ **********************************************************/
+boolean Adc_Inj_OwnsGroup(Adc_GroupType Group);
+
+/**********************************************************
+ * @brief Chép kết quả injected mới nhất của nhóm ưu tiên.
+ * @param[out] Timestamp OS_TickCount() lúc JEOC (NULL = bỏ qua).
+ * @return E_NOT_OK nếu chưa có kết quả nào.
+ **********************************************************/
+Std_ReturnType Adc_Inj_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                 uint32_t *Timestamp);
+
+/**********************************************************
+ * @brief Số chuỗi injected đã công bố kể từ Adc_Inj_Init.
+ **********************************************************/
+uint32_t Adc_Inj_GetCount(void);
+
 #endif // ADC_H
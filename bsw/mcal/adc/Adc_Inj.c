@@ -0,0 +1,151 @@
+/**********************************************************************************************************************
+ * @file    Adc_Inj.c
+ * @brief   Nhóm ADC ưu tiên trên chuỗi injected: chọn nhóm, trung bình & công bố.
+ * @details Thuần tính toán, không chạm thanh ghi: Adc.c nạp chuỗi
+ *          Adc_Inj_Sequence() vào JSQR, ISR JEOC (Adc_cfg.c) đọc JDR1..n rồi
+ *          gọi Adc_Inj_OnJeoc(); bản host (Sim_Mcal.c) là bộ tuần tự giả lập
+ *          gọi cùng ISR.
+ *
+ *          Chọn nhóm (ưu tiên nhóm AUTOSAR): nhóm ADC1 có Priority cao nhất
+ *          > ADC_GROUP_PRIORITY_BACKGROUND, 1..ADC_INJ_MAX_CHANNELS kênh;
+ *          bằng Priority thì id nhỏ hơn thắng. Các nhóm còn lại ở chuỗi
+ *          regular/quét nền. Chỉ có một bộ tuần tự injected nên chỉ một nhóm
+ *          chen ngang được.
+ *
+ *          Chuỗi: kênh của nhóm lặp cho đủ ADC_INJ_MAX_CHANNELS rank
+ *          (1 kênh → 4 mẫu, 2 kênh → 2 mẫu mỗi kênh, 3 kênh → 1 mẫu);
+ *          ISR lấy trung bình từng kênh.
+ *
+ *          Công bố: double buffer + số thứ tự như Adc_Scan.c, kèm
+ *          OS_TickCount() lúc JEOC.
+ *
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ *********************************************************************************************************************/
+#include "Adc.h"
+#include "Adc_Cfg.h"
+#include "Os.h"
+
+static Adc_ValueGroupType inj_res[2u][ADC_INJ_MAX_CHANNELS];
+static uint32_t           inj_ts[2u];
+static volatile uint32_t  inj_seq;
+
+static Adc_GroupType inj_grp;
+static uint8_t inj_nch;                                 /* kênh của nhóm, 0 = không có nhóm */
+static uint8_t inj_len;                                 /* số rank injected */
+
+/* =========================================================
+ * 1) Khởi tạo
+ * =======================================================*/
+Std_ReturnType Adc_Inj_Init(const Adc_ConfigType *ConfigPtr)
+{
+    Adc_GroupPriorityType best = ADC_GROUP_PRIORITY_BACKGROUND;
+
+    inj_nch = 0u;
+    inj_len = 0u;
+    inj_seq = 0u;
+    if ((ConfigPtr == NULL) || (ConfigPtr->AdcInstance != ADC_INSTANCE_1)) {
+        return E_OK;
+    }
+
+    for (Adc_GroupType g = 0u; g < ADC_MAX_GROUPS; g++) {
+        const Adc_GroupDefType *grp = &Adc_GroupConfigs[g];
+        if ((grp->AdcInstance == ConfigPtr->AdcInstance) && (grp->Priority > best) &&
+            (grp->NumChannels != 0u) && (grp->NumChannels <= ADC_INJ_MAX_CHANNELS)) {
+            best = grp->Priority;
+            inj_grp = g;
+            inj_nch = grp->NumChannels;
+        }
+    }
+    if (inj_nch != 0u) {
+        inj_len = (uint8_t)((ADC_INJ_MAX_CHANNELS / inj_nch) * inj_nch);
+    }
+    return E_OK;
+}
+
+uint8_t Adc_Inj_Sequence(Adc_ChannelType *Channels)
+{
+    if (Channels == NULL) {
+        return 0u;
+    }
+    for (uint8_t r = 0u; r < inj_len; r++) {
+        Channels[r] = Adc_GroupConfigs[inj_grp].Channels[r % inj_nch];
+    }
+    return inj_len;
+}
+
+/* =========================================================
+ * 2) ISR JEOC: trung bình theo kênh rồi công bố
+ * =======================================================*/
+void Adc_Inj_OnJeoc(const Adc_ValueGroupType *Jdr)
+{
+    if ((inj_nch == 0u) || (Jdr == NULL)) {
+        return;
+    }
+
+    const uint32_t k = inj_len / inj_nch;
+    uint32_t next = inj_seq + 1u;
+    Adc_ValueGroupType *dst = inj_res[next & 1u];
+
+    for (uint32_t c = 0u; c < inj_nch; c++) {
+        uint32_t sum = k / 2u;                      /* làm tròn */
+        for (uint32_t r = c; r < inj_len; r += inj_nch) {
+            sum += Jdr[r];
+        }
+        dst[c] = (Adc_ValueGroupType)(sum / k);
+    }
+    inj_ts[next & 1u] = OS_TickCount();
+    __DMB();
+    inj_seq = next;
+}
+
+/* =========================================================
+ * 3) Reader
+ * =======================================================*/
+boolean Adc_Inj_OwnsGroup(Adc_GroupType Group)
+{
+    return ((inj_nch != 0u) && (Group == inj_grp)) ? TRUE : FALSE;
+}
+
+Std_ReturnType Adc_Inj_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                 uint32_t *Timestamp)
+{
+    const Adc_GroupDefType *grp;
+    uint32_t s;
+    uint32_t ts;
+
+    if ((Adc_Inj_OwnsGroup(Group) == FALSE) || (DataBufferPtr == NULL)) {
+        return E_NOT_OK;
+    }
+    grp = &Adc_GroupConfigs[Group];
+
+    do {
+        s = inj_seq;
+        if (s == 0u) {
+            return E_NOT_OK;                        /* chưa có chuỗi injected nào */
+        }
+        __DMB();
+        for (uint8_t i = 0u; i < inj_nch; i++) {
+            DataBufferPtr[i] = inj_res[s & 1u][i];
+        }
+        ts = inj_ts[s & 1u];
+        __DMB();
+    } while ((inj_seq - s) >= 2u);
+
+    if (Timestamp != NULL) {
+        *Timestamp = ts;
+    }
+
+    if (grp->Result != NULL) {
+        for (uint8_t i = 0u; i < inj_nch; i++) {
+            grp->Result[i] = DataBufferPtr[i];
+        }
+    }
+    return E_OK;
+}
+
+uint32_t Adc_Inj_GetCount(void)
+{
+    return inj_seq;
+}
@@ -0,0 +1,189 @@
+/**********************************************************************************************************************
+ * @file    Adc_Scan.c
+ * @brief   Quét ADC liên tục qua DMA vòng: trung bình & công bố bộ kết quả.
+ * @details Thuần tính toán, không chạm thanh ghi: Adc.c cấu hình ADC1 + DMA1
+ *          Channel1 trỏ vào adc_dma_buf, ISR DMA (Adc_cfg.c) gọi
+ *          Adc_Scan_OnDmaHalf(); bản host (Sim_Mcal.c) là "DMA giả lập" ghi
+ *          cùng buffer và gọi cùng ISR.
+ *
+ *          Bố trí buffer (NumChannels = N, Oversampling = K):
+ *            [ nửa 0: K lần quét × N kênh | nửa 1: K lần quét × N kênh ]
+ *          Kênh theo thứ tự Rank. DMA vòng ghi liên tục; khi nửa này đầy
+ *          (HT/TC) thì DMA đang ghi nửa kia → ISR đọc nửa vừa đầy an toàn
+ *          trong suốt K lần quét kế tiếp.
+ *
+ *          Công bố (double buffer + số thứ tự):
+ *            - Bộ thứ n ghi vào adc_res[n & 1], xong mới adc_seq = n.
+ *            - Reader: s = adc_seq, chép adc_res[s & 1], đọc lại adc_seq;
+ *              chỉ khi đã có thêm >= 2 bộ (ISR đã ghi đè slot s & 1) mới
+ *              chép lại. ISR luôn chạy trọn trước khi task đọc tiếp, nên
+ *              không có bộ "ghi dở" nào lọt qua.
+ *
+ *          STM32F1 không có oversampling phần cứng: trung bình K mẫu làm
+ *          trong ISR (làm tròn), đồng thời giảm tần suất ngắt K lần.
+ *          Quét kích timer: Adc.c lặp Rank K lần trong chuỗi regular nên
+ *          một lần kích lấp đủ một nửa buffer (K × N ≤ ADC_SCAN_MAX_SEQUENCE).
+ *
+ *          Mỗi bộ mang dấu thời gian OS_TickCount() lúc công bố để lớp
+ *          trên tính tuổi mẫu (IoHwAb_Pedal_GetSampleAge).
+ *
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ *********************************************************************************************************************/
+#include "Adc.h"
+#include "Adc_Cfg.h"
+#include "Os.h"
+
+static Adc_ValueGroupType adc_dma_buf[2u * ADC_SCAN_MAX_OVERSAMPLE * ADC_SCAN_MAX_CHANNELS];
+static Adc_ValueGroupType adc_res[2u][ADC_SCAN_MAX_CHANNELS];
+static uint32_t           adc_ts[2u];                   /* OS_TickCount() của từng bộ */
+static volatile uint32_t  adc_seq;
+
+static Adc_ChannelType adc_ch[ADC_SCAN_MAX_CHANNELS];   /* kênh theo Rank */
+static Adc_InstanceType adc_inst;
+static uint8_t adc_n;                                   /* 0 = không quét */
+static uint8_t adc_k;
+
+/* =========================================================
+ * 1) Khởi tạo
+ * =======================================================*/
+Std_ReturnType Adc_Scan_Init(const Adc_ConfigType *ConfigPtr)
+{
+    adc_n = 0u;
+    adc_seq = 0u;
+    if ((ConfigPtr == NULL) || (ConfigPtr->ScanMode != ADC_SCAN_DMA_CIRCULAR)) {
+        return E_OK;
+    }
+    /* DMA chỉ nối với ADC1 trên STM32F1 */
+    if ((ConfigPtr->AdcInstance != ADC_INSTANCE_1) ||
+        (ConfigPtr->NumChannels == 0u) || (ConfigPtr->NumChannels > ADC_SCAN_MAX_CHANNELS)) {
+        return E_NOT_OK;
+    }
+
+    for (uint8_t i = 0u; i < ConfigPtr->NumChannels; i++) {
+        uint8_t rank = ConfigPtr->Channels[i].Rank;
+        if ((rank == 0u) || (rank > ConfigPtr->NumChannels)) {
+            return E_NOT_OK;
+        }
+        adc_ch[rank - 1u] = ConfigPtr->Channels[i].Channel;
+    }
+
+    adc_k = ConfigPtr->Oversampling;
+    if (adc_k == 0u) {
+        adc_k = 1u;
+    } else if (adc_k > ADC_SCAN_MAX_OVERSAMPLE) {
+        adc_k = ADC_SCAN_MAX_OVERSAMPLE;
+    }
+    /* Kích timer: cả nửa buffer là một chuỗi regular (Rank lặp K lần) */
+    if ((ConfigPtr->TriggerSource != ADC_TRIGGER_SOFTWARE) &&
+        ((uint32_t)adc_k * ConfigPtr->NumChannels > ADC_SCAN_MAX_SEQUENCE)) {
+        adc_k = (uint8_t)(ADC_SCAN_MAX_SEQUENCE / ConfigPtr->NumChannels);
+    }
+    adc_inst = ConfigPtr->AdcInstance;
+    adc_n = ConfigPtr->NumChannels;
+    return E_OK;
+}
+
+Adc_ValueGroupType *Adc_Scan_DmaBuffer(uint32_t *NumSamples)
+{
+    if (NumSamples != NULL) {
+        *NumSamples = 2u * (uint32_t)adc_k * adc_n;
+    }
+    return adc_dma_buf;
+}
+
+/* =========================================================
+ * 2) ISR: trung bình nửa buffer vừa đầy rồi công bố
+ * =======================================================*/
+void Adc_Scan_OnDmaHalf(uint8_t Half)
+{
+    if (adc_n == 0u) {
+        return;
+    }
+
+    const uint32_t half_len = (uint32_t)adc_k * adc_n;
+    const Adc_ValueGroupType *src = &adc_dma_buf[(Half != 0u) ? half_len : 0u];
+    uint32_t next = adc_seq + 1u;
+    Adc_ValueGroupType *dst = adc_res[next & 1u];
+
+    for (uint32_t c = 0u; c < adc_n; c++) {
+        uint32_t sum = adc_k / 2u;                  /* làm tròn */
+        for (uint32_t s = c; s < half_len; s += adc_n) {
+            sum += src[s];
+        }
+        dst[c] = (Adc_ValueGroupType)(sum / adc_k);
+    }
+    adc_ts[next & 1u] = OS_TickCount();
+    __DMB();
+    adc_seq = next;
+}
+
+/* =========================================================
+ * 3) Reader
+ * =======================================================*/
+boolean Adc_Scan_OwnsGroup(Adc_GroupType Group)
+{
+    /* Nhóm ưu tiên chạy trên chuỗi injected (Adc_Inj.c), không thuộc chuỗi quét */
+    return ((adc_n != 0u) && (Group < ADC_MAX_GROUPS) &&
+            (Adc_GroupConfigs[Group].AdcInstance == adc_inst) &&
+            (Adc_Inj_OwnsGroup(Group) == FALSE)) ? TRUE : FALSE;
+}
+
+Std_ReturnType Adc_Scan_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                  uint32_t *Timestamp)
+{
+    const Adc_GroupDefType *grp;
+    uint8_t idx[ADC_SCAN_MAX_CHANNELS];
+    uint32_t s;
+    uint32_t ts;
+
+    if ((Adc_Scan_OwnsGroup(Group) == FALSE) || (DataBufferPtr == NULL)) {
+        return E_NOT_OK;
+    }
+    grp = &Adc_GroupConfigs[Group];
+    if (grp->NumChannels > ADC_SCAN_MAX_CHANNELS) {
+        return E_NOT_OK;
+    }
+
+    /* Kênh của nhóm → vị trí trong chuỗi quét */
+    for (uint8_t i = 0u; i < grp->NumChannels; i++) {
+        uint8_t r = 0u;
+        while ((r < adc_n) && (adc_ch[r] != grp->Channels[i])) {
+            r++;
+        }
+        if (r == adc_n) {
+            return E_NOT_OK;                        /* kênh không nằm trong chuỗi quét */
+        }
+        idx[i] = r;
+    }
+
+    do {
+        s = adc_seq;
+        if (s == 0u) {
+            return E_NOT_OK;                        /* chưa có bộ kết quả nào */
+        }
+        __DMB();
+        for (uint8_t i = 0u; i < grp->NumChannels; i++) {
+            DataBufferPtr[i] = adc_res[s & 1u][idx[i]];
+        }
+        ts = adc_ts[s & 1u];
+        __DMB();
+    } while ((adc_seq - s) >= 2u);
+
+    if (Timestamp != NULL) {
+        *Timestamp = ts;
+    }
+
+    if (grp->Result != NULL) {
+        for (uint8_t i = 0u; i < grp->NumChannels; i++) {
+            grp->Result[i] = DataBufferPtr[i];
+        }
+    }
+    return E_OK;
+}
+
+uint32_t Adc_Scan_GetCount(void)
+{
+    return adc_seq;
+}
@@ -6,6 +6,21 @@
  *          thư viện SPL) để thực hiện các chức năng như khởi tạo, gửi/nhận dữ liệu,
  *          và quản lý trạng thái.
  *
+ *          Đường truyền không chặn:
+ *          - Can_Write() chép frame vào hàng đợi TX mềm sắp theo CAN ID rồi
+ *            nạp vào mailbox nếu còn rỗi; không chờ bus, chỉ trả CAN_BUSY
+ *            khi hàng đợi đầy.
+ *          - Ngắt TME (USB_HP_CAN1_TX_IRQHandler → Can_MainFunction_Write)
+ *            giải phóng mailbox, báo TxConfirmation lên CanIf và nạp tiếp
+ *            frame ưu tiên cao nhất từ hàng đợi.
+ *          - CAN_TXFP = DISABLE (Can_Cfg.c): bxCAN chọn mailbox phát theo
+ *            ID, không theo thứ tự nạp → frame ID nhỏ nạp sau vẫn không bị
+ *            kẹt sau frame ID lớn đã nằm trong mailbox.
+ *
+ *          Bộ lọc nhận: Can_SetRxFilter() nạp các filter bank sinh từ danh
+ *          sách CAN ID của CanIf (Can_Filter.c) → frame không ai nhận không
+ *          vào FIFO, không gây ngắt RX.
+ *
  * @version 1.0
  * @date    2025-09-10
  * @author  Nguyễn Tuấn Khoa
@@ -19,9 +34,66 @@
  * @details `mbx_busy` theo dõi mailbox nào đang bận. `swPduHandle` lưu PDU ID của lớp trên 
  *          tương ứng với mỗi mailbox, dùng cho việc xác nhận truyền (Tx Confirmation).
  */
-static uint8_t mbx;
 static uint8_t mbx_busy[CAN_MAX_TX_MAILBOX];
-static PduIdType* swPduHandle[CAN_MAX_TX_MAILBOX];
+static PduIdType swPduHandle[CAN_MAX_TX_MAILBOX];
+
+/**
+ * @brief Hàng đợi TX mềm (CAN_TX_QUEUE_SIZE frame) chờ mailbox rỗi.
+ * @details Mảng giữ CAN ID GIẢM dần: phần tử cuối là frame ưu tiên cao
+ *          nhất (ID nhỏ nhất) nên lấy ra O(1); frame cùng ID giữ thứ tự
+ *          gửi. Dữ liệu được chép vào đây, lớp trên được dùng lại buffer
+ *          ngay sau Can_Write(). Chỉ truy cập trong vùng găng (task ↔ ISR TX).
+ */
+typedef struct {
+    Can_IdType id;
+    PduIdType  swPduHandle;
+    uint8_t    length;
+    uint8_t    data[8];
+} Can_TxQueueEntryType;
+
+static Can_TxQueueEntryType txQueue[CAN_TX_QUEUE_SIZE];
+static uint8_t txQueueLen;
+
+static Can_FilterLayoutType filterLayout;   /* bộ lọc đang nạp (Can_SetRxFilter) */
+
+static const uint32_t mbx_rqcp[CAN_MAX_TX_MAILBOX] = { CAN_TSR_RQCP0, CAN_TSR_RQCP1, CAN_TSR_RQCP2 };
+static const uint32_t mbx_txok[CAN_MAX_TX_MAILBOX] = { CAN_TSR_TXOK0, CAN_TSR_TXOK1, CAN_TSR_TXOK2 };
+
+/******************************************************************************
+ * @brief Nạp một frame vào mailbox rỗi (gọi trong vùng găng).
+ * @return TRUE nếu đã nạp, FALSE nếu không còn mailbox rỗi.
+ *****************************************************************************/
+static boolean prv_mailbox_write(const Can_TxQueueEntryType* e){
+    CanTxMsg TxMessage;
+    TxMessage.RTR = CAN_RTR_DATA;
+    TxMessage.IDE = (e->id > 0x7FFu) ? CAN_ID_EXT : CAN_ID_STD;
+    TxMessage.StdId = (TxMessage.IDE == CAN_ID_STD) ? e->id : 0u;
+    TxMessage.ExtId = (TxMessage.IDE == CAN_ID_EXT) ? e->id : 0u;
+    TxMessage.DLC = e->length;
+    for(uint8_t i = 0; i < e->length; i++){
+        TxMessage.Data[i] = e->data[i];
+    }
+
+    // CAN_Transmit trả về số mailbox (0, 1, 2) hoặc CAN_TxStatus_NoMailBox (4)
+    const uint8_t mbx = CAN_Transmit(CAN1, &TxMessage);
+    if(mbx >= CAN_MAX_TX_MAILBOX) return FALSE;
+
+    mbx_busy[mbx] = 1;
+    swPduHandle[mbx] = e->swPduHandle;
+    return TRUE;
+}
+
+/******************************************************************************
+ * @brief Chuyển frame từ hàng đợi mềm sang mailbox khi còn mailbox rỗi.
+ * @details Ưu tiên cao nhất (cuối mảng) đi trước. Gọi trong vùng găng.
+ *****************************************************************************/
+static void prv_tx_refill(void){
+    while(txQueueLen > 0u){
+        if((CAN1->TSR & (CAN_TSR_TME0 | CAN_TSR_TME1 | CAN_TSR_TME2)) == 0u) break;
+        if(prv_mailbox_write(&txQueue[txQueueLen - 1u]) == FALSE) break;
+        txQueueLen--;
+    }
+}
 /******************************************************************************
  * @brief Khởi tạo CAN controller với cấu hình được cung cấp.
  * @param[in] config Con trỏ tới cấu trúc cấu hình.
@@ -50,28 +122,69 @@ void Can_Init(const Can_ConfigType* config) {
         // printf("CAN Init failed!\n");
     };
 
-    CAN_FilterInitTypeDef Can_FilterInitStructure;
-    Can_FilterInitStructure.CAN_FilterNumber = 0;
-    Can_FilterInitStructure.CAN_FilterMode = CAN_FilterMode_IdMask;
-    Can_FilterInitStructure.CAN_FilterScale = CAN_FilterScale_32bit;
-    Can_FilterInitStructure.CAN_FilterIdHigh = config->Filter_Config.Can_FilterIdHigh;
-    Can_FilterInitStructure.CAN_FilterIdLow = config->Filter_Config.Can_FilterIdLow;
-    Can_FilterInitStructure.CAN_FilterMaskIdHigh = config->Filter_Config.Can_FilterMaskIdHigh;
-    Can_FilterInitStructure.CAN_FilterMaskIdLow = config->Filter_Config.Can_FilterMaskIdLow;
-    Can_FilterInitStructure.CAN_FilterFIFOAssignment = CAN_FIFO0;
-    Can_FilterInitStructure.CAN_FilterActivation = ENABLE;
-
-    CAN_FilterInit(&Can_FilterInitStructure);
+    // Bộ lọc: mọi bank tắt tới khi CanIf_Init nạp theo bảng định tuyến (Can_SetRxFilter)
+    (void)Can_SetRxFilter(NULL, 0u);
+    txQueueLen = 0u;
+    for(uint8_t m = 0u; m < CAN_MAX_TX_MAILBOX; m++){
+        mbx_busy[m] = 0u;
+    }
     if(config->NotificationEnable == ENABLE){
+        // RX: có frame hoặc tràn FIFO → ISR vét hết FIFO vào vòng RX của CanIf
         CAN_ITConfig(CAN1, CAN_IT_FMP0, ENABLE);
+        CAN_ITConfig(CAN1, CAN_IT_FOV0, ENABLE);
+        CAN_ITConfig(CAN1, CAN_IT_FMP1, ENABLE);
+        CAN_ITConfig(CAN1, CAN_IT_FOV1, ENABLE);
         NVIC_EnableIRQ(USB_LP_CAN1_RX0_IRQn);
+        NVIC_EnableIRQ(CAN1_RX1_IRQn);
+        // Mailbox rỗi → nạp hàng đợi TX mềm + TxConfirmation
+        CAN_ITConfig(CAN1, CAN_IT_TME, ENABLE);
+        NVIC_EnableIRQ(USB_HP_CAN1_TX_IRQn);
     }
 }
 
+/******************************************************************************
+ * @brief Nạp filter bank sinh từ danh sách CAN ID nhận; bank thừa bị tắt.
+ *****************************************************************************/
+Std_ReturnType Can_SetRxFilter(const Can_IdType* ids, uint8_t numIds){
+    const Std_ReturnType ret = Can_BuildFilterLayout(ids, numIds, CAN_MAX_FILTER_BANKS, &filterLayout);
+
+    for(uint8_t i = 0u; i < CAN_MAX_FILTER_BANKS; i++){
+        CAN_FilterInitTypeDef f;
+        f.CAN_FilterNumber = i;
+        if(i < filterLayout.numBanks){
+            const Can_FilterBankType* b = &filterLayout.bank[i];
+            f.CAN_FilterMode = b->FilterMode;
+            f.CAN_FilterScale = b->FilterScale;
+            f.CAN_FilterIdHigh = b->FilterIdHigh;
+            f.CAN_FilterIdLow = b->FilterIdLow;
+            f.CAN_FilterMaskIdHigh = b->FilterMaskIdHigh;
+            f.CAN_FilterMaskIdLow = b->FilterMaskIdLow;
+            f.CAN_FilterFIFOAssignment = b->FilterFIFOAssignment;
+            f.CAN_FilterActivation = ENABLE;
+        } else {
+            f.CAN_FilterMode = CAN_FilterMode_IdMask;
+            f.CAN_FilterScale = CAN_FilterScale_32bit;
+            f.CAN_FilterIdHigh = 0u;
+            f.CAN_FilterIdLow = 0u;
+            f.CAN_FilterMaskIdHigh = 0u;
+            f.CAN_FilterMaskIdLow = 0u;
+            f.CAN_FilterFIFOAssignment = CAN_FIFO0;
+            f.CAN_FilterActivation = DISABLE;
+        }
+        CAN_FilterInit(&f);
+    }
+    return ret;
+}
+
+const Can_FilterLayoutType* Can_GetFilterLayout(void){
+    return &filterLayout;
+}
+
 /******************************************************************************
  * @brief Hủy khởi tạo CAN controller.
  *****************************************************************************/
 void Can_DeInit(void) {
+    txQueueLen = 0u;
     CAN_DeInit(CAN1);
     RCC_APB1PeriphResetCmd(RCC_APB1Periph_CAN1, ENABLE);
 }
@@ -326,48 +439,68 @@ Std_ReturnType CAN_GetControllerTxErrorCounter(uint8_t Controller, uint8_t* TxEr
 
 /******************************************************************************
  * @brief Ghi một PDU (Protocol Data Unit) để truyền đi.
+ * @details Không chờ bus: frame được chép vào hàng đợi TX mềm (sắp theo CAN ID)
+ *          rồi nạp ngay vào mailbox nếu còn rỗi; phần còn lại do ngắt TME nạp
+ *          tiếp. TxConfirmation đến sau, từ Can_MainFunction_Write().
  * @param[in] Hth Handle của đối tượng phần cứng truyền (không dùng trong phiên bản này).
  * @param[in] PduInfo Con trỏ tới cấu trúc PDU chứa thông tin cần gửi.
- * @return Std_ReturnType E_OK nếu yêu cầu được chấp nhận, E_NOT_OK nếu lỗi, CAN_BUSY nếu không có mailbox rỗi.
+ * @return Std_ReturnType E_OK nếu yêu cầu được chấp nhận, E_NOT_OK nếu lỗi, CAN_BUSY nếu hàng đợi TX đầy.
  *****************************************************************************/
 Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType* PduInfo){
-    if(PduInfo == NULL) return E_NOT_OK;
-
-    // Kiểm tra xem có ít nhất một mailbox truyền đang rỗi không
-    if((CAN1->TSR & CAN_TSR_TME0) == 0 &&
-       (CAN1->TSR & CAN_TSR_TME1) == 0 &&
-       (CAN1->TSR & CAN_TSR_TME2) == 0
-    ) return CAN_BUSY;
+    (void)Hth;
+    if((PduInfo == NULL) || (PduInfo->sdu == NULL) || (PduInfo->length > 8u)) return E_NOT_OK;
 
-    // Chuẩn bị message để truyền đi theo cấu trúc của thư viện SPL
-    CanTxMsg TxMessage;
-    TxMessage.RTR = CAN_RTR_DATA;
-    TxMessage.IDE = (PduInfo->id > 0x7FFu) ? CAN_ID_EXT : CAN_ID_STD;
-    
-    // Gán ID (Standard hoặc Extended)
-    if(TxMessage.IDE == CAN_ID_STD){
-        TxMessage.StdId = PduInfo->id;
-    }else{
-        TxMessage.ExtId = PduInfo->id;
+    __disable_irq();
+    if(txQueueLen >= CAN_TX_QUEUE_SIZE){
+        __enable_irq();
+        return CAN_BUSY;
     }
 
-    TxMessage.DLC = PduInfo->length;
-    for(uint8_t i = 0; i < PduInfo->length; i++){
-        TxMessage.Data[i] = PduInfo->sdu[i]; // Sao chép dữ liệu
+    // Chèn giữ CAN ID giảm dần; đứng trước các frame cùng ID đã chờ
+    // (phía chỉ số nhỏ) để frame cũ hơn được lấy ra trước.
+    uint8_t i = txQueueLen;
+    while((i > 0u) && (txQueue[i - 1u].id <= PduInfo->id)){
+        txQueue[i] = txQueue[i - 1u];
+        i--;
     }
-    
-    // Gọi hàm của SPL để truyền message
-    mbx = CAN_Transmit(CAN1, &TxMessage);
-    // CAN_Transmit trả về số mailbox (0, 1, 2) hoặc CAN_TxStatus_NoMailBox (4)
-    if(mbx == CAN_TxStatus_NoMailBox) return CAN_BUSY;
-
-    if(mbx < CAN_MAX_TX_MAILBOX){
-        mbx_busy[mbx] = 1;
-        swPduHandle[mbx] = PduInfo->swPduHandle;
-    };
-   
-    while(CAN_TransmitStatus(CAN1, mbx) == CAN_TxStatus_Failed) ;
+    Can_TxQueueEntryType* e = &txQueue[i];
+    e->id = PduInfo->id;
+    e->swPduHandle = PduInfo->swPduHandle;
+    e->length = PduInfo->length;
+    for(uint8_t b = 0; b < PduInfo->length; b++){
+        e->data[b] = PduInfo->sdu[b];
+    }
+    txQueueLen++;
 
-    return E_OK;   
+    prv_tx_refill();
+    __enable_irq();
+    return E_OK;
 }
 
+/******************************************************************************
+ * @brief Xử lý mailbox đã truyền xong (ngắt TME hoặc polling).
+ * @details Với mỗi mailbox có RQCPx: xoá cờ, giải phóng mailbox, nếu TXOKx thì
+ *          báo Can_NotifyTxConfirmation(swPduHandle); sau đó nạp lại mailbox
+ *          từ hàng đợi mềm. Callback gọi ngoài vùng găng.
+ *****************************************************************************/
+void Can_MainFunction_Write(void){
+    PduIdType done[CAN_MAX_TX_MAILBOX];
+    uint8_t nDone = 0u;
+
+    __disable_irq();
+    const uint32_t tsr = CAN1->TSR;
+    for(uint8_t m = 0u; m < CAN_MAX_TX_MAILBOX; m++){
+        if((tsr & mbx_rqcp[m]) == 0u) continue;
+        CAN1->TSR = mbx_rqcp[m];            // ghi 1 để xoá RQCP/TXOK/ALST/TERR
+        if((mbx_busy[m] != 0u) && ((tsr & mbx_txok[m]) != 0u)){
+            done[nDone++] = swPduHandle[m];
+        }
+        mbx_busy[m] = 0u;
+    }
+    prv_tx_refill();
+    __enable_irq();
+
+    for(uint8_t k = 0u; k < nDone; k++){
+        Can_NotifyTxConfirmation(done[k]);
+    }
+}
@@ -35,12 +35,17 @@
 #define CAN_SW_MAJOR_VERSION 1U
 #define CAN_SW_MINOR_VERSION 0U
 #define CAN_SW_PATCH_VERSION 0U
+
+#define CAN_MAX_FILTER_BANKS 14U   /*!< Số filter bank của CAN1 (STM32F10x). */
+#define CAN_FILTER_MAX_IDS   64U   /*!< Số CAN ID nhận tối đa đưa vào bộ sinh bộ lọc. */
+
 /********************************************************************************
  * @struct Can_ConfigType
  * @brief  Cấu trúc chứa các thông số cấu hình cho một CAN controller.
  * @details Cấu trúc này được truyền vào hàm `Can_Init` để thiết lập các thông số
  *          vận hành cho phần cứng CAN, bao gồm cả timing, các tính năng phụ trợ 
- *          và bộ lọc.
+ *          và ngắt. Bộ lọc không cấu hình ở đây mà sinh từ các CAN ID nhận
+ *          của CanIf qua Can_SetRxFilter().
  *******************************************************************************/
 typedef struct {
     
@@ -65,24 +70,35 @@ typedef struct {
         FunctionalState CAN_TXFP; /*!< Transmit FIFO Priority: Bật/tắt ưu tiên truyền theo thứ tự yêu cầu (thay vì theo ID). */
     }Basic_Config;
 
-    /****************************************************************************
-     * @brief Cấu hình bộ lọc tin nhắn CAN.
-     ****************************************************************************/
-    struct 
-    {
-        uint16_t Can_FilterIdHigh;         /*!< Thanh ghi ID bộ lọc (phần cao). */
-        uint16_t Can_FilterIdLow;          /*!< Thanh ghi ID bộ lọc (phần thấp). */
-        uint16_t Can_FilterMaskIdHigh;     /*!< Thanh ghi mặt nạ hoặc ID thứ hai (phần cao). */
-        uint16_t Can_FilterMaskIdLow;      /*!< Thanh ghi mặt nạ hoặc ID thứ hai (phần thấp). */
-        uint16_t Can_FilterFIFOAssignment; /*!< Chỉ định FIFO (0 hoặc 1) cho bộ lọc. */
-        uint8_t Can_FilterNumber;          /*!< Số thứ tự của bộ lọc (0-13). */
-        uint8_t Can_FilterMode;            /*!< Chế độ bộ lọc: Mask (CAN_FilterMode_IdMask) hoặc List (CAN_FilterMode_IdList). */
-        uint8_t Can_FilterScale;           /*!< Kích thước bộ lọc: 16-bit (CAN_FilterScale_16bit) hoặc 32-bit (CAN_FilterScale_32bit). */
-        uint8_t Can_FilterActivation;      /*!< Trạng thái kích hoạt bộ lọc (ENABLE hoặc DISABLE). */
-    } Filter_Config;
     uint8_t NotificationEnable;            /*!< Bật/Tắt ngắt CAN */
 }Can_ConfigType;
 
+/********************************************************************************
+ * @struct Can_FilterBankType
+ * @brief  Nội dung một filter bank bxCAN (theo trường của CAN_FilterInitTypeDef).
+ *******************************************************************************/
+typedef struct {
+    uint16_t FilterIdHigh;         /*!< FR1[31:16] (32-bit) hoặc FR2[15:0] (16-bit). */
+    uint16_t FilterIdLow;          /*!< FR1[15:0]. */
+    uint16_t FilterMaskIdHigh;     /*!< FR2[31:16]. */
+    uint16_t FilterMaskIdLow;      /*!< FR2[15:0] (32-bit) hoặc FR1[31:16] (16-bit). */
+    uint8_t  FilterMode;           /*!< CAN_FilterMode_IdList / CAN_FilterMode_IdMask. */
+    uint8_t  FilterScale;          /*!< CAN_FilterScale_16bit / CAN_FilterScale_32bit. */
+    uint8_t  FilterFIFOAssignment; /*!< CAN_FIFO0 / CAN_FIFO1. */
+    uint8_t  numIds;               /*!< Số CAN ID cấu hình mà bank này nhận. */
+} Can_FilterBankType;
+
+/********************************************************************************
+ * @struct Can_FilterLayoutType
+ * @brief  Kết quả sinh bộ lọc: các bank dùng (từ bank 0) và thống kê.
+ *******************************************************************************/
+typedef struct {
+    Can_FilterBankType bank[CAN_MAX_FILTER_BANKS];
+    uint8_t  numBanks;             /*!< Số bank dùng; bank còn lại tắt. */
+    uint8_t  numIds[2];            /*!< Số CAN ID cấu hình về FIFO0 / FIFO1. */
+    uint32_t falseAcceptIds;       /*!< Số ID KHÔNG cấu hình vẫn lọt qua mask (0 = khớp đúng). */
+} Can_FilterLayoutType;
+
 /*******************************************************************************
  * @brief Khởi tạo CAN driver.
  * @details Hàm này khởi tạo tất cả các CAN controller được định nghĩa trong cấu hình.
@@ -173,10 +189,54 @@ Std_ReturnType CAN_GetControllerRxErrorCounter(uint8_t Controller, uint8_t* RxEr
 Std_ReturnType CAN_GetControllerTxErrorCounter(uint8_t Controller, uint8_t* TxErrorCounterPtr);
 /******************************************************************************
  * @brief Ghi một PDU (Protocol Data Unit) để truyền đi.
+ * @details Không chặn: frame vào hàng đợi TX mềm (ưu tiên theo CAN ID) khi cả
+ *          3 mailbox đều bận; TxConfirmation báo sau qua Can_MainFunction_Write().
  * @param[in] Hth Handle của đối tượng phần cứng truyền (Hardware Transmit Handle).
  * @param[in] PduInfo Con trỏ tới cấu trúc PDU chứa thông tin (ID, data, length) cần gửi.
- * @return Std_ReturnType E_OK nếu yêu cầu được chấp nhận, E_NOT_OK nếu Hth không hợp lệ, CAN_BUSY nếu mailbox đang bận.
+ * @return Std_ReturnType E_OK nếu yêu cầu được chấp nhận, E_NOT_OK nếu tham số không hợp lệ, CAN_BUSY nếu hàng đợi TX đầy.
  *****************************************************************************/
 Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType* PduInfo);
+/******************************************************************************
+ * @brief Xử lý các mailbox đã truyền xong.
+ * @details Gọi từ ngắt TX (USB_HP_CAN1_TX_IRQHandler) hoặc định kỳ khi tắt ngắt:
+ *          báo TxConfirmation cho frame đã lên bus và nạp lại mailbox từ hàng
+ *          đợi TX mềm.
+ *****************************************************************************/
+void Can_MainFunction_Write(void);
+
+/******************************************************************************
+ * @brief Sinh bộ lọc phần cứng từ danh sách CAN ID nhận (không chạm thanh ghi).
+ * @details Ưu tiên list mode (khớp đúng); thiếu bank thì gộp ID thành cặp
+ *          ID/mask nhận thừa ít nhất; bank chia đều hai FIFO (Can_Filter.c).
+ * @param[in]  ids      Danh sách CAN ID (ID > 0x7FF là ID mở rộng).
+ * @param[in]  numIds   Số phần tử (tối đa CAN_FILTER_MAX_IDS).
+ * @param[in]  maxBanks Số bank được dùng (tối đa CAN_MAX_FILTER_BANKS).
+ * @param[out] layout   Kết quả.
+ * @return E_OK, hoặc E_NOT_OK khi không sinh được — layout là một bank nhận mọi frame.
+ *****************************************************************************/
+Std_ReturnType Can_BuildFilterLayout(const Can_IdType* ids, uint8_t numIds, uint8_t maxBanks,
+                                     Can_FilterLayoutType* layout);
+
+/******************************************************************************
+ * @brief Kiểm tra một frame có lọt bộ lọc không (như phần cứng).
+ * @param[in]  ide  CAN_Id_Standard / CAN_Id_Extended.
+ * @param[out] fifo FIFO nhận frame (có thể NULL).
+ * @return TRUE nếu frame được nhận.
+ *****************************************************************************/
+boolean Can_FilterMatch(const Can_FilterLayoutType* layout, Can_IdType id, uint8_t ide, uint8_t* fifo);
+
+/******************************************************************************
+ * @brief Nạp bộ lọc phần cứng nhận đúng các CAN ID cho trước.
+ * @details CanIf_Init gọi với các CAN ID Rx trong bảng định tuyến: frame
+ *          không ai nhận bị loại ngay ở filter bank, không gây ngắt RX.
+ *          Trước lần gọi đầu, mọi bank tắt (không nhận frame nào).
+ * @return E_OK; E_NOT_OK nếu không sinh được (đã nạp bộ lọc nhận mọi frame).
+ *****************************************************************************/
+Std_ReturnType Can_SetRxFilter(const Can_IdType* ids, uint8_t numIds);
+
+/******************************************************************************
+ * @brief Bộ lọc đang nạp (chẩn đoán).
+ *****************************************************************************/
+const Can_FilterLayoutType* Can_GetFilterLayout(void);
 
 #endif /* CAN_H */
@@ -0,0 +1,314 @@
+/**********************************************************************************************************************
+ * @file    Can_Filter.c
+ * @brief   Sinh cấu hình filter bank bxCAN từ danh sách CAN ID nhận.
+ * @details Thuần tính toán, không chạm thanh ghi: Can_SetRxFilter() (Can.c)
+ *          nạp kết quả vào phần cứng, bản host (Sim_Mcal.c) dùng lại để lọc
+ *          frame giả lập và báo cáo.
+ *
+ *          Chiến lược (bxCAN STM32F10x, CAN_MAX_FILTER_BANKS bank):
+ *          1) Khớp đúng trước: ID chuẩn xếp 4 ID/bank (16-bit list), ID mở
+ *             rộng 2 ID/bank (32-bit list) → không nhận nhầm frame nào.
+ *          2) Thiếu bank: gộp dần hai nhóm cùng loại có phần "nhận thừa"
+ *             tăng ít nhất thành một cặp ID/mask (16-bit mask: 2 nhóm/bank,
+ *             32-bit mask: 1 nhóm/bank) cho tới khi vừa số bank cho phép.
+ *          3) Cân bằng FIFO: mỗi bank gán vào FIFO đang nhận ít ID hơn để
+ *             hai ngắt RX0/RX1 chia tải.
+ *          Bit IDE/RTR luôn được so: bank ID chuẩn không nhận frame mở rộng
+ *          hay remote frame và ngược lại.
+ *
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ *********************************************************************************************************************/
+#include "Can.h"
+#include <string.h>
+
+#define CAN_STD_ID_BITS   11u
+#define CAN_EXT_ID_BITS   29u
+#define CAN_STD_ID_MASK   0x7FFu
+#define CAN_EXT_ID_MASK   0x1FFFFFFFu
+
+/* Thanh ghi 16-bit: STID[10:0] | RTR | IDE | EXID[17:15] */
+#define CAN_F16_ID(id)    ((uint16_t)((id) << 5))
+#define CAN_F16_IDE_RTR   0x0018u
+/* Thanh ghi 32-bit: EXID[28:0] | IDE | RTR | 0 */
+#define CAN_F32_ID(id)    ((uint32_t)((id) << 3) | (uint32_t)CAN_Id_Extended)
+#define CAN_F32_IDE_RTR   0x00000006u
+
+/**
+ * @brief Một nhóm ID trong quá trình gộp: nhận mọi ID có (ID & care) == value.
+ */
+typedef struct {
+    uint32_t value;
+    uint32_t care;      /*!< Bit phải khớp (mask đầy = một ID duy nhất). */
+    uint8_t  ext;       /*!< 1 = ID mở rộng (29 bit). */
+    uint8_t  count;     /*!< Số ID cấu hình thuộc nhóm. */
+} Can_FilterGroupType;
+
+static uint8_t prv_popcount(uint32_t v){
+    uint8_t n = 0u;
+    while(v != 0u){
+        v &= v - 1u;
+        n++;
+    }
+    return n;
+}
+
+/* Số ID mà nhóm nhận (kể cả ID cấu hình). */
+static uint32_t prv_cover(const Can_FilterGroupType* g){
+    const uint8_t bits = (g->ext != 0u) ? CAN_EXT_ID_BITS : CAN_STD_ID_BITS;
+    return (uint32_t)1u << (bits - prv_popcount(g->care));
+}
+
+static boolean prv_is_single(const Can_FilterGroupType* g){
+    return (g->care == ((g->ext != 0u) ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK)) ? TRUE : FALSE;
+}
+
+/* Số bank cần để xếp các nhóm hiện có theo 4 kiểu bank. */
+static uint8_t prv_banks_needed(const Can_FilterGroupType* g, uint8_t n){
+    uint8_t std1 = 0u, std2 = 0u, ext1 = 0u, ext2 = 0u;
+    for(uint8_t i = 0u; i < n; i++){
+        const boolean single = prv_is_single(&g[i]);
+        if(g[i].ext == 0u){
+            if(single) std1++; else std2++;
+        } else {
+            if(single) ext1++; else ext2++;
+        }
+    }
+    return (uint8_t)(((std1 + 3u) / 4u) + ((std2 + 1u) / 2u) + ((ext1 + 1u) / 2u) + ext2);
+}
+
+/* Gộp cặp nhóm cùng loại làm tăng phần nhận thừa ít nhất; FALSE nếu hết cặp. */
+static boolean prv_merge_cheapest(Can_FilterGroupType* g, uint8_t* n){
+    uint8_t bi = 0u, bj = 0u;
+    uint32_t bestCost = 0xFFFFFFFFu;
+    boolean found = FALSE;
+
+    for(uint8_t i = 0u; i < *n; i++){
+        for(uint8_t j = (uint8_t)(i + 1u); j < *n; j++){
+            if(g[i].ext != g[j].ext) continue;
+            Can_FilterGroupType m = g[i];
+            m.care = g[i].care & g[j].care & ~(g[i].value ^ g[j].value);
+            const uint32_t old  = prv_cover(&g[i]) + prv_cover(&g[j]);
+            const uint32_t cost = (prv_cover(&m) > old) ? (prv_cover(&m) - old) : 0u;   // nhóm chồng nhau
+            if((found == FALSE) || (cost < bestCost)){
+                bestCost = cost;
+                bi = i;
+                bj = j;
+                found = TRUE;
+            }
+        }
+    }
+    if(found == FALSE) return FALSE;
+
+    g[bi].care  = g[bi].care & g[bj].care & ~(g[bi].value ^ g[bj].value);
+    g[bi].value &= g[bi].care;
+    g[bi].count = (uint8_t)(g[bi].count + g[bj].count);
+    g[bj] = g[*n - 1u];
+    (*n)--;
+    return TRUE;
+}
+
+/**
+ * @brief Số ID mà hợp các nhóm trong `set` nhận, giới hạn trong ô (ID & fixed) == fval.
+ * @details Các nhóm có thể chồng nhau (nhóm gộp chứa ID của nhóm khác hoặc hai
+ *          mask giao nhau) nên không cộng prv_cover() từng nhóm: tách ô theo
+ *          một bit nhóm còn so cho tới khi ô nằm trọn trong một nhóm hoặc chỉ
+ *          còn một nhóm. Độ sâu đệ quy <= số bit ID.
+ * @param set Bit i = nhóm g[i] (CAN_FILTER_MAX_IDS <= 64), cùng loại ID.
+ */
+static uint32_t prv_union_size(const Can_FilterGroupType* g, uint64_t set,
+                               uint32_t fixed, uint32_t fval, uint8_t bits){
+    uint64_t live = 0u;
+    uint32_t split = 0u;
+    uint8_t  left = 0u;
+    uint8_t  last = 0u;
+
+    for(uint8_t i = 0u; i < CAN_FILTER_MAX_IDS; i++){
+        if(((set >> i) & 1u) == 0u) continue;
+        if(((g[i].value ^ fval) & g[i].care & fixed) != 0u) continue;   // nhóm ngoài ô
+        const uint32_t rest = g[i].care & ~fixed;
+        if(rest == 0u) return (uint32_t)1u << (bits - prv_popcount(fixed));   // ô nằm trọn trong nhóm
+        if(split == 0u) split = rest & (~rest + 1u);
+        live |= (uint64_t)1u << i;
+        last = i;
+        left++;
+    }
+    if(left == 0u) return 0u;
+    if(left == 1u) return (uint32_t)1u << (bits - prv_popcount(fixed | g[last].care));
+    return prv_union_size(g, live, fixed | split, fval, bits)
+         + prv_union_size(g, live, fixed | split, fval | split, bits);
+}
+
+/* Mở một bank mới; FIFO được chọn khi đóng bank (FIFO đang nhận ít ID hơn). */
+static Can_FilterBankType* prv_open_bank(Can_FilterLayoutType* layout, uint8_t mode, uint8_t scale){
+    Can_FilterBankType* b = &layout->bank[layout->numBanks++];
+    memset(b, 0, sizeof(*b));
+    b->FilterMode  = mode;
+    b->FilterScale = scale;
+    return b;
+}
+
+static void prv_close_bank(Can_FilterLayoutType* layout, Can_FilterBankType* b){
+    b->FilterFIFOAssignment = (layout->numIds[CAN_FIFO1] < layout->numIds[CAN_FIFO0]) ? CAN_FIFO1 : CAN_FIFO0;
+    layout->numIds[b->FilterFIFOAssignment] = (uint8_t)(layout->numIds[b->FilterFIFOAssignment] + b->numIds);
+}
+
+/* Ghi từng ô 16-bit theo thứ tự FR1.lo, FR1.hi, FR2.lo, FR2.hi. */
+static void prv_set_slot16(Can_FilterBankType* b, uint8_t slot, uint16_t v){
+    switch(slot){
+        case 0u: b->FilterIdLow      = v; break;
+        case 1u: b->FilterMaskIdLow  = v; break;
+        case 2u: b->FilterIdHigh     = v; break;
+        default: b->FilterMaskIdHigh = v; break;
+    }
+}
+
+/* Ghi ô 32-bit: 0 = FR1 (IdHigh:IdLow), 1 = FR2 (MaskIdHigh:MaskIdLow). */
+static void prv_set_slot32(Can_FilterBankType* b, uint8_t slot, uint32_t v){
+    if(slot == 0u){
+        b->FilterIdHigh = (uint16_t)(v >> 16);
+        b->FilterIdLow  = (uint16_t)v;
+    } else {
+        b->FilterMaskIdHigh = (uint16_t)(v >> 16);
+        b->FilterMaskIdLow  = (uint16_t)v;
+    }
+}
+
+/**
+ * @brief Xếp các nhóm cùng kiểu vào bank; ô trống lặp lại ô đầu (không nhận thêm ID).
+ * @param ext    0 = ID chuẩn, 1 = ID mở rộng.
+ * @param single TRUE = nhóm một ID (list mode), FALSE = nhóm có mask.
+ */
+static void prv_emit(Can_FilterLayoutType* layout, const Can_FilterGroupType* g, uint8_t n,
+                     uint8_t ext, boolean single){
+    const uint8_t perBank = (ext == 0u) ? (single ? 4u : 2u) : (single ? 2u : 1u);
+    const uint8_t mode    = single ? CAN_FilterMode_IdList : CAN_FilterMode_IdMask;
+    const uint8_t scale   = (ext == 0u) ? CAN_FilterScale_16bit : CAN_FilterScale_32bit;
+    Can_FilterBankType* b = NULL;
+    uint8_t used = 0u;
+
+    for(uint8_t i = 0u; i < n; i++){
+        if((g[i].ext != ext) || (prv_is_single(&g[i]) != single)) continue;
+        if(b == NULL){
+            b = prv_open_bank(layout, mode, scale);
+            used = 0u;
+        }
+        for(uint8_t s = used; s < perBank; s++){    // ô chưa dùng = bản sao nhóm đầu của bank
+            if(ext == 0u){
+                if(single){
+                    prv_set_slot16(b, s, CAN_F16_ID(g[i].value));
+                } else {
+                    prv_set_slot16(b, (uint8_t)(2u * s),      CAN_F16_ID(g[i].value));
+                    prv_set_slot16(b, (uint8_t)(2u * s + 1u), (uint16_t)(CAN_F16_ID(g[i].care) | CAN_F16_IDE_RTR));
+                }
+            } else {
+                if(single){
+                    prv_set_slot32(b, s, CAN_F32_ID(g[i].value));
+                } else {
+                    prv_set_slot32(b, 0u, CAN_F32_ID(g[i].value));
+                    prv_set_slot32(b, 1u, (uint32_t)(g[i].care << 3) | CAN_F32_IDE_RTR);
+                }
+            }
+            if(used != 0u) break;                  // chỉ bank mới cần lấp ô trống
+        }
+        b->numIds = (uint8_t)(b->numIds + g[i].count);
+        if(++used == perBank){
+            prv_close_bank(layout, b);
+            b = NULL;
+        }
+    }
+    if(b != NULL){
+        prv_close_bank(layout, b);
+    }
+}
+
+/* Không sinh được: một bank 32-bit mask 0 → nhận mọi frame, CanIf tự lọc. */
+static Std_ReturnType prv_accept_all(Can_FilterLayoutType* layout){
+    memset(layout, 0, sizeof(*layout));
+    Can_FilterBankType* b = prv_open_bank(layout, CAN_FilterMode_IdMask, CAN_FilterScale_32bit);
+    b->FilterFIFOAssignment = CAN_FIFO0;
+    layout->falseAcceptIds = 0xFFFFFFFFu;
+    return E_NOT_OK;
+}
+
+Std_ReturnType Can_BuildFilterLayout(const Can_IdType* ids, uint8_t numIds, uint8_t maxBanks,
+                                     Can_FilterLayoutType* layout){
+    Can_FilterGroupType g[CAN_FILTER_MAX_IDS];
+    uint8_t n = 0u;
+
+    if(layout == NULL) return E_NOT_OK;
+    memset(layout, 0, sizeof(*layout));
+    if(maxBanks > CAN_MAX_FILTER_BANKS) maxBanks = CAN_MAX_FILTER_BANKS;
+
+    if(((ids == NULL) && (numIds != 0u)) || (numIds > CAN_FILTER_MAX_IDS) || (maxBanks == 0u)){
+        return prv_accept_all(layout);
+    }
+
+    // Mỗi ID (bỏ trùng) là một nhóm khớp đúng.
+    for(uint8_t i = 0u; i < numIds; i++){
+        const uint8_t ext = (ids[i] > CAN_STD_ID_MASK) ? 1u : 0u;
+        const uint32_t id = ids[i] & (ext ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK);
+        boolean dup = FALSE;
+        for(uint8_t k = 0u; k < n; k++){
+            if((g[k].ext == ext) && (g[k].value == id)){ dup = TRUE; break; }
+        }
+        if(dup) continue;
+        g[n].value = id;
+        g[n].care  = ext ? CAN_EXT_ID_MASK : CAN_STD_ID_MASK;
+        g[n].ext   = ext;
+        g[n].count = 1u;
+        n++;
+    }
+
+    while(prv_banks_needed(g, n) > maxBanks){
+        if(prv_merge_cheapest(g, &n) == FALSE){
+            return prv_accept_all(layout);          // còn 1 nhóm chuẩn + 1 mở rộng mà vẫn > maxBanks
+        }
+    }
+
+    prv_emit(layout, g, n, 0u, TRUE);
+    prv_emit(layout, g, n, 0u, FALSE);
+    prv_emit(layout, g, n, 1u, TRUE);
+    prv_emit(layout, g, n, 1u, FALSE);
+
+    uint32_t configured = 0u;
+    uint64_t std = 0u, ext = 0u;
+    for(uint8_t i = 0u; i < n; i++){
+        configured += g[i].count;
+        if(g[i].ext != 0u) ext |= (uint64_t)1u << i; else std |= (uint64_t)1u << i;
+    }
+    layout->falseAcceptIds = prv_union_size(g, std, 0u, 0u, CAN_STD_ID_BITS)
+                           + prv_union_size(g, ext, 0u, 0u, CAN_EXT_ID_BITS) - configured;
+    return E_OK;
+}
+
+boolean Can_FilterMatch(const Can_FilterLayoutType* layout, Can_IdType id, uint8_t ide, uint8_t* fifo){
+    if(layout == NULL) return FALSE;
+    const uint16_t r16 = (ide == CAN_Id_Standard) ? CAN_F16_ID(id & CAN_STD_ID_MASK)
+                                                   : (uint16_t)(((id >> 13) & 0xFFE0u) | 0x0008u | ((id >> 15) & 0x7u));
+    const uint32_t r32 = (ide == CAN_Id_Standard) ? ((id & CAN_STD_ID_MASK) << 21)
+                                                   : CAN_F32_ID(id & CAN_EXT_ID_MASK);
+
+    for(uint8_t i = 0u; i < layout->numBanks; i++){
+        const Can_FilterBankType* b = &layout->bank[i];
+        const uint32_t fr1 = ((uint32_t)b->FilterIdHigh << 16) | b->FilterIdLow;
+        const uint32_t fr2 = ((uint32_t)b->FilterMaskIdHigh << 16) | b->FilterMaskIdLow;
+        boolean hit;
+        if(b->FilterScale == CAN_FilterScale_32bit){
+            hit = (b->FilterMode == CAN_FilterMode_IdList) ? ((r32 == fr1) || (r32 == fr2))
+                                                            : (((r32 ^ fr1) & fr2) == 0u);
+        } else if(b->FilterMode == CAN_FilterMode_IdList){
+            hit = (r16 == b->FilterIdLow) || (r16 == b->FilterMaskIdLow) ||
+                  (r16 == b->FilterIdHigh) || (r16 == b->FilterMaskIdHigh);
+        } else {
+            hit = (((r16 ^ b->FilterIdLow) & b->FilterMaskIdLow) == 0u) ||
+                  (((r16 ^ b->FilterIdHigh) & b->FilterMaskIdHigh) == 0u);
+        }
+        if(hit){
+            if(fifo != NULL) *fifo = b->FilterFIFOAssignment;
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
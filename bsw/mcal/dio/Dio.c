@@ -8,7 +8,7 @@
 #include "stm32f10x.h"
 #include "stm32f10x_gpio.h"
 #include "stm32f10x_rcc.h"
-#include "DIO.h"
+#include "Dio.h"
 /***************************************************************************
  * @brief Hàm để ghi mức độ của một kênh DIO.
  * @details Hàm này nhận vào ID của kênh và mức độ cần ghi (STD_HIGH hoặc STD_LOW).
@@ -81,7 +81,7 @@ Dio_PortLevelType DIO_ReadPort(Dio_PortType PortId)
 {
     GPIO_TypeDef *GPIO_Port;
 
-    GPIO_Port = GPIO_GetPort(PortId);
+    GPIO_Port = GPIO_GetPort(DIO_CHANNEL(PortId, 0)); /* GPIO_GetPort nhận ID kênh */
     if (GPIO_Port == NULL)
     {
         return 0; // Return a default value or handle error appropriately
@@ -12,7 +12,7 @@
 
 #include "EcuM.h"
 #include "stm32f10x.h" /* Để sử dụng SystemInit() */
-#include <stdio.h>     /* Để sử dụng printf() cho mục đích log */
+#include "Log.h"       /* LOG(): log trì hoãn, đẩy ra ở Task_Idle */
     
 /**
  * @brief Biến lưu trữ trạng thái hiện tại của ECU.
@@ -31,7 +31,7 @@ static EcuM_stateType EcuM_State = ECU_STATE_UNINIT;
 void EcuM_Init(void)
 {
     EcuM_State = ECU_STATE_STARTUP_ONE;
-    printf("[EcuM] init -> StartupOne\n");
+    LOG("[EcuM] init -> StartupOne\n");
 }
 
 /**
@@ -47,11 +47,11 @@ void EcuM_Init(void)
 void EcuM_StartupTwo(void)
 {
     EcuM_State = ECU_STATE_STARTUP_TWO;
-    printf("[EcuM] StartupTwo -> Run\n");
+    LOG("[EcuM] StartupTwo -> Run\n");
 
     /* Khởi tạo clock hệ thống (PLL, HCLK, PCLKs) theo cấu hình trong system_stm32f10x.c */
     SystemInit();
 
     EcuM_State = ECU_STATE_RUN;
-    printf("[EcuM] State: Run\n");
+    LOG("[EcuM] State: Run\n");
 }
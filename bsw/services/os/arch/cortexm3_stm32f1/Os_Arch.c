@@ -86,6 +86,93 @@ void OS_Arch_SystickConfig(uint32_t hz){
 }
 
 
+/* =========================================================
+ * Tickless idle — ngủ dài bằng một lần đếm SysTick
+ *  - per_tick = số chu kỳ HCLK của một tick OS.
+ *  - remain   = phần còn lại của tick đang dở (VAL lúc dừng).
+ *  - Nạp LOAD = remain + per_tick*(ticks-1) → SysTick về 0 đúng
+ *    tại biên tick thứ 'ticks'.
+ *  - Thức do SysTick (COUNTFLAG): ISR pending sẽ báo tick cuối,
+ *    kernel bù ticks-1.
+ *  - Thức do IRQ khác: tính số biên tick đã qua từ số chu kỳ đã
+ *    đếm, nạp phần lẻ còn lại để giữ pha tick.
+ * =======================================================*/
+TickType Os_Arch_TicklessSleep(TickType ticks){
+    const uint32_t per_tick  = SystemCoreClock / OS_TICK_HZ;
+    const uint32_t max_ticks = 0x00FFFFFFu / per_tick;
+    uint32_t remain, reload, done, next;
+    TickType elapsed;
+
+    if (ticks > max_ticks)
+        {
+        ticks = max_ticks;
+        }
+    if (ticks == 0u)
+        {
+        return 0u;
+        }
+
+    /* Dừng SysTick (giữ nguồn HCLK) và đọc phần còn lại của tick hiện tại */
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk;
+    remain = SysTick->VAL;
+    if ((remain == 0u) || ((SCB->ICSR & SCB_ICSR_PENDSTSET_Msk) != 0u))
+        {
+        /* Tick đã tới/đang pending → không ngủ, để SysTick_Handler xử lý */
+        SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |
+                        SysTick_CTRL_TICKINT_Msk   |
+                        SysTick_CTRL_ENABLE_Msk;
+        return 0u;
+        }
+
+    reload = remain + per_tick * (ticks - 1u);
+    SysTick->LOAD = reload - 1u;
+    SysTick->VAL  = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |
+                    SysTick_CTRL_TICKINT_Msk   |
+                    SysTick_CTRL_ENABLE_Msk;
+
+    __DSB();
+    __WFI();
+    __ISB();
+
+    /* Đọc CTRL xoá COUNTFLAG; dừng lại để tính toán */
+    uint32_t ctrl = SysTick->CTRL;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk;
+
+    if ((ctrl & SysTick_CTRL_COUNTFLAG_Msk) != 0u)
+        {
+        /* Hết thời gian ngủ: SysTick IRQ đang pending báo tick cuối */
+        elapsed = ticks - 1u;
+        next    = per_tick;
+        }
+    else
+        {
+        /* Thức sớm do IRQ khác */
+        done = (reload - 1u) - SysTick->VAL;
+        if (done < remain)
+            {
+            elapsed = 0u;
+            next    = remain - done;
+            }
+        else
+            {
+            done   -= remain;
+            elapsed = 1u + (done / per_tick);
+            next    = per_tick - (done % per_tick);
+            }
+        }
+
+    /* Chạy tiếp phần lẻ của tick hiện tại, sau đó quay về chu kỳ 1 tick */
+    SysTick->LOAD = next - 1u;
+    SysTick->VAL  = 0u;
+    SysTick->CTRL = SysTick_CTRL_CLKSOURCE_Msk |
+                    SysTick_CTRL_TICKINT_Msk   |
+                    SysTick_CTRL_ENABLE_Msk;
+    SysTick->LOAD = per_tick - 1u; /* áp dụng từ lần nạp lại kế tiếp */
+
+    return elapsed;
+}
+
 /* =========================================================
  * 4) OS_Arch_TriggerPendSV — yêu cầu chuyển ngữ cảnh
  * =======================================================*/
@@ -109,3 +196,62 @@ void Os_Arch_TriggerPendSV(void){
 void Os_Arch_StartFirstTask(void){
     __ASM volatile("svc 0");
 }
+
+/* =========================================================
+ * 5) Os_Arch_StackInit — khung stack ban đầu của task
+ *    - Dựng khung đúng thứ tự do HW pop sau khi thoát exception
+ *      (PendSV/SVC), trả về &R4 để nạp vào TCB->sp.
+ *    - LR trỏ tới trampoline: task return → ngủ vĩnh viễn thay vì
+ *      nhảy vào EXC_RETURN ngẫu nhiên.
+ * =======================================================*/
+static void task_exit_trampoline(void)
+{
+    for (;;) {
+        __WFI(); /* ngủ vĩnh viễn */
+    }
+}
+
+uint32_t *Os_Arch_StackInit(TaskType tid, TaskEntry_t entry, uint32_t *top){
+    (void)tid;
+
+    /* 1) Căn chỉnh 8 byte: yêu cầu AAPCS + đảm bảo khi vào ISR/HW stack */
+    uint32_t *sp = (uint32_t*)((uintptr_t)top & ~((uintptr_t)0x07));
+    /* 2) ---- HW-stacked frame ----
+     *  Thứ tự "unstack" của HW khi EXC_RETURN:
+     *    R0, R1, R2, R3, R12, LR, PC, xPSR
+     *
+     *  Ta push theo thứ tự ngược lại để khi pop ra đúng:
+     *    xPSR → PC → LR → R12 → R3 → R2 → R1 → R0
+     */
+    *(--sp) = 0x01000000u;                           /* xPSR: T-bit=1 (Thumb) */
+    *(--sp) = ((uint32_t)entry) | 1u;                /* PC: địa chỉ hàm entry | 1 */
+    *(--sp) = ((uint32_t)task_exit_trampoline)|1u;   /* LR: nếu entry return → thoát */
+    *(--sp) = 0x12121212u;                           /* R12 */
+    *(--sp) = 0x03030303u;                           /* R3  */
+    *(--sp) = 0x02020202u;                           /* R2  */
+    *(--sp) = 0x01010101u;                           /* R1  */
+    *(--sp) = 0u;                                    /* R0  */
+    /* 3) ---- SW-saved frame (R4..R11) ----
+     *  Đặt ngay bên dưới HW-frame. Khi LDMIA {r4-r11}, con trỏ PSP sẽ tiến
+     *  đến &R0 (đầu HW-frame), đúng kỳ vọng của PendSV restore.
+     */
+    *(--sp) = 0x11111111u; /* R11 */
+    *(--sp) = 0x10101010u; /* R10 */
+    *(--sp) = 0x09090909u; /* R9  */
+    *(--sp) = 0x08080808u; /* R8  */
+    *(--sp) = 0x07070707u; /* R7  */
+    *(--sp) = 0x06060606u; /* R6  */
+    *(--sp) = 0x05050505u; /* R5  */
+    *(--sp) = 0x04040404u; /* R4  */
+
+    /* 4) &R4 (đầu SW-frame); sau khi restore, PSP = &R0 (đầu HW-frame) */
+    return sp;
+}
+
+/* =========================================================
+ * 6) Os_Arch_Shutdown — tắt IRQ và dừng vô hạn (ShutdownOS)
+ * =======================================================*/
+void Os_Arch_Shutdown(StatusType error){
+    (void)error;
+    __ASM volatile ("cpsid i\nb .");
+}
@@ -77,6 +77,36 @@ extern "C"
      **********************************************************/
     void Os_Arch_TriggerPendSV(void);
 
+    /**********************************************************
+     * Os_Arch_TicklessSleep
+     *  @param ticks  Số tick OS muốn ngủ (tới hạn kế tiếp của kernel)
+     *  @return       Số tick đã trôi qua mà kernel phải tự bù
+     *                (Os_Counter_Advance); tick cuối cùng, nếu SysTick
+     *                là nguồn đánh thức, vẫn do SysTick_Handler báo.
+     *  - Gọi với ngắt đã khoá (PRIMASK=1); WFI vẫn thức khi có IRQ pending.
+     *  - Tạm nạp LOAD của SysTick thành một lần đếm dài (giới hạn 24-bit:
+     *    ~233 tick @72 MHz), ngủ WFI, rồi khôi phục chu kỳ 1 tick và
+     *    giữ pha tick theo phần chu kỳ còn dở.
+     **********************************************************/
+    TickType Os_Arch_TicklessSleep(TickType ticks);
+
+    /**********************************************************
+     * Os_Arch_StackInit
+     *  @param tid    Task sở hữu stack
+     *  @param entry  Hàm thân task
+     *  @param top    Đỉnh stack (địa chỉ ngay sau word cao nhất)
+     *  @return       Giá trị nạp vào TCB->sp (&R4 của khung giả)
+     *  - Dựng khung HW (xPSR, PC=entry, LR=trampoline, ...) + SW
+     *    (R4..R11) để PendSV/SVC khởi chạy task từ entry.
+     **********************************************************/
+    uint32_t *Os_Arch_StackInit(TaskType tid, TaskEntry_t entry, uint32_t *top);
+
+    /**********************************************************
+     * Os_Arch_Shutdown
+     *  - Gọi cuối ShutdownOS(): tắt IRQ và dừng vô hạn.
+     **********************************************************/
+    void Os_Arch_Shutdown(StatusType error);
+
 #ifdef __cplusplus
 }
 #endif
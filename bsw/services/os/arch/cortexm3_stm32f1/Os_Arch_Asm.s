@@ -24,6 +24,9 @@
     .extern g_current
     .extern g_next
     .extern os_on_tick
+    .extern os_svc_prepare
+    .extern os_switch_out
+    .extern os_switch_in
 
     .global PendSV_Handler
     .global SysTick_Handler
@@ -40,6 +43,14 @@
  *     - Đặt PSP = &R0 (đầu HW-frame) của task kế tiếp.
  *     - Gán g_current = g_next; và xóa g_next = NULL.
  *  2) Nếu KHÔNG có g_next → thoát nhanh, không làm gì.
+ *  3) os_switch_out() trước khi đổi (g_current = task cũ: PostTaskHook),
+ *     os_switch_in() sau khi đổi (g_current = task mới: PreTaskHook, trace).
+ *     Hàm C giữ nguyên R4..R11 (callee-saved theo AAPCS) nên gọi được
+ *     ngay trước SAVE và ngay sau RESTORE; PUSH {r0, lr} giữ MSP 8-byte aligned.
+ *  4) Từ lần đọc g_next cuối tới khi g_current = next; g_next = NULL
+ *     chạy trong CPSID i: schedule() (SysTick/ISR) có thể hoàn lại vé
+ *     g_next và chọn task khác, nên PendSV phải nhận vé và đổi
+ *     g_current như một bước nguyên tử, không để ISR chen giữa.
  *
  * Lưu ý:
  *  - Trong Handler mode, LR giữ EXC_RETURN. BX LR sẽ kích hoạt logic
@@ -53,6 +64,14 @@ PendSV_Handler:
     LDR     r2, [r1]              /* r2 = g_next (TCB*) */
     CBZ     r2, pend_exit         /* nếu r2 == 0 → không có next, thoát handler */
 
+    PUSH    {r0, lr}              /* giữ EXC_RETURN qua lời gọi C */
+    BL      os_switch_out         /* PostTaskHook của task sắp rời CPU */
+    POP     {r0, lr}
+    CPSID   i                     /* nhận vé g_next nguyên tử với schedule() */
+    LDR     r1, =g_next           /* nạp lại: ISR có thể đã đổi g_next trong lúc gọi C */
+    LDR     r2, [r1]
+    CBZ     r2, pend_exit_irq
+
     /* [B2] Lưu ngữ cảnh task hiện hành vào PSP (nếu PSP hợp lệ) */
     MRS     r0, psp               /* r0 = PSP hiện tại (trỏ &R0 nếu chưa SAVE SW-frame) */
     CBZ     r0, pend_no_save      /* nếu PSP = 0 (chưa chạy task nào) → bỏ qua SAVE */
@@ -78,6 +97,7 @@ pend_no_save:
     STR     r2, [r3]              /* g_current = g_next */
     MOVS    r3, #0
     STR     r3, [r1]              /* g_next = NULL */
+    CPSIE   i                     /* g_current/g_next đã nhất quán → mở IRQ */
 
     /* [B4] Phục hồi SW-frame của next và cập nhật PSP:
      *  - LDMIA r0!, {r4-r11}: nạp R4..R11 từ vùng SW-frame của next,
@@ -89,12 +109,21 @@ pend_no_save:
     LDMIA   r0!, {r4-r11}         /* pop SW-frame → r0 = &R0 (đầu HW-frame) */
     MSR     psp, r0               /* PSP = &R0 của next */
 
+    PUSH    {r0, lr}
+    BL      os_switch_in          /* trace + PreTaskHook của task vừa được chạy */
+    POP     {r0, lr}
+
     /* Hàng rào bộ nhớ/điều khiển luồng để chắc chắn cập nhật PSP/ghi bộ nhớ được
      * nhìn thấy đúng trước khi rời Handler.
      */
     DSB
     ISB
 
+    B       pend_exit
+
+pend_exit_irq:
+    CPSIE   i                     /* vé đã bị hoàn lại: không đổi ngữ cảnh */
+
 pend_exit:
     /* [B5] Thoát handler.
      *  - Nếu có next: LR đang là EXC_RETURN (ví dụ 0xFFFFFFFD),
@@ -129,10 +158,12 @@ SysTick_Handler:
     BX      lr                    /* 4. Exception return. CPU đọc giá trị EXC_RETURN trong LR để quay về ngữ cảnh bị ngắt. */
 
 /* =========================================================================
- * SVC_Handler — KHỞI CHẠY TASK ĐẦU TIÊN
+ * SVC_Handler — KHỞI CHẠY TASK ĐẦU TIÊN / CHẠY LẠI TASK HIỆN HÀNH
  *
  * Mục tiêu:
- *  - Dùng khi hệ thống chưa có PSP hợp lệ (chưa chạy task nào).
+ *  - Dùng khi hệ thống chưa có PSP hợp lệ (chưa chạy task nào), hoặc khi
+ *    TerminateTask() cần chạy lại chính task hiện hành từ entry (bỏ ngữ
+ *    cảnh cũ, không lưu gì).
  *  - Lấy g_current->sp (đã được chuẩn bị sẵn ở giai đoạn "create/init task"),
  *    trong đó sp trỏ &R4 (đầu SW-frame) như quy ước.
  *  - POP SW-frame (R4..R11) để r0 → &R0 (đầu HW-frame).
@@ -142,6 +173,11 @@ SysTick_Handler:
  * ========================================================================= */
     .thumb_func
 SVC_Handler:
+    /* [C0] Cho kernel dựng lại khung stack nếu g_current cần chạy lại từ
+     *      đầu (multiple activation: TerminateTask chọn lại chính nó).
+     *      LR không cần giữ: handler thoát bằng EXC_RETURN cố định. */
+    BL    os_svc_prepare
+
     /* [C1] r0 = g_current->sp (= &R4 của task đầu tiên) */
     LDR   r0, =g_current          /* r0 = &g_current */
     LDR   r0, [r0]                /* r0 = g_current (TCB*) */
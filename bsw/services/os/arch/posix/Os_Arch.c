@@ -0,0 +1,298 @@
+/*
+ * ============================================================
+ *  OS Port Layer (host POSIX / Linux)
+ *  - Task = ucontext_t + stack host riêng (POSIX_TASK_STACK)
+ *  - PendSV  → posix_pendsv(): swapcontext giữa hai task
+ *  - SVC     → Os_Arch_StartFirstTask(): os_svc_prepare + setcontext
+ *  - SysTick → posix_tick(): os_on_tick() + Os_Posix_TickHook()
+ *  Xem Os_Arch.h về mô hình ngắt và chế độ thời gian.
+ * ============================================================
+ */
+#include "Os_Arch.h"
+#include "Os.h"
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+
+/* Stack host: printf/glibc cần nhiều hơn STACK_WORDS_* của target */
+#define POSIX_TASK_STACK       (64u * 1024u)
+/* Trần một lần ngủ tickless ở chế độ virtual (như giới hạn 24-bit SysTick) */
+#define POSIX_TICKLESS_MAX     1000u
+
+extern volatile TCB_t *g_current;
+extern volatile TCB_t *g_next;
+extern void os_on_tick(void);
+extern void os_svc_prepare(void);
+extern void os_switch_out(void);
+extern void os_switch_in(void);
+
+/* =========================================================
+ * 1) Trạng thái lõi giả lập
+ *    - irq_mask    : PRIMASK (1 tới khi task đầu tiên chạy)
+ *    - in_isr      : đang trong "handler" (tick/PendSV/SVC)
+ *    - tick_pending: số tick SysTick chưa phục vụ (handler tín
+ *                    hiệu chỉ tăng, task trừ → phép toán atomic)
+ *    - pendsv      : PENDSVSET
+ * =======================================================*/
+static ucontext_t task_ctx[OS_MAX_TASKS];
+static uint8_t task_stack[OS_MAX_TASKS][POSIX_TASK_STACK] __attribute__((aligned(16)));
+
+static volatile sig_atomic_t irq_mask = 1;
+static volatile sig_atomic_t in_isr;
+static volatile uint32_t tick_pending;
+static volatile sig_atomic_t pendsv;
+static bool started;
+
+static bool     realtime;
+static TickType sim_ticks;
+static TickType sim_limit;       /* 0 = không giới hạn */
+static uint64_t switches;
+static struct timespec wall_start;
+
+static inline bool posix_pending(void)
+{
+    return (__atomic_load_n(&tick_pending, __ATOMIC_SEQ_CST) != 0u) || (pendsv != 0);
+}
+
+__attribute__((weak)) void Os_Posix_TickHook(TickType now){ (void)now; }
+
+TickType Os_Posix_Now(void)
+{
+    return sim_ticks;
+}
+
+/* =========================================================
+ * 2) "Handler" SysTick và PendSV (gọi từ posix_dispatch)
+ * =======================================================*/
+static void posix_tick(void)
+{
+    in_isr = 1;
+    os_on_tick();
+    sim_ticks++;
+    Os_Posix_TickHook(sim_ticks);
+    in_isr = 0;
+
+    if ((sim_limit != 0u) && (sim_ticks >= sim_limit)) {
+        ShutdownOS(E_OK);
+    }
+}
+
+static void posix_pendsv(void)
+{
+    if (g_next == NULL) {
+        return;
+    }
+    in_isr = 1;
+    os_switch_out();                 /* PostTaskHook của task sắp rời CPU */
+    TCB_t *next = (TCB_t *)g_next;   /* nạp lại: hook có thể đổi g_next */
+    if (next == NULL) {
+        in_isr = 0;
+        return;
+    }
+    TCB_t *prev = (TCB_t *)g_current;
+    g_current = next;
+    g_next    = NULL;
+    os_switch_in();                  /* trace + PreTaskHook của task mới */
+    switches++;
+
+    swapcontext(&task_ctx[prev->id], &task_ctx[next->id]);
+
+    /* prev được chọn lại: tiếp tục như sau exception return */
+    in_isr = 0;
+}
+
+/* Phục vụ mọi ngắt đang pending: tick trước (ưu tiên cao hơn PendSV) */
+static void posix_dispatch(void)
+{
+    while (started && !in_isr && !irq_mask) {
+        if (__atomic_load_n(&tick_pending, __ATOMIC_SEQ_CST) != 0u) {
+            __atomic_sub_fetch(&tick_pending, 1u, __ATOMIC_SEQ_CST);
+            posix_tick();
+        } else if (pendsv) {
+            pendsv = 0;
+            posix_pendsv();
+        } else {
+            break;
+        }
+    }
+}
+
+/* =========================================================
+ * 3) PRIMASK / WFI (cmsis_gcc.h host)
+ * =======================================================*/
+void Os_Posix_DisableIrq(void)
+{
+    irq_mask = 1;
+}
+
+void Os_Posix_EnableIrq(void)
+{
+    irq_mask = 0;
+    if (!in_isr && posix_pending()) {
+        posix_dispatch();
+    }
+}
+
+static void posix_wait_tick(void)
+{
+    if (!realtime) {
+        /* Virtual: CPU rỗi → nhảy thẳng tới biên tick kế tiếp */
+        __atomic_add_fetch(&tick_pending, 1u, __ATOMIC_SEQ_CST);
+        return;
+    }
+    sigset_t blk, old;
+    sigemptyset(&blk);
+    sigaddset(&blk, SIGALRM);
+    sigprocmask(SIG_BLOCK, &blk, &old);
+    while (__atomic_load_n(&tick_pending, __ATOMIC_SEQ_CST) == 0u) {
+        sigsuspend(&old);
+    }
+    sigprocmask(SIG_SETMASK, &old, NULL);
+}
+
+void Os_Posix_Wfi(void)
+{
+    if (!started) {
+        return;
+    }
+    if (!posix_pending()) {
+        posix_wait_tick();
+    }
+    /* PRIMASK = 1: WFI vẫn thức nhưng ngắt chỉ được lấy khi mở */
+    if (!in_isr) {
+        posix_dispatch();
+    }
+}
+
+/* =========================================================
+ * 4) Khởi tạo, SysTick, tickless
+ * =======================================================*/
+static void posix_sigalrm(int sig)
+{
+    (void)sig;
+    __atomic_add_fetch(&tick_pending, 1u, __ATOMIC_SEQ_CST);
+}
+
+void Os_Arch_Init(void)
+{
+    const char *mode = getenv("VCU_SIM_TIME");
+    const char *ms   = getenv("VCU_SIM_MS");
+
+    realtime  = (mode != NULL) && (strcmp(mode, "realtime") == 0);
+    sim_limit = (ms != NULL) ?
+                (TickType)(((uint64_t)strtoul(ms, NULL, 0) * OS_TICK_HZ) / 1000u) : 0u;
+    sim_ticks = 0u;
+    switches  = 0u;
+    clock_gettime(CLOCK_MONOTONIC, &wall_start);
+
+    OS_Arch_SystickConfig(OS_TICK_HZ);
+}
+
+void OS_Arch_SystickConfig(uint32_t hz){
+    if (!realtime || (hz == 0u)) {
+        return;                      /* virtual: tick sinh từ WFI/tickless */
+    }
+    struct sigaction sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = posix_sigalrm;
+    sa.sa_flags   = SA_RESTART;      /* printf/read của task không bị EINTR */
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGALRM, &sa, NULL);
+
+    struct itimerval it;
+    it.it_interval.tv_sec  = 0;
+    it.it_interval.tv_usec = (suseconds_t)(1000000u / hz);
+    it.it_value            = it.it_interval;
+    setitimer(ITIMER_REAL, &it, NULL);
+}
+
+/* =========================================================
+ * Tickless idle (gọi với irq_mask = 1)
+ *  - virtual : bỏ qua ticks-1 tick (kernel bù), tick cuối được
+ *              đặt pending như SysTick đánh thức → trả ticks-1.
+ *  - realtime: timer vẫn chạy đều → chỉ chờ tick kế tiếp, trả 0.
+ * =======================================================*/
+TickType Os_Arch_TicklessSleep(TickType ticks){
+    if (ticks == 0u) {
+        return 0u;
+    }
+    if (realtime) {
+        posix_wait_tick();
+        return 0u;
+    }
+    if (ticks > POSIX_TICKLESS_MAX) {
+        ticks = POSIX_TICKLESS_MAX;
+    }
+    if ((sim_limit != 0u) && ((sim_limit - sim_ticks) < ticks)) {
+        ticks = sim_limit - sim_ticks;   /* dừng đúng VCU_SIM_MS */
+    }
+    sim_ticks += ticks - 1u;
+    __atomic_add_fetch(&tick_pending, 1u, __ATOMIC_SEQ_CST);
+    return ticks - 1u;
+}
+
+/* =========================================================
+ * 5) PendSV / khung task / SVC
+ * =======================================================*/
+void Os_Arch_TriggerPendSV(void){
+    pendsv = 1;
+}
+
+/* Entry chung của mọi task: g_current đã trỏ tới task này */
+static void posix_task_entry(void)
+{
+    TaskEntry_t entry = g_current->entry;
+
+    in_isr = 0;
+    Os_Posix_EnableIrq();            /* exception return: PRIMASK = 0 */
+    entry();
+    for (;;) {
+        Os_Posix_Wfi();              /* như task_exit_trampoline */
+    }
+}
+
+/* 'top' (stack kernel) chỉ để giữ TCB->sp khác NULL; task chạy trên
+ * task_stack[tid] → Os_GetStackUsage() không phản ánh stack host. */
+uint32_t *Os_Arch_StackInit(TaskType tid, TaskEntry_t entry, uint32_t *top){
+    ucontext_t *c = &task_ctx[tid];
+    (void)entry;
+
+    getcontext(c);
+    c->uc_stack.ss_sp   = task_stack[tid];
+    c->uc_stack.ss_size = sizeof(task_stack[tid]);
+    c->uc_link          = NULL;
+    sigemptyset(&c->uc_sigmask);
+    makecontext(c, posix_task_entry, 0);
+    return top;
+}
+
+void Os_Arch_StartFirstTask(void){
+    in_isr  = 1;
+    started = true;
+    os_svc_prepare();
+    setcontext(&task_ctx[g_current->id]);
+}
+
+/* =========================================================
+ * 6) Os_Arch_Shutdown — in thống kê mô phỏng rồi thoát tiến trình
+ *    (exit code = error, 0 khi hết VCU_SIM_MS)
+ * =======================================================*/
+void Os_Arch_Shutdown(StatusType error){
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    double wall = (double)(now.tv_sec - wall_start.tv_sec) +
+                  (double)(now.tv_nsec - wall_start.tv_nsec) / 1e9;
+
+    irq_mask = 1;
+    fflush(stdout);
+    fprintf(stderr, "[os-posix] shutdown(%u): %s, %lu ms simulated in %.3f s, %llu switches\n",
+            (unsigned)error, realtime ? "realtime" : "virtual",
+            (unsigned long)(((uint64_t)sim_ticks * 1000u) / OS_TICK_HZ), wall,
+            (unsigned long long)switches);
+    exit((int)error);
+}
@@ -0,0 +1,82 @@
+/**********************************************************
+ * @file    Os_Arch.h
+ * @brief   Lớp glue phụ thuộc kiến trúc cho OS (host POSIX/Linux)
+ * @details Cùng API với arch/cortexm3_stm32f1 để kernel, RTE, SWC
+ *          và COM biên dịch nguyên vẹn thành chương trình Linux
+ *          (make host):
+ *          - Mỗi task là một ucontext_t với stack host riêng;
+ *            PendSV/SVC được giả lập bằng swapcontext/setcontext.
+ *          - PRIMASK giả lập bằng cờ (Os_Posix_DisableIrq/EnableIrq,
+ *            gọi từ __disable_irq/__enable_irq của cmsis_gcc.h host).
+ *          - SysTick:
+ *              * VCU_SIM_TIME=virtual (mặc định): không có tín hiệu,
+ *                thời gian chỉ trôi khi CPU rỗi (WFI/tickless) →
+ *                chạy nhanh nhất có thể, tất định.
+ *              * VCU_SIM_TIME=realtime: SIGALRM theo OS_TICK_HZ.
+ *          - VCU_SIM_MS=<ms>: hết thời gian mô phỏng → ShutdownOS(E_OK)
+ *            → exit(0). 0/không đặt = chạy mãi.
+ *
+ *          Mô hình ngắt (1 CPU, không song song thật):
+ *            - Tick/PendSV "pending" chỉ được phục vụ tại điểm mở
+ *              ngắt (__enable_irq) hoặc WFI trong ngữ cảnh task, như
+ *              exception được lấy ngay khi PRIMASK = 0. Handler tín
+ *              hiệu chỉ tăng bộ đếm tick → không gọi kernel trong
+ *              handler bất đồng bộ.
+ *            - Task chạy vòng lặp bận không gọi API kernel sẽ không
+ *              bị preempt (khác target) — task VCU đều kết thúc bằng
+ *              TerminateTask/WaitEvent nên không bị ảnh hưởng.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#ifndef OS_ARCH_H
+#define OS_ARCH_H
+
+#include "Std_Types.h"
+#include "Os_Types.h"
+#include <stdint.h>
+#ifdef __cplusplus
+extern "C"
+{
+#endif
+
+    /**********************************************************
+     * API chung với arch Cortex-M3 (xem cortexm3_stm32f1/Os_Arch.h)
+     **********************************************************/
+    void Os_Arch_Init(void);
+    void OS_Arch_SystickConfig(uint32_t hz);
+    void Os_Arch_StartFirstTask(void);
+    void Os_Arch_TriggerPendSV(void);
+    TickType Os_Arch_TicklessSleep(TickType ticks);
+    uint32_t *Os_Arch_StackInit(TaskType tid, TaskEntry_t entry, uint32_t *top);
+    void Os_Arch_Shutdown(StatusType error);
+
+    /**********************************************************
+     * Giả lập lõi (cmsis_gcc.h host gọi tới)
+     *  - DisableIrq/EnableIrq: PRIMASK; mở ngắt ngoài ISR → phục vụ
+     *    tick và PendSV đang pending.
+     *  - Wfi: chờ tick kế tiếp (realtime) hoặc nhảy tới nó (virtual).
+     **********************************************************/
+    void Os_Posix_DisableIrq(void);
+    void Os_Posix_EnableIrq(void);
+    void Os_Posix_Wfi(void);
+
+    /**********************************************************
+     * Os_Posix_TickHook (weak, mặc định rỗng)
+     *  @param now  Số tick đã mô phỏng kể từ StartOS
+     *  - Gọi trong "ISR" tick, sau os_on_tick(). Mô phỏng phần
+     *    cứng (platform/posix) cập nhật kích thích đầu vào tại đây.
+     *    Tick bị gộp bởi tickless không gọi hook → tính kích thích
+     *    theo 'now', không cộng dồn theo số lần gọi.
+     **********************************************************/
+    void Os_Posix_TickHook(TickType now);
+
+    /* Số tick đã mô phỏng kể từ StartOS (kể cả tick bù tickless) */
+    TickType Os_Posix_Now(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OS_ARCH_H */
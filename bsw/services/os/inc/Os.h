@@ -12,10 +12,13 @@
  *            3) Event    : WaitEvent, SetEvent, GetEvent, ClearEvent (Extended Task)
  *            4) Alarm    : SetRelAlarm/CancelAlarm (ms)
  *            5) Counter  : OS_TickCount()
- *            6) IOC demo : hàng đợi byte vòng (SR queued tối giản)
- *            7) Resource : mutex đơn giản (không có ceiling protocol)
+ *            6) IOC      : kênh có kiểu 1:N, unqueued/queued, zero-copy
+ *            7) Resource : OSEK priority ceiling (lồng nhau LIFO, RES_SCHEDULER)
  *            8) Schedule : ScheduleTable “lite”
  *            9) Arch     : glue phụ thuộc kiến trúc (SysTick/PendSV/bootstrap)
+ *           10) Stack    : high-water mark stack (Os_GetStackUsage)
+ *           11) Idle     : tickless idle (Os_IdleSleep)
+ *           12) Trace    : thời gian thực thi/đáp ứng/trễ của task, CPU load
  *
  * @version  1.0
  * @date     2025-09-10
@@ -76,11 +79,27 @@ extern "C"
      *
      * @details
      *  - Nếu Task đang SUSPENDED → chuyển về READY, gán entry/stack/priority.
-     *  - Nếu đã RUNNING/READY và không cấu hình multi-activation → E_OS_LIMIT.
+     *  - Nếu đã RUNNING/READY/WAITING: ghi nhận thêm một lần kích (tối đa
+     *    OsTaskActivation); task chạy lại từ đầu sau TerminateTask().
+     *  - Vượt giới hạn → E_OS_LIMIT, tăng bộ đếm overrun của task.
      *  - Có thể được gọi từ TASK hoặc ISR (Cat2) tùy hiện thực.
      */
     StatusType ActivateTask(TaskType tid);
 
+    /**
+     * @brief  Số lần ActivateTask() của task bị từ chối (E_OS_LIMIT).
+     * @param  tid  ID Task
+     * @return Bộ đếm overrun (bão hoà 0xFFFF); 0 nếu tid không hợp lệ.
+     */
+    uint16_t Os_GetActivationOverrun(TaskType tid);
+
+    /**
+     * @brief  Lấy ID của task đang chạy.
+     * @param  tid  [out] ID task, INVALID_TASK nếu chưa có task nào
+     * @return E_OK | E_OS_ID (tid NULL)
+     */
+    StatusType GetTaskID(TaskRefType tid);
+
     /* Prototype task */
 extern void Task_Init(void);
 extern void Task_A(void);
@@ -88,7 +107,8 @@ extern void Task_B(void);
 extern void Task_Idle(void);
     /**
      * @brief  Kết thúc Task hiện tại.
-     * @return E_OK | E_OS_STATE (nếu gọi khi không ở RUNNING)
+     * @return E_OS_RESOURCE nếu còn giữ resource (task tiếp tục chạy);
+     *         thành công thì không quay lại.
      *
      * @details
      *  - Chuyển Task về SUSPENDED (Basic) hoặc READY (nếu cấu hình khác).
@@ -103,7 +123,9 @@ extern void Task_Idle(void);
     /**
      * @brief  Treo Task hiện tại một khoảng thời gian (ms).
      * @param  ms  Thời gian trì hoãn (mili-giây)
-     * @note   Chỉ gọi ở ngữ cảnh TASK; không gọi từ ISR. Task chuyển sang WAITING.
+     * @note   Chỉ gọi ở ngữ cảnh TASK; không gọi từ ISR. Task chuyển sang WAITING
+     *         và nằm trong hàng đợi timeout của kernel tới khi hết hạn.
+     *         Bị bỏ qua nếu task đang giữ resource.
      */
     void OS_Delay(uint32_t ms);
     /* =========================================================
@@ -112,13 +134,24 @@ extern void Task_Idle(void);
     /**
      * @brief  Chờ tới khi bất kỳ bit trong mask được set.
      * @param  mask  Mặt nạ event mong đợi
-     * @return E_OK | E_OS_STATE | E_OS_TIMEOUT (nếu có cơ chế timeout đi kèm)
+     * @return E_OK | E_OS_STATE | E_OS_RESOURCE
      *
      * @details
      *  - Chỉ dùng cho Extended Task.
      *  - Không gọi từ ISR. Task chuyển sang WAITING cho tới khi (events & m) != 0.
      */
     StatusType WaitEvent(EventMaskType mask);
+    /**
+     * @brief  Chờ tới khi bất kỳ bit trong mask được set, tối đa 'ticks' tick.
+     * @param  mask   Mặt nạ event mong đợi
+     * @param  ticks  Thời gian chờ tối đa (tick OS); 0 = chỉ kiểm tra
+     * @return E_OK | E_OS_STATE | E_OS_RESOURCE | E_OS_TIMEOUT
+     *
+     * @details
+     *  - Chỉ dùng cho Extended Task, không gọi từ ISR.
+     *  - Hết hạn mà chưa có event → task READY lại và nhận E_OS_TIMEOUT.
+     */
+    StatusType WaitEventTimeout(EventMaskType mask, TickType ticks);
     /**
      * @brief  Set event cho Task t và đánh thức nếu Task đang WaitEvent().
      * @param  tid  Task ID
@@ -198,6 +231,12 @@ extern void Task_Idle(void);
      * @details Đọc và trả về giá trị hiện tại của counter được chỉ định.
      */
     StatusType GetCounterValue(CounterTypeId cid, TickRefType value);
+
+    /**
+     * @brief  Số tick kernel (SysTick, 1 ms) kể từ StartOS, không wrap theo counter.
+     * @note   Đã gồm số tick bù sau tickless idle; dùng làm mốc thời gian (Log).
+     */
+    TickType OS_TickCount(void);
     /* =========================================================
      * 6) SCHEDULE TABLE API
      * =======================================================*/
@@ -234,37 +273,85 @@ extern void Task_Idle(void);
 
     /* =========================================================
      * 7) IOC API
+     *    - Kênh 1 sender → N receiver, payload là struct bất kỳ.
+     *    - Unqueued (last-is-best): Write ghi đè, Read luôn lấy bản
+     *      mới nhất; depth >= 2 slot, reader kiểm tra seq trước/sau
+     *      khi copy → không khoá, không chờ.
+     *    - Queued (FIFO): mỗi receiver một chỉ số đọc riêng; Send
+     *      trả IOC_E_LIMIT khi receiver chậm nhất đã đầy.
+     *    - Zero-copy: sender ghi thẳng vào slot (WriteBegin/Commit);
+     *      receiver queued đọc thẳng từ slot (ReceivePeek/Release).
+     *    - Không API nào chờ: receiver muốn ngủ thì WaitEvent(ev) của
+     *      kênh rồi đọc tới khi IOC_E_NO_DATA.
+     *    - Ứng dụng dùng các hàm có kiểu IocWrite_<Name>/IocRead_<Name>
+     *      (unqueued), IocSend_<Name>/IocReceive_<Name> (queued) sinh
+     *      từ Os_Ioc_Cfg.h; các hàm dưới đây là lõi không kiểu.
      * =======================================================*/
     /**
-     * @brief Gửi dữ liệu qua một kênh giao tiếp liên tác vụ (IOC).
-     * @param ch Kênh IOC.
-     * @param data Con trỏ tới dữ liệu cần gửi.
-     * @return E_OK nếu thành công.
+     * @brief  Đưa mọi kênh về rỗng (gọi một lần trong StartOS).
      */
-    uint8_t Ioc_Send(uint8_t ch, uint16_t *data);
+    void Ioc_Init(void);
 
     /**
-     * @brief Nhận dữ liệu từ một kênh IOC cho một task cụ thể.
-     * @param ch Kênh IOC.
-     * @param data Con trỏ để nhận dữ liệu.
-     * @param receiver ID của Task nhận.
-     * @return E_OK nếu có dữ liệu mới và nhận thành công.
+     * @brief  Lấy slot để ghi trực tiếp (zero-copy).
+     * @return Con trỏ slot; NULL nếu kênh sai hoặc (queued) đầy
+     * @note   Chỉ một sender cho mỗi kênh; phải gọi Ioc_WriteCommit sau đó.
      */
-    uint8_t Ioc_Receive(uint8_t ch, uint16_t *data, TaskType receiver);
-    
-    /*******************************************************************
-     * @brief  Khởi tạo một kênh giao tiếp liên tác vụ (IOC).
-     * @param  channel   ID của kênh IOC cần khởi tạo (xem Ioc_Channels trong Os_Cfg.h).
-     * @param  num       Số lượng Task sẽ nhận dữ liệu trên kênh này.
-     * @param  receivers Con trỏ tới một mảng chứa ID của các Task nhận.
-     * @details
-     *  Hàm này thiết lập và chuẩn bị một kênh IOC để sẵn sàng cho việc gửi và nhận dữ liệu.
-     *  Nó thực hiện các công việc sau:
-     
-     * @note   Hàm này không có cơ chế bảo vệ (vùng găng) và nên được gọi một lần duy nhất
-     *         trong quá trình khởi tạo hệ thống (ví dụ: trong Task_Init) trước khi các Task khác bắt đầu gửi/nhận.
-     *****************************************************************/
-    void Ioc_Init(uint8_t channel, uint8_t num, TaskType* receivers);
+    void *Ioc_WriteBegin(IocChannelType ch);
+
+    /**
+     * @brief  Công bố slot vừa ghi và SetEvent các receiver.
+     */
+    Std_ReturnType Ioc_WriteCommit(IocChannelType ch);
+
+    /**
+     * @brief  Copy data (elem_size byte) vào kênh = Begin + memcpy + Commit.
+     * @return IOC_E_OK, IOC_E_LIMIT (queued đầy), IOC_E_NOK
+     */
+    Std_ReturnType Ioc_Write(IocChannelType ch, const void *data);
+
+    /**
+     * @brief  Đọc không chặn.
+     * @param  rx   Chỉ số receiver trong kênh (bỏ qua với unqueued)
+     * @return IOC_E_OK, IOC_E_LOST_DATA, IOC_E_NO_DATA, IOC_E_NOK
+     */
+    Std_ReturnType Ioc_Read(IocChannelType ch, uint8_t rx, void *data);
+
+    /**
+     * @brief  (queued) Con trỏ tới bản tin kế tiếp của receiver, không copy.
+     * @return NULL nếu rỗng; slot giữ nguyên tới Ioc_ReceiveRelease
+     */
+    const void *Ioc_ReceivePeek(IocChannelType ch, uint8_t rx);
+
+    /**
+     * @brief  (queued) Trả slot đã Peek, chuyển sang bản tin kế tiếp.
+     */
+    Std_ReturnType Ioc_ReceiveRelease(IocChannelType ch, uint8_t rx);
+
+    /* ---- Sinh hàm có kiểu cho từng kênh (dùng trong Os_Ioc_Cfg.h) ---- */
+#define OS_IOC_API_UNQUEUED(name, type)                                        \
+    static inline Std_ReturnType IocWrite_##name(const type *d)                \
+    { return Ioc_Write(IOC_CH_##name, d); }                                    \
+    static inline type *IocWriteBegin_##name(void)                             \
+    { return (type *)Ioc_WriteBegin(IOC_CH_##name); }                          \
+    static inline Std_ReturnType IocWriteCommit_##name(void)                   \
+    { return Ioc_WriteCommit(IOC_CH_##name); }                                 \
+    static inline Std_ReturnType IocRead_##name(type *d)                       \
+    { return Ioc_Read(IOC_CH_##name, 0u, d); }
+
+#define OS_IOC_API_QUEUED(name, type)                                          \
+    static inline Std_ReturnType IocSend_##name(const type *d)                 \
+    { return Ioc_Write(IOC_CH_##name, d); }                                    \
+    static inline type *IocSendBegin_##name(void)                              \
+    { return (type *)Ioc_WriteBegin(IOC_CH_##name); }                          \
+    static inline Std_ReturnType IocSendCommit_##name(void)                    \
+    { return Ioc_WriteCommit(IOC_CH_##name); }                                 \
+    static inline Std_ReturnType IocReceive_##name(uint8_t rx, type *d)        \
+    { return Ioc_Read(IOC_CH_##name, rx, d); }                                 \
+    static inline const type *IocReceivePeek_##name(uint8_t rx)                \
+    { return (const type *)Ioc_ReceivePeek(IOC_CH_##name, rx); }               \
+    static inline Std_ReturnType IocReceiveRelease_##name(uint8_t rx)          \
+    { return Ioc_ReceiveRelease(IOC_CH_##name, rx); }
 
     /* =========================================================
      * 8) HOOK API
@@ -316,25 +403,104 @@ extern void Task_Idle(void);
      */
     void PostTaskHook(void);
 
+    /**
+     * @brief Hook được gọi khi một alarm tới hạn, ngay trước hành động của nó.
+     * @param alarm ID alarm vừa tới hạn.
+     * @details Chạy trong ngữ cảnh SysTick (os_alarm_tick), đúng nhịp nhả task
+     *          của alarm, ngoài vùng găng của heap alarm.
+     * @note Dùng để khoá pha phần cứng theo lịch task (ví dụ timer kích ADC
+     *       theo nhịp nhả Task_A). Phải ngắn và không chặn.
+     */
+    void AlarmExpiryHook(AlarmType alarm);
+
     /* =========================================================
      * 9) Resource API
      * =======================================================*/
+    /**
+     * @brief  Pseudo-resource có ceiling cao nhất (OSEK RES_SCHEDULER).
+     * @note   Task giữ RES_SCHEDULER không bị task nào khác preempt (ISR vẫn chạy).
+     */
+    extern OsResource Os_ResScheduler;
+#define RES_SCHEDULER (&Os_ResScheduler)
+
+    /**
+     * @brief  Đưa resource về trạng thái rỗi (giữ nguyên ceilingPrio đã cấu hình).
+     * @param  r  Con trỏ tới khối điều khiển của resource.
+     */
+    void Resource_Init(OsResource *r);
+
     /****************************************************************************************
      * @brief Yêu cầu và khóa một resource để bảo vệ vùng tranh chấp.
      * @param r Con trỏ tới khối điều khiển của resource.
-     * @details Cơ chế này đảm bảo quyền truy cập độc quyền vào dữ liệu chia sẻ giữa các task.
-     *          Tùy thuộc vào cấu hình, nó có thể được hiện thực bằng cách vô hiệu hóa ngắt
-     *          hoặc sử dụng thuật toán ưu tiên như Priority Ceiling Protocol (PCP).
+     * @return E_OK | E_OS_ID | E_OS_ACCESS | E_OS_LIMIT
+     * @details Immediate Priority Ceiling Protocol (OSEK): prio của task được nâng ngay lên
+     *          ceilingPrio của resource, nên không task nào khác dùng resource có thể chạy
+     *          cho tới khi nhả → không chờ, không đảo ưu tiên, không deadlock.
+     *          Có thể lồng nhau; phải nhả theo thứ tự ngược lại (LIFO).
      *****************************************************************************************/
-    void GetResource(OsResource *r);
+    StatusType GetResource(OsResource *r);
 
     /**
      * @brief Mở khóa và giải phóng một resource đã được lấy trước đó.
      * @param r Con trỏ tới khối điều khiển của resource.
-     * @details Phải được gọi bởi chính task đã lấy resource để các task khác có thể tiếp tục
-     *          sử dụng.
+     * @return E_OK | E_OS_ID | E_OS_NOFUNC
+     * @details Phải được gọi bởi chính task đã lấy resource, đúng thứ tự LIFO. Prio của task
+     *          được khôi phục và scheduler chạy ngay (task READY prio cao hơn được preempt).
      */
-    void ReleaseResource(OsResource *r);
+    StatusType ReleaseResource(OsResource *r);
+
+    /* =========================================================
+     * 10) STACK API
+     * =======================================================*/
+    /**
+     * @brief  Lượng stack lớn nhất task đã dùng kể từ StartOS (high-water mark).
+     * @param  tid  Task ID
+     * @return Số byte đã dùng (0 nếu tid không hợp lệ)
+     * @note   Dựa trên tô stack (OS_STACK_PAINT) ở StartOS; dùng để chỉnh
+     *         STACK_WORDS_* trong Os_Cfg.h.
+     */
+    uint32_t Os_GetStackUsage(TaskType tid);
+
+    /* =========================================================
+     * 11) IDLE API
+     * =======================================================*/
+    /**
+     * @brief  Ngủ tiết kiệm năng lượng trong Task_Idle (tickless).
+     * @details
+     *  - OS_TICKLESS_IDLE = 1: tính lần tới hạn kế tiếp (alarm, schedule table, task ngủ),
+     *    tắt tick định kỳ và ngủ tới đúng thời điểm đó; khi thức, bù số tick
+     *    đã bỏ qua vào counter rồi mới xử lý ngắt đánh thức.
+     *  - OS_TICKLESS_IDLE = 0: tương đương __WFI().
+     * @note   Chỉ gọi từ Task_Idle.
+     */
+    void Os_IdleSleep(void);
+
+    /* =========================================================
+     * 12) TRACE API (OS_TRACE_ENABLE = 1)
+     *    - Thời gian tính bằng chu kỳ CYCCNT; đổi sang µs bằng
+     *      cycles / (SystemCoreClock / 1000000).
+     * =======================================================*/
+    /**
+     * @brief  Lấy thống kê thời gian của một task.
+     * @param  tid  Task ID
+     * @param  out  Bản sao thống kê (exec min/max/sum/count, resp_max, lat_max)
+     * @return E_OK; E_OS_ID nếu tid sai hoặc out == NULL
+     */
+    StatusType Os_Trace_GetTaskTiming(TaskType tid, Os_TaskTimingType *out);
+
+    /**
+     * @brief  CPU load của cửa sổ OS_TRACE_LOAD_WINDOW_MS gần nhất.
+     * @return Phần nghìn (0..1000) = 1000 - thời gian Task_Idle / cửa sổ
+     */
+    uint16_t Os_Trace_GetCpuLoad(void);
+
+    /**
+     * @brief  Xoá thống kê và ring buffer (giữ CYCCNT chạy).
+     */
+    void Os_Trace_Reset(void);
+
+    /* Ring buffer bản ghi đổi ngữ cảnh (đọc không khoá: head rồi các slot) */
+    extern Os_TraceBufType Os_TraceBuf;
 
     StatusType Os_ConnectAlarm(AlarmType alarm, void (*cb)(void));
     StatusType Os_DisconnectAlarm(AlarmType alarm);
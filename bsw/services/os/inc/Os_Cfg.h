@@ -5,30 +5,43 @@
 #include "Std_Types.h"
 
 #define MAX_EXPIRY_POINTS       3
-#define IOC_BUFFER_SIZE         4
-#define MAX_IOC_CHANNELS        1
 
 #define MAX_RESOURCES           4
 
 #define OS_10MS_TICKS           10u
 #define OS_TICK_HZ              1000u   /* 1ms */
 
-#define OS_MAX_TASKS            5u      /* Init, A, B, Idle */
-#define OS_MAX_ALARMS           3u      /* AlarmA, AlarmB   */
+#define OS_MAX_TASKS            6u      /* Init, A, B, C, Com, Idle */
+#define OS_PRIO_LEVELS          32u     /* Số mức ưu tiên (bitmap 2 mức, tối đa 256) */
+#define OS_MAX_ALARMS           4u      /* AlarmA, AlarmB, AlarmRte, AlarmCom */
 #define OS_MAX_COUNTERS         2u
 #define OS_MAX_SchedTbl         2u
-/* Stack size (word = 4 byte) */
+/* Tickless idle: 1 = Task_Idle tắt SysTick định kỳ tới lần tới hạn kế tiếp */
+#define OS_TICKLESS_IDLE        1u
+#define OS_TICKLESS_MIN_TICKS   2u      /* Ngủ ngắn hơn mức này → chỉ WFI */
+/* Stack size (word = 4 byte) — mỗi task một mảng riêng (Os_Task.c) */
 #define STACK_WORDS_INIT        256u
 #define STACK_WORDS_A           256u
 #define STACK_WORDS_B           256u
 #define STACK_WORDS_C           256U
+#define STACK_WORDS_COM         256u
 #define STACK_WORDS_IDLE        128u
+/* 1 = kiểm tra guard word ở đáy stack mỗi lần đổi ngữ cảnh */
+#define OS_STACK_CHECK          1u
+/* Đo thời gian task bằng DWT CYCCNT (Os_Trace.c): 1 = bật
+ * (bản host/POSIX không có DWT: Makefile truyền -DOS_TRACE_ENABLE=0u) */
+#ifndef OS_TRACE_ENABLE
+#define OS_TRACE_ENABLE         1u
+#endif
+#define OS_TRACE_RING_SIZE      128u    /* số bản ghi, lũy thừa của 2 (8 byte/bản ghi) */
+#define OS_TRACE_LOAD_WINDOW_MS 1000u   /* cửa sổ tính CPU load */
 /* ID Task */
 typedef enum {
     TASK_INIT = 0,
     TASK_A,
     TASK_B,
     TASK_C,
+    TASK_COM,
     TASK_IDLE,
     TASK_COUNT /* = OS_MAX_TASKS */
 } TaskId_e;
@@ -37,24 +50,25 @@ typedef enum {
 typedef enum {
     ALARM_A = 0,
     ALARM_B,
+    ALARM_RTE,      /* nhịp timeout của RTE hướng sự kiện (cfg/rte/Rte_Cfg.h) */
+    ALARM_COM,      /* nhịp Com_MainFunctionRx/Tx (COM_MAINFUNCTION_PERIOD_MS) */
     Alarm_Count
 } AlarmId_e;
 
-typedef enum{
-    Ioc_CH_1,
-    Ioc_CH_COUNT
-}Ioc_Channels;
-
-
+/* Kênh IOC: xem OS_IOC_CHANNEL_LIST trong cfg/os/Os_Ioc_Cfg.h */
 
 /**********************************************************
  * 2) EVENT MASKS cho Extended Task
- *    Dùng bởi Task_Com:
+ *    Dự phòng (Task_Com hiện là Basic Task, không chờ event):
  *      - EV_RX : có dữ liệu nhận cần xử lý
  *      - EV_TX : có yêu cầu truyền cần xử lý
+ *    Dùng bởi task RTE (RTE_EVENT_TASK):
+ *      - EV_RTE_TIMING : nhịp đếm timeout runnable (ALARM_RTE)
+ *      - bit 8..       : DataReceivedEvent (RTE_EV_RUNNABLE)
  **********************************************************/
 #define EV_RX   ((EventMaskType)0x0001u)
 #define EV_TX   ((EventMaskType)0x0002u)
+#define EV_RTE_TIMING   ((EventMaskType)0x0004u)
 
 /**********************************************************
  * 5) PROTOTYPES TASK (cho trình biên dịch biết sớm)
@@ -66,6 +80,7 @@ DECLARE_TASK(Task_Init);
 DECLARE_TASK(Task_A);
 DECLARE_TASK(Task_B);
 DECLARE_TASK(Task_C);
+DECLARE_TASK(Task_Com);
 DECLARE_TASK(Task_Idle);
 
 
@@ -48,6 +48,8 @@ extern "C"
      * Gtái trị counter sẽ được trả về.
      */
     typedef TickType *TickRefType;
+    typedef TaskType *TaskRefType;
+#define INVALID_TASK ((TaskType)0xFFu)
 
     /*
      * Chế độ mà khởi tạo OS
@@ -62,6 +64,9 @@ extern "C"
  *    - E_OS_STATE   : không hợp lệ ở trạng thái hiện tại.
  *    - E_OS_LIMIT   : vượt giới hạn cấu hình/tài nguyên (vd: re-activate không cho phép).
  *    - E_OS_TIMEOUT : hết thời gian chờ (WaitEvent/Delay có timeout).
+ *    - E_OS_ACCESS  : không có quyền (vd: prio task > ceiling của resource).
+ *    - E_OS_RESOURCE: task còn giữ resource khi Terminate/WaitEvent/Delay.
+ *    - E_OS_STACKFAULT: guard word ở đáy stack của task bị ghi đè.
  *
  *  Lưu ý:
  *    - E_OK có thể đã được định nghĩa trong Std_Types.h (Std_ReturnType).
@@ -76,6 +81,9 @@ extern "C"
 #define E_OS_TIMEOUT ((StatusType)4u)
 #define E_OS_NOFUNC ((StatusType)5u)
 #define E_OS_VALUE ((StatusType)6u)
+#define E_OS_ACCESS ((StatusType)7u)
+#define E_OS_RESOURCE ((StatusType)8u)
+#define E_OS_STACKFAULT ((StatusType)9u)
 
     /* =========================================================
      * 3) Trạng thái của Task
@@ -133,15 +141,19 @@ extern "C"
      *    - waitMask     : mặt nạ Event Task đang chờ trong WaitEvent().
      *    - state        : trạng thái hiện tại của Task.
      *    - isExtended   : 1 = Extended Task (hỗ trợ Event), 0 = Basic Task.
-     *    - prio         : ưu tiên (0..31) — số lớn hơn = ưu tiên cao hơn.
-     *    - delay        : ms còn chờ (OS_Delay hoặc timeout WaitEvent).
+     *    - ActivationCount/OsTaskActivation : số lần kích đang chờ / giới hạn
+     *                     (multiple activation, Basic Task nên > 1 nếu cần).
+     *    - OverrunCount : số lần kích bị từ chối vì vượt giới hạn.
+     *    - prio         : ưu tiên (0..OS_PRIO_LEVELS-1) — số lớn hơn = ưu tiên cao hơn.
+     *    - wake_tick    : tick thức (OS_Delay hoặc timeout WaitEventTimeout).
+     *    - timed_out    : 1 = lần chờ gần nhất kết thúc do hết hạn.
      *    - entry        : con trỏ hàm thân Task.
      *    - name         : tên phục vụ log/trace.
      *
      *  Gợi ý hiện thực trên Cortex-M3:
      *    - sp/stack_bottom nên căn 8-byte (AAPCS) để tránh HardFault.
-     *    - `prio` có thể ánh xạ trực tiếp vào bitmap scheduler (0..31).
-     *    - `delay` giảm theo tick SysTick 1ms.
+     *    - `prio` ánh xạ trực tiếp vào bitmap ready của scheduler (Os_Task.c).
+     *    - `wake_tick` là khoá của hàng đợi timeout (Os_Task.c), so với tick kernel.
      * =======================================================*/
     typedef struct
     {
@@ -151,11 +163,15 @@ extern "C"
         EventMaskType SetEvent;     /* Event mask (Extended Task).                  */
         EventMaskType WaitEvent;   /* Mặt nạ Event đang chờ trong WaitEvent().      */
         OsTaskState state;        /* Trạng thái hiện tại của Task.                  */
-        uint8_t ActivationCount;  /* Đếm số lần đã active                           */
+        uint8_t ActivationCount;  /* Số lần kích đang ghi nhận (kể cả lần đang chạy) */
         uint8_t OsTaskActivation; /* Giới hạn số lần activate                       */
-        uint8_t prio;             /* Ưu tiên (0..31), 0 = thấp nhất.                */
+        uint8_t restart;          /* 1 = lần chạy kế tiếp bắt đầu lại từ entry      */
+        uint16_t OverrunCount;    /* Số lần ActivateTask() bị E_OS_LIMIT            */
+        uint8_t prio;             /* Ưu tiên (0..OS_PRIO_LEVELS-1), 0 = thấp nhất.  */
         uint8_t base_prio;        /* Priority gốc                                   */
         uint8_t isExtended;       /* Khai báo Task là basic hay Extended Task       */
+        uint8_t timed_out;        /* 1 = bị đánh thức do hết thời gian chờ          */
+        TickType wake_tick;       /* Tick thức khi nằm trong hàng đợi timeout       */
         TaskEntry_t entry;        /* Hàm thân Task (void TaskX(void)).              */
         const char *name;         /* Tên Task cho mục đích log/trace.               */
     } TCB_t;
@@ -166,6 +182,8 @@ extern "C"
      *  - max_allowed_Value : giá trị tối đa (giới hạn tràn).
      *  - ticks_per_base    : số tick tương ứng 1 đơn vị base (thường là 1).
      *  - min_cycles        : chu kỳ tối thiểu (đơn vị base) cho alarm.
+     *  - ticks_total       : số lần tăng kể từ StartOS (không wrap theo max),
+     *                        làm khoá thời gian tuyệt đối cho heap alarm.
      *
      * Gợi ý:
      *  - Với SysTick 1ms, thường có: ticks_per_base = 1, min_cycles = 1.
@@ -176,13 +194,14 @@ extern "C"
         TickType max_allowed_Value;
         TickType ticks_per_base;
         uint8_t min_cycles;
+        TickType ticks_total;
     } OsCounterCtl;
 
         /* =========================================================
      * CẤU TRÚC ĐIỀU KHIỂN ALARM
      *  - active : 1=đang hoạt động; 0=đã hủy/one-shot đã bắn xong
-     *  - Expiry-tick : thời điểm tới hạn 
-     *  - cycle  : chu kỳ (ms); 0 = one-shot
+     *  - Expiry-tick : thời điểm tới hạn (theo ticks_total của counter)
+     *  - cycle  : chu kỳ (tick); 0 = one-shot
      *  - id     : Alarm ID (để switch/map sang Task tương ứng)
      *  - counter: con trỏ đến counter điều khiển alarm
      *  - action_type : kiểu hành động khi tới hạn
@@ -248,27 +267,116 @@ extern "C"
     } OsSchedCtl;
     /* ========================================================
      * Cấu trúc cho Resource
-
+     *  - ceilingPrio : cấu hình tĩnh = prio cao nhất của các task dùng resource
+     *  - prev_prio   : prio của owner trước GetResource (khôi phục khi nhả)
      *=========================================================*/
     typedef struct
     {
         volatile uint8_t locked;            // Resource locked?
         uint8_t ceilingPrio; // Ceiling Priority (PCP)
         TaskType owner;      // Task đang giữ resource (INVALID_TASK nếu rảnh)
+        uint8_t prev_prio;   // Prio của owner trước khi lấy resource
     } OsResource;
     /* ========================================================
-     * Cấu hình cho kênh IOC
+     * IOC — kênh truyền dữ liệu có kiểu giữa Task/ISR (Os_Ioc.c)
+     *  - Mã trả về theo AUTOSAR IOC (Std_ReturnType):
+     *      IOC_E_OK        : thành công
+     *      IOC_E_NOK       : tham số/kênh sai
+     *      IOC_E_LOST_DATA : (queued) có bản tin bị bỏ vì receiver đầy;
+     *                        dữ liệu trả về vẫn hợp lệ
+     *      IOC_E_LIMIT     : (queued) hàng đợi của một receiver đã đầy
+     *      IOC_E_NO_DATA   : chưa có dữ liệu / hàng đợi rỗng
+     *  - Os_IocRxType: trạng thái riêng của một receiver (queued)
+     *      + rd         : chỉ số bản tin kế tiếp cần đọc (chỉ receiver ghi)
+     *      + drops      : số lần Send bị từ chối (có receiver đầy, bản
+     *                     tin không tới receiver này) (chỉ sender ghi)
+     *      + drops_seen : drops đã báo cho receiver (chỉ receiver ghi)
+     *  - Os_IocChannelCfgType: mô tả tĩnh một kênh, sinh bởi
+     *    OS_IOC_CHANNEL_LIST trong Os_Ioc_Cfg.h
+     *      + data       : depth slot, mỗi slot elem_size byte
+     *      + seq        : số thứ tự bản ghi của từng slot (0 = đang ghi)
+     *      + wr         : tổng số bản tin đã công bố (chỉ sender ghi)
+     *      + receivers  : task nhận (SetEvent ev sau mỗi lần ghi, ev != 0)
+     *=========================================================*/
+    typedef uint8_t IocChannelType;
+
+#define IOC_E_OK        ((Std_ReturnType)0u)
+#define IOC_E_NOK       ((Std_ReturnType)1u)
+#define IOC_E_LOST_DATA ((Std_ReturnType)64u)
+#define IOC_E_LIMIT     ((Std_ReturnType)130u)
+#define IOC_E_NO_DATA   ((Std_ReturnType)131u)
+
+    typedef struct
+    {
+        volatile uint32_t rd;
+        volatile uint16_t drops;
+        uint16_t          drops_seen;
+    } Os_IocRxType;
 
+    typedef struct
+    {
+        uint8_t           *data;
+        volatile uint32_t *seq;
+        volatile uint32_t *wr;
+        Os_IocRxType      *rx;
+        const TaskType    *receivers;
+        EventMaskType      ev;
+        uint16_t           elem_size;
+        uint8_t            depth;
+        uint8_t            num_receivers;
+        uint8_t            queued;      /* 0 = last-is-best, 1 = FIFO */
+    } Os_IocChannelCfgType;
+    /* ========================================================
+     * Đo thời gian task (OS_TRACE_ENABLE = 1, Os_Trace.c)
+     *  - Mọi mốc thời gian tính bằng chu kỳ DWT CYCCNT (HCLK).
+     *  - Os_TraceRecType : một bản ghi trong ring buffer (8 byte).
+     *      + ts   : CYCCNT lúc xảy ra sự kiện
+     *      + type : OS_TRACE_EV_*
+     *      + tid  : task liên quan (task được chạy với SWITCH)
+     *      + arg  : SWITCH → task vừa rời CPU; ACTIVATE → ActivationCount
+     *  - Os_TraceBufType : header cố định + ring, debugger dump nguyên
+     *    khối (symbol Os_TraceBuf) cho debug/os_trace_decode.py.
+     *      + head : tổng số bản ghi đã ghi (slot = head % size)
+     *  - Os_TaskTimingType: thống kê một task (chu kỳ)
+     *      + exec_*   : thời gian CPU thực sự của một lần chạy
+     *                   (Activate → Terminate, trừ thời gian bị preempt/chờ)
+     *      + resp_max : thời gian đáp ứng lớn nhất (Activate → Terminate)
+     *      + lat_max  : trễ lớn nhất từ Activate tới lần đầu được chạy
      *=========================================================*/
+#define OS_TRACE_EV_ACTIVATE   ((uint8_t)1u)
+#define OS_TRACE_EV_SWITCH     ((uint8_t)2u)
+#define OS_TRACE_EV_TERMINATE  ((uint8_t)3u)
+#define OS_TRACE_EV_OVERRUN    ((uint8_t)4u)   /* ActivateTask → E_OS_LIMIT */
+#define OS_TRACE_MAGIC         0x5254534Fu     /* "OSTR" little-endian */
+#define OS_TRACE_VERSION       1u
+
+    typedef struct
+    {
+        uint32_t ts;
+        uint8_t  type;
+        uint8_t  tid;
+        uint16_t arg;
+    } Os_TraceRecType;
+
+    typedef struct
+    {
+        uint32_t          magic;
+        uint16_t          version;
+        uint16_t          size;
+        volatile uint32_t head;
+        uint32_t          core_hz;
+        Os_TraceRecType   rec[OS_TRACE_RING_SIZE];
+    } Os_TraceBufType;
+
     typedef struct
     {
-        uint8_t used;                             
-        uint8_t num_receivers;              
-        TaskType receivers[4];              
-        uint8_t head, count;
-        uint16_t buffer[MAX_IOC_CHANNELS][IOC_BUFFER_SIZE]; 
-        uint8_t tail[4];                   
-    } OsIocCtrl;
+        uint32_t exec_min;
+        uint32_t exec_max;
+        uint64_t exec_sum;
+        uint32_t count;       /* số lần chạy đã hoàn tất (TerminateTask) */
+        uint32_t resp_max;
+        uint32_t lat_max;
+    } Os_TaskTimingType;
 #ifdef __cplusplus
 }
 #endif
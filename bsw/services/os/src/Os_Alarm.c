@@ -2,21 +2,26 @@
  * @file    Os_Alarm.c
  * @brief   Bộ điều phối Alarm (ms) cho OS (subset AUTOSAR/OSEK) trên STM32F103
  * @details Cung cấp:
- *          - Bộ đếm Alarm theo tick (ms) gọi từ SysTick/ISR: os_alarm_tick()
- *          - API SetRelAlarm()/CancelAlarm() theo phong cách AUTOSAR
- *          - Ánh xạ Alarm → Task chu kỳ (ActivateTask)
+ *          - Xử lý Alarm tới hạn của một counter: os_alarm_tick(cid)
+ *            (gọi từ IncrementCounter() mỗi khi counter tăng)
+ *          - API SetRelAlarm()/SetAbsAlarm()/CancelAlarm() theo phong cách AUTOSAR
+ *          - Ánh xạ Alarm → Task chu kỳ (ActivateTask/SetEvent/callback)
  *
  *          Mô hình thời gian:
  *            - SysTick cấu hình 1 kHz (1 ms/tick)
- *            - Mỗi tick gọi os_alarm_tick() để giảm bộ đếm remain
- *            - Khi remain về 0 → kích hoạt Task được map với Alarm
- *            - cycle = 0 → one-shot; cycle > 0 → periodic (reload remain=cycle)
+ *            - Mỗi counter có một min-heap các alarm đang active, khoá
+ *              theo Expiry_tick (giá trị tuyệt đối của ticks_total).
+ *            - Mỗi tick chỉ so sánh gốc heap: ISR chỉ chạm tới các alarm
+ *              thực sự tới hạn, không quét toàn bảng alarm_tbl.
+ *            - Set/Cancel: O(log n); xử lý tick: O(1) + O(log n) mỗi alarm tới hạn.
+ *            - cycle = 0 → one-shot; cycle > 0 → periodic
+ *              (nạp lại Expiry_tick = now + cycle).
  *
  *          Tính đồng bộ:
  *            - os_alarm_tick() thường chạy trong ngữ cảnh ISR (SysTick)
  *            - SetRelAlarm()/CancelAlarm() có thể gọi từ TASK hoặc ISR
- *            - Cần đảm bảo vùng găng (critical section) khi cập nhật s_alarms
- *              nếu OS hỗ trợ tiền xử lý song song giữa ISR và TASK.
+ *            - Mọi thao tác trên heap nằm trong vùng găng ngắn; hành động
+ *              của alarm (ActivateTask/SetEvent/callback) chạy ngoài vùng găng.
  *
  * @version  1.0
  * @date     2025-09-10 11:25
@@ -32,6 +37,83 @@ extern TCB_t tcb[OS_MAX_TASKS];
 
 extern OsCounterCtl Counter_tbl[OS_MAX_COUNTERS];
 
+/* =========================================================
+ * Min-heap alarm theo từng counter
+ *  - alarm_heap[cid][i] : Alarm ID, gốc (i=0) là alarm tới hạn sớm nhất
+ *  - heap_len[cid]      : số alarm active trên counter cid
+ *  - heap_pos[aid]      : vị trí của alarm trong heap (cho Cancel O(log n))
+ * =======================================================*/
+#define OS_ALARM_NONE   ((uint8_t)0xFFu)
+
+#if (OS_MAX_ALARMS >= 0xFFu)
+#error "OS_MAX_ALARMS phải < 255 (0xFF dùng làm OS_ALARM_NONE)"
+#endif
+
+static AlarmType alarm_heap[OS_MAX_COUNTERS][OS_MAX_ALARMS];
+static uint8_t   heap_len[OS_MAX_COUNTERS];
+static uint8_t   heap_pos[OS_MAX_ALARMS];
+
+/* So sánh an toàn khi ticks_total tràn 32-bit */
+static inline bool tick_before(TickType a, TickType b){
+    return (int32_t)(a - b) < 0;
+}
+static inline CounterTypeId alarm_cid(const OsAlarmCtl *a){
+    return (CounterTypeId)(a->counter - Counter_tbl);
+}
+static inline void heap_set(CounterTypeId cid, uint8_t i, AlarmType aid){
+    alarm_heap[cid][i] = aid;
+    heap_pos[aid] = i;
+}
+static void heap_sift_up(CounterTypeId cid, uint8_t i){
+    AlarmType aid = alarm_heap[cid][i];
+    TickType  key = alarm_tbl[aid].Expiry_tick;
+    while(i > 0u){
+        uint8_t parent = (uint8_t)((i - 1u) >> 1);
+        AlarmType pid = alarm_heap[cid][parent];
+        if(!tick_before(key, alarm_tbl[pid].Expiry_tick)) break;
+        heap_set(cid, i, pid);
+        i = parent;
+    }
+    heap_set(cid, i, aid);
+}
+static void heap_sift_down(CounterTypeId cid, uint8_t i){
+    uint8_t   n   = heap_len[cid];
+    AlarmType aid = alarm_heap[cid][i];
+    TickType  key = alarm_tbl[aid].Expiry_tick;
+    for(;;){
+        /* chỉ số con tính 32-bit: 2*i+1 tràn uint8_t khi heap > 127 alarm */
+        uint32_t l = 2u * (uint32_t)i + 1u;
+        if(l >= n) break;
+        uint32_t r = l + 1u;
+        uint32_t m = l;
+        if((r < n) && tick_before(alarm_tbl[alarm_heap[cid][r]].Expiry_tick,
+                                  alarm_tbl[alarm_heap[cid][l]].Expiry_tick)){
+            m = r;
+        }
+        if(!tick_before(alarm_tbl[alarm_heap[cid][m]].Expiry_tick, key)) break;
+        heap_set(cid, i, alarm_heap[cid][m]);
+        i = (uint8_t)m;
+    }
+    heap_set(cid, i, aid);
+}
+static void heap_insert(CounterTypeId cid, AlarmType aid){
+    uint8_t i = heap_len[cid]++;
+    heap_set(cid, i, aid);
+    heap_sift_up(cid, i);
+}
+static void heap_remove(CounterTypeId cid, AlarmType aid){
+    uint8_t i = heap_pos[aid];
+    uint8_t last = (uint8_t)(--heap_len[cid]);
+    heap_pos[aid] = OS_ALARM_NONE;
+    if(i == last) return;
+    AlarmType moved = alarm_heap[cid][last];
+    heap_set(cid, i, moved);
+    heap_sift_down(cid, i);
+    if(heap_pos[moved] == i){
+        heap_sift_up(cid, i);
+    }
+}
+
 static inline uint32_t ms_to_tick(uint32_t ms){
     if(ms == 0u)
         return 0u;
@@ -41,59 +123,71 @@ static inline uint32_t ms_to_tick(uint32_t ms){
     if(t > 0xFFFFFFFFull) t = 0xFFFFFFFFull;
     return (uint32_t)t;
 }
+
+/* Đưa alarm vào heap của counter với thời điểm tới hạn tuyệt đối */
+static void alarm_arm(OsAlarmCtl *a, TickType expiry, TickType cycle){
+    a->active      = 1u;
+    a->Expiry_tick = expiry;
+    a->cycle       = cycle;
+    heap_insert(alarm_cid(a), a->id);
+}
 /*
  * 1) SetRelAlarm()
  */
 
  StatusType SetRelAlarm(AlarmType aid, TickType offset, TickType cycle){
 
-    if(aid >= OS_MAX_ALARMS) return E_OS_LIMIT;
-
-    //OsCounterCtl *c = alarm_to_counter[aid];
+    if(aid >= OS_MAX_ALARMS) return E_OS_ID;
 
+    OsAlarmCtl *a = &alarm_tbl[aid];
     uint32_t inc_ticks = ms_to_tick(offset);
     uint32_t cyc_ticks = ms_to_tick(cycle);
 
-    __disable_irq();
-
-    OsAlarmCtl *a = &alarm_tbl[aid];
-    a->active = 1u;
-    a->Expiry_tick = (a->counter->current_value + inc_ticks) % a->counter->max_allowed_Value;
+    if((cyc_ticks != 0u) && (cyc_ticks < a->counter->min_cycles)){
+        return E_OS_VALUE;
+    }
 
-    if(cyc_ticks >= a->counter->min_cycles){
-        a->cycle = cyc_ticks % a->counter->max_allowed_Value;
-    } else{
-      return E_OS_VALUE;
+    __disable_irq();
+    if(a->active){
+        __enable_irq();
+        return E_OS_STATE;
     }
+    alarm_arm(a, a->counter->ticks_total + inc_ticks, cyc_ticks);
     __enable_irq();
     return E_OK;
  }
 
  /*
   * 2) SetAbsAlarm
+  *    - start là giá trị counter (0..max_allowed_Value-1) tại đó alarm bắn
+  *      lần đầu; quy đổi sang ticks_total theo lần tới gần nhất.
   */
 StatusType SetAbsAlarm(AlarmType aid, TickType start, TickType cycle){
 
-     if(aid >= OS_MAX_ALARMS) return E_OS_LIMIT;
+    if(aid >= OS_MAX_ALARMS) return E_OS_ID;
 
-   // OsCounterCtl *c = alarm_to_counter[aid];
-    uint32_t inc_ticks = ms_to_tick(start);
+    OsAlarmCtl *a = &alarm_tbl[aid];
+    OsCounterCtl *c = a->counter;
+    uint32_t abs_ticks = ms_to_tick(start);
     uint32_t cyc_ticks = ms_to_tick(cycle);
-    if((cyc_ticks > 0u) && (cyc_ticks < 1u)){
-        cyc_ticks = 1u;
+
+    if(abs_ticks >= c->max_allowed_Value){
+        return E_OS_VALUE;
+    }
+    if((cyc_ticks != 0u) && (cyc_ticks < c->min_cycles)){
+        return E_OS_VALUE;
     }
 
     __disable_irq();
-    OsAlarmCtl *a = &alarm_tbl[aid];
-    a->active = 1u;
-    a->Expiry_tick = inc_ticks & a->counter->max_allowed_Value;
-
-    if(cyc_ticks >= a->counter->min_cycles){
-        a->cycle = cyc_ticks % a->counter->max_allowed_Value;
-    } else{
-      return E_OS_VALUE;
+    if(a->active){
+        __enable_irq();
+        return E_OS_STATE;
     }
-
+    TickType delta = (abs_ticks + c->max_allowed_Value - c->current_value) % c->max_allowed_Value;
+    if(delta == 0u){
+        delta = c->max_allowed_Value; /* start == giá trị hiện tại → lần quay vòng kế tiếp */
+    }
+    alarm_arm(a, c->ticks_total + delta, cyc_ticks);
     __enable_irq();
     return E_OK;
 }
@@ -103,21 +197,34 @@ StatusType SetAbsAlarm(AlarmType aid, TickType start, TickType cycle){
 */
 StatusType CancelAlarm(AlarmType alarm){
 
-   OsAlarmCtl *a = &alarm_tbl[alarm];
   if (alarm >= OS_MAX_ALARMS) {
     return E_OS_ID;
   }
+  OsAlarmCtl *a = &alarm_tbl[alarm];
 
-  if (a->active) {
+  __disable_irq();
+  if (!a->active) {
+    __enable_irq();
     return E_OS_STATE;
   }
 
-  /* Huỷ hoạt động alarm. (Có thể cần critical section tuỳ kiến trúc.) */
+  /* Huỷ hoạt động alarm và gỡ khỏi heap của counter */
+  heap_remove(alarm_cid(a), alarm);
   a->active = 0u;
+  __enable_irq();
   return E_OK;
 }
 
 void Os_Alarm_Init(void){
+    for(uint8_t c = 0u; c < OS_MAX_COUNTERS; c++){
+        heap_len[c] = 0u;
+    }
+    for(uint8_t i = 0u; i < OS_MAX_ALARMS; i++){
+        alarm_tbl[i].id     = i;
+        alarm_tbl[i].active = 0u;
+        heap_pos[i]         = OS_ALARM_NONE;
+    }
+
     alarm_tbl[0].counter      = &Counter_tbl[0];
     alarm_tbl[0].action_type  = ALARMACTION_ACTIVATETASK;
     alarm_tbl[0].action.task_id = TASK_A;
@@ -126,38 +233,78 @@ void Os_Alarm_Init(void){
     alarm_tbl[1].action_type  = ALARMACTION_ACTIVATETASK;
     alarm_tbl[1].action.task_id = TASK_B;
 
+    /* ALARM_RTE: nhịp timeout cho runnable của RTE (Task_C) */
     alarm_tbl[2].counter      = &Counter_tbl[0];
-    alarm_tbl[2].action_type  = ALARMACTION_ACTIVATETASK;
-    alarm_tbl[2].action.task_id = TASK_C;
+    alarm_tbl[2].action_type  = ALARMACTION_SETEVENT;
+    alarm_tbl[2].action.Set_event.task_id = TASK_C;
+    alarm_tbl[2].action.Set_event.mask    = EV_RTE_TIMING;
+
+    /* ALARM_COM: nhịp main function của COM (Task_Com) */
+    alarm_tbl[3].counter      = &Counter_tbl[0];
+    alarm_tbl[3].action_type  = ALARMACTION_ACTIVATETASK;
+    alarm_tbl[3].action.task_id = TASK_COM;
 }
-void os_alarm_tick(void){
-   for(int i=0; i< OS_MAX_ALARMS; i++){
-        OsAlarmCtl *a = &alarm_tbl[i];
-        
-        if (!a->active)
-            continue;
-
-        if (a->Expiry_tick == a->counter->current_value)
-        {
-            // ActivateTask(a->action.task_id);
-            switch(a->action_type){
-                case ALARMACTION_ACTIVATETASK:
-                    /* Kích hoạt task đích */
-                    ActivateTask(a->action.task_id);
-                    break;
-                case ALARMACTION_SETEVENT:
-                    SetEvent(a->action.Set_event.task_id, a->action.Set_event.mask);
-                    break;
-                case ALARMACTION_CALLBACK:
-                    a->action.callback();
-                    break;
-            }
-            /* Lặp hay one-shot */
-            if ((a->cycle > 0u) && (a-> cycle >= a->counter->min_cycles)) {
-                a->Expiry_tick = a->cycle; /* nạp lại chu kỳ */
-            } else {
-                a->active = 0u; /* one-shot → tắt */
-            }   
+
+/* =========================================================
+ * os_alarm_tick(cid)
+ *  - Gọi sau mỗi lần counter cid tăng (IncrementCounter).
+ *  - Chỉ xét gốc heap: khi chưa có alarm tới hạn → thoát ngay.
+ *  - Alarm cyclic được nạp lại (now + cycle) TRƯỚC khi thực thi
+ *    hành động, để callback có thể CancelAlarm() chính nó.
+ * =======================================================*/
+void os_alarm_tick(CounterTypeId cid){
+    OsCounterCtl *c = &Counter_tbl[cid];
+
+    for(;;){
+        __disable_irq();
+        TickType now = c->ticks_total;
+        if((heap_len[cid] == 0u) ||
+           tick_before(now, alarm_tbl[alarm_heap[cid][0]].Expiry_tick)){
+            __enable_irq();
+            break;
         }
-  }
+        AlarmType aid = alarm_heap[cid][0];
+        OsAlarmCtl *a = &alarm_tbl[aid];
+        heap_remove(cid, aid);
+
+        /* Lặp hay one-shot */
+        if (a->cycle > 0u) {
+            a->Expiry_tick = now + a->cycle; /* nạp lại chu kỳ */
+            heap_insert(cid, aid);
+        } else {
+            a->active = 0u; /* one-shot → tắt */
+        }
+        __enable_irq();
+
+        AlarmExpiryHook(aid);
+        switch(a->action_type){
+            case ALARMACTION_ACTIVATETASK:
+                /* Kích hoạt task đích */
+                ActivateTask(a->action.task_id);
+                break;
+            case ALARMACTION_SETEVENT:
+                SetEvent(a->action.Set_event.task_id, a->action.Set_event.mask);
+                break;
+            case ALARMACTION_CALLBACK:
+                a->action.callback();
+                break;
+        }
+    }
+}
+
+/* =========================================================
+ * Os_Alarm_NextExpiry(cid, delta)
+ *  - Trả về số đơn vị counter còn lại tới alarm sớm nhất của
+ *    counter cid (đọc gốc heap, O(1)). Dùng cho tickless idle.
+ *  - E_OS_NOFUNC nếu counter không có alarm nào đang active.
+ *  - Gọi trong vùng găng (đọc heap không khoá).
+ * =======================================================*/
+StatusType Os_Alarm_NextExpiry(CounterTypeId cid, TickRefType delta){
+    if(cid >= OS_MAX_COUNTERS || delta == NULL) return E_OS_ID;
+    if(heap_len[cid] == 0u) return E_OS_NOFUNC;
+
+    TickType now = Counter_tbl[cid].ticks_total;
+    TickType exp = alarm_tbl[alarm_heap[cid][0]].Expiry_tick;
+    *delta = tick_before(now, exp) ? (exp - now) : 0u;
+    return E_OK;
 }
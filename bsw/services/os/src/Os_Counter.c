@@ -5,6 +5,7 @@
  *          dụng các API như:
  *          - GetCounterValue(): Lấy giá trị hiện tại của counter
  *          - IncrementCounter(): Tăng giá trị Counter (gọi từ Systick)
+ *            và xử lý các Alarm tới hạn gắn với counter đó
  * @version 1.0
  * @date    2025 -09-10
  * @author  Nguyễn Tuấn Khoa
@@ -13,6 +14,8 @@
 #include "Os_Arch.h"
 #include "Os_Cfg.h"
 
+extern void os_alarm_tick(CounterTypeId cid);
+
 volatile TickType s_tick = 0;
 OsCounterCtl Counter_tbl[OS_MAX_COUNTERS]={
     // counter 0
@@ -39,8 +42,11 @@ StatusType IncrementCounter(CounterTypeId cid){
     // Logic này giả định mỗi lần gọi là một tick.
     OsCounterCtl *c = (OsCounterCtl*)&Counter_tbl[cid];
     if(s_tick  == c->ticks_per_base){
-        c->current_value = (c->current_value + 1) % c->max_allowed_Value;\
+        c->current_value = (c->current_value + 1) % c->max_allowed_Value;
+        c->ticks_total++;
         s_tick = 0;
+        /* Chỉ chạm tới các alarm tới hạn của counter này */
+        os_alarm_tick(cid);
     }
 
     // Logic s_tick cũ có thể không cần thiết nếu mỗi counter có logic riêng
@@ -54,3 +60,33 @@ StatusType GetCounterValue(CounterTypeId cid, TickRefType value){
     *value = c->current_value;
     return E_OK;
 }
+
+/* =========================================================
+ * Tickless idle: quy đổi & bù tick cho counter
+ *  - "tick nguồn" = một lần gọi IncrementCounter(cid) (SysTick 1ms).
+ *  - Os_Counter_SourceTicks(): số tick nguồn cần để counter tăng
+ *    thêm 'delta' đơn vị (tính cả bộ chia s_tick đang dở).
+ *  - Os_Counter_Advance(): tương đương gọi IncrementCounter() 'ticks'
+ *    lần liên tiếp, nhưng chỉ xử lý alarm một lần (O(1) + alarm tới hạn).
+ * =======================================================*/
+TickType Os_Counter_SourceTicks(CounterTypeId cid, TickType delta){
+    OsCounterCtl *c = &Counter_tbl[cid];
+    TickType ticks = delta * c->ticks_per_base;
+    return (ticks > s_tick) ? (ticks - s_tick) : 1u;
+}
+
+StatusType Os_Counter_Advance(CounterTypeId cid, TickType ticks){
+    if(cid >= OS_MAX_COUNTERS) return E_OS_ID;
+    if(ticks == 0u) return E_OK;
+
+    OsCounterCtl *c = &Counter_tbl[cid];
+    TickType total = s_tick + ticks;
+    TickType n     = total / c->ticks_per_base;
+    s_tick = total % c->ticks_per_base;
+    if(n > 0u){
+        c->current_value = (c->current_value + (n % c->max_allowed_Value)) % c->max_allowed_Value;
+        c->ticks_total  += n;
+        os_alarm_tick(cid);
+    }
+    return E_OK;
+}
@@ -6,6 +6,7 @@
  *            - SetEvent(t, mask)
  *            - GetEvent(t, *mask)
  *            - ClearEvent(mask)
+ *            - WaitEventTimeout(mask, ticks) (mở rộng, không thuộc OSEK)
  *
  *          Quy ước/Ngữ nghĩa (theo AUTOSAR/OSEK, rút gọn):
  *            - Extended Task mới được dùng Event. Basic Task gọi → lỗi E_OS_STATE.
@@ -34,12 +35,18 @@
 
 extern TCB_t tcb[OS_MAX_TASKS];
 extern volatile TCB_t *g_current;
+extern void Os_MakeReady(TaskType tid);
+extern void Os_Dispatch(void);
+extern void Os_TimeoutArm(TaskType tid, TickType ticks);
+extern void Os_TimeoutCancel(TaskType tid);
+extern bool Os_ResourceHeld(TaskType tid);
 
 /* =========================================================
  * SetEvent(t, mask)
  *  - OR bit vào events của task t.
  *  - Nếu t đang WAITING & trùng đợi → READY + clear waitMask.
- *  - Kích PendSV để có thể chuyển ngữ cảnh sớm.
+ *  - Nếu t có prio cao hơn task đang chạy → preempt ngay
+ *    (từ ISR: PendSV chạy khi thoát ISR).
  * =======================================================*/
 /********************************************
  * @brief  Đặt Event cho Exteneded Task
@@ -57,12 +64,12 @@ StatusType SetEvent(TaskType id, EventMaskType mask){
         return E_OS_STATE; 
     __disable_irq();
     tc->SetEvent |= mask;
-    __enable_irq();
     if(tc->state == OS_TASK_WAITING && (tc->SetEvent & tc->WaitEvent)){
-        ActivateTask(tc ->id);
         tc->WaitEvent = 0;
-        (void)Os_Arch_TriggerPendSV();
+        Os_TimeoutCancel(tc->id);   /* nếu đang chờ có timeout */
+        Os_MakeReady(tc->id);
     }
+    __enable_irq();
     return E_OK;
 }
 /* =========================================================
@@ -70,11 +77,13 @@ StatusType SetEvent(TaskType id, EventMaskType mask){
  *  - Extended Task chờ bất kỳ bit trong mask được set.
  *  - Nếu đã có sẵn bit → trả ngay E_OK (KHÔNG tự clear).
  *  - Nếu chưa có → set waitMask, chuyển trạng thái WAITING, nhường CPU.
+ *    PendSV chạy ngay khi mở IRQ; task tiếp tục tại đây khi SetEvent()
+ *    đưa nó về READY và nó lại là task ưu tiên cao nhất.
  * =======================================================*/
 /**********************************************************
  * @brief  Chờ Event (Extended Task))
  * @param  m  Mặt nạ event mong đợi
- * @return E_OK | E_OS_STATE
+ * @return E_OK | E_OS_STATE | E_OS_RESOURCE
  * @note   Chỉ gọi trong ngữ cảnh TASK (không gọi từ ISR).
  *         Sau khi trả về E_OK do được đánh thức, ứng dụng 
  *         thường gọi ClearEvent(m) tương ứng để xóa các bit đã xử lý.
@@ -84,6 +93,8 @@ StatusType WaitEvent(EventMaskType mask){
 
     if(!tc->isExtended) 
         return E_OS_STATE;    
+    if(Os_ResourceHeld(tc->id))
+        return E_OS_RESOURCE;
     __disable_irq();
 
     if((tc->SetEvent & mask) != 0){
@@ -93,10 +104,50 @@ StatusType WaitEvent(EventMaskType mask){
     else{
         tc -> WaitEvent = mask;
         tc -> state = OS_TASK_WAITING;
+        Os_Dispatch();
     }
     __enable_irq();
     return E_OK;
 }
+/* =========================================================
+ * WaitEventTimeout(mask, ticks)
+ *  - Như WaitEvent(), nhưng task cũng nằm trong hàng đợi timeout
+ *    của kernel: hết 'ticks' tick mà chưa có event → E_OS_TIMEOUT.
+ *  - SetEvent() tới trước sẽ gỡ task khỏi hàng đợi (O(1)).
+ *  - ticks = 0 → chỉ kiểm tra, không chờ.
+ * =======================================================*/
+/**********************************************************
+ * @brief  Chờ Event có giới hạn thời gian (Extended Task)
+ * @param  mask   Mặt nạ event mong đợi
+ * @param  ticks  Thời gian chờ tối đa (tick OS, 1 tick = 1 ms)
+ * @return E_OK | E_OS_STATE | E_OS_RESOURCE | E_OS_TIMEOUT
+ * @note   Chỉ gọi trong ngữ cảnh TASK (không gọi từ ISR).
+ **********************************************************/
+StatusType WaitEventTimeout(EventMaskType mask, TickType ticks){
+    TCB_t *tc = &tcb[g_current->id];
+
+    if(!tc->isExtended)
+        return E_OS_STATE;
+    if(Os_ResourceHeld(tc->id))
+        return E_OS_RESOURCE;
+    __disable_irq();
+
+    if((tc->SetEvent & mask) != 0){
+        __enable_irq();
+        return E_OK;
+    }
+    if(ticks == 0u){
+        __enable_irq();
+        return E_OS_TIMEOUT;
+    }
+    tc -> WaitEvent = mask;
+    tc -> state = OS_TASK_WAITING;
+    Os_TimeoutArm(tc->id, ticks);
+    Os_Dispatch();
+    __enable_irq();
+
+    return (tc->timed_out != 0u) ? E_OS_TIMEOUT : E_OK;
+}
 /********************************************
  * @brief Lấy Event hiện tại của Task
  * @param[in] id  Task ID
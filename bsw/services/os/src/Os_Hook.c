@@ -16,6 +16,8 @@
  *                    Dùng để log lỗi, debug hoặc kích hoạt cơ chế phục hồi.
  *    - PreTaskHook:  Được gọi ngay trước khi một task được chuyển vào trạng thái RUNNING.
  *    - PostTaskHook: Được gọi ngay sau khi một task rời khỏi trạng thái RUNNING.
+ *    - AlarmExpiryHook: Được gọi trong SysTick khi một alarm tới hạn, trước
+ *                    hành động của alarm (đồng bộ phần cứng theo nhịp task).
  *
  * @version  1.1
  * @date     2025-09-10
@@ -28,3 +30,4 @@ __attribute__((weak)) void ShutdownHook(StatusType e){ (void)e; }
 __attribute__((weak)) void ErrorHook(StatusType e){ (void)e; }
 __attribute__((weak)) void PreTaskHook(void){}
 __attribute__((weak)) void PostTaskHook(void){}
+__attribute__((weak)) void AlarmExpiryHook(AlarmType alarm){ (void)alarm; }
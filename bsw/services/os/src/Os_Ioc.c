@@ -1,108 +1,230 @@
 /**********************************************************
  * @file    Os_Ioc.c
- * @brief   Hàng đợi IOC (byte queue) tối giản cho OS (STM32F103)
- * @details Dùng Enable và Disable_irq để bảo vệ head/tail 
- *          khi truy cập đồng thời giữa ISR và Task.
+ * @brief   IOC có kiểu, 1 sender → N receiver, không khoá
+ * @details Kênh được sinh tĩnh từ OS_IOC_CHANNEL_LIST
+ *          (cfg/os/Os_Ioc_Cfg.h): payload là struct bất kỳ
+ *          (vd Safe_s), mỗi kênh có depth slot elem_size byte.
  *
- *  API:
- *            - void Ioc_Init(OsIocQueue* q, uint8* storage, uint16 size)
- *            - int  Ioc_Send(OsIocQueue* q, uint8 b)       // 0=OK, -1=FULL/err
- *            - int  Ioc_Receive(OsIocQueue* q, uint8* out) // 0=OK, -1=EMPTY/err
+ *  API lõi (ứng dụng dùng hàm có kiểu sinh trong Os_Ioc_Cfg.h):
+ *            - void           Ioc_Init(void)
+ *            - void*          Ioc_WriteBegin(ch)       // zero-copy
+ *            - Std_ReturnType Ioc_WriteCommit(ch)
+ *            - Std_ReturnType Ioc_Write(ch, data)
+ *            - Std_ReturnType Ioc_Read(ch, rx, data)   // không chặn
+ *            - const void*    Ioc_ReceivePeek(ch, rx)  // zero-copy (queued)
+ *            - Std_ReturnType Ioc_ReceiveRelease(ch, rx)
  *
- * Quy ước:
- *            - Dùng 1 ô trống để phân biệt FULL/EMPTY:
- *                next(head) == tail  ⇒ FULL
- *                head == tail        ⇒ EMPTY
- *            - size tối thiểu = 2 (nếu <2 → vô hiệu queue).
+ * Quy ước đồng bộ (không tắt IRQ, 1 core):
+ *            - Mỗi biến chỉ có MỘT bên ghi: wr/seq/drops do sender,
+ *              rd/drops_seen do từng receiver. Thứ tự ghi được giữ
+ *              bằng DMB; đọc/ghi 32 bit trên Cortex-M3 là nguyên tử.
+ *            - Unqueued (last-is-best), 2 slot:
+ *                sender : seq[slot] = 0 → ghi slot → seq[slot] = n → wr = n
+ *                reader : slot của wr, kiểm tra seq == wr trước và sau
+ *                         khi copy; khác → sender vừa ghi đè (chỉ xảy ra
+ *                         khi sender preempt reader) → đọc lại bản mới.
+ *                Reader preempt sender đang ghi thì sender đang ở slot
+ *                còn lại → bản cũ vẫn nguyên vẹn, không bao giờ phải chờ.
+ *            - Queued (FIFO), depth slot:
+ *                sender chỉ ghi slot wr % depth khi MỌI receiver còn chỗ
+ *                (wr - rd < depth) → slot receiver đang đọc không bị ghi
+ *                đè; có receiver đầy → IOC_E_LIMIT, bản tin không tới
+ *                receiver nào nên MỌI receiver drops++ và nhận
+ *                IOC_E_LOST_DATA ở lần đọc kế tiếp (không mất âm thầm).
+ *            - Sau khi công bố, SetEvent(receiver, ev) nếu kênh có ev.
  *
- * @version  1.0
- * @date     2025-09-10 
+ * @version  2.0
+ * @date     2025-09-10
  * @author   Nguyễn Tuấn Khoa
  **********************************************************/
 
-#include "Os.h"   /* OsIocQueue, uint8/uint16/uint32 ... */
+#include "Os.h"
+#include "Os_Ioc_Cfg.h"
+#include <string.h>   /* memcpy */
 
-TaskType Rec_list[2]= {TASK_B, TASK_C};
+/* =========================================================
+ * Tiện ích
+ * =======================================================*/
+static inline const Os_IocChannelCfgType *ioc_cfg(IocChannelType ch)
+{
+  return (ch < IOC_CH_COUNT) ? &Os_IocCfg[ch] : NULL;
+}
+
+static inline uint8_t *ioc_slot(const Os_IocChannelCfgType *c, uint32_t n)
+{
+  return &c->data[(n % c->depth) * c->elem_size];
+}
 
-static OsIocCtrl IocChannel[MAX_IOC_CHANNELS];
 /* =========================================================
  * Ioc_Init
- *  - Khởi tạo queue với bộ nhớ ngoài do ứng dụng cấp.
- *  - size phải ≥ 2 (vì dùng 1 ô trống để phân biệt full/empty).
- *  - Nếu tham số lỗi → vô hiệu queue (size=0).
+ *  - Xoá wr/seq/rd của mọi kênh (gọi trong StartOS, trước khi
+ *    task/ISR nào dùng IOC).
  * =======================================================*/
-void Ioc_Init(uint8_t channel, uint8_t num, TaskType* receivers)
+void Ioc_Init(void)
 {
-  if(channel >= MAX_IOC_CHANNELS || !receivers) return;
-  
-  /* Init thường gọi trước khi bật IRQ → không cần vùng găng */
-  IocChannel[channel].used = 1;
-  IocChannel[channel].num_receivers = num;
-  IocChannel[channel].head = 0;
-  IocChannel[channel].count = 0;
-
-  for(int i=0; i<num; i++) {
-    IocChannel[channel].receivers[i] = receivers[i];
-    IocChannel[channel].tail[i] = 0;
+  for (uint32_t ch = 0u; ch < IOC_CH_COUNT; ch++) {
+    const Os_IocChannelCfgType *c = &Os_IocCfg[ch];
+    *c->wr = 0u;
+    for (uint32_t i = 0u; i < c->depth; i++) {
+      c->seq[i] = 0u;
+    }
+    for (uint32_t i = 0u; i < c->num_receivers; i++) {
+      c->rx[i].rd         = 0u;
+      c->rx[i].drops      = 0u;
+      c->rx[i].drops_seen = 0u;
+    }
   }
 }
 
 /* =========================================================
- * Ioc_Send
- *  - Ghi 1 byte vào queue.
- *  - Trả  0 nếu OK, -1 nếu FULL hoặc chưa init.
- *  - Bảo vệ head/tail bằng vùng găng ngắn (PRIMASK).
+ * Ioc_WriteBegin
+ *  - Trả slot kế tiếp để sender ghi trực tiếp.
+ *  - Queued: có receiver đầy → bản tin bị bỏ với mọi receiver
+ *    (drops++ cho từng receiver), trả NULL.
  * =======================================================*/
-uint8_t Ioc_Send(uint8_t channel, uint16_t* data)
+void *Ioc_WriteBegin(IocChannelType ch)
 {
-  if (channel >= MAX_IOC_CHANNELS || !IocChannel[channel].used|| !data) return -1;
-    OsIocCtrl *I = &IocChannel[channel];
-  __disable_irq();
+  const Os_IocChannelCfgType *c = ioc_cfg(ch);
+  if (c == NULL) return NULL;
 
-    I->buffer[channel][I->head] = *data;
-    I->head = (I->head + 1u) % IOC_BUFFER_SIZE;
+  uint32_t w = *c->wr;
 
-    if(I->count < IOC_BUFFER_SIZE) I->count++;
-    else {
-      for (int i=0; i<I->num_receivers; i++){
-        I->tail[i] = (I->tail[i] + 1u) % IOC_BUFFER_SIZE;
+  if (c->queued) {
+    bool full = false;
+    for (uint32_t i = 0u; i < c->num_receivers; i++) {
+      if ((w - c->rx[i].rd) >= c->depth) {
+        full = true;
+      }
+    }
+    if (full) {
+      for (uint32_t i = 0u; i < c->num_receivers; i++) {
+        c->rx[i].drops++;
       }
+      return NULL;
     }
-    __enable_irq();
-    for(int i=0; i<I->num_receivers; i++) {
-      SetEvent(I->receivers[i], EV_RX);
+  }
+
+  c->seq[w % c->depth] = 0u;   /* slot đang ghi: reader unqueued sẽ bỏ qua */
+  __DMB();
+  return ioc_slot(c, w);
+}
+
+/* =========================================================
+ * Ioc_WriteCommit
+ *  - Đóng dấu seq, công bố wr rồi báo receiver bằng Event.
+ * =======================================================*/
+Std_ReturnType Ioc_WriteCommit(IocChannelType ch)
+{
+  const Os_IocChannelCfgType *c = ioc_cfg(ch);
+  if (c == NULL) return IOC_E_NOK;
+
+  uint32_t w = *c->wr;
+
+  __DMB();                     /* dữ liệu slot trước seq/wr */
+  c->seq[w % c->depth] = w + 1u;
+  __DMB();
+  *c->wr = w + 1u;
+
+  if (c->ev != 0u) {
+    for (uint32_t i = 0u; i < c->num_receivers; i++) {
+      (void)SetEvent(c->receivers[i], c->ev);
     }
-    return 0;
-  
+  }
+  return IOC_E_OK;
 }
 
 /* =========================================================
- * Ioc_Receive
- *  - Đọc 1 byte từ queue.
- *  - Trả  0 nếu OK (*out nhận dữ liệu), -1 nếu EMPTY/err.
+ * Ioc_Write
+ *  - Copy elem_size byte vào slot kế tiếp và công bố.
+ *  - IOC_E_LIMIT nếu (queued) có receiver đầy.
  * =======================================================*/
-uint8_t Ioc_Receive(uint8_t channel, uint16_t* data, TaskType receiver)
+Std_ReturnType Ioc_Write(IocChannelType ch, const void *data)
 {
-  if (channel >= MAX_IOC_CHANNELS|| !IocChannel[channel].used || !receiver || !data)
-   return -1;
+  if (data == NULL) return IOC_E_NOK;
 
-  OsIocCtrl *I = &IocChannel[channel];
-  EventMaskType ev;
+  void *slot = Ioc_WriteBegin(ch);
+  if (slot == NULL) {
+    return (ioc_cfg(ch) != NULL) ? IOC_E_LIMIT : IOC_E_NOK;
+  }
+  memcpy(slot, data, Os_IocCfg[ch].elem_size);
+  return Ioc_WriteCommit(ch);
+}
+
+/* =========================================================
+ * Ioc_Read
+ *  - Unqueued: copy bản mới nhất (rx bỏ qua), IOC_E_NO_DATA nếu
+ *    chưa từng ghi. Vòng lặp chỉ lặp lại khi sender vừa preempt
+ *    và ghi đè đúng slot đang copy.
+ *  - Queued: lấy bản tin kế tiếp của receiver rx.
+ * =======================================================*/
+Std_ReturnType Ioc_Read(IocChannelType ch, uint8_t rx, void *data)
+{
+  const Os_IocChannelCfgType *c = ioc_cfg(ch);
+  if ((c == NULL) || (data == NULL)) return IOC_E_NOK;
 
-  WaitEvent(EV_RX);
-  GetEvent(receiver, &ev);
+  if (!c->queued) {
+    for (;;) {
+      uint32_t w = *c->wr;
+      if (w == 0u) return IOC_E_NO_DATA;
 
-  if(ev & EV_RX){
-    if (I->tail[receiver] == I->head) { /* Buffer rỗng */
-      return -1;
+      uint32_t slot = (w - 1u) % c->depth;
+      uint32_t s1   = c->seq[slot];
+      __DMB();
+      if (s1 == w) {
+        memcpy(data, ioc_slot(c, w - 1u), c->elem_size);
+        __DMB();
+        if (c->seq[slot] == s1) return IOC_E_OK;
+      }
     }
-    ClearEvent(EV_RX);
-    __disable_irq();
+  }
+
+  if (rx >= c->num_receivers) return IOC_E_NOK;
+  Os_IocRxType *r = &c->rx[rx];
+  uint32_t n = r->rd;
+  if (n == *c->wr) return IOC_E_NO_DATA;
+
+  __DMB();                     /* wr trước dữ liệu slot */
+  memcpy(data, ioc_slot(c, n), c->elem_size);
+  __DMB();
+  r->rd = n + 1u;
+
+  if (r->drops != r->drops_seen) {
+    r->drops_seen = r->drops;
+    return IOC_E_LOST_DATA;
+  }
+  return IOC_E_OK;
+}
+
+/* =========================================================
+ * Ioc_ReceivePeek / Ioc_ReceiveRelease (chỉ kênh queued)
+ *  - Peek trả con trỏ vào slot; sender không ghi đè slot này
+ *    cho tới khi Release tăng rd.
+ * =======================================================*/
+const void *Ioc_ReceivePeek(IocChannelType ch, uint8_t rx)
+{
+  const Os_IocChannelCfgType *c = ioc_cfg(ch);
+  if ((c == NULL) || !c->queued || (rx >= c->num_receivers)) return NULL;
+
+  uint32_t n = c->rx[rx].rd;
+  if (n == *c->wr) return NULL;
+  __DMB();
+  return ioc_slot(c, n);
+}
+
+Std_ReturnType Ioc_ReceiveRelease(IocChannelType ch, uint8_t rx)
+{
+  const Os_IocChannelCfgType *c = ioc_cfg(ch);
+  if ((c == NULL) || !c->queued || (rx >= c->num_receivers)) return IOC_E_NOK;
+
+  Os_IocRxType *r = &c->rx[rx];
+  uint32_t n = r->rd;
+  if (n == *c->wr) return IOC_E_NO_DATA;
+  __DMB();
+  r->rd = n + 1u;
 
-    *data = I->buffer[channel][I->tail[receiver]];
-    I->tail[receiver] = (I->tail[receiver] + 1u) % IOC_BUFFER_SIZE;
-    __enable_irq();
+  if (r->drops != r->drops_seen) {
+    r->drops_seen = r->drops;
+    return IOC_E_LOST_DATA;
   }
-    return 0;
-  
+  return IOC_E_OK;
 }
@@ -1,24 +1,44 @@
 /**********************************************************
  * @file    Os_Resource.c (hỗ trợ cho kernel preemption)
- * @brief   Resource (mutex tối giản) cho OS trên STM32F103 (Cortex-M3) 
- * @details Cung cấp 3 API khớp prototype:
- *            - void Resource_Init(OsResource* r)
- *            - void GetResource(OsResource* r)
- *            - void ReleaseResource(OsResource* r)
+ * @brief   Resource theo OSEK Immediate Priority Ceiling Protocol
+ *          cho OS trên STM32F103 (Cortex-M3)
+ * @details Cung cấp các API:
+ *            - void       Resource_Init(OsResource* r)
+ *            - StatusType GetResource(OsResource* r)
+ *            - StatusType ReleaseResource(OsResource* r)
+ *            - RES_SCHEDULER: pseudo-resource có ceiling cao nhất
+ *              (giữ nó = task không bị task nào khác preempt)
  *
- *          Đặc tả (rút gọn theo tinh thần AUTOSAR/OSEK):
- *            - Resource là mutex không hỗ trợ priority ceiling/boost.
- *            - GetResource KHÔNG trả mã lỗi → lấy Resource 
- *            - Không hỗ trợ re-entrant (nested lock cùng một task).
+ *          Đặc tả (OSEK immediate ceiling / OSEK-PCP):
+ *            - Mỗi resource có ceilingPrio = prio cao nhất của các task
+ *              dùng nó (cấu hình tĩnh khi khai báo OsResource).
+ *            - GetResource: lưu prio hiện tại vào resource rồi nâng prio
+ *              task lên ceiling NGAY LẬP TỨC. Mọi task khác có thể tranh
+ *              chấp resource đều có prio <= ceiling nên không được chạy
+ *              tới khi resource được nhả → không bao giờ phải chờ, không
+ *              đảo ưu tiên, không deadlock; thời gian bị chặn tối đa của
+ *              một task = đoạn găng dài nhất của task prio thấp hơn có
+ *              ceiling >= prio của nó.
+ *            - Mỗi task có một stack resource đang giữ: lồng nhau được,
+ *              nhưng phải nhả theo thứ tự LIFO.
+ *            - ReleaseResource: khôi phục prio đã lưu và gọi scheduler
+ *              ngay (task READY có prio cao hơn được chạy luôn).
+ *            - Task đang giữ resource không được Terminate/WaitEvent/
+ *              OS_Delay (E_OS_RESOURCE).
+ *
+ *          Mã lỗi:
+ *            - E_OS_ID       : r == NULL.
+ *            - E_OS_ACCESS   : prio gốc của task > ceiling (cấu hình sai),
+ *                              hoặc resource đang bị giữ (lấy lặp/sai ceiling).
+ *            - E_OS_LIMIT    : vượt quá MAX_RESOURCES lồng nhau.
+ *            - E_OS_NOFUNC   : nhả resource không giữ, hoặc sai thứ tự LIFO.
  *
  *          Đồng bộ:
- *            - Bảo vệ trường locked/owner trong critical section rất ngắn
- *              bằng __DISABLE_IRQ (tắt toàn bộ IRQ trong vài lệnh).
- *            - Chỉ tắt IRQ khi kiểm tra/ghi cờ; KHÔNG tắt IRQ khi chờ,
- *              nhằm tránh làm đơ SysTick và các ISR khác.
+ *            - Cập nhật locked/owner/prio/stack trong vùng găng ngắn
+ *              bằng __disable_irq (chỉ vài lệnh).
  *
- * @version  1.1
- * @date     2025-09-10 
+ * @version  1.2
+ * @date     2025-09-10
  * @author   Nguyễn Tuấn Khoa
  **********************************************************/
 
@@ -30,75 +50,120 @@
 #define OS_INVALID_TASK_OWNER ((TaskType)0xFFu)
 #endif
 
-extern TCB_t*g_current;
+extern volatile TCB_t *g_current;
 extern TCB_t tcb[OS_MAX_TASKS];
+extern void Os_Dispatch(void);
+
+/* =========================================================
+ * RES_SCHEDULER — ceiling = mức ưu tiên cao nhất của hệ thống
+ * =======================================================*/
+OsResource Os_ResScheduler = {
+    .locked      = 0u,
+    .ceilingPrio = (uint8_t)(OS_PRIO_LEVELS - 1u),
+    .owner       = OS_INVALID_TASK_OWNER
+};
+
+/* =========================================================
+ * Stack resource đang giữ của từng task (LIFO)
+ *  - res_stack[tid][0..res_top[tid]-1], đỉnh là resource lấy sau cùng.
+ * =======================================================*/
+static OsResource *res_stack[OS_MAX_TASKS][MAX_RESOURCES];
+static uint8_t     res_top[OS_MAX_TASKS];
+
+/* =========================================================
+ * Os_ResourceHeld
+ *  - true nếu task tid còn giữ ít nhất một resource.
+ *  - Dùng bởi TerminateTask/WaitEvent/OS_Delay để trả E_OS_RESOURCE.
+ * =======================================================*/
+bool Os_ResourceHeld(TaskType tid)
+{
+  return (res_top[tid] != 0u);
+}
+
 /* =========================================================
  * Resource_Init
  *  - Đưa resource về trạng thái rỗi (unlocked, owner = invalid)
+ *  - Giữ nguyên ceilingPrio đã cấu hình.
  * =======================================================*/
 void Resource_Init(OsResource* r)
 {
   if (!r) return;
-  r->locked = 0u;
-  r->owner  = OS_INVALID_TASK_OWNER;
+  r->locked    = 0u;
+  r->owner     = OS_INVALID_TASK_OWNER;
+  r->prev_prio = 0u;
 }
 /* =========================================================
  * GetResource
- *  - Chiếm mutex theo kiểu “đợi bận có nhường CPU”.
+ *  - Chiếm resource và nâng prio task hiện hành lên ceiling.
+ *  - Không chờ: với ceiling đúng, resource luôn rỗi khi task
+ *    được chạy tới lời gọi này.
  *  - Không gọi được từ ISR (thiết kế OS này hướng tới dùng trong Task).
- *  - Không hỗ trợ re-entrant: gọi lặp từ cùng một task là sai cách dùng.
  * =======================================================*/
-void GetResource(OsResource* r)
+StatusType GetResource(OsResource* r)
 {
-  if (!r) return;
-
-    /* Lấy danh tính task hiện hành (nếu chưa có task chạy thì thoát) */
+  if (!r) return E_OS_ID;
 
-    TaskType me = g_current->id;
-    TCB_t *t= &tcb[g_current->id];
-    /* Thử chiếm trong vùng găng rất ngắn */
-    __disable_irq();
-    if (r->locked == 0u) {
-      /* Tài nguyên đang rỗi → chiếm ngay */
-      r->locked = 1u;
-      r->owner  = me;
+  __disable_irq();
+  if (g_current == NULL) {
+    __enable_irq();
+    return E_OS_ACCESS;
+  }
+  TCB_t   *t  = (TCB_t *)g_current;
+  TaskType me = t->id;
 
-      if(t->prio < r->ceilingPrio){
-        t->prio = r->ceilingPrio;
-      }
+  if ((r->locked != 0u) || (t->base_prio > r->ceilingPrio)) {
+    __enable_irq();
+    return E_OS_ACCESS;
+  }
+  if (res_top[me] >= MAX_RESOURCES) {
     __enable_irq();
-      return;
-    }
+    return E_OS_LIMIT;
+  }
 
-    /* Đang bị giữ: nếu chính mình giữ thì KHÔNG hỗ trợ nested → rời vòng
-       (giữ nguyên trạng thái). Có thể đổi sang assert nếu muốn phát hiện sớm. */
-    if (r->owner == me) {
-      __enable_irq();
-      return; /* re-entrant không được hỗ trợ, coi như “đã giữ” */
-    }
+  r->locked    = 1u;
+  r->owner     = me;
+  r->prev_prio = t->prio;
+  res_stack[me][res_top[me]++] = r;
 
-    __enable_irq();
+  /* Task đang RUNNING không nằm trong ready queue → đổi prio trực tiếp */
+  if (t->prio < r->ceilingPrio) {
+    t->prio = r->ceilingPrio;
+  }
+  __enable_irq();
+  return E_OK;
 }
 
 
 /* =========================================================
  * ReleaseResource
- *  - Nhả mutex nếu và chỉ nếu chủ sở hữu hiện tại là task đang chạy.
- *  - Không hỗ trợ nested lock → 1 lần Get ↔ 1 lần Release.
+ *  - Nhả resource ở đỉnh stack của task hiện hành (LIFO).
+ *  - Khôi phục prio trước khi lấy và lập lịch lại ngay:
+ *    task READY có prio cao hơn sẽ preempt qua PendSV.
  * =======================================================*/
-void ReleaseResource(OsResource* r)
+StatusType ReleaseResource(OsResource* r)
 {
-  if (!r) return;
- 
-  TaskType me = g_current->id;
+  if (!r) return E_OS_ID;
 
   __disable_irq();
+  if (g_current == NULL) {
+    __enable_irq();
+    return E_OS_ACCESS;
+  }
+  TCB_t   *t  = (TCB_t *)g_current;
+  TaskType me = t->id;
 
-  if ((r->locked != 0u) && (r->owner == me)) {
-    r->locked = 0u;
-    r->owner  = OS_INVALID_TASK_OWNER;
+  if ((r->locked == 0u) || (r->owner != me) ||
+      (res_top[me] == 0u) || (res_stack[me][res_top[me] - 1u] != r)) {
+    __enable_irq();
+    return E_OS_NOFUNC;
   }
-  /* Nếu không phải chủ sở hữu hiện tại → bỏ qua (không làm gì). */
 
+  res_stack[me][--res_top[me]] = NULL;
+  t->prio   = r->prev_prio;
+  r->locked = 0u;
+  r->owner  = OS_INVALID_TASK_OWNER;
+
+  Os_Dispatch();
   __enable_irq();
+  return E_OK;
 }
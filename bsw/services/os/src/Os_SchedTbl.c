@@ -234,6 +234,42 @@ void ScheduleTable_tick(CounterTypeId cid){
     }   
 }
 
+/* =========================================================
+ * Os_SchedTbl_NextExpiry(cid, delta)
+ *  - Số đơn vị counter còn lại tới expiry point (hoặc điểm kết
+ *    thúc chu kỳ) gần nhất trong các table gắn với counter cid.
+ *  - Table ở ST_WAITING_START được xử lý ngay ở tick kế tiếp
+ *    (xem ScheduleTable_tick) → delta = 1.
+ *  - E_OS_NOFUNC nếu không có table nào đang chạy trên counter.
+ *  - Dùng cho tickless idle, gọi trong vùng găng.
+ * =======================================================*/
+StatusType Os_SchedTbl_NextExpiry(CounterTypeId cid, TickRefType delta){
+    if(cid >= OS_MAX_COUNTERS || delta == NULL) return E_OS_ID;
+
+    OsCounterCtl *c = &Counter_tbl[cid];
+    StatusType ret = E_OS_NOFUNC;
+    TickType best = 0u;
+
+    for(uint8_t i = 0u; i < OS_MAX_SchedTbl; i++){
+        OsSchedCtl *s = &Schedule_Table_List[i];
+        if(s->counter != c || s->state == ST_STOPPED) continue;
+
+        TickType d = 1u;
+        if(s->state == ST_RUNNING){
+            TickType elapsed = diff_wrap(c->current_value, s->start, c->max_allowed_Value);
+            TickType next = (s->current_ep < s->num_eps) ? s->eps[s->current_ep].offset
+                                                         : s->duration;
+            d = (next > elapsed) ? (next - elapsed) : 1u;
+        }
+        if(ret != E_OK || d < best){
+            best = d;
+            ret = E_OK;
+        }
+    }
+    if(ret == E_OK) *delta = best;
+    return ret;
+}
+
 void Os_SchedTbl_Init(void){
     OsSchedCtl *t = &Schedule_Table_List[0];
 
@@ -1,11 +1,12 @@
 /**********************************************************
  * @file    Os_Taks.c
  * @brief   Hạt nhân OS tối giản (Cortex-M3, STM32F103)
- * @details Scheduler round-robin trong cùng mức ưu tiên,
+ * @details Scheduler ưu tiên cố định có preempt (bitmap +
+ *          CLZ, O(1)), FIFO trong cùng mức ưu tiên,
  *          tick 1ms, hỗ trợ Activate/Terminate, Delay,
  *          Event (ở module khác), Alarm, và chuyển ngữ
- *          cảnh bằng PendSV. Không có idle task riêng;
- *          khi không còn READY sẽ WFI chờ ngắt.
+ *          cảnh bằng PendSV. Khi không còn READY sẽ
+ *          chọn Task_Idle (WFI chờ ngắt).
  *
  *          Lưu ý thiết kế:
  *            - PSP cho THREAD mode, MSP cho HANDLER mode.
@@ -13,7 +14,7 @@
  *              [xPSR, PC, LR, R12, R3, R2, R1, R0] + (R4-R11).
  *            - LR trong khung HW trỏ tới trampoline để
  *              Task return → TerminateTask().
- *            - OS_TASK_STACK_WORDS nên CHẴN để PSP 8-byte aligned.
+ *            - STACK_WORDS_* (Os_Cfg.h) nên CHẴN để PSP 8-byte aligned.
  *
  * @version  1.0
  * @date     2025-09-10
@@ -24,16 +25,42 @@
 #include "Os_Cfg.h"
 /* =========================================================
  * 1) Cấu hình stack cho từng task
- *    - Mỗi task có 1 stack riêng (full-descending).
- *    - OS_TASK_STACK_WORDS nên là số CHẴN để bảo đảm 8-byte align.
+ *    - Mỗi task có 1 stack riêng (full-descending), kích thước
+ *      lấy từ STACK_WORDS_* trong Os_Cfg.h.
+ *    - STACK_WORDS_* nên là số CHẴN để bảo đảm 8-byte align.
+ *    - Word thấp nhất (stack_bottom[0]) là guard word; phần còn lại
+ *      được tô OS_STACK_PAINT ở StartOS để đo high-water mark.
  * =======================================================*/
-
-#ifndef OS_TASK_STACK_WORDS
-#define OS_TASK_STACK_WORDS    256U
-#endif
-
-static uint32_t stack[OS_MAX_TASKS][OS_TASK_STACK_WORDS];
-#define STACK_TOP(tid)   (&stack[tid][OS_TASK_STACK_WORDS])
+#define OS_STACK_PAINT         0xA5A5A5A5u
+#define OS_STACK_GUARD         0xDEADBEEFu
+
+#define OS_DEFINE_STACK(tid, words) \
+    static uint32_t stack_##tid[(words)] __attribute__((aligned(8)))
+
+OS_DEFINE_STACK(TASK_INIT, STACK_WORDS_INIT);
+OS_DEFINE_STACK(TASK_A,    STACK_WORDS_A);
+OS_DEFINE_STACK(TASK_B,    STACK_WORDS_B);
+OS_DEFINE_STACK(TASK_C,    STACK_WORDS_C);
+OS_DEFINE_STACK(TASK_COM,  STACK_WORDS_COM);
+OS_DEFINE_STACK(TASK_IDLE, STACK_WORDS_IDLE);
+
+static uint32_t *const stack_base[OS_MAX_TASKS] = {
+    [TASK_INIT] = stack_TASK_INIT,
+    [TASK_A]    = stack_TASK_A,
+    [TASK_B]    = stack_TASK_B,
+    [TASK_C]    = stack_TASK_C,
+    [TASK_COM]  = stack_TASK_COM,
+    [TASK_IDLE] = stack_TASK_IDLE
+};
+static const uint16_t stack_words[OS_MAX_TASKS] = {
+    [TASK_INIT] = STACK_WORDS_INIT,
+    [TASK_A]    = STACK_WORDS_A,
+    [TASK_B]    = STACK_WORDS_B,
+    [TASK_C]    = STACK_WORDS_C,
+    [TASK_COM]  = STACK_WORDS_COM,
+    [TASK_IDLE] = STACK_WORDS_IDLE
+};
+#define STACK_TOP(tid)   (&stack_base[tid][stack_words[tid]])
 /* =================TEST_Schedule_Table======================*/
 void SetMode_Normal(void) {return 0;}
 void SetMode_Warning(void) {return 0;}
@@ -47,10 +74,21 @@ void SetMode_Off(void) {return 0;}
     extern Std_ReturnType IncrementCounter(CounterTypeId cid);
     extern OsAlarmCtl alarm_tbl[OS_MAX_ALARMS];
     extern OsCounterCtl Counter_tbl[OS_MAX_COUNTERS];
-    extern void os_alarm_tick(void);
     extern void Os_Alarm_Init(void);
     extern void ScheduleTable_tick(CounterTypeId cid);
     extern void Os_SchedTbl_Init(void);
+    extern StatusType Os_Alarm_NextExpiry(CounterTypeId cid, TickRefType delta);
+    extern StatusType Os_SchedTbl_NextExpiry(CounterTypeId cid, TickRefType delta);
+    extern TickType   Os_Counter_SourceTicks(CounterTypeId cid, TickType delta);
+    extern StatusType Os_Counter_Advance(CounterTypeId cid, TickType ticks);
+    extern bool Os_ResourceHeld(TaskType tid);
+#if (OS_TRACE_ENABLE == 1u)
+    extern void Os_Trace_Init(void);
+    extern void Os_Trace_Activate(TaskType tid, uint8_t count);
+    extern void Os_Trace_Overrun(TaskType tid);
+    extern void Os_Trace_Terminate(TaskType tid, uint8_t again);
+    extern void Os_Trace_Switch(TaskType tid);
+#endif
 /* =========================================================
  * 3) Khai báo thân Task do ứng dụng cung cấp (nếu định nghĩa trong file Os_Cfg rồi thì thôi)
  * ========================================================= */
@@ -61,48 +99,184 @@ void SetMode_Off(void) {return 0;}
 // extern void Task_Idle(void);
 
 /* =========================================================
- * 4) READY Queue (ring buffer) – chừa 1 ô để phân biệt FULL/EMPTY
+ * 4) Trạng thái runtime (export để module khác dùng)
+ *    - g_current: TCB đang RUNNING (PendSV khôi phục từ đây)
+ *    - g_next   : TCB mục tiêu sắp chuyển sang
+ *    - s_curr_idx: chỉ số task hiện hành (hỗ trợ API khác)
+ * =======================================================*/
+    TCB_t tcb[OS_MAX_TASKS];
+    volatile TCB_t *g_current = NULL;
+    volatile TCB_t *g_next    = NULL;
+   // uint8_t current_idx =-1;
+
+
+/* =========================================================
+ * 4) READY Queue — bitmap ưu tiên 2 mức + FIFO theo từng mức
+ *    - rdy_group : bit g = 1 ⇔ nhóm g (prio g*32..g*32+31) có task READY
+ *    - rdy_map[g]: bit b = 1 ⇔ mức prio (g*32 + b) có task READY
+ *    - rq_head/rq_tail[prio]: danh sách FIFO liên kết qua rq_next[tid]
+ *    - Chọn task ưu tiên cao nhất = 2 lệnh CLZ → O(1), không phụ thuộc
+ *      OS_MAX_TASKS hay số mức ưu tiên (tối đa 32*32 mức).
+ *    - TASK_IDLE không bao giờ nằm trong hàng đợi.
+ *    - Mọi hàm rq_* KHÔNG tự bọc IRQ: caller phải ở trong vùng găng.
  * ========================================================= */
-static uint8_t ready_q[OS_MAX_TASKS];
-static uint8_t rq_head = 0u;
-static uint8_t rq_tail = 0u;
+#define OS_RQ_NONE          ((uint8_t)0xFFu)
+#define OS_RQ_GROUPS        ((OS_PRIO_LEVELS + 31u) / 32u)
+
+#if (OS_PRIO_LEVELS > 256u)
+#error "OS_PRIO_LEVELS vượt quá phạm vi của TCB_t.prio (uint8_t)"
+#endif
+#if (OS_MAX_TASKS >= 0xFFu)
+#error "OS_MAX_TASKS phải < 255 (0xFF dùng làm OS_RQ_NONE)"
+#endif
+
+static uint32_t rdy_group;
+static uint32_t rdy_map[OS_RQ_GROUPS];
+static uint8_t  rq_head[OS_PRIO_LEVELS];
+static uint8_t  rq_tail[OS_PRIO_LEVELS];
+static uint8_t  rq_next[OS_MAX_TASKS];
 
 static inline void rq_reset(void){
-    rq_head = 0;
-    rq_tail = 0;
+    rdy_group = 0u;
+    for(uint32_t g = 0u; g < OS_RQ_GROUPS; g++){
+        rdy_map[g] = 0u;
+    }
+    for(uint32_t p = 0u; p < OS_PRIO_LEVELS; p++){
+        rq_head[p] = OS_RQ_NONE;
+        rq_tail[p] = OS_RQ_NONE;
+    }
 }
 static inline bool rq_empty(void){
-    return (rq_head == rq_tail);
+    return (rdy_group == 0u);
 }
-static inline bool rq_full(void){
-    return (uint8_t)((rq_tail + 1) % OS_MAX_TASKS) == rq_head;
+static inline void rq_mark(uint8_t prio){
+    rdy_map[prio >> 5] |= (1u << (prio & 31u));
+    rdy_group          |= (1u << (prio >> 5));
 }
-static inline bool rq_push(uint8_t tid){
-    if(rq_full()){
-        return false;
+static inline void rq_unmark(uint8_t prio){
+    rdy_map[prio >> 5] &= ~(1u << (prio & 31u));
+    if(rdy_map[prio >> 5] == 0u){
+        rdy_group &= ~(1u << (prio >> 5));
     }
-    ready_q[rq_tail] = tid;
-    rq_tail = (uint8_t)((rq_tail + 1) % OS_MAX_TASKS);
-    return true;
 }
+/* Mức ưu tiên cao nhất đang có task READY (chỉ gọi khi !rq_empty()) */
+static inline uint8_t rq_top_prio(void){
+    uint32_t g = 31u - __CLZ(rdy_group);
+    uint32_t b = 31u - __CLZ(rdy_map[g]);
+    return (uint8_t)((g << 5) | b);
+}
+/* Thêm vào CUỐI FIFO của mức prio (task mới READY) */
+static inline void rq_push(uint8_t tid){
+    uint8_t prio = tcb[tid].prio;
+    rq_next[tid] = OS_RQ_NONE;
+    if(rq_tail[prio] == OS_RQ_NONE){
+        rq_head[prio] = tid;
+    } else {
+        rq_next[rq_tail[prio]] = tid;
+    }
+    rq_tail[prio] = tid;
+    rq_mark(prio);
+}
+/* Thêm vào ĐẦU FIFO của mức prio (task bị preempt → chạy tiếp trước) */
+static inline void rq_push_front(uint8_t tid){
+    uint8_t prio = tcb[tid].prio;
+    rq_next[tid] = rq_head[prio];
+    if(rq_head[prio] == OS_RQ_NONE){
+        rq_tail[prio] = tid;
+    }
+    rq_head[prio] = tid;
+    rq_mark(prio);
+}
+/* Lấy task đầu FIFO của mức ưu tiên cao nhất */
 static inline bool rq_pop_raw(uint8_t *out_tid){
-    if(rq_empty()) 
+    if(rq_empty())
         return false;
-    *out_tid = ready_q[rq_head];
-    rq_head = (uint8_t)((rq_head + 1u) % OS_MAX_TASKS);
+    uint8_t prio = rq_top_prio();
+    uint8_t tid  = rq_head[prio];
+    rq_head[prio] = rq_next[tid];
+    if(rq_head[prio] == OS_RQ_NONE){
+        rq_tail[prio] = OS_RQ_NONE;
+        rq_unmark(prio);
+    }
+    rq_next[tid] = OS_RQ_NONE;
+    *out_tid = tid;
     return true;
 }
 /* =========================================================
- * 4) Trạng thái runtime (export để module khác dùng)
- *    - g_current: TCB đang RUNNING (PendSV khôi phục từ đây)
- *    - g_next   : TCB mục tiêu sắp chuyển sang
- *    - s_curr_idx: chỉ số task hiện hành (hỗ trợ API khác)
- * =======================================================*/
-    TCB_t tcb[OS_MAX_TASKS];
-    volatile TCB_t *g_current = NULL;
-    volatile TCB_t *g_next    = NULL;
-   // uint8_t current_idx =-1;
+ * 4b) Hàng đợi TIMEOUT — task ngủ sắp theo thời điểm thức
+ *    - os_ticks  : tick kernel (1 tick/SysTick), không wrap theo counter.
+ *    - tq_head   : task thức sớm nhất; tq_next/tq_prev: danh sách kép
+ *                  sắp tăng dần theo tcb[].wake_tick (bằng nhau → FIFO).
+ *    - Chèn: O(số task đang ngủ); huỷ (SetEvent tới trước): O(1).
+ *    - Mỗi tick chỉ so sánh đầu danh sách → O(số task hết hạn),
+ *      không quét toàn bộ OS_MAX_TASKS.
+ *    - Phục vụ OS_Delay(), WaitEventTimeout() (Os_Event.c).
+ *    - Các hàm tq_* / Os_Timeout* không tự bọc IRQ: caller trong vùng găng.
+ * ========================================================= */
+static volatile TickType os_ticks;
+static uint8_t tq_head;
+static uint8_t tq_next[OS_MAX_TASKS];
+static uint8_t tq_prev[OS_MAX_TASKS];
+static bool    tq_linked[OS_MAX_TASKS];
+
+TickType OS_TickCount(void){
+    return os_ticks;
+}
 
+/* So sánh an toàn khi os_ticks tràn 32-bit */
+static inline bool tq_before(TickType a, TickType b){
+    return (int32_t)(a - b) < 0;
+}
+static inline void tq_reset(void){
+    tq_head = OS_RQ_NONE;
+    for(uint32_t i = 0u; i < OS_MAX_TASKS; i++){
+        tq_next[i]   = OS_RQ_NONE;
+        tq_prev[i]   = OS_RQ_NONE;
+        tq_linked[i] = false;
+    }
+}
+/* Đưa task tid vào hàng đợi, thức sau 'ticks' tick kể từ bây giờ */
+void Os_TimeoutArm(TaskType tid, TickType ticks){
+    TickType wake = os_ticks + ticks;
+    uint8_t prev = OS_RQ_NONE;
+    uint8_t cur  = tq_head;
+
+    while((cur != OS_RQ_NONE) && !tq_before(wake, tcb[cur].wake_tick)){
+        prev = cur;
+        cur  = tq_next[cur];
+    }
+    tcb[tid].wake_tick = wake;
+    tcb[tid].timed_out = 0u;
+    tq_prev[tid] = prev;
+    tq_next[tid] = cur;
+    if(prev == OS_RQ_NONE){
+        tq_head = tid;
+    } else {
+        tq_next[prev] = tid;
+    }
+    if(cur != OS_RQ_NONE){
+        tq_prev[cur] = tid;
+    }
+    tq_linked[tid] = true;
+}
+/* Gỡ task tid khỏi hàng đợi (bị đánh thức trước hạn); bỏ qua nếu không có */
+void Os_TimeoutCancel(TaskType tid){
+    if(!tq_linked[tid])
+        return;
+    uint8_t prev = tq_prev[tid];
+    uint8_t next = tq_next[tid];
+    if(prev == OS_RQ_NONE){
+        tq_head = next;
+    } else {
+        tq_next[prev] = next;
+    }
+    if(next != OS_RQ_NONE){
+        tq_prev[next] = prev;
+    }
+    tq_next[tid]   = OS_RQ_NONE;
+    tq_prev[tid]   = OS_RQ_NONE;
+    tq_linked[tid] = false;
+}
 /* =========================================================
  * 5) Fallback WFI (nếu vắng CMSIS)
  * =======================================================*/
@@ -112,119 +286,112 @@ static inline bool rq_pop_raw(uint8_t *out_tid){
 #endif
 
 /* =========================================================
- * 6) Trampoline
- *    - Bảo đảm task không rơi vào EXC_RETURN ngẫu nhiên.
- * =======================================================*/
-
-static void task_exit_trampoline(void)
-{
-      for (;;) {
-        __WFI(); /* ngủ vĩnh viễn */
-    }
-}
-
-/* =========================================================
- * 7) os_task_stack_init()
- *    - Dựng khung stack ban đầu đúng thứ tự do HW pop sau
- *      khi thoát exception 
+ * 6) Khung stack ban đầu của task
+ *    - Dựng trong lớp arch: Os_Arch_StackInit(tid, entry, top)
+ *      (Cortex-M3: HW/SW-frame + trampoline; POSIX: ucontext).
+ *    - Gọi lại mỗi khi task chạy lại từ entry (ActivateTask,
+ *      restart trong schedule()/os_svc_prepare()).
  * =======================================================*/
 
- uint32_t *os_task_stack_init(TaskEntry_t entry, void *arg, uint32_t *top){
-
-    /* 1) Căn chỉnh 8 byte: yêu cầu AAPCS + đảm bảo khi vào ISR/HW stack */
-    uint32_t *sp = (uint32_t*)((uintptr_t)top & ~((uintptr_t)0x07));
-    /* 2) ---- HW-stacked frame ----
-     *  Thứ tự "unstack" của HW khi EXC_RETURN:
-     *    R0, R1, R2, R3, R12, LR, PC, xPSR
-     *
-     *  Ta push theo thứ tự ngược lại để khi pop ra đúng:
-     *    xPSR → PC → LR → R12 → R3 → R2 → R1 → R0
-     */
-    *(--sp) = 0x01000000u;                           /* xPSR: T-bit=1 (Thumb) */
-    *(--sp) = ((uint32_t)entry) | 1u;                /* PC: địa chỉ hàm entry | 1 */
-    *(--sp) = ((uint32_t)task_exit_trampoline)|1u;   /* LR: nếu entry return → thoát */
-    *(--sp) = 0x12121212u;                           /* R12 */
-    *(--sp) = 0x03030303u;                           /* R3  */
-    *(--sp) = 0x02020202u;                           /* R2  */
-    *(--sp) = 0x01010101u;                           /* R1  */
-    *(--sp) = (uint32_t)arg;                         /* R0  (tham số truyền vào entry) */
-    /* 3) ---- SW-saved frame (R4..R11) ----
-     *  Đặt ngay bên dưới HW-frame. Khi LDMIA {r4-r11}, con trỏ PSP sẽ tiến
-     *  đến &R0 (đầu HW-frame), đúng kỳ vọng của PendSV restore.
-     *  Giá trị khởi tạo 0 là đủ (không bắt buộc).
-     */
-    *(--sp) = 0x11111111u; /* R11 */
-    *(--sp) = 0x10101010u; /* R10 */
-    *(--sp) = 0x09090909u; /* R9  */
-    *(--sp) = 0x08080808u; /* R8  */
-    *(--sp) = 0x07070707u; /* R7  */
-    *(--sp) = 0x06060606u; /* R6  */
-    *(--sp) = 0x05050505u; /* R5  */
-    *(--sp) = 0x04040404u; /* R4  */
-
-    /* 4) Trả về địa chỉ &R4 (đầu SW-frame) để nạp vào TCB->sp.
-     *    Sau khi PendSV restore SW-frame, PSP sẽ = &R0 (đầu HW-frame).
-     */
-    return sp;
-}
 /* =========================================================
  * 8) schedule()
  * ---------------------------------------------------------
  * Mục tiêu:
- *   - Chọn "next" (TCB kế tiếp) để chạy.
+ *   - Scheduler ưu tiên cố định, có preempt (full-preemptive):
+ *     chọn task READY có prio cao nhất (bitmap + CLZ, O(1)).
+ *   - Task đang RUNNING chỉ bị preempt khi có task READY có
+ *     prio CAO HƠN hẳn; cùng prio → chạy tới khi kết thúc/chờ.
+ *   - Task bị preempt được đưa về ĐẦU FIFO mức prio của nó
+ *     (OSEK: là task chạy tiếp đầu tiên ở mức đó).
  *   - Nếu READY queue rỗng → chọn IDLE.
  *   - Đặt yêu cầu đổi ngữ cảnh bằng PendSV (trì hoãn tới cuối ISR).
  *
  * Bối cảnh gọi:
- *   - Có thể được gọi trong ISR (ví dụ từ os_on_tick) hoặc từ Thread
- *     (ví dụ TerminateTask). Nếu gọi từ Thread, caller nên bọc vùng
- *     tới hạn (tắt IRQ ngắn hạn) trước/sau khi gọi để tránh race
- *     với ISR cũng đang thao tác READY queue.
+ *   - Caller PHẢI đang trong vùng găng (__disable_irq). Gọi được từ
+ *     ISR (ActivateTask/SetEvent trong SysTick, CAN RX...) hoặc từ
+ *     Thread (Terminate/WaitEvent): PendSV chạy ngay khi mở IRQ.
  *
  * Quy ước:
  *   - g_next: con trỏ TCB của task sẽ được chuyển tới (vé chuyển cảnh).
- *     + Nếu g_next != NULL: đã có chuyển ngữ cảnh pending → không
- *       chọn thêm (tránh ghi đè vé cũ).
- *   - rq_pop_raw(): pop 1 task ID từ READY queue (không tự bọc IRQ).
+ *     + Nếu g_next != NULL: PendSV chưa tiêu thụ vé cũ → trả task đó
+ *       về ĐẦU hàng đợi rồi chọn lại, để task ưu tiên cao hơn vừa
+ *       READY trong cùng ISR không bị trễ thêm một lượt.
  *   - TASK_IDLE: task rỗi, KHÔNG enqueue; chỉ được chọn khi queue rỗng.
- *   - os_trigger_pendsv(): đặt bit PENDSVSET để yêu cầu PendSV chạy.
+ *
+ * Kiểm tra tràn stack (OS_STACK_CHECK = 1):
+ *   - Mỗi lần đổi ngữ cảnh, guard word của task sắp rời CPU phải còn
+ *     nguyên; bị ghi đè → ShutdownOS(E_OS_STACKFAULT).
  *
  * Yêu cầu với PendSV_Handler:
  *   - Sau khi chuyển xong: g_current = g_next; g_next = NULL;
- *     (xóa vé) để lần sau schedule() có thể đặt vé mới.
- *
- * Trả về:
- *   - true luôn (vì nếu không có READY thì vẫn chọn IDLE).
+ *   - Đọc g_next lần cuối → ghi g_current/g_next phải trong vùng găng
+ *     (CPSID i): nếu ISR gọi schedule() chen giữa, vé vừa đọc đã bị
+ *     hoàn lại vào hàng đợi mà PendSV vẫn chạy task đó.
  * ========================================================= */
 static bool schedule(void)
 {
-    if(g_next != NULL) return true;
-
+    TCB_t *cur  = (TCB_t *)g_current;
+    TCB_t *idle = &tcb[TASK_IDLE];
+    TCB_t *next;
     uint8_t tid;
-    TCB_t *next = NULL;
-    bool ok = rq_pop_raw(&tid);
 
-    if(!ok){
-        // Không có READY -> đừng Pendsv, chuyển sang idle
-        next = &tcb[TASK_IDLE];
-    } else {
-        next = &tcb[tid];
-        if(next->state != OS_TASK_READY){
-            // lỗi logic: task không ở trạng thái READY
-            next = &tcb[TASK_IDLE];
-        } else {
-            next -> state = OS_TASK_RUNNING;
+    /* 1) Vé cũ chưa được PendSV tiêu thụ → hoàn lại để chọn lại */
+    if(g_next != NULL){
+        TCB_t *pend = (TCB_t *)g_next;
+        g_next = NULL;
+        pend->state = OS_TASK_READY;
+        if(pend != idle){
+            rq_push_front(pend->id);
         }
     }
+
+    /* 2) Task hiện hành còn chạy được → chỉ nhường cho prio cao hơn */
+    if((cur != NULL) && (cur->state == OS_TASK_RUNNING)){
+        if(rq_empty()){
+            return true;
+        }
+        if((cur != idle) && (rq_top_prio() <= cur->prio)){
+            return true;
+        }
+        cur->state = OS_TASK_READY;
+        if(cur != idle){
+            rq_push_front(cur->id);
+        }
+    }
+
+    /* 3) Chọn task READY ưu tiên cao nhất (hoặc IDLE) */
+    next = rq_pop_raw(&tid) ? &tcb[tid] : idle;
+    next->state = OS_TASK_RUNNING;
+
+    if(next == cur){
+        /* Vé vừa hoàn lại lại trỏ về chính task hiện hành → không đổi */
+        return true;
+    }
+    if(next->restart){
+        /* Lần kích kế tiếp (multiple activation): chạy lại từ entry */
+        next->restart = 0u;
+        next->sp = Os_Arch_StackInit(next->id, next->entry, STACK_TOP(next->id));
+    }
+#if (OS_STACK_CHECK == 1u)
+    /* Task sắp rời CPU đã ghi đè guard word → tràn stack */
+    if((cur != NULL) && (cur->stack_bottom[0] != OS_STACK_GUARD)){
+        ShutdownOS(E_OS_STACKFAULT);
+    }
+#endif
     g_next = next;
-    //PreTaskHook();
     __DSB(); __ISB();
     Os_Arch_TriggerPendSV();
     return true;
 }
 
 /* =========================================================
- *  9) ActivateTask(): DORMANT → READY (không kích chồng)
+ *  9) ActivateTask(): SUSPENDED → READY, kích chồng có giới hạn
+ *     - Gọi được từ TASK hoặc ISR; nếu task vừa READY có prio
+ *       cao hơn task đang chạy → preempt qua PendSV.
+ *     - Task đang READY/RUNNING/WAITING: ghi nhận thêm một lần
+ *       kích (ActivationCount) nếu chưa vượt OsTaskActivation;
+ *       TerminateTask() sẽ cho task chạy lại từ đầu.
+ *     - Vượt giới hạn → E_OS_LIMIT và tăng OverrunCount.
  * ========================================================= */
 
  StatusType ActivateTask(uint8_t tid){
@@ -232,44 +399,115 @@ static bool schedule(void)
 
     __disable_irq();
     TCB_t *t = &tcb[tid];
-    if(t->state == OS_TASK_SUSPENDED || t -> state == OS_TASK_WAITING){
+    if(t->state == OS_TASK_SUSPENDED){
         /*  Quan trọng dựng lại PSP để task lại từ đầu entry*/
-        t->sp = os_task_stack_init(t->entry, 0, STACK_TOP(tid));
+        if(t == g_current){
+            /* ISR chen vào đoạn cuối TerminateTask(), task vẫn đang chạy
+             * trên stack này → dựng lại lười (schedule/os_svc_prepare) */
+            t->restart = 1u;
+        } else {
+            t->sp = Os_Arch_StackInit(tid, t->entry, STACK_TOP(tid));
+            t->restart = 0u;
+        }
+        t->ActivationCount = 1u;
         t->state = OS_TASK_READY;
-        (void)rq_push(tid);
-
-        if(g_current == NULL){
-            g_current = &tcb[tid];
-            tcb[TASK_IDLE].sp = os_task_stack_init(tcb[TASK_IDLE].entry, 0, STACK_TOP(TASK_IDLE));
-            //g_next = g_current;
-        };
-        
-        if((g_current == &tcb[TASK_IDLE]) && (g_next == NULL)){
-            __DSB(); __ISB();
-            Os_Arch_TriggerPendSV();
+        rq_push(tid);
+#if (OS_TRACE_ENABLE == 1u)
+        Os_Trace_Activate(tid, 1u);
+#endif
+
+        /* Trước StartOS chưa có task chạy: StartOS tự chọn task đầu tiên */
+        if(g_current != NULL){
+            (void)schedule();
         }
+    } else if(t->ActivationCount < t->OsTaskActivation){
+        t->ActivationCount++;
+#if (OS_TRACE_ENABLE == 1u)
+        Os_Trace_Activate(tid, t->ActivationCount);
+#endif
+    } else {
+        if(t->OverrunCount < 0xFFFFu){
+            t->OverrunCount++;
+        }
+#if (OS_TRACE_ENABLE == 1u)
+        Os_Trace_Overrun(tid);
+#endif
+        __enable_irq();
+        return E_OS_LIMIT;
     }
     __enable_irq();
     return E_OK;
  }
+
+/* =========================================================
+ *  Os_MakeReady(): WAITING → READY (dùng bởi SetEvent...)
+ *     - Không dựng lại stack: task tiếp tục ngay sau WaitEvent().
+ *     - Caller phải đang trong vùng găng.
+ * ========================================================= */
+void Os_MakeReady(TaskType tid){
+    TCB_t *t = &tcb[tid];
+    t->state = OS_TASK_READY;
+    rq_push(tid);
+    (void)schedule();
+}
+
+/* =========================================================
+ *  Os_Dispatch(): task hiện hành vừa rời RUNNING (WAITING/
+ *     SUSPENDED) → chọn task kế tiếp. Caller trong vùng găng.
+ * ========================================================= */
+void Os_Dispatch(void){
+    (void)schedule();
+}
 /* =========================================================
  *  10) TerminateTask(): Task tự kết thúc → DORMANT và chuyển lịch
+ *     - ActivationCount > 1: tiêu thụ một lần kích, task READY lại
+ *       (cuối FIFO) với cờ restart; khung stack được dựng lại lười
+ *       khi task được chọn (schedule) hoặc trong SVC nếu chọn ngay.
  * ========================================================= */
 StatusType TerminateTask(void){
 
     __disable_irq();
     TCB_t *cur = (TCB_t *) g_current;
-    
+
+    /* OSEK: không được kết thúc khi còn giữ resource */
+    if ((cur != NULL) && Os_ResourceHeld(cur->id)){
+        __enable_irq();
+        return E_OS_RESOURCE;
+    }
     if (cur){
-        cur -> state = OS_TASK_SUSPENDED;
+        if (cur->ActivationCount > 1u){
+            /* Còn lần kích đang chờ → vào cuối FIFO mức prio, chạy lại từ entry */
+            cur->ActivationCount--;
+            cur->restart = 1u;
+            cur->state = OS_TASK_READY;
+            rq_push(cur->id);
+        } else {
+            cur->ActivationCount = 0u;
+            cur->state = OS_TASK_SUSPENDED;
+        }
+#if (OS_TRACE_ENABLE == 1u)
+        Os_Trace_Terminate(cur->id, cur->restart);
+#endif
     }
-    //PostTaskHook();
-    __enable_irq();
     (void)schedule();
 
+    if ((cur != NULL) && (cur->state == OS_TASK_RUNNING)){
+        /* Chính task này lại được chọn: không thể dựng lại stack đang
+         * dùng → SVC khởi chạy lại g_current (os_svc_prepare dựng khung) */
+        __enable_irq();
+        Os_Arch_StartFirstTask();
+    }
+    __enable_irq();
 
+    /* Chờ PendSV rời CPU. ISR chen vào trước đó có thể ActivateTask()
+     * lại chính task này (cờ restart) và chọn nó ngay → khởi chạy lại
+     * bằng SVC thay vì kẹt ở đây với trạng thái RUNNING. */
     for(;;){
-        __NOP();
+        if ((cur != NULL) && (g_current == cur) && (g_next == NULL) &&
+            (cur->state == OS_TASK_RUNNING)){
+            Os_Arch_StartFirstTask();
+        }
+        __WFI();
     }
 }
 /* ===========================================================
@@ -280,34 +518,233 @@ void ChainTask(TaskType tid){
     ActivateTask(tid);
 }
 
+/* ===========================================================
+ * 11a) OS_Delay(): Task hiện hành ngủ 'ms' mili-giây
+ *     - RUNNING → WAITING, nằm trong hàng đợi timeout tới khi hết hạn.
+ *     - ms = 0 hoặc task đang giữ resource → trả về ngay.
+ *       Không gọi từ ISR / Task_Idle.
+ * =============================================================*/
+void OS_Delay(uint32_t ms){
+    TickType ticks = (TickType)(((uint64_t)ms * OS_TICK_HZ + 999u) / 1000u);
+    if(ticks == 0u)
+        return;
+
+    __disable_irq();
+    TCB_t *cur = (TCB_t *)g_current;
+    if((cur == NULL) || (cur->id == TASK_IDLE) || Os_ResourceHeld(cur->id)){
+        __enable_irq();
+        return;
+    }
+    cur->WaitEvent = 0u;
+    cur->state = OS_TASK_WAITING;
+    Os_TimeoutArm(cur->id, ticks);
+    (void)schedule();
+    __enable_irq();
+}
+
  
 /* =========================================================
  *  os_on_tick(): gọi mỗi nhịp SysTick (ISR context)
- *   - Tăng tick, quét Alarm → ActivateTask() khi đến hạn
- *   - Run-to-completion: chỉ schedule ngay khi current là IDLE
+ *   - Đánh thức các task hết hạn trong hàng đợi timeout
+ *     (chỉ xét đầu danh sách → O(số task hết hạn)).
+ *   - Tăng counter hệ thống; IncrementCounter() xử lý các Alarm
+ *     tới hạn của counter → ActivateTask()/SetEvent()
+ *   - Preempt do ActivateTask()/SetEvent() tự gọi schedule()
  * ========================================================= */
+static void os_timeout_tick(void)
+{
+    bool woke = false;
+
+    __disable_irq();
+    os_ticks++;
+    while((tq_head != OS_RQ_NONE) && !tq_before(os_ticks, tcb[tq_head].wake_tick)){
+        uint8_t tid = tq_head;
+        Os_TimeoutCancel(tid);
+        tcb[tid].timed_out = 1u;
+        tcb[tid].WaitEvent = 0u;
+        tcb[tid].state = OS_TASK_READY;
+        rq_push(tid);
+        woke = true;
+    }
+    if(woke){
+        (void)schedule();
+    }
+    __enable_irq();
+}
 
 void os_on_tick(void)
 {
-    (void)IncrementCounter(0); // Sử dụng hàm đã có để tăng counter
-    /* Quét mọi alarm (ISR: atomic với thread) */
-    os_alarm_tick();
+    os_timeout_tick();
+    /* Tăng counter 0 + bắn các alarm tới hạn (ISR: atomic với thread) */
+    (void)IncrementCounter(0);
     //ScheduleTable_tick(0);
-    /* Giảm latency: nếu chưa có pending switch và đang ở IDLE → chọn ngay */
-    if ((g_next == NULL) && (g_current == &tcb[TASK_IDLE])) {
-        (void)schedule();
+}
+
+/* =========================================================
+ * 11b) Tickless idle
+ *  os_next_wakeup(): số tick SysTick tới lần tới hạn sớm nhất
+ *    của counter 0 (alarm + schedule table) và hàng đợi timeout;
+ *    không có gì chờ → ngủ tối đa mà phần arch cho phép.
+ *  Os_IdleSleep(): gọi từ Task_Idle thay cho __WFI().
+ *    - Khoá ngắt, bỏ qua nếu đang có task chờ chuyển ngữ cảnh.
+ *    - Ngủ tới lần tới hạn kế tiếp (Os_Arch_TicklessSleep).
+ *    - Bù các tick đã bỏ qua vào os_ticks và Counter_tbl (Os_Counter_Advance),
+ *      rồi mở ngắt để ISR đánh thức (và tick cuối) được xử lý.
+ * =======================================================*/
+#if (OS_TICKLESS_IDLE == 1u)
+static TickType os_next_wakeup(void)
+{
+    TickType best = 0u;
+    TickType d;
+    bool found = false;
+
+    /* delta = 0 hợp lệ (tới hạn ngay tick kế) → cờ riêng, không dùng 0 làm "không có" */
+    if (Os_Alarm_NextExpiry(0, &d) == E_OK) {
+        best = d;
+        found = true;
+    }
+    if (Os_SchedTbl_NextExpiry(0, &d) == E_OK && (!found || d < best)) {
+        best = d;
+        found = true;
+    }
+    best = found ? Os_Counter_SourceTicks(0, best) : (TickType)0xFFFFFFFFu;
+
+    /* Task ngủ sớm nhất trong hàng đợi timeout (đã tính theo tick SysTick) */
+    if (tq_head != OS_RQ_NONE) {
+        TickType wake = tcb[tq_head].wake_tick;
+        d = tq_before(os_ticks, wake) ? (wake - os_ticks) : 1u;
+        if (d < best) {
+            best = d;
+        }
+    }
+    return best;
+}
+#endif
+
+void Os_IdleSleep(void)
+{
+#if (OS_TICKLESS_IDLE == 1u)
+    __disable_irq();
+    if (g_next != NULL) {
+        __enable_irq();
+        return;
+    }
+    TickType sleep = os_next_wakeup();
+    if (sleep < OS_TICKLESS_MIN_TICKS) {
+        __enable_irq();
+        __WFI();
+        return;
+    }
+    TickType slept = Os_Arch_TicklessSleep(sleep);
+    os_ticks += slept;
+    (void)Os_Counter_Advance(0, slept);
+    __enable_irq();
+#else
+    __WFI();
+#endif
+}
+
+/* =========================================================
+ * 11c) os_switch_out()/os_switch_in(): gọi từ PendSV_Handler
+ *   - os_switch_out: trước khi lưu ngữ cảnh, g_current = task sắp
+ *     rời CPU → PostTaskHook().
+ *   - os_switch_in : sau khi khôi phục, g_current = task vừa được
+ *     chạy → đo thời gian (Os_Trace_Switch) rồi PreTaskHook().
+ *   - Chỉ gọi khi thực sự đổi ngữ cảnh (vé g_next bị hoàn lại trong
+ *     schedule() không sinh hook).
+ * =======================================================*/
+void os_switch_out(void)
+{
+    PostTaskHook();
+}
+
+void os_switch_in(void)
+{
+#if (OS_TRACE_ENABLE == 1u)
+    __disable_irq();
+    Os_Trace_Switch(g_current->id);
+    __enable_irq();
+#endif
+    PreTaskHook();
+}
+
+/* =========================================================
+ * 11d) os_svc_prepare(): gọi từ SVC_Handler trước khi khởi chạy
+ *   g_current. Task được TerminateTask() chọn lại ngay (restart)
+ *   → dựng lại khung stack tại đây (trong SVC, không bị PendSV chen).
+ *   Task đầu tiên / task chạy lại cũng đi qua os_switch_in() như PendSV.
+ * =======================================================*/
+void os_svc_prepare(void)
+{
+    TCB_t *t = (TCB_t *)g_current;
+    if ((t != NULL) && t->restart) {
+        PostTaskHook();
+        t->restart = 0u;
+        t->sp = Os_Arch_StackInit(t->id, t->entry, STACK_TOP(t->id));
+    }
+    if (t != NULL) {
+        os_switch_in();
     }
 }
 
+/* =========================================================
+ * Os_GetActivationOverrun(): số lần ActivateTask() bị từ chối
+ *   (E_OS_LIMIT) của task — dấu hiệu alarm/schedule table kích
+ *   nhanh hơn task xử lý kịp. Bão hoà ở 0xFFFF.
+ * =======================================================*/
+uint16_t Os_GetActivationOverrun(TaskType tid)
+{
+    if (tid >= OS_MAX_TASKS) {
+        return 0u;
+    }
+    return tcb[tid].OverrunCount;
+}
+
+/* =========================================================
+ * GetTaskID(): ID task đang RUNNING (OSEK)
+ *   - Gọi từ ISR: task bị ngắt; chưa có task nào → INVALID_TASK.
+ * =======================================================*/
+StatusType GetTaskID(TaskRefType tid)
+{
+    if (tid == NULL) {
+        return E_OS_ID;
+    }
+    const TCB_t *t = (const TCB_t *)g_current;
+    *tid = (t != NULL) ? t->id : INVALID_TASK;
+    return E_OK;
+}
+
+/* =========================================================
+ * 11e) Os_GetStackUsage(): high-water mark stack của task
+ *   - Đếm từ đáy (bỏ qua guard word) các word còn giữ OS_STACK_PAINT;
+ *     phần còn lại là vùng đã từng bị dùng kể từ StartOS.
+ *   - Trả về số byte (0 nếu tid không hợp lệ). Chỉ đọc, gọi từ Task
+ *     bất kỳ (ví dụ Task_Idle hay task chẩn đoán) để tinh chỉnh
+ *     STACK_WORDS_* trong Os_Cfg.h.
+ * =======================================================*/
+uint32_t Os_GetStackUsage(TaskType tid)
+{
+    if (tid >= OS_MAX_TASKS) {
+        return 0u;
+    }
+    const uint32_t *p = stack_base[tid];
+    uint32_t w = 1u;
+    while ((w < stack_words[tid]) && (p[w] == OS_STACK_PAINT)) {
+        w++;
+    }
+    return (uint32_t)(stack_words[tid] - w) * sizeof(uint32_t);
+}
+
 /* =========================================================
  * 12) Cấu hình tĩnh các Task (ứng dụng cung cấp)
  * ========================================================= */
 const TCB_t Os_TaskConfig [OS_MAX_TASKS]={
-    [TASK_INIT] = {.entry = Task_Init, .name = "InitTask", .id = TASK_INIT, .prio = 1u, .isExtended =0u},
-    [TASK_A]    = {.entry = Task_A,    .name = "Task_A",   .id = TASK_A,    .prio = 2u, .isExtended =0u},
-    [TASK_B]    = {.entry = Task_B,    .name = "Task_B",   .id = TASK_B,    .prio = 1u, .isExtended =1u},
-    [TASK_IDLE] = {.entry = Task_Idle, .name = "Task_Idle",.id = TASK_IDLE, .prio = 1u, .isExtended =1u},
-    [TASK_C]    = {.entry = Task_C,    .name = "Task_C",   .id = TASK_C,    .prio = 1u, .isExtended =1u}
+    [TASK_INIT] = {.entry = Task_Init, .name = "InitTask", .id = TASK_INIT, .prio = 1u, .isExtended =0u, .OsTaskActivation = 1u},
+    [TASK_A]    = {.entry = Task_A,    .name = "Task_A",   .id = TASK_A,    .prio = 2u, .isExtended =0u, .OsTaskActivation = 2u},
+    [TASK_B]    = {.entry = Task_B,    .name = "Task_B",   .id = TASK_B,    .prio = 1u, .isExtended =1u, .OsTaskActivation = 1u},
+    [TASK_IDLE] = {.entry = Task_Idle, .name = "Task_Idle",.id = TASK_IDLE, .prio = 0u, .isExtended =1u, .OsTaskActivation = 1u},
+    [TASK_C]    = {.entry = Task_C,    .name = "Task_C",   .id = TASK_C,    .prio = 1u, .isExtended =1u, .OsTaskActivation = 1u},
+    [TASK_COM]  = {.entry = Task_Com,  .name = "Task_Com", .id = TASK_COM,  .prio = 3u, .isExtended =0u, .OsTaskActivation = 1u}
 };
 
 /* =========================================================
@@ -329,7 +766,27 @@ StatusType StartOS(AppModeType appMode){
         tcb[i].state = OS_TASK_SUSPENDED;
         tcb[i].SetEvent = 0u;
         tcb[i].WaitEvent = 0u;
+        tcb[i].base_prio = tcb[i].prio;
+        tcb[i].ActivationCount = 0u;
+        tcb[i].OverrunCount = 0u;
+        tcb[i].restart = 0u;
+        if(tcb[i].OsTaskActivation == 0u){
+            tcb[i].OsTaskActivation = 1u;
+        }
+        tcb[i].stack_bottom = stack_base[i];
+
+        /* Tô stack để đo high-water mark, đặt guard word ở đáy */
+        stack_base[i][0] = OS_STACK_GUARD;
+        for(uint32_t w = 1u; w < stack_words[i]; w++){
+            stack_base[i][w] = OS_STACK_PAINT;
+        }
     }
+    rq_reset();
+    tq_reset();
+    Ioc_Init();
+#if (OS_TRACE_ENABLE == 1u)
+    Os_Trace_Init();
+#endif
 
     Os_Alarm_Init();
     //StartupHook();
@@ -338,6 +795,14 @@ StatusType StartOS(AppModeType appMode){
 
     (void)ActivateTask(TASK_INIT);
 
+    /* Chọn task đầu tiên (prio cao nhất) cho SVC_Handler khởi chạy */
+    __disable_irq();
+    uint8_t first;
+    tcb[TASK_IDLE].sp = Os_Arch_StackInit(TASK_IDLE, tcb[TASK_IDLE].entry, STACK_TOP(TASK_IDLE));
+    g_current = rq_pop_raw(&first) ? &tcb[first] : &tcb[TASK_IDLE];
+    g_current->state = OS_TASK_RUNNING;
+    __enable_irq();
+
     //Os_SchedTbl_Init();
     Os_Arch_StartFirstTask();
 
@@ -348,6 +813,6 @@ StatusType StartOS(AppModeType appMode){
 
 void ShutdownOS(StatusType error){
         ShutdownHook(error);
-      __asm volatile ("cpsid i\nb ."); /* tắt IRQ và dừng vô hạn */
+        Os_Arch_Shutdown(error); /* tắt IRQ và dừng (không quay lại) */
 
 }
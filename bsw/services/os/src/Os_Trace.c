@@ -0,0 +1,253 @@
+/**********************************************************
+ * @file    Os_Trace.c
+ * @brief   Đo thời gian task bằng DWT CYCCNT (OS_TRACE_ENABLE)
+ * @details Kernel gọi các điểm đo sau (luôn trong vùng găng):
+ *            - Os_Trace_Activate : ActivateTask() thành công
+ *            - Os_Trace_Overrun  : ActivateTask() → E_OS_LIMIT
+ *            - Os_Trace_Terminate: TerminateTask()
+ *            - Os_Trace_Switch   : PendSV vừa đổi g_current
+ *                                  (qua os_switch_in), hoặc SVC
+ *                                  khởi chạy/chạy lại g_current
+ *
+ *          Mỗi điểm đo đọc CYCCNT (1 chu kỳ HCLK, 32 bit → tràn
+ *          sau ~59 s ở 72 MHz; hiệu hai mốc tính bằng phép trừ
+ *          không dấu nên vẫn đúng qua một lần tràn) và:
+ *            - Cộng dồn thời gian CPU của lần chạy hiện tại theo
+ *              từng lát (slice) giữa hai lần đổi ngữ cảnh.
+ *            - Khi Terminate: exec min/max/sum, resp_max.
+ *            - Khi task được chạy lần đầu sau Activate: lat_max.
+ *            - Lát của Task_Idle cộng vào thời gian rỗi của cửa
+ *              sổ OS_TRACE_LOAD_WINDOW_MS → CPU load (‰).
+ *            - Ghi một bản ghi vào ring Os_TraceBuf.
+ *
+ *          Ring buffer:
+ *            - Một writer tại một thời điểm (các điểm đo đều ở
+ *              trong vùng găng của kernel), reader không khoá:
+ *              ghi bản ghi vào slot head % size, DMB, rồi mới
+ *              tăng head. Reader (task chẩn đoán hoặc debugger
+ *              dump) chỉ đọc head và các slot, không chặn kernel.
+ *            - Đầy thì ghi đè bản ghi cũ nhất.
+ *            - Dump: dump binary memory trace.bin &Os_TraceBuf
+ *              (&Os_TraceBuf + 1), giải mã bằng
+ *              debug/os_trace_decode.py.
+ *
+ *          Lưu ý:
+ *            - CYCCNT dừng khi lõi ngủ WFI (Task_Idle) → bật
+ *              DBGMCU_CR.DBG_SLEEP để HCLK vẫn chạy khi ngủ; chỉ
+ *              dùng khi đo (tốn dòng hơn Sleep thật).
+ *            - Nhiều lần kích chồng (OsTaskActivation > 1): chỉ
+ *              giữ mốc của lần kích chờ đầu tiên → resp/lat của
+ *              các lần sau là cận trên (không bao giờ đo thiếu).
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+
+#include "Os.h"
+#include "Os_Arch.h"
+
+#if (OS_TRACE_ENABLE == 1u)
+
+#if ((OS_TRACE_RING_SIZE & (OS_TRACE_RING_SIZE - 1u)) != 0u) || (OS_TRACE_RING_SIZE > 0xFFFFu)
+#error "OS_TRACE_RING_SIZE phải là lũy thừa của 2 và <= 65535"
+#endif
+
+#define OS_TRACE_NO_TASK   ((TaskType)0xFFu)
+
+/* =========================================================
+ * 1) Trạng thái đo
+ *    - Os_TraceBuf : ring + header, symbol cố định cho debugger
+ *    - act_ts      : mốc Activate của lần chạy hiện tại
+ *    - act_q_ts    : mốc Activate đang xếp hàng (kích chồng)
+ *    - job_exec    : chu kỳ CPU đã dùng của lần chạy hiện tại
+ *    - job_started : 1 = lần chạy hiện tại đã được cấp CPU
+ *    - cur_tid/slice_ts: task đang giữ CPU và mốc bắt đầu lát
+ * =======================================================*/
+Os_TraceBufType Os_TraceBuf;
+
+static Os_TaskTimingType timing[OS_MAX_TASKS];
+static uint32_t act_ts[OS_MAX_TASKS];
+static uint32_t act_q_ts[OS_MAX_TASKS];
+static uint32_t job_exec[OS_MAX_TASKS];
+static uint8_t  job_started[OS_MAX_TASKS];
+
+static TaskType cur_tid = OS_TRACE_NO_TASK;
+static uint32_t slice_ts;
+
+static uint32_t win_ts;      /* mốc mở cửa sổ CPU load */
+static uint32_t win_idle;    /* chu kỳ Task_Idle trong cửa sổ */
+static uint32_t win_cycles;  /* độ dài cửa sổ (chu kỳ) */
+static volatile uint16_t cpu_load;
+
+static inline uint32_t trace_now(void)
+{
+    return DWT->CYCCNT;
+}
+
+/* =========================================================
+ * 2) trace_put(): ghi một bản ghi rồi công bố head
+ *    Caller trong vùng găng (một writer tại một thời điểm).
+ * =======================================================*/
+static void trace_put(uint32_t ts, uint8_t type, TaskType tid, uint16_t arg)
+{
+    uint32_t h = Os_TraceBuf.head;
+    Os_TraceRecType *r = &Os_TraceBuf.rec[h & (OS_TRACE_RING_SIZE - 1u)];
+
+    r->ts   = ts;
+    r->type = type;
+    r->tid  = tid;
+    r->arg  = arg;
+    __DMB();
+    Os_TraceBuf.head = h + 1u;
+}
+
+/* =========================================================
+ * 3) Os_Trace_Reset(): xoá thống kê và ring
+ * =======================================================*/
+void Os_Trace_Reset(void)
+{
+    __disable_irq();
+    uint32_t now = trace_now();
+
+    for (uint32_t i = 0u; i < OS_MAX_TASKS; i++) {
+        timing[i].exec_min = 0xFFFFFFFFu;
+        timing[i].exec_max = 0u;
+        timing[i].exec_sum = 0u;
+        timing[i].count    = 0u;
+        timing[i].resp_max = 0u;
+        timing[i].lat_max  = 0u;
+    }
+    Os_TraceBuf.magic   = OS_TRACE_MAGIC;
+    Os_TraceBuf.version = OS_TRACE_VERSION;
+    Os_TraceBuf.size    = OS_TRACE_RING_SIZE;
+    Os_TraceBuf.core_hz = SystemCoreClock;
+    Os_TraceBuf.head    = 0u;
+
+    win_cycles = (SystemCoreClock / 1000u) * OS_TRACE_LOAD_WINDOW_MS;
+    win_ts     = now;
+    win_idle   = 0u;
+    cpu_load   = 0u;
+    __enable_irq();
+}
+
+/* =========================================================
+ * 4) Os_Trace_Init(): bật CYCCNT, gọi một lần từ StartOS()
+ *    trước ActivateTask(TASK_INIT).
+ * =======================================================*/
+void Os_Trace_Init(void)
+{
+    CoreDebug->DEMCR |= CoreDebug_DEMCR_TRCENA_Msk;
+    DWT->CYCCNT = 0u;
+    DWT->CTRL  |= DWT_CTRL_CYCCNTENA_Msk;
+    DBGMCU->CR |= DBGMCU_CR_DBG_SLEEP;   /* CYCCNT đếm cả lúc WFI */
+
+    for (uint32_t i = 0u; i < OS_MAX_TASKS; i++) {
+        act_ts[i]      = 0u;
+        act_q_ts[i]    = 0u;
+        job_exec[i]    = 0u;
+        job_started[i] = 0u;
+    }
+    cur_tid = OS_TRACE_NO_TASK;
+    Os_Trace_Reset();
+}
+
+/* =========================================================
+ * 5) Điểm đo của kernel (caller trong vùng găng)
+ * =======================================================*/
+void Os_Trace_Activate(TaskType tid, uint8_t count)
+{
+    uint32_t now = trace_now();
+
+    if (count == 1u) {
+        /* SUSPENDED → READY: mở một lần chạy mới */
+        act_ts[tid]      = now;
+        job_exec[tid]    = 0u;
+        job_started[tid] = 0u;
+    } else if (count == 2u) {
+        act_q_ts[tid] = now;
+    }
+    trace_put(now, OS_TRACE_EV_ACTIVATE, tid, count);
+}
+
+void Os_Trace_Overrun(TaskType tid)
+{
+    trace_put(trace_now(), OS_TRACE_EV_OVERRUN, tid, 0u);
+}
+
+/* again = 1: còn lần kích chờ → task chạy lại từ entry */
+void Os_Trace_Terminate(TaskType tid, uint8_t again)
+{
+    uint32_t now  = trace_now();
+    Os_TaskTimingType *s = &timing[tid];
+    uint32_t exec = job_exec[tid] + (now - slice_ts);
+    uint32_t resp = now - act_ts[tid];
+
+    if (exec < s->exec_min) s->exec_min = exec;
+    if (exec > s->exec_max) s->exec_max = exec;
+    s->exec_sum += exec;
+    s->count++;
+    if (resp > s->resp_max) s->resp_max = resp;
+
+    /* Phần còn lại tới lần đổi ngữ cảnh không thuộc lần chạy nào */
+    job_exec[tid]    = 0u;
+    job_started[tid] = 0u;
+    if (again) {
+        act_ts[tid] = act_q_ts[tid];
+    }
+    trace_put(now, OS_TRACE_EV_TERMINATE, tid, again);
+}
+
+void Os_Trace_Switch(TaskType tid)
+{
+    uint32_t now = trace_now();
+    TaskType prev = cur_tid;
+
+    /* 1) Khép lát của task vừa rời CPU */
+    if (prev == TASK_IDLE) {
+        win_idle += now - slice_ts;
+    } else if ((prev != OS_TRACE_NO_TASK) && job_started[prev]) {
+        job_exec[prev] += now - slice_ts;
+    }
+
+    /* 2) Lần đầu được cấp CPU kể từ Activate → trễ khởi động */
+    if ((tid != TASK_IDLE) && !job_started[tid]) {
+        uint32_t lat = now - act_ts[tid];
+        job_started[tid] = 1u;
+        if (lat > timing[tid].lat_max) {
+            timing[tid].lat_max = lat;
+        }
+    }
+    cur_tid  = tid;
+    slice_ts = now;
+
+    /* 3) Hết cửa sổ → CPU load = 1 - rỗi/cửa sổ (‰) */
+    uint32_t span = now - win_ts;
+    if (span >= win_cycles) {
+        cpu_load = (uint16_t)(1000u - (uint32_t)(((uint64_t)win_idle * 1000u) / span));
+        win_ts   = now;
+        win_idle = 0u;
+    }
+    trace_put(now, OS_TRACE_EV_SWITCH, tid, prev);
+}
+
+/* =========================================================
+ * 6) API đọc kết quả (Os.h)
+ * =======================================================*/
+StatusType Os_Trace_GetTaskTiming(TaskType tid, Os_TaskTimingType *out)
+{
+    if ((tid >= OS_MAX_TASKS) || (out == NULL)) {
+        return E_OS_ID;
+    }
+    __disable_irq();
+    *out = timing[tid];
+    __enable_irq();
+    return E_OK;
+}
+
+uint16_t Os_Trace_GetCpuLoad(void)
+{
+    return cpu_load;
+}
+
+#endif /* OS_TRACE_ENABLE */
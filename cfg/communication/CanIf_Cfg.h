@@ -16,11 +16,11 @@ extern CanIf_ConfigType My_CanIf_Config;
 
 /***************************************************************************
  * @brief Callback xác nhận truyền, được gọi bởi lớp CanDrv.
- * @details Khi CanDrv hoàn tất việc truyền một frame, nó sẽ gọi hàm này.
- *          CanIf tìm PDU ID tương ứng với CAN ID đã truyền và gọi callback của lớp trên (PduR).
- * @param[in] CanId CAN ID của frame vừa được truyền thành công.
+ * @details Khi CanDrv hoàn tất việc truyền một frame (ngắt TX), nó sẽ gọi hàm này
+ *          với swPduHandle của frame; CanIf gọi callback của lớp trên (PduR).
+ * @param[in] CanTxPduId TxPduId của frame vừa được truyền thành công.
  *****************************************************************************/
-void CanIf_TxConfirmation(Can_IdType CanId);
+void CanIf_TxConfirmation(PduIdType CanTxPduId);
 
 /**
  * @brief Callback chỉ báo nhận dữ liệu, được gọi bởi lớp CanDrv.
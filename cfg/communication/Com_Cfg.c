@@ -7,30 +7,60 @@
  *    Đây là nơi duy nhất các biến này được định nghĩa trong toàn bộ dự án.
  * ===================================================================*/
 uint8_t s_TxBuf_VcuCommand[5u];
+uint8_t s_ShadowBuf_VcuCommand[5u];
+uint8_t s_GroupMask_VcuCommand[5u];
 uint8_t s_RxBuf_EngStatus[2u];
 
 const Com_IPduCfgType Com_IPduCfg[COM_NUM_IPDUS] =
 {
     /* TX: VCU_Command */
-    {
+    [ComConf_ComIPdu_VCU_Command] = {
         .PduId     = ComConf_ComIPdu_VCU_Command,
         .Length    = (PduLengthType)sizeof(s_TxBuf_VcuCommand),
-        .direction = COM_PDU_DIR_TX
+        .direction = COM_PDU_DIR_TX,
+        .buffer    = s_TxBuf_VcuCommand,
+        .txMode    = COM_TX_MODE_MIXED,       /* 100 ms + khi lệnh đổi */
+        .periodMs  = 100u,
+        .offsetMs  = 0u,
+        .mdtMs     = 10u
     },
     /* RX: Engine_Status */
-    {
-        .PduId     = ComConf_ComIPdu_Engine_Status,
-        .Length    = (PduLengthType)sizeof(s_RxBuf_EngStatus),
-        .direction = COM_PDU_DIR_RX
+    [ComConf_ComIPdu_Engine_Status] = {
+        .PduId         = ComConf_ComIPdu_Engine_Status,
+        .Length        = (PduLengthType)sizeof(s_RxBuf_EngStatus),
+        .direction     = COM_PDU_DIR_RX,
+        .buffer        = s_RxBuf_EngStatus,
+        .timeoutMs     = 100u,                /* ECU động cơ phát 10 ms */
+        .timeoutAction = COM_RX_TIMEOUT_REPLACE
     }
 };
 
 const Com_SignalCfgType Com_SignalCfg[COM_NUM_SIGNALS] =
 {
-    [ComConf_ComSignal_VCU_ThrottleReq_pct] = { .PduId = ComConf_ComIPdu_VCU_Command,   .byteIndex = 0u, .bitOffset = 0u, .bitLength =  8u, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_ThrottleReq_pct */
-    [ComConf_ComSignal_VCU_GearSel]         = { .PduId = ComConf_ComIPdu_VCU_Command,   .byteIndex = 1u, .bitOffset = 0u, .bitLength =  8u, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_GearSel */
-    [ComConf_ComSignal_VCU_DriveMode]       = { .PduId = ComConf_ComIPdu_VCU_Command,   .byteIndex = 2u, .bitOffset = 0u, .bitLength =  8u, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_DriveMode */
-    [ComConf_ComSignal_VCU_BrakeActive]     = { .PduId = ComConf_ComIPdu_VCU_Command,   .byteIndex = 3u, .bitOffset = 0u, .bitLength =  8u, .type = COM_SIGTYPE_BOOLEAN, .direction = COM_PDU_DIR_TX }, /* VCU_BrakeActive (0/1) */
-    [ComConf_ComSignal_VCU_Alive]           = { .PduId = ComConf_ComIPdu_VCU_Command,   .byteIndex = 4u, .bitOffset = 0u, .bitLength =  4u, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_Alive (nibble) */
-    [ComConf_ComSignal_EngineSpeedRpm]      = { .PduId = ComConf_ComIPdu_Engine_Status, .byteIndex = 0u, .bitOffset = 0u, .bitLength =  8u, .type = COM_SIGTYPE_UINT8,  .direction = COM_PDU_DIR_RX }  /* EngineSpeedRpm (BE) */
+    [ComConf_ComSignal_VCU_ThrottleReq_pct] = { .PduId = ComConf_ComIPdu_VCU_Command,   .bitPosition =  0u, .bitLength = 8u, .endianness = COM_LITTLE_ENDIAN, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_ThrottleReq_pct */
+    [ComConf_ComSignal_VCU_GearSel]         = { .PduId = ComConf_ComIPdu_VCU_Command,   .bitPosition =  8u, .bitLength = 8u, .endianness = COM_LITTLE_ENDIAN, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_GearSel */
+    [ComConf_ComSignal_VCU_DriveMode]       = { .PduId = ComConf_ComIPdu_VCU_Command,   .bitPosition = 16u, .bitLength = 8u, .endianness = COM_LITTLE_ENDIAN, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_DriveMode */
+    [ComConf_ComSignal_VCU_BrakeActive]     = { .PduId = ComConf_ComIPdu_VCU_Command,   .bitPosition = 24u, .bitLength = 8u, .endianness = COM_LITTLE_ENDIAN, .type = COM_SIGTYPE_BOOLEAN, .direction = COM_PDU_DIR_TX }, /* VCU_BrakeActive (0/1) */
+    [ComConf_ComSignal_VCU_Alive]           = { .PduId = ComConf_ComIPdu_VCU_Command,   .bitPosition = 32u, .bitLength = 4u, .endianness = COM_LITTLE_ENDIAN, .type = COM_SIGTYPE_UINT8,   .direction = COM_PDU_DIR_TX }, /* VCU_Alive (nibble) */
+    [ComConf_ComSignal_EngineSpeedRpm]      = { .PduId = ComConf_ComIPdu_Engine_Status, .bitPosition =  0u, .bitLength = 8u, .endianness = COM_LITTLE_ENDIAN, .type = COM_SIGTYPE_UINT16,  .direction = COM_PDU_DIR_RX }  /* EngineSpeedRpm (u8, không scaling) */
+};
+
+static const Com_SignalIdType Com_GroupSignals_VCU_Command[] =
+{
+    ComConf_ComSignal_VCU_ThrottleReq_pct,
+    ComConf_ComSignal_VCU_GearSel,
+    ComConf_ComSignal_VCU_DriveMode,
+    ComConf_ComSignal_VCU_BrakeActive,
+    ComConf_ComSignal_VCU_Alive
+};
+
+const Com_SignalGroupCfgType Com_SignalGroupCfg[COM_NUM_SIGNAL_GROUPS] =
+{
+    [ComConf_ComSignalGroup_VCU_Command] = {
+        .PduId      = ComConf_ComIPdu_VCU_Command,
+        .shadow     = s_ShadowBuf_VcuCommand,
+        .mask       = s_GroupMask_VcuCommand,
+        .signals    = Com_GroupSignals_VCU_Command,
+        .numSignals = (uint8_t)(sizeof(Com_GroupSignals_VCU_Command) / sizeof(Com_GroupSignals_VCU_Command[0]))
+    }
 };
\ No newline at end of file
@@ -4,17 +4,19 @@
  * @details Khai báo:
  *            - Kiểu ID cho Signal/SignalGroup/GroupSignal
  *            - Hướng I-PDU (RX/TX)
- *            - Kiểu dữ liệu tín hiệu (uint8/boolean/uint16)
- *            - Cấu trúc ánh xạ Signal ↔ I-PDU (byte/bit offset)
- *            - Cấu trúc cấu hình I-PDU (độ dài, hướng)
+ *            - Kiểu dữ liệu tín hiệu (8..64 bit, có/không dấu, boolean)
+ *            - Cấu trúc ánh xạ Signal ↔ I-PDU (bit position, độ dài,
+ *              byte order, scaling)
+ *            - Cấu trúc cấu hình I-PDU (độ dài, hướng, chế độ phát,
+ *              MDT, deadline RX)
  *            - Các Symbolic ID cho ví dụ: VCU_Command (TX),
  *              Engine_Status (RX)
  *          Lưu ý triển khai:
  *            • Tất cả chạy trên MCU thật; không có phần mô phỏng PC.
- *            • Bản demo chỉ hỗ trợ tín hiệu đặt trọn trong 1 byte,
- *              1 nibble (4 bit) hoặc 1 bit; và 16-bit big-endian cho RX.
- *            • Packing/endianness nâng cao hoặc bit-length khác cần
- *              mở rộng thêm ở phần Com.c.
+ *            • Tín hiệu đặt tại bit bất kỳ, dài 1..64 bit, Intel hoặc
+ *              Motorola; Com_Init() tính sẵn bảng shift/mask cho từng
+ *              signal, Com_SendSignal/Com_ReceiveSignal chỉ còn vòng
+ *              lặp theo số byte tín hiệu trải qua.
  *
  * @version 1.0
  * @date    2025-09-10
@@ -30,9 +32,22 @@ extern "C" {
 #include "Std_Types.h"
 #include "ComStack_Types.h"   /* PduIdType, PduInfoType */
 
+/* =========================================================
+ * 0) ID typedef (rút gọn)
+ *    - Trong dự án thực tế, các kiểu này có thể do tool sinh
+ *      ra với độ rộng phù hợp. Ở đây dùng uint16 cho gọn.
+ * =======================================================*/
+typedef uint16_t Com_SignalIdType;        /**< Kiểu dữ liệu cho ID của Signal. */
+typedef uint16_t Com_SignalGroupIdType;   /**< Kiểu dữ liệu cho ID của Signal Group. */
+
 #define CANID_ENGINE_DATA 0x200
 #define CANID_VCU_COMMAND 0x100
 
+/* Chu kỳ gọi Com_MainFunctionRx/Tx (ALARM_COM → Task_Com).
+ * Mọi thời gian cấu hình dưới đây tính bằng ms và được làm tròn
+ * lên bội của chu kỳ này. */
+#define COM_MAINFUNCTION_PERIOD_MS   (5u)
+
 /* ====================================================================
  * 1) CẤU HÌNH & BỘ ĐỆM I-PDU (DEMO)
  * ===================================================================*/
@@ -44,9 +59,11 @@ extern "C" {
  *  Byte4: BrakeActive (u8: 0/1)
  */
 extern uint8_t s_TxBuf_VcuCommand[5u];
+extern uint8_t s_ShadowBuf_VcuCommand[5u];   /* shadow của signal group VCU_Command */
+extern uint8_t s_GroupMask_VcuCommand[5u];   /* bit thuộc nhóm (Com_Init tính) */
 
 /* -------- I-PDU RX: Engine_Status (2 byte)
- *  Byte0..1: EngineSpeedRpm (big-endian: rpm = (b0<<8) | b1)
+ *  Byte0: EngineSpeedRpm (u8, rpm = raw, không scaling)
  */
 extern uint8_t s_RxBuf_EngStatus[2u];
 /* =========================================================
@@ -57,42 +74,72 @@ typedef enum {
     COM_PDU_DIR_TX = 1u    /**< I-PDU phát (Tx ra bus)  */
 } Com_PduDirection_e;
 
+/* Chế độ phát I-PDU TX (Com_MainFunctionTx thực hiện việc phát) */
+typedef enum {
+    COM_TX_MODE_DIRECT   = 0u,   /**< phát khi Com_TriggerIPDUSend()          */
+    COM_TX_MODE_PERIODIC = 1u,   /**< chỉ phát theo chu kỳ periodMs            */
+    COM_TX_MODE_MIXED    = 2u    /**< theo chu kỳ + khi Com_TriggerIPDUSend()  */
+} Com_TxMode_e;
+
+/* Hành động khi I-PDU RX quá hạn (không nhận trong timeoutMs) */
+typedef enum {
+    COM_RX_TIMEOUT_NONE    = 0u, /**< giữ giá trị nhận cuối                   */
+    COM_RX_TIMEOUT_REPLACE = 1u  /**< nạp lại giá trị khởi tạo (buffer = 0)   */
+} Com_RxTimeoutAction_e;
+
 /* =========================================================
- * 3) Kiểu dữ liệu tín hiệu (demo)
- *    - COM_SIGTYPE_UINT8   : 1 byte
- *    - COM_SIGTYPE_BOOLEAN : 1 bit hoặc 1 byte (tuỳ cấu hình)
- *    - COM_SIGTYPE_UINT16  : 2 byte (ở ví dụ RX: big-endian)
+ * 3) Kiểu dữ liệu tín hiệu
+ *    - Kiểu của biến ứng dụng mà dataPtr trỏ tới (độc lập với
+ *      bitLength trong I-PDU).
+ *    - COM_SIGTYPE_SINT*: giá trị thô được mở rộng dấu từ bit
+ *      cao nhất của tín hiệu khi nhận.
+ *    - COM_SIGTYPE_BOOLEAN : khác 0 → 1 khi gửi.
  * =======================================================*/
 typedef enum {
     COM_SIGTYPE_UINT8   = 0u,
     COM_SIGTYPE_BOOLEAN = 1u,
-    COM_SIGTYPE_UINT16  = 2u
+    COM_SIGTYPE_UINT16  = 2u,
+    COM_SIGTYPE_UINT32  = 3u,
+    COM_SIGTYPE_UINT64  = 4u,
+    COM_SIGTYPE_SINT8   = 5u,
+    COM_SIGTYPE_SINT16  = 6u,
+    COM_SIGTYPE_SINT32  = 7u,
+    COM_SIGTYPE_SINT64  = 8u
 } Com_SignalType_e;
 
+/* Byte order của tín hiệu trong I-PDU */
+typedef enum {
+    COM_LITTLE_ENDIAN = 0u,   /**< Intel: byte trọng số cao ở chỉ số lớn hơn   */
+    COM_BIG_ENDIAN    = 1u    /**< Motorola: byte trọng số cao ở chỉ số nhỏ hơn */
+} Com_SignalEndianness_e;
+
 /* =========================================================
  * 4) Cấu hình Signal ↔ I-PDU
- *    - PduId      : I-PDU chứa tín hiệu
- *    - byteIndex  : vị trí byte trong I-PDU (0..Length-1)
- *    - bitOffset  : bit offset trong byte (0..7) cho bit/nibble
- *    - bitLength  : 1/4/8 (demo); 16 cho RX uint16 (đặt trọn 2 byte)
- *    - type       : kiểu dữ liệu (xem trên)
- *    - direction  : hướng tín hiệu (TX hoặc RX)
+ *    - PduId       : I-PDU chứa tín hiệu
+ *    - bitPosition : vị trí bit LSB của tín hiệu trong I-PDU
+ *                    (byte*8 + bit 0..7, như ComBitPosition)
+ *    - bitLength   : 1..64
+ *    - endianness  : COM_LITTLE_ENDIAN / COM_BIG_ENDIAN
+ *    - type        : kiểu dữ liệu phía ứng dụng (xem trên)
+ *    - direction   : hướng tín hiệu (TX hoặc RX)
+ *    - factor/offset: vật lý = thô * factor + offset
+ *                    (factor = 0 hiểu là 1 → không scaling)
  *
  *  Ghi chú:
- *    • Với bitLength = 8: tín hiệu chiếm trọn 1 byte ở byteIndex.
- *    • Với bitLength = 4: tín hiệu chiếm nibble tại bitOffset (0..3).
- *    • Với bitLength = 1: tín hiệu là 1 bit tại bitOffset (0..7).
- *    • Với bitLength = 16 và type = UINT16 (ví dụ RX): tín hiệu chiếm
- *      2 byte liên tiếp bắt đầu tại byteIndex, và được hiểu big-endian
- *      ở ví dụ Com.c.
+ *    • Motorola: từ byte chứa LSB đi về byte chỉ số NHỎ hơn, ví dụ
+ *      u16 ở byte0..1 (b0 = MSB) có bitPosition = 8.
+ *    • Tín hiệu phải nằm trọn trong I-PDU; signal sai bị Com_Init()
+ *      đánh dấu không hợp lệ, Send/Receive trả E_NOT_OK.
  * =======================================================*/
 typedef struct {
-    PduIdType           PduId;
-    uint16_t            byteIndex;
-    uint8_t             bitOffset;
-    uint8_t             bitLength;
-    Com_SignalType_e    type;
-    Com_PduDirection_e  direction;
+    PduIdType               PduId;
+    uint16_t                bitPosition;
+    uint8_t                 bitLength;
+    Com_SignalEndianness_e  endianness;
+    Com_SignalType_e        type;
+    Com_PduDirection_e      direction;
+    int32_t                 factor;
+    int32_t                 offset;
 } Com_SignalCfgType;
 
 /* =========================================================
@@ -100,13 +147,55 @@ typedef struct {
  *    - PduId     : ID tượng trưng của I-PDU
  *    - Length    : độ dài payload (byte)
  *    - direction : RX hoặc TX
+ *    - buffer    : buffer I-PDU của COM (Length byte)
+ *  TX:
+ *    - txMode    : DIRECT / PERIODIC / MIXED
+ *    - periodMs  : chu kỳ phát (PERIODIC, MIXED)
+ *    - offsetMs  : thời điểm lần phát chu kỳ đầu tiên sau Com_Init();
+ *                  lệch offset giữa các I-PDU cùng chu kỳ để trải tải bus
+ *    - mdtMs     : Minimum Delay Time giữa hai lần phát (0 = không)
+ *    - txNotification : gọi từ Com_TxConfirmation() khi frame đã lên bus
+ *                       (ngữ cảnh ISR TX; có thể NULL)
+ *  RX:
+ *    - timeoutMs           : deadline giữa hai lần nhận (0 = không giám sát)
+ *    - timeoutAction       : NONE / REPLACE
+ *    - timeoutNotification : gọi từ Com_MainFunctionRx khi quá hạn (có thể NULL)
+ *  Com_IPduCfg[] đánh chỉ số trực tiếp theo PduId
+ *  (Com_IPduCfg[id].PduId == id) → tra cứu O(1).
  * =======================================================*/
 typedef struct {
-    PduIdType           PduId;
-    PduLengthType       Length;
-    Com_PduDirection_e  direction;
+    PduIdType              PduId;
+    PduLengthType          Length;
+    Com_PduDirection_e     direction;
+    uint8_t               *buffer;
+    Com_TxMode_e           txMode;
+    uint16_t               periodMs;
+    uint16_t               offsetMs;
+    uint16_t               mdtMs;
+    void                 (*txNotification)(void);
+    uint16_t               timeoutMs;
+    Com_RxTimeoutAction_e  timeoutAction;
+    void                 (*timeoutNotification)(void);
 } Com_IPduCfgType;
 
+/* =========================================================
+ * 5b) Cấu hình Signal Group (TX)
+ *    - PduId      : I-PDU chứa nhóm
+ *    - shadow     : ảnh I-PDU của nhóm (dài bằng Length của PduId);
+ *                   Com_UpdateShadowSignal() pack vào đây
+ *    - mask       : bit thuộc nhóm, Com_Init() tính từ signals[];
+ *                   Com_SendSignalGroup() chỉ chép các bit này
+ *    - signals    : các group signal (ID trong Com_SignalCfg)
+ *    - numSignals : số phần tử của signals[]
+ * =======================================================*/
+typedef struct {
+    PduIdType               PduId;
+    uint8_t                *shadow;
+    uint8_t                *mask;
+    const Com_SignalIdType *signals;
+    uint8_t                 numSignals;
+} Com_SignalGroupCfgType;
+
 /* =========================================================
  * 6) SYMBOLIC IDs (ví dụ phù hợp với RTE demo)
  *    - VCU_Command (TX): chứa các tín hiệu điều khiển từ ECU
@@ -120,14 +209,16 @@ typedef struct {
 #define ComConf_ComSignal_VCU_BrakeActive       ((Com_SignalIdType)3u)  /**< boolean (0/1)     */
 #define ComConf_ComSignal_VCU_Alive             ((Com_SignalIdType)4u)  /**< uint8 nibble 0..15 */
 #define ComConf_ComIPdu_VCU_Command             ((PduIdType)0u)         /**< I-PDU TX          */
+#define ComConf_ComSignalGroup_VCU_Command      ((Com_SignalGroupIdType)0u) /**< 5 signal trên  */
 
 /* ---- RX: Engine_Status ---- */
-#define ComConf_ComSignal_EngineSpeedRpm        ((Com_SignalIdType)5u) /**< uint16 (BE)       */
+#define ComConf_ComSignal_EngineSpeedRpm        ((Com_SignalIdType)5u) /**< uint16 rpm (u8, byte 0) */
 #define ComConf_ComIPdu_Engine_Status           ((PduIdType)1u)         /**< I-PDU RX          */
 
 /* ---- Số lượng phần tử (để kiểm tra biên, vòng lặp tra bảng) ---- */
 #define COM_NUM_SIGNALS   (6u)   /**< 5 TX + 1 RX */
 #define COM_NUM_IPDUS     (2u)   /**< 1 TX + 1 RX */
+#define COM_NUM_SIGNAL_GROUPS (1u)
 
 /* =========================================================
  * 7) BẢNG CẤU HÌNH & TRUY CẬP BUFFER (được định nghĩa ở Com.c)
@@ -138,6 +229,9 @@ extern const Com_IPduCfgType Com_IPduCfg[COM_NUM_IPDUS];
 /* -------- Bảng Signal (ví dụ demo) -------------------------------- */
 extern const Com_SignalCfgType Com_SignalCfg[COM_NUM_SIGNALS];
 
+/* -------- Bảng Signal Group --------------------------------------- */
+extern const Com_SignalGroupCfgType Com_SignalGroupCfg[COM_NUM_SIGNAL_GROUPS];
+
 
 /**
  * @brief   Lấy con trỏ buffer TX nội bộ của COM theo PduId.
@@ -1,18 +1,23 @@
 #include "PduR_Cfg.h"
 
-// Định nghĩa các bảng định tuyến
+// Định nghĩa các bảng định tuyến (chỉ số = srcPduId, chỗ trống = PDUR_NO_ROUTE)
 const PduR_Route_1to1_Type ComTxRoutingTable[PDUR_NUM_COM_TX_ROUTES] = {
-    {.srcPduId = ComConf_ComIPdu_VCU_Command, .desPduId = CANIFCONF_PDU_VCU_COMMAND},
-    {.srcPduId = ComConf_ComIPdu_VCU_Command, .desPduId = CANIFCONF_PDU_ENGINE_STATUS}
+    [ComConf_ComIPdu_VCU_Command]   = {.srcPduId = ComConf_ComIPdu_VCU_Command, .desPduId = CANIFCONF_PDU_VCU_COMMAND},
+    [ComConf_ComIPdu_Engine_Status] = PDUR_NO_ROUTE
 };
 
 const PduR_Route_1to1_Type CanIfRxRoutingTable[PDUR_NUM_CAN_RX_ROUTES] = {
-    {.srcPduId = CANIFCONF_PDU_VCU_COMMAND, .desPduId = ComConf_ComIPdu_Engine_Status},
+    [CANIFCONF_PDU_ENGINE_STATUS] = {.srcPduId = CANIFCONF_PDU_ENGINE_STATUS, .desPduId = ComConf_ComIPdu_Engine_Status},
+};
+
+// TxConfirmation: CanIf TxPduId → I-PDU TX của COM
+const PduR_Route_1to1_Type CanIfTxRoutingTable[PDUR_NUM_CAN_TX_ROUTES] = {
+    [CANIFCONF_PDU_VCU_COMMAND] = {.srcPduId = CANIFCONF_PDU_VCU_COMMAND, .desPduId = ComConf_ComIPdu_VCU_Command},
 };
 
 // Định nghĩa cấu trúc cấu hình chính của PduR
 const PduR_PBConfigType PduR_Config = {
     .ComTxRoutingTable = ComTxRoutingTable,
     .CanIfRxRoutingTable = CanIfRxRoutingTable,
-    .CanIfTxRoutingTable = NULL // Giả sử không có bảng Tx Confirmation routing trong ví dụ này
+    .CanIfTxRoutingTable = CanIfTxRoutingTable
 };
\ No newline at end of file
@@ -5,17 +5,18 @@
 #include "CanIf_Cfg.h"
 #include "Com_Cfg.h"
 
-#define PDUR_NUM_COM_TX_ROUTES 2
-#define PDUR_NUM_CAN_RX_ROUTES 2
-#define PDUR_NUM_CAN_TX_ROUTES 2
+/* Kích thước bảng = số PDU ID nguồn (bảng đánh chỉ số theo srcPduId) */
+#define PDUR_NUM_COM_TX_ROUTES COM_NUM_IPDUS
+#define PDUR_NUM_CAN_RX_ROUTES CANIF_NUM_RX_PDUS
+#define PDUR_NUM_CAN_TX_ROUTES CANIF_NUM_TX_PDUS
 
-#define CANIFCONF_PDU_VCU_COMMAND 0X00U
-#define CANIFCONF_PDU_ENGINE_STATUS 0X01u
+/* PDU ID của CanIf: Tx và Rx là hai không gian ID riêng */
+#define CANIFCONF_PDU_VCU_COMMAND 0X00U     /* Tx */
+#define CANIFCONF_PDU_ENGINE_STATUS 0X00u   /* Rx */
 
 extern const PduR_Route_1to1_Type ComTxRoutingTable[PDUR_NUM_COM_TX_ROUTES];
 extern const PduR_Route_1to1_Type CanIfRxRoutingTable[PDUR_NUM_CAN_RX_ROUTES];
-// Nếu có bảng CanIfTxRoutingTable, bạn cũng sẽ khai báo extern ở đây
-// extern const PduR_Route_1to1_Type CanIfTxRoutingTable[PDUR_NUM_CAN_TX_ROUTES];
+extern const PduR_Route_1to1_Type CanIfTxRoutingTable[PDUR_NUM_CAN_TX_ROUTES];
 
 extern const PduR_PBConfigType PduR_Config;
 
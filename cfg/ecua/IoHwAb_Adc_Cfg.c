@@ -6,7 +6,7 @@
  * @author : Nguyễn Tuấn Khoa
  *********************************************/
 
-#include "IoHwAb_ADC_Cfg.h"
+#include "IoHwAb_Adc_Cfg.h"
 
 /* Định nghĩa biến cấu hình cho IoHwAb ADC */
 const IoHwAb0_ConfigType IoHwAb0_Config = {
@@ -8,7 +8,7 @@
  *********************************************/
 #ifndef __IOHWAB_ADC_CFG_H__
 #define __IOHWAB_ADC_CFG_H__
-#include "Port_cfg.h"
+#include "Port_Cfg.h"
 #include "Adc_Cfg.h"
 #include "Pwm_Lcfg.h"
 
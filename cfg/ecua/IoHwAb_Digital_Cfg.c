@@ -8,10 +8,24 @@
 
 #include "IoHwAb_Digital_Cfg.h"
 
+/* Ngưỡng debounce theo kênh (trước đây nằm trong từng SWC) */
+static const IoHwAb_DigInCfgType IoHwAb_DigIn_Cfg[IOHWAB_DIN_COUNT] = {
+    [IOHWAB_DIN_BRAKE]   = { DIO_CHANNEL_B0,  IOHWAB_DIG_TICKS(20u) },
+    [IOHWAB_DIN_GEAR_B0] = { DIO_CHANNEL_A8,  IOHWAB_DIG_TICKS(20u) },
+    [IOHWAB_DIN_GEAR_B1] = { DIO_CHANNEL_A10, IOHWAB_DIG_TICKS(20u) },
+    [IOHWAB_DIN_MODE]    = { DIO_CHANNEL_B1,  IOHWAB_DIG_TICKS(20u) },
+};
+
+const IoHwAb_DigCfgType IoHwAb_Dig_Config = {
+    .lanePort  = { DIO_PORT_A, DIO_PORT_B },
+    .inputs    = IoHwAb_DigIn_Cfg,
+    .numInputs = IOHWAB_DIN_COUNT,
+};
+
 /* Định nghĩa biến cấu hình IoHwAb cho Digital I/O */
 const IoHwAb1_ConfigType IoHwAb1_Config = {
     .portConfig = &portConfig,
     .adcConfig = &Adc_Configs[0],
     .canConfig = &Can_Config,
+    .digConfig = &IoHwAb_Dig_Config,
 };
-
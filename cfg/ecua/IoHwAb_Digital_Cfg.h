@@ -2,16 +2,20 @@
  * @file   : IoHwAb_Adc_Cfg.h
  * @brief  : IoHwAb ADC Driver Configuration Header File (AUTOSAR)
  * @details: Khai báo kiểu cấu hình cho ADC trong IoHwAb.
+ *           Đầu vào số được lấy mẫu & debounce theo vector 32 bit:
+ *           làn 0 = bit 0..15, làn 1 = bit 16..31, mỗi làn là IDR
+ *           của một cổng GPIO (bit = làn*16 + chân).
  * @version: 1.0
  * @date   : 2024-06-27
  * @author : Nguyễn Tuấn Khoa
  *********************************************/
 #ifndef __IOHWAB_DIGITAL_CFG_H__
 #define __IOHWAB_DIGITAL_CFG_H__
-#include "Port_cfg.h"
+#include "Port_Cfg.h"
 #include "Adc_Cfg.h"
 #include "Pwm_Lcfg.h"
 #include "Can_Cfg.h"
+#include "Dio.h"
 
 extern const Port_ConfigType portConfig;
 typedef enum
@@ -19,14 +23,54 @@ typedef enum
     IoHwAb_CHANNEL_Button = 1,
     IoHwAb_CHANNEL_Led = 12,
 } IoHwAb_SignalType;
+
+/* =========================================================
+ * Đầu vào số có debounce (IoHwAb_Digital_MainFunction)
+ * =======================================================*/
+#define IOHWAB_DIG_SAMPLE_PERIOD_MS  10u    /* gọi từ Task_A (10 ms) */
+#define IOHWAB_DIG_LANES             2u     /* 2 cổng × 16 chân = 32 đầu vào */
+#define IOHWAB_DIG_LANE_NONE         0xFFu  /* làn không dùng: không đọc cổng */
+#define IOHWAB_DIG_CNT_BITS          3u     /* bộ đếm dọc 3 bit */
+#define IOHWAB_DIG_MAX_TICKS         ((1u << IOHWAB_DIG_CNT_BITS) - 1u)   /* ngưỡng 1..7 mẫu */
+
+/* Thời gian ổn định (ms) → số mẫu, làm tròn lên */
+#define IOHWAB_DIG_TICKS(ms) \
+    ((uint8_t)(((ms) + (IOHWAB_DIG_SAMPLE_PERIOD_MS - 1u)) / IOHWAB_DIG_SAMPLE_PERIOD_MS))
+
+/* Chỉ số đầu vào (vị trí trong IoHwAb_DigIn_Cfg[]) */
+typedef enum
+{
+    IOHWAB_DIN_BRAKE = 0,   /* PB0,  HIGH = đạp phanh */
+    IOHWAB_DIN_GEAR_B0,     /* PA8,  bit 0 mã cần số  */
+    IOHWAB_DIN_GEAR_B1,     /* PA10, bit 1 mã cần số  */
+    IOHWAB_DIN_MODE,        /* PB1,  HIGH = NORMAL    */
+    IOHWAB_DIN_COUNT
+} IoHwAb_DigInType;
+
+typedef struct
+{
+    Dio_ChannelType channel;        /* port*16 + chân, cổng phải là một làn */
+    uint8_t debounceTicks;          /* số mẫu liên tiếp khác trạng thái ổn định để lật (1..IOHWAB_DIG_MAX_TICKS) */
+} IoHwAb_DigInCfgType;
+
+typedef struct
+{
+    Dio_PortType lanePort[IOHWAB_DIG_LANES];    /* DIO_PORT_x hoặc IOHWAB_DIG_LANE_NONE */
+    const IoHwAb_DigInCfgType *inputs;
+    uint8_t numInputs;                          /* ≤ 32 */
+} IoHwAb_DigCfgType;
+
+extern const IoHwAb_DigCfgType IoHwAb_Dig_Config;
+
 typedef struct
 {
     Port_ConfigType *portConfig;
     Adc_ConfigType *adcConfig;
     Can_ConfigType *canConfig;
+    const IoHwAb_DigCfgType *digConfig;
 } IoHwAb1_ConfigType;
 
 /* Khai báo biến cấu hình, định nghĩa sẽ nằm trong file .c */
 extern const IoHwAb1_ConfigType IoHwAb1_Config;
 
-#endif /* __IOHWAB_DIGITAL_CFG_H__ */
\ No newline at end of file
+#endif /* __IOHWAB_DIGITAL_CFG_H__ */
@@ -13,8 +13,22 @@
 #include "stm32f10x_adc.h"
 #include "stm32f10x_rcc.h"
 #include "stm32f10x_dma.h"
+#include "stm32f10x_tim.h"
 extern Adc_ValueGroupType Adc_Group_Buffer[ADC_MAX_GROUPS];
 
+/* Quét DMA kích bằng timer, khoá pha với Task_A (AlarmExpiryHook):
+ * mỗi chu kỳ task một lần kích, chuỗi regular lặp Rank
+ * ADC_SCAN_OVERSAMPLING lần ≈ 16 × 21 µs = 336 µs, xong ngay trước nhịp
+ * nhả Task_A → Task_A đọc trung bình 16 lần quét mới nhất. */
+#define ADC_TRIG_TASK_PERIOD_MS  10u    /* chu kỳ ALARM_A (InitTask.c) */
+#define ADC_SCAN_OVERSAMPLING    16u    /* × 1 kênh nền = 16 = chuỗi regular tối đa */
+#define ADC_TRIG_PERIOD_US       (ADC_TRIG_TASK_PERIOD_MS * 1000u)
+#define ADC_TRIG_LEAD_US         400u   /* > thời gian chuỗi + ISR DMA */
+
+/* Bàn đạp (Priority > 0) trên chuỗi injected, TIM1 CC4 cùng timer:
+ * kích 100 µs trước nhịp nhả Task_A, chen ngang chuỗi nền đang chạy;
+ * 4 rank × (55.5 + 12.5) chu kỳ / 12 MHz ≈ 22.7 µs từ kích tới JEOC. */
+#define ADC_INJ_LEAD_US          100u   /* > độ trễ chuỗi injected + ISR JEOC */
 /* ============================= */
 /* ==== Global Config Array ==== */
 /* ============================= */
@@ -23,6 +37,8 @@ extern Adc_GroupDefType Adc_GroupConfigs[ADC_MAX_GROUPS];
 void Adc_Notification_callback(void);
 void ADC_isrHandler(void);
 void DMA_ADC_isrHandler(void);
+void DMA1_Channel1_IRQHandler(void);
+void ADC1_2_IRQHandler(void);
 void DMA_Notification_callback(void);
 
 #endif
\ No newline at end of file
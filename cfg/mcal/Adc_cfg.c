@@ -1,4 +1,4 @@
-#include "Adc_cfg.h"
+#include "Adc_Cfg.h"
 #include "Adc.h"
 #include <stdio.h>
 Adc_ValueGroupType Adc_Group_Buffer[ADC_MAX_GROUPS];
@@ -16,6 +16,19 @@ void DMA_Notification_callback(void)
 }
 void ADC_isrHandler(void)
 {
+    /* Chuỗi injected (nhóm ưu tiên) xong: JDR1..n theo rank */
+    if (ADC_GetITStatus(ADC1, ADC_IT_JEOC))
+    {
+        static const uint8_t jdr[ADC_INJ_MAX_CHANNELS] = {
+            ADC_InjectedChannel_1, ADC_InjectedChannel_2, ADC_InjectedChannel_3, ADC_InjectedChannel_4};
+        Adc_ValueGroupType val[ADC_INJ_MAX_CHANNELS];
+
+        ADC_ClearITPendingBit(ADC1, ADC_IT_JEOC);
+        for (uint8_t r = 0; r < ADC_INJ_MAX_CHANNELS; r++)
+            val[r] = ADC_GetInjectedConversionValue(ADC1, jdr[r]);
+        Adc_Inj_OnJeoc(val);
+    }
+
     for (uint8_t group = 0; group < ADC_MAX_GROUPS; group++)
     {
         Adc_GroupDefType *grp = &Adc_GroupConfigs[group];
@@ -42,43 +55,86 @@ void ADC_isrHandler(void)
 }
 void DMA_ADC_isrHandler(void)
 {
+    uint8_t done = 0u;
+
+    /* Quét DMA vòng: HT = nửa 0 đầy, TC = nửa 1 đầy */
+    if (DMA_GetITStatus(DMA1_IT_HT1))
+    {
+        DMA_ClearITPendingBit(DMA1_IT_HT1);
+        Adc_Scan_OnDmaHalf(0u);
+        done = 1u;
+    }
+    if (DMA_GetITStatus(DMA1_IT_TC1))
+    {
+        DMA_ClearITPendingBit(DMA1_IT_TC1);
+        Adc_Scan_OnDmaHalf(1u);
+        done = 1u;
+    }
+    if (done == 0u)
+        return;
+
     for (uint8_t group = 0; group < ADC_MAX_GROUPS; group++)
     {
         Adc_GroupDefType *grp = &Adc_GroupConfigs[group];
         Adc_ConfigType *cfg = &Adc_Configs[grp->AdcInstance];
 
-        if (grp->Dma_Notification == DMA_ADC_NOTIFICATION_ENABLED)
-        {
-            if (DMA_GetITStatus(DMA1_IT_TC1))
-            {
-                DMA_ClearITPendingBit(DMA1_IT_TC1);
-
-                if (cfg->InitCallback)
-                    cfg->InitCallback();
-            }
-        }
+        if ((grp->Dma_Notification == DMA_ADC_NOTIFICATION_ENABLED) && cfg->InitCallback)
+            cfg->InitCallback();
     }
 }
+void DMA1_Channel1_IRQHandler(void)
+{
+    DMA_ADC_isrHandler();
+}
+void ADC1_2_IRQHandler(void)
+{
+    ADC_isrHandler();
+}
+/* Chuỗi nền: cảm biến nhiệt nội, ADCCLK = 72/6 = 12 MHz: mỗi lần quét
+ * 239.5 + 12.5 = 252 chu kỳ = 21 µs. TIM1 CC1 (TIM1 không dùng cho PWM)
+ * kích mỗi 10 ms, sớm 400 µs so với nhịp nhả Task_A; một lần kích = 16
+ * lần quét liền (≈ 336 µs) = một nửa buffer.
+ * Bàn đạp PA0 (group 0, Priority 1) trên chuỗi injected, TIM1 CC4 kích
+ * 100 µs trước nhịp nhả: chen vào cuối chuỗi nền, 4 mẫu 55.5 chu kỳ
+ * (≈ 22.7 µs) rồi chuỗi nền làm lại rank bị ngắt. */
 Adc_ConfigType Adc_Configs[1] = {
     {.AdcInstance = ADC_INSTANCE_1,
-     .ClockPrescaler = 2,
+     .ClockPrescaler = 6,
      .ConversionMode = ADC_CONV_MODE_CONTINUOUS,
-     .TriggerSource = ADC_TRIGGER_SOFTWARE,
+     .TriggerSource = ADC_TRIGGER_TIM1_CC1,
      .NotificationEnabled = ADC_NOTIFICATION_DISABLED,
      .NumChannels = 1,
      .ResultAlignment = ADC_RESULT_ALIGNMENT_RIGHT,
      .InitCallback = DMA_Notification_callback,
      .Channels = {
-         {.Channel = ADC_Channel_0, .SamplingTime = ADC_SampleTime_1Cycles5, .Rank = 1}}}};
+         {.Channel = ADC_Channel_16, .SamplingTime = ADC_SampleTime_239Cycles5, .Rank = 1}},
+     .ScanMode = ADC_SCAN_DMA_CIRCULAR,
+     .Oversampling = ADC_SCAN_OVERSAMPLING,
+     .TriggerPeriodUs = ADC_TRIG_PERIOD_US,
+     .TriggerLeadUs = ADC_TRIG_LEAD_US,
+     .InjTriggerSource = ADC_INJ_TRIGGER_TIM1_CC4,
+     .InjTriggerLeadUs = ADC_INJ_LEAD_US,
+     .InjSamplingTime = ADC_SampleTime_55Cycles5}};
 Adc_GroupDefType Adc_GroupConfigs[ADC_MAX_GROUPS] = {
     {.id = 0,
      .AdcInstance = ADC_INSTANCE_1,
-     .Channels = {ADC_Channel_1},
-     .Priority = 0,
+     .Channels = {ADC_Channel_0},
+     .Priority = 1,
      .NumChannels = 1,
      .Status = ADC_IDLE,
      .Result = Adc_Group_Buffer,
      .Adc_StreamEnableType = 1,
      .Adc_StreamBufferSize = 1,
      .Adc_StreamBufferMode = ADC_STREAM_BUFFER_CIRCULAR,
+     .Dma_Notification = DMA_ADC_NOTIFICATION_DISABLED},
+    {.id = 1,
+     .AdcInstance = ADC_INSTANCE_1,
+     .Channels = {ADC_Channel_16},
+     .Priority = 0,
+     .NumChannels = 1,
+     .Status = ADC_IDLE,
+     .Result = &Adc_Group_Buffer[1],
+     .Adc_StreamEnableType = 1,
+     .Adc_StreamBufferSize = 1,
+     .Adc_StreamBufferMode = ADC_STREAM_BUFFER_CIRCULAR,
      .Dma_Notification = DMA_ADC_NOTIFICATION_DISABLED}};
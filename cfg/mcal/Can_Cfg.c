@@ -16,18 +16,7 @@ const Can_ConfigType Can_Config = {
         .CAN_AWUM = ENABLE,
         .CAN_NART = DISABLE,
         .CAN_RFLM = DISABLE,
-        .CAN_TXFP = ENABLE,
-    },
-    .Filter_Config = {
-        .Can_FilterIdHigh = (0x123 << 5),
-        .Can_FilterIdLow = 0,
-        .Can_FilterMaskIdHigh = 0xFFE0,
-        .Can_FilterMaskIdLow = 0,
-        .Can_FilterNumber = 0,
-        .Can_FilterMode = CAN_FilterMode_IdMask,
-        .Can_FilterScale = CAN_FilterScale_32bit,
-        .Can_FilterFIFOAssignment = CAN_FIFO0,
-        .Can_FilterActivation = ENABLE,
+        .CAN_TXFP = DISABLE,    /* 3 mailbox phát theo CAN ID, khớp hàng đợi TX mềm (Can.c) */
     },
     .NotificationEnable = ENABLE,
 };
@@ -39,10 +28,20 @@ void Can_RegisterTxCallback(void(*cb)(PduIdType TxPduID)){
     txCallback = cb;
 }
 
-void USB_LP_CAN1_RX0_IRQHandler(void){
-    if(CAN_GetITStatus(CAN1, CAN_IT_FMP0) == SET){
+/* Số lần FIFO phần cứng tràn (FOVRx), đếm trong ISR RX */
+static volatile uint32_t rxOverrun[2];
+
+uint32_t Can_GetRxOverrunCount(uint8_t fifo){
+    return (fifo <= CAN_FIFO1) ? rxOverrun[fifo] : 0u;
+}
+
+/*  Vét hết frame đang chờ trong một FIFO (tối đa 3) trong một lần ngắt:
+ *  mỗi frame chỉ được chép vào vòng RX của CanIf (rxCallback), chuỗi
+ *  PduR → COM chạy sau ở CanIf_MainFunctionRx. */
+static void prv_rx_drain(uint8_t fifo){
+    while(CAN_MessagePending(CAN1, fifo) != 0u){
         CanRxMsg RxMessage;
-        CAN_Receive(CAN1, CAN_FIFO0, &RxMessage);
+        CAN_Receive(CAN1, fifo, &RxMessage);    // nhả output mailbox (RFOMx)
         if(rxCallback){
         /*  Đóng gói dữ liệu thành gói tin Pdu*/
             PduInfoType PduInfo;
@@ -50,19 +49,33 @@ void USB_LP_CAN1_RX0_IRQHandler(void){
             PduInfo.SduLength = RxMessage.DLC;
         /* Cập nhật Can ID*/
             Can_HwType CAN;
-            CAN.CanId = RxMessage.StdId;
-            
+            CAN.CanId = (RxMessage.IDE == CAN_Id_Standard) ? RxMessage.StdId : RxMessage.ExtId;
+
             rxCallback(&CAN, &PduInfo);
         }
-    CAN_ClearITPendingBit(CAN1, CAN_IT_FMP0);
+    }
+    const uint32_t fov = (fifo == CAN_FIFO0) ? CAN_FLAG_FOV0 : CAN_FLAG_FOV1;
+    if(CAN_GetFlagStatus(CAN1, fov) == SET){
+        rxOverrun[fifo]++;
+        CAN_ClearFlag(CAN1, fov);
+    }
+}
+
+void USB_LP_CAN1_RX0_IRQHandler(void){
+    prv_rx_drain(CAN_FIFO0);
+}
+void CAN1_RX1_IRQHandler(void){
+    prv_rx_drain(CAN_FIFO1);
+}
+void Can_NotifyTxConfirmation(PduIdType TxPduID){
+    if(txCallback){
+        txCallback(TxPduID);
     }
 }
 void USB_HP_CAN1_TX_IRQHandler(void){
     if(CAN_GetITStatus(CAN1, CAN_IT_TME) == SET){
-    //     if(CAN_TransmitStatus(CAN1, CAN_TXMAILBOX_0)){
-            
-    //  }
-    CAN_ClearITPendingBit(CAN1, CAN_IT_TME);
+    /*  Xoá RQCPx từng mailbox, báo TxConfirmation, nạp hàng đợi TX mềm */
+        Can_MainFunction_Write();
     }
 }
 
@@ -2,13 +2,21 @@
 #define CAN_CFG_H
 #include "Can.h"
 #define CAN_MAX_TX_MAILBOX 3u
+#define CAN_TX_QUEUE_SIZE  8u   /* hàng đợi TX mềm khi cả 3 mailbox bận */
 
 extern Can_HwType MailBox[CAN_MAX_TX_MAILBOX];
 extern const Can_ConfigType Can_Config;
 
 void Can_RegisterRxCallback(void(*cb)(const Can_HwType* Mailbox, const PduInfoType* PduInfoPtr));
 void Can_RegisterTxCallback(void(*cb)(PduIdType TxPduID));
+/* Can.c gọi khi một frame đã lên bus → callback TX đã đăng ký (CanIf) */
+void Can_NotifyTxConfirmation(PduIdType TxPduID);
 
 
+/* Số lần FIFO RX phần cứng tràn (CAN_FIFO0/CAN_FIFO1) */
+uint32_t Can_GetRxOverrunCount(uint8_t fifo);
+
 void USB_LP_CAN1_RX0_IRQHandler(void);
+void CAN1_RX1_IRQHandler(void);
+void USB_HP_CAN1_TX_IRQHandler(void);
 #endif /* CAN_CFG_H */
@@ -10,7 +10,7 @@
  * @author  Nguyễn Tuấn Khoa
  **********************************************************/
 
-#include "Port_cfg.h"
+#include "Port_Cfg.h"
 
 /**********************************************************
  * Cấu hình chi tiết cho từng chân GPIO
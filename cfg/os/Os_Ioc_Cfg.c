@@ -0,0 +1,46 @@
+/**********************************************************
+ * @file    Os_Ioc_Cfg.c
+ * @brief   Bộ nhớ và bảng cấu hình kênh IOC (sinh từ
+ *          OS_IOC_CHANNEL_LIST trong Os_Ioc_Cfg.h)
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Os_Ioc_Cfg.h"
+
+/* =========================================================
+ * 1) Bộ nhớ từng kênh
+ *    - Data : slot payload, căn 8 byte (mọi kiểu struct)
+ *    - Seq  : số thứ tự bản ghi từng slot
+ *    - Rx   : trạng thái từng receiver
+ * =======================================================*/
+#define OS_IOC_STORAGE(name, type, kind, n)                                        \
+    static const TaskType Ioc_Rcv_##name[] = IOC_RECEIVERS_##name;                 \
+    static uint8_t Ioc_Data_##name[OS_IOC_SLOTS_##kind(n) * sizeof(type)]          \
+        __attribute__((aligned(8)));                                               \
+    static volatile uint32_t Ioc_Seq_##name[OS_IOC_SLOTS_##kind(n)];               \
+    static volatile uint32_t Ioc_Wr_##name;                                        \
+    static Os_IocRxType Ioc_Rx_##name[sizeof(Ioc_Rcv_##name) / sizeof(TaskType)];
+OS_IOC_CHANNEL_LIST(OS_IOC_STORAGE)
+#undef OS_IOC_STORAGE
+
+/* =========================================================
+ * 2) Bảng cấu hình (index = IOC_CH_<Name>)
+ * =======================================================*/
+#define OS_IOC_ENTRY(name, type, kind, n)                                          \
+    [IOC_CH_##name] = {                                                            \
+        .data          = Ioc_Data_##name,                                          \
+        .seq           = Ioc_Seq_##name,                                           \
+        .wr            = &Ioc_Wr_##name,                                           \
+        .rx            = Ioc_Rx_##name,                                            \
+        .receivers     = Ioc_Rcv_##name,                                           \
+        .ev            = IOC_EVENT_##name,                                         \
+        .elem_size     = (uint16_t)sizeof(type),                                   \
+        .depth         = (uint8_t)OS_IOC_SLOTS_##kind(n),                          \
+        .num_receivers = (uint8_t)(sizeof(Ioc_Rcv_##name) / sizeof(TaskType)),     \
+        .queued        = OS_IOC_QUEUED_##kind                                      \
+    },
+const Os_IocChannelCfgType Os_IocCfg[IOC_CH_COUNT] = {
+    OS_IOC_CHANNEL_LIST(OS_IOC_ENTRY)
+};
+#undef OS_IOC_ENTRY
@@ -0,0 +1,75 @@
+/**********************************************************
+ * @file    Os_Ioc_Cfg.h
+ * @brief   Cấu hình kênh IOC (sinh tĩnh) cho Os_Ioc.c
+ * @details Mỗi dòng của OS_IOC_CHANNEL_LIST là một kênh:
+ *            X(Name, Type, Kind, Depth)
+ *              - Name  : tên kênh → IOC_CH_<Name>, hàm Ioc*_<Name>
+ *              - Type  : kiểu payload (struct bất kỳ)
+ *              - Kind  : UNQUEUED (last-is-best, luôn 2 slot, Depth bỏ qua)
+ *                        QUEUED   (FIFO Depth slot)
+ *          Receiver và Event của kênh: IOC_RECEIVERS_<Name>,
+ *          IOC_EVENT_<Name> (0 = không SetEvent). Chỉ số receiver
+ *          (tham số rx của hàm queued) là vị trí trong danh sách.
+ *
+ *          Từ danh sách này sinh ra:
+ *            - enum IOC_CH_<Name>, IOC_CH_COUNT
+ *            - bộ nhớ + bảng Os_IocCfg[] (Os_Ioc_Cfg.c)
+ *            - hàm có kiểu (Os.h: OS_IOC_API_UNQUEUED/QUEUED)
+ *
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ **********************************************************/
+#ifndef OS_IOC_CFG_H
+#define OS_IOC_CFG_H
+
+#include "Os.h"
+#include "Rte_Types.h"   /* Safe_s */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =========================================================
+ * 1) Danh sách kênh
+ * =======================================================*/
+#define OS_IOC_CHANNEL_LIST(X)                          \
+    /*  Name    Type      Kind       Depth */           \
+    X(Safe,     Safe_s,   UNQUEUED,  2u)                \
+    X(Speed,    uint16_t, QUEUED,    4u)
+
+/* Receiver / Event theo kênh */
+#define IOC_RECEIVERS_Safe      { TASK_B }
+#define IOC_EVENT_Safe          ((EventMaskType)0u)
+
+#define IOC_RECEIVERS_Speed     { TASK_B, TASK_C }
+#define IOC_EVENT_Speed         EV_RX
+#define IOC_RX_Speed_TASK_B     0u
+#define IOC_RX_Speed_TASK_C     1u
+
+/* =========================================================
+ * 2) Phần sinh tự động — không sửa tay
+ * =======================================================*/
+#define OS_IOC_QUEUED_UNQUEUED      0u
+#define OS_IOC_QUEUED_QUEUED        1u
+#define OS_IOC_SLOTS_UNQUEUED(d)    2u
+#define OS_IOC_SLOTS_QUEUED(d)      (d)
+
+#define OS_IOC_ENUM(name, type, kind, depth)  IOC_CH_##name,
+typedef enum {
+    OS_IOC_CHANNEL_LIST(OS_IOC_ENUM)
+    IOC_CH_COUNT
+} Ioc_ChannelId_e;
+#undef OS_IOC_ENUM
+
+extern const Os_IocChannelCfgType Os_IocCfg[IOC_CH_COUNT];
+
+#define OS_IOC_API(name, type, kind, depth)   OS_IOC_API_##kind(name, type)
+OS_IOC_CHANNEL_LIST(OS_IOC_API)
+#undef OS_IOC_API
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OS_IOC_CFG_H */
@@ -0,0 +1,33 @@
+/**********************************************************
+ * @file    Rte_Cfg.c
+ * @brief   Bảng runnable / cổng của RTE hướng sự kiện (sinh từ
+ *          RTE_RUNNABLE_LIST, RTE_PORT_LIST trong Rte_Cfg.h)
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Rte_Cfg.h"
+#include "Swc_SafetyManager.h"
+#include "Swc_CmdComposer.h"
+
+/* =========================================================
+ * 1) Runnable (index = RTE_RUN_<Name>)
+ * =======================================================*/
+#define RTE_RUN_ENTRY(name, fn, tmo)                                               \
+    [RTE_RUN_##name] = {                                                           \
+        .runnable = fn,                                                            \
+        .timeout  = (uint16_t)((tmo) / RTE_TIMING_BASE_MS)                         \
+    },
+const Rte_RunnableCfgType Rte_RunnableCfg[RTE_RUN_COUNT] = {
+    RTE_RUNNABLE_LIST(RTE_RUN_ENTRY)
+};
+#undef RTE_RUN_ENTRY
+
+/* =========================================================
+ * 2) Cổng → event của runnable consumer (index = RTE_PORT_<Port>)
+ * =======================================================*/
+#define RTE_PORT_ENTRY(port, name)   [RTE_PORT_##port] = RTE_EV_RUNNABLE(RTE_RUN_##name),
+const EventMaskType Rte_PortEvent[RTE_PORT_COUNT] = {
+    RTE_PORT_LIST(RTE_PORT_ENTRY)
+};
+#undef RTE_PORT_ENTRY
@@ -0,0 +1,95 @@
+/**********************************************************
+ * @file    Rte_Cfg.h
+ * @brief   Cấu hình RTE hướng sự kiện (sinh tĩnh) cho Rte.c
+ * @details RTE_EVENT_DRIVEN = 1:
+ *            - Runnable consumer không còn bị Task_A/Task_B gọi mù
+ *              mỗi chu kỳ, mà chạy trong RTE_EVENT_TASK (Extended
+ *              Task) khi:
+ *                * DataReceivedEvent: một cổng SR nó đọc được ghi
+ *                  với giá trị KHÁC giá trị hiện hành, hoặc
+ *                * timeout: đã TimeoutMs mà chưa chạy (không có dữ
+ *                  liệu mới), đếm theo nhịp RTE_TIMING_ALARM.
+ *            - Runnable chạy theo thứ tự danh sách: producer đứng
+ *              trước consumer thì chuỗi Pedal → Safety → CmdComposer
+ *              hoàn tất trong một lần dispatch.
+ *          RTE_EVENT_DRIVEN = 0: polling như cũ (Task_A/Task_B).
+ *
+ *          RTE_RUNNABLE_LIST: X(Name, Runnable, TimeoutMs)
+ *            - Name     : tên → RTE_RUN_<Name>, event RTE_EV_RUNNABLE()
+ *                         (bit 8 + thứ tự → tối đa 24 runnable)
+ *            - Runnable : hàm void(void) của SWC
+ *            - TimeoutMs: bội của RTE_TIMING_BASE_MS
+ *          RTE_PORT_LIST: X(Port, Name) — ghi Port kích runnable Name.
+ *
+ * @version 1.0
+ * @date    2025-09-10
+ * @author  Nguyễn Tuấn Khoa
+ **********************************************************/
+#ifndef RTE_CFG_H
+#define RTE_CFG_H
+
+#include "Os.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =========================================================
+ * 1) Chế độ và tài nguyên OS
+ * =======================================================*/
+#ifndef RTE_EVENT_DRIVEN
+#define RTE_EVENT_DRIVEN        1u
+#endif
+#define RTE_EVENT_TASK          TASK_C          /* Extended Task chạy runnable */
+#define RTE_TIMING_ALARM        ALARM_RTE       /* SETEVENT EV_RTE_TIMING → RTE_EVENT_TASK */
+#define RTE_TIMING_BASE_MS      50u             /* nhịp đếm timeout */
+#define RTE_EV_BASE             ((EventMaskType)0x0100u)  /* bit 8.. (0..7 cho OS/IOC) */
+
+/* =========================================================
+ * 2) Runnable và cổng kích hoạt
+ * =======================================================*/
+#define RTE_RUNNABLE_LIST(X)                                    \
+    /*  Name           Runnable                   TimeoutMs */  \
+    X(SafetyManager,   Swc_SafetyManager_Run10ms, 100u)         \
+    X(CmdComposer,     Swc_CmdComposer_Run10ms,   100u)
+
+#define RTE_PORT_LIST(X)                                        \
+    /*  Port           Runnable */                              \
+    X(PedalOut,        SafetyManager)                           \
+    X(BrakeOut,        SafetyManager)                           \
+    X(GearOut,         SafetyManager)                           \
+    X(DriveModeOut,    SafetyManager)                           \
+    X(SafeOut,         CmdComposer)
+
+/* =========================================================
+ * 3) Phần sinh tự động — không sửa tay
+ * =======================================================*/
+#define RTE_RUN_ENUM(name, fn, tmo)    RTE_RUN_##name,
+typedef enum {
+    RTE_RUNNABLE_LIST(RTE_RUN_ENUM)
+    RTE_RUN_COUNT
+} Rte_RunnableId_e;
+#undef RTE_RUN_ENUM
+
+#define RTE_PORT_ENUM(port, name)      RTE_PORT_##port,
+typedef enum {
+    RTE_PORT_LIST(RTE_PORT_ENUM)
+    RTE_PORT_COUNT
+} Rte_PortId_e;
+#undef RTE_PORT_ENUM
+
+#define RTE_EV_RUNNABLE(id)     ((EventMaskType)(RTE_EV_BASE << (id)))
+
+typedef struct {
+    void     (*runnable)(void);
+    uint16_t timeout;           /* số nhịp RTE_TIMING_BASE_MS, 0 = không timeout */
+} Rte_RunnableCfgType;
+
+extern const Rte_RunnableCfgType Rte_RunnableCfg[RTE_RUN_COUNT];
+extern const EventMaskType       Rte_PortEvent[RTE_PORT_COUNT];
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* RTE_CFG_H */
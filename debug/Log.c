@@ -0,0 +1,139 @@
+/**********************************************************
+ * @file    Log.c
+ * @brief   Log trì hoãn dạng nhị phân (xem Log.h)
+ * @details Ring nhiều-ghi một-đọc:
+ *            - Writer (Log_Put): đọc head/tail, ring đầy thì bỏ;
+ *              nếu không, CAS head → head + 1 để giành slot (lặp
+ *              lại nếu bị writer khác chen vào). Ghi ts/fmt/arg,
+ *              DMB, rồi seq = chỉ số + 1 → bản ghi được công bố.
+ *              Không tắt ngắt, không chờ: an toàn từ mọi task/ISR.
+ *            - Reader (Log_Flush, chỉ Task_Idle/ShutdownHook): slot
+ *              tail có seq == tail + 1 thì đẩy qua transport rồi
+ *              tăng tail; chưa công bố (writer bị ngắt giữa chừng)
+ *              thì dừng, lần idle sau đọc tiếp.
+ *          Slot chỉ được cấp lại khi head - tail < LOG_RING_SIZE,
+ *          tức reader đã đẩy xong slot đó.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Log.h"
+#include "Os.h"
+#include "stm32f10x.h"
+#include <stdio.h>
+
+#if ((LOG_RING_SIZE & (LOG_RING_SIZE - 1u)) != 0u) || (LOG_RING_SIZE > 0xFFFFu)
+#error "LOG_RING_SIZE phải là lũy thừa của 2 và <= 65535"
+#endif
+
+Log_BufType Log_Buf;
+
+static Log_TransportType log_transport;
+
+/* =========================================================
+ * 1) Khởi tạo
+ * =======================================================*/
+void Log_Init(void)
+{
+    for (uint32_t i = 0u; i < LOG_RING_SIZE; i++) {
+        Log_Buf.rec[i].seq = 0u;
+    }
+    Log_Buf.magic   = LOG_MAGIC;
+    Log_Buf.version = LOG_VERSION;
+    Log_Buf.size    = LOG_RING_SIZE;
+    Log_Buf.head    = 0u;
+    Log_Buf.tail    = 0u;
+    Log_Buf.drops   = 0u;
+#if defined(ITM_BASE)
+    log_transport = Log_TransportItm;
+#else
+    log_transport = Log_TransportPrintf;
+#endif
+}
+
+void Log_SetTransport(Log_TransportType transport)
+{
+    log_transport = transport;
+}
+
+/* =========================================================
+ * 2) Writer: giành slot bằng CAS, ghi, công bố
+ * =======================================================*/
+void Log_Put(const char *fmt, const uint32_t *arg)
+{
+    uint32_t h = Log_Buf.head;
+
+    do {
+        if ((h - Log_Buf.tail) >= LOG_RING_SIZE) {
+            __atomic_fetch_add(&Log_Buf.drops, 1u, __ATOMIC_RELAXED);
+            return;
+        }
+    } while (!__atomic_compare_exchange_n(&Log_Buf.head, &h, h + 1u, true,
+                                          __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+
+    Log_RecordType *r = &Log_Buf.rec[h & (LOG_RING_SIZE - 1u)];
+    r->ts  = OS_TickCount();
+    r->fmt = fmt;
+    for (uint32_t i = 0u; i < LOG_MAX_ARGS; i++) {
+        r->arg[i] = arg[i];
+    }
+    __DMB();
+    r->seq = h + 1u;
+}
+
+/* =========================================================
+ * 3) Reader: đẩy bản ghi đã công bố theo thứ tự
+ * =======================================================*/
+void Log_Flush(void)
+{
+    uint32_t t = Log_Buf.tail;
+
+    while (t != Log_Buf.head) {
+        const Log_RecordType *r = &Log_Buf.rec[t & (LOG_RING_SIZE - 1u)];
+        if (r->seq != (t + 1u)) {
+            break;                      /* writer chưa công bố */
+        }
+        __DMB();
+        if (log_transport != NULL) {
+            log_transport(r);
+        }
+        __DMB();
+        t++;
+        Log_Buf.tail = t;               /* trả slot cho writer */
+    }
+}
+
+uint32_t Log_GetDropCount(void)
+{
+    return Log_Buf.drops;
+}
+
+/* =========================================================
+ * 4) Transport
+ * =======================================================*/
+void Log_TransportPrintf(const Log_RecordType *rec)
+{
+    printf(rec->fmt, rec->arg[0], rec->arg[1], rec->arg[2], rec->arg[3]);
+}
+
+/* Luồng ITM: LOG_ITM_SYNC, ts, fmt, arg[0..3] — mỗi mục một word.
+ * Debugger chưa bật ITM/cổng → bỏ qua, không chờ. */
+void Log_TransportItm(const Log_RecordType *rec)
+{
+#if defined(ITM_BASE)
+    if (((ITM->TCR & ITM_TCR_ITMENA_Msk) == 0u) || ((ITM->TER & (1u << LOG_ITM_PORT)) == 0u)) {
+        return;
+    }
+    const uint32_t w[3u + LOG_MAX_ARGS] = {
+        LOG_ITM_SYNC, rec->ts, (uint32_t)rec->fmt,
+        rec->arg[0], rec->arg[1], rec->arg[2], rec->arg[3]
+    };
+    for (uint32_t i = 0u; i < (3u + LOG_MAX_ARGS); i++) {
+        while (ITM->PORT[LOG_ITM_PORT].u32 == 0u) { }   /* FIFO đầy: chờ (idle, bị ngắt chen được) */
+        ITM->PORT[LOG_ITM_PORT].u32 = w[i];
+    }
+#else
+    (void)rec;
+#endif
+}
@@ -0,0 +1,126 @@
+/**********************************************************
+ * @file    Log.h
+ * @brief   Log trì hoãn dạng nhị phân (thay printf trên đường nóng)
+ * @details Điểm log không định dạng chuỗi: LOG(fmt, ...) chỉ ghi
+ *          con trỏ chuỗi định dạng (nằm sẵn trong .rodata của ELF)
+ *          cùng tối đa LOG_MAX_ARGS đối số 32 bit vào ring RAM —
+ *          vài chục chu kỳ, không chặn, không khoá.
+ *          Task_Idle gọi Log_Flush() để đẩy bản ghi qua transport:
+ *            - Log_TransportItm    : nhị phân qua ITM/SWO (mặc định
+ *              trên target, không dừng lõi), giải mã bằng
+ *              debug/log_decode.py + ELF.
+ *            - Log_TransportPrintf : định dạng rồi printf (host;
+ *              trên target là semihosting — chậm nhưng chỉ ở idle).
+ *            - Hoặc hàm bất kỳ kiểu Log_TransportType (UART...)
+ *              đăng ký qua Log_SetTransport().
+ *
+ *          Giới hạn đối số: chỉ kiểu nguyên ≤ 32 bit (%d %u %x %c);
+ *          không %s/%f (chuỗi/float không được chép vào ring).
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#ifndef LOG_H
+#define LOG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* =========================================================
+ * 1) Cấu hình
+ * =======================================================*/
+#ifndef LOG_ENABLE
+#define LOG_ENABLE          1u
+#endif
+#define LOG_RING_SIZE       32u     /* số bản ghi, lũy thừa của 2 (28 byte/bản ghi trên target) */
+#define LOG_MAX_ARGS        4u
+#define LOG_ITM_PORT        1u      /* cổng stimulus ITM (0 thường dành cho printf) */
+#define LOG_ITM_SYNC        0x21474F4Cu   /* "LOG!" mở đầu mỗi bản ghi trên luồng ITM */
+#define LOG_MAGIC           0x42474F4Cu   /* "LOGB" */
+#define LOG_VERSION         1u
+
+/* =========================================================
+ * 2) Kiểu dữ liệu
+ * =======================================================*/
+typedef struct {
+    volatile uint32_t seq;          /* chỉ số ghi + 1 khi bản ghi đã đầy đủ */
+    uint32_t ts;                    /* OS_TickCount() (ms) */
+    const char *fmt;                /* chuỗi định dạng trong .rodata */
+    uint32_t arg[LOG_MAX_ARGS];
+} Log_RecordType;
+
+/* Ring + header, symbol cố định cho debugger:
+ * dump binary memory log.bin &Log_Buf (&Log_Buf + 1) */
+typedef struct {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t size;
+    volatile uint32_t head;         /* số slot đã cấp cho writer */
+    volatile uint32_t tail;         /* số bản ghi đã đẩy qua transport */
+    volatile uint32_t drops;        /* bản ghi bỏ vì ring đầy */
+    Log_RecordType rec[LOG_RING_SIZE];
+} Log_BufType;
+
+typedef void (*Log_TransportType)(const Log_RecordType *rec);
+
+extern Log_BufType Log_Buf;
+
+/* =========================================================
+ * 3) API
+ * =======================================================*/
+/**
+ * @brief  Khởi tạo ring và chọn transport mặc định.
+ * @note   Gọi một lần trước lần LOG() đầu tiên (main, trước EcuM_Init).
+ */
+void Log_Init(void);
+
+/**
+ * @brief  Đổi transport (NULL = giữ bản ghi trong ring, không đẩy ra).
+ */
+void Log_SetTransport(Log_TransportType transport);
+
+/**
+ * @brief  Ghi một bản ghi (dùng qua macro LOG).
+ * @details Nhiều writer (task mọi mức ưu tiên, ISR) không khoá: giành slot
+ *          bằng compare-and-swap trên head (LDREX/STREX), ghi nội dung, rồi
+ *          công bố bằng seq. Ring đầy → bỏ bản ghi mới, tăng drops.
+ */
+void Log_Put(const char *fmt, const uint32_t *arg);
+
+/**
+ * @brief  Đẩy mọi bản ghi đã công bố qua transport (một reader).
+ * @note   Gọi từ Task_Idle (ưu tiên thấp nhất) hoặc ShutdownHook.
+ */
+void Log_Flush(void);
+
+/** @brief Số bản ghi bị bỏ vì ring đầy kể từ Log_Init(). */
+uint32_t Log_GetDropCount(void);
+
+/* Transport có sẵn */
+void Log_TransportPrintf(const Log_RecordType *rec);
+void Log_TransportItm(const Log_RecordType *rec);
+
+/**
+ * @brief  Log trì hoãn: LOG("[Task_B] Engine Speed:%d\n", rpm);
+ * @note   Quá LOG_MAX_ARGS đối số → lỗi biên dịch (excess elements).
+ */
+#if (LOG_ENABLE == 1u)
+#define LOG(fmt, ...)                                                   \
+    do {                                                                \
+        const uint32_t log_arg_[LOG_MAX_ARGS] = { __VA_ARGS__ };        \
+        Log_Put((fmt), log_arg_);                                       \
+    } while (0)
+#else
+#define LOG(fmt, ...)   do { } while (0)
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* LOG_H */
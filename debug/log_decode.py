@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+log_decode.py — dựng lại text từ log nhị phân của Log.c (LOG(fmt, ...))
+
+Bản ghi chỉ chứa địa chỉ chuỗi định dạng; chuỗi được đọc từ section
+.rodata của chính file ELF đã nạp cho target.
+
+Nguồn vào:
+  1) Luồng ITM/SWO (Log_TransportItm, cổng LOG_ITM_PORT), ví dụ OpenOCD:
+         (openocd) tpiu config internal swo.bin uart off 72000000
+         (openocd) itm port 1 on
+     rồi:
+         python3 debug/log_decode.py Tools/os_test.elf swo.bin
+  2) Luồng word thô little-endian (transport UART tự viết, cùng khung
+     LOG_ITM_SYNC, ts, fmt, arg[0..3]):
+         python3 debug/log_decode.py Tools/os_test.elf uart.bin -f raw
+  3) Dump ring khi target đang dừng:
+         (gdb) dump binary memory log.bin &Log_Buf (&Log_Buf + 1)
+         python3 debug/log_decode.py Tools/os_test.elf log.bin -f dump
+
+Định dạng (little-endian, khớp Log.h):
+    khung ITM/raw : uint32 LOG_ITM_SYNC, ts, fmt, arg[4]
+    Log_Buf       : uint32 magic "LOGB", uint16 version, uint16 size,
+                    uint32 head, tail, drops,
+                    rec[i]: uint32 seq, ts, fmt, arg[4]
+"""
+
+import argparse
+import re
+import struct
+import sys
+
+LOG_ITM_SYNC = 0x21474F4C
+LOG_MAGIC = 0x42474F4C
+MAX_ARGS = 4
+HDR = struct.Struct("<IHHIII")
+REC = struct.Struct("<III%dI" % MAX_ARGS)
+
+SPEC = re.compile(r"%([-+ #0]*\d*(?:\.\d+)?)(hh|h|ll|l|z)?([diuxXoc%])")
+
+
+class Elf:
+    """Đọc chuỗi theo địa chỉ từ các section được nạp (ELF32/ELF64 LE)."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.raw = f.read()
+        if self.raw[:4] != b"\x7fELF":
+            sys.exit("%s không phải ELF" % path)
+        is64 = self.raw[4] == 2
+        if is64:
+            shoff, = struct.unpack_from("<Q", self.raw, 0x28)
+            shentsize, shnum = struct.unpack_from("<HH", self.raw, 0x3A)
+            sh = struct.Struct("<IIQQQQIIQQ")
+        else:
+            shoff, = struct.unpack_from("<I", self.raw, 0x20)
+            shentsize, shnum = struct.unpack_from("<HH", self.raw, 0x2E)
+            sh = struct.Struct("<IIIIIIIIII")
+        self.sections = []
+        for i in range(shnum):
+            _, typ, flags, addr, off, size = sh.unpack_from(self.raw, shoff + i * shentsize)[:6]
+            if (flags & 0x2) and typ != 8 and size:      # SHF_ALLOC, bỏ NOBITS (.bss)
+                self.sections.append((addr, off, size))
+        self.cache = {}
+
+    def string(self, addr):
+        if addr in self.cache:
+            return self.cache[addr]
+        for base, off, size in self.sections:
+            if base <= addr < base + size:
+                start = off + (addr - base)
+                end = self.raw.index(b"\0", start)
+                s = self.raw[start:end].decode("utf-8", "replace")
+                break
+        else:
+            s = None
+        self.cache[addr] = s
+        return s
+
+
+def render(fmt, args):
+    """printf tối giản: chỉ đối số nguyên 32 bit như Log.h cho phép."""
+    it = iter(args)
+
+    def sub(m):
+        flags, _, conv = m.groups()
+        if conv == "%":
+            return "%"
+        v = next(it, 0)
+        if conv in "di":
+            v = v - (1 << 32) if v & 0x80000000 else v
+            conv = "d"
+        elif conv == "c":
+            v = chr(v & 0xFF)
+        return ("%" + flags + conv) % v
+
+    return SPEC.sub(sub, fmt)
+
+
+def itm_words(data, port):
+    """Tách word của một cổng stimulus khỏi luồng gói ITM."""
+    words, i, n = [], 0, len(data)
+    while i < n:
+        b = data[i]
+        i += 1
+        size = (0, 1, 2, 4)[b & 0x3]
+        if size:                                  # gói nguồn (SW hoặc HW)
+            payload = data[i:i + size]
+            i += size
+            if not (b & 0x4) and (b >> 3) == port and size == 4 and len(payload) == 4:
+                words.append(struct.unpack("<I", payload)[0])
+        elif b & 0x80 and b != 0x80:              # timestamp/extension: bỏ các byte nối tiếp (bit 7)
+            while i < n:
+                c = data[i]
+                i += 1
+                if not c & 0x80:
+                    break
+        # 0x00/0x80 (sync), 0x70 (overflow): bỏ qua
+    return words
+
+
+def frames(words):
+    """Ghép khung LOG_ITM_SYNC + 6 word, tự bắt lại nhịp khi mất dữ liệu."""
+    out, i = [], 0
+    while i + 3 + MAX_ARGS <= len(words):
+        if words[i] != LOG_ITM_SYNC:
+            i += 1
+            continue
+        out.append((words[i + 1], words[i + 2], words[i + 3:i + 3 + MAX_ARGS]))
+        i += 3 + MAX_ARGS
+    return out
+
+
+def dump_records(data):
+    magic, ver, size, head, tail, drops = HDR.unpack_from(data, 0)
+    if magic != LOG_MAGIC:
+        sys.exit("sai magic 0x%08X (không phải Log_Buf?)" % magic)
+    if ver != 1:
+        sys.exit("không hỗ trợ version %d" % ver)
+    out = []
+    for idx in range(max(0, head - size), head):
+        seq, ts, fmt, *args = REC.unpack_from(data, HDR.size + (idx % size) * REC.size)
+        if seq == idx + 1:
+            out.append((ts, fmt, args))
+    print("# head %d, tail %d (chưa đẩy %d), drops %d" % (head, tail, head - tail, drops))
+    return out
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Giải mã log nhị phân Log.c")
+    ap.add_argument("elf", help="file ELF của firmware (chứa chuỗi định dạng)")
+    ap.add_argument("input", help="luồng ITM/raw hoặc dump Log_Buf")
+    ap.add_argument("-f", "--format", choices=("itm", "raw", "dump"), default="itm")
+    ap.add_argument("--port", type=int, default=1, help="cổng ITM (LOG_ITM_PORT)")
+    args = ap.parse_args()
+
+    elf = Elf(args.elf)
+    with open(args.input, "rb") as f:
+        data = f.read()
+    if args.format == "dump":
+        recs = dump_records(data)
+    elif args.format == "raw":
+        recs = frames(list(struct.unpack("<%dI" % (len(data) // 4), data[:len(data) // 4 * 4])))
+    else:
+        recs = frames(itm_words(data, args.port))
+
+    for ts, fmt, a in recs:
+        s = elf.string(fmt)
+        text = render(s, a) if s is not None else "<fmt 0x%08X?> %s" % (fmt, a)
+        sys.stdout.write("[%8.3f] %s" % (ts / 1000.0, text if text.endswith("\n") else text + "\n"))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,216 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+os_trace_decode.py — giải mã ring buffer Os_TraceBuf (Os_Trace.c)
+
+Lấy dump từ GDB (target đang dừng):
+    (gdb) dump binary memory trace.bin &Os_TraceBuf (&Os_TraceBuf + 1)
+
+Chạy:
+    python3 debug/os_trace_decode.py trace.bin               # bảng thời gian theo task
+    python3 debug/os_trace_decode.py trace.bin -j trace.json # + Chrome trace (chrome://tracing, Perfetto)
+
+Định dạng (little-endian, khớp Os_TraceBufType trong Os_Types.h):
+    header : uint32 magic "OSTR", uint16 version, uint16 size,
+             uint32 head (tổng số bản ghi đã ghi), uint32 core_hz
+    rec[i] : uint32 ts (CYCCNT), uint8 type, uint8 tid, uint16 arg
+
+Ring chỉ giữ 'size' bản ghi gần nhất → số liệu ở đây tính trên cửa sổ đó;
+thống kê đầy đủ từ StartOS nằm trong Os_Trace_GetTaskTiming() trên target.
+"""
+
+import argparse
+import json
+import os
+import re
+import struct
+import sys
+
+MAGIC = 0x5254534F
+HDR = struct.Struct("<IHHII")
+REC = struct.Struct("<IBBH")
+
+EV_ACTIVATE, EV_SWITCH, EV_TERMINATE, EV_OVERRUN = 1, 2, 3, 4
+
+# Theo TaskId_e trong Os_Cfg.h
+DEFAULT_NAMES = "InitTask,Task_A,Task_B,Task_C,Task_Com,Task_Idle"
+DEFAULT_CFG = os.path.join(os.path.dirname(os.path.abspath(__file__)),
+                           "..", "bsw", "services", "os", "inc", "Os_Cfg.h")
+MASK32 = 0xFFFFFFFF
+
+
+def task_ids(path):
+    """Danh sách tên enum TaskId_e (thứ tự = TaskId), None nếu không đọc được."""
+    try:
+        with open(path, encoding="utf-8") as f:
+            src = f.read()
+    except OSError:
+        return None
+    m = re.search(r"typedef\s+enum\s*\{([^}]*)\}\s*TaskId_e\s*;", src)
+    if not m:
+        return None
+    body = re.sub(r"/\*.*?\*/|//[^\n]*", "", m.group(1), flags=re.S)
+    ids = []
+    for item in body.split(","):
+        name = item.split("=")[0].strip()
+        if name and name != "TASK_COUNT":
+            ids.append(name)
+    return ids
+
+
+def load(path):
+    with open(path, "rb") as f:
+        raw = f.read()
+    magic, ver, size, head, hz = HDR.unpack_from(raw, 0)
+    if magic != MAGIC:
+        sys.exit("sai magic 0x%08X (không phải Os_TraceBuf?)" % magic)
+    if ver != 1:
+        sys.exit("không hỗ trợ version %d" % ver)
+    n = min(head, size)
+    recs = []
+    for seq in range(head - n, head):
+        off = HDR.size + (seq % size) * REC.size
+        recs.append(REC.unpack_from(raw, off))
+    # Mở rộng CYCCNT 32 bit thành thời gian tuyệt đối (bản ghi liền nhau < 1 vòng tràn)
+    out, base, last = [], 0, None
+    for ts, typ, tid, arg in recs:
+        if last is not None and ts < last:
+            base += MASK32 + 1
+        last = ts
+        out.append((base + ts, typ, tid, arg))
+    return hz, head, out
+
+
+class Stat:
+    def __init__(self):
+        self.exec = []
+        self.resp = []
+        self.lat = []
+        self.overrun = 0
+
+
+def analyse(hz, recs, names, idle):
+    stats = {}
+    slices = []          # (tid, start, end)
+    act = {}             # tid -> [mốc activate đang chờ] (FIFO)
+    job_start = {}       # tid -> mốc activate của lần chạy hiện tại
+    job_exec = {}        # tid -> chu kỳ đã dùng, None = chưa được chạy
+    cur, slice_ts = None, None
+    idle_cyc = 0
+
+    def st(t):
+        return stats.setdefault(t, Stat())
+
+    for ts, typ, tid, arg in recs:
+        if typ == EV_ACTIVATE:
+            if arg == 1:
+                job_start[tid] = ts
+                job_exec[tid] = None
+            else:
+                act.setdefault(tid, []).append(ts)
+        elif typ == EV_OVERRUN:
+            st(tid).overrun += 1
+        elif typ == EV_SWITCH:
+            if cur is not None:
+                slices.append((cur, slice_ts, ts))
+                if cur == idle:
+                    idle_cyc += ts - slice_ts
+                elif job_exec.get(cur) is not None:
+                    job_exec[cur] += ts - slice_ts
+            if tid != idle and tid in job_start and job_exec.get(tid) is None:
+                st(tid).lat.append(ts - job_start[tid])
+                job_exec[tid] = 0
+            cur, slice_ts = tid, ts
+        elif typ == EV_TERMINATE:
+            if job_exec.get(tid) is not None and tid == cur:
+                st(tid).exec.append(job_exec[tid] + ts - slice_ts)
+                st(tid).resp.append(ts - job_start[tid])
+                slices.append((cur, slice_ts, ts))
+                slice_ts = ts
+            job_exec[tid] = None
+            job_start.pop(tid, None)
+            if arg and act.get(tid):
+                job_start[tid] = act[tid].pop(0)
+            # phần còn lại tới SWITCH kế tiếp không thuộc lần chạy nào
+            cur = None if tid == cur else cur
+    span = (recs[-1][0] - recs[0][0]) if len(recs) > 1 else 0
+    return stats, slices, idle_cyc, span
+
+
+def us(cyc, hz):
+    return cyc * 1e6 / hz
+
+
+def print_table(hz, head, recs, names, stats, idle_cyc, span):
+    print("core %d Hz, %d bản ghi (tổng %d), cửa sổ %.3f ms"
+          % (hz, len(recs), head, us(span, hz) / 1000.0))
+    print("%-10s %5s %10s %10s %10s %10s %10s %7s"
+          % ("task", "n", "exec_min", "exec_avg", "exec_max", "resp_max", "lat_max", "overrun"))
+    for tid in sorted(stats):
+        s = stats[tid]
+        name = names[tid] if tid < len(names) else "T%d" % tid
+        if s.exec:
+            emin, eavg, emax = min(s.exec), sum(s.exec) / len(s.exec), max(s.exec)
+        else:
+            emin = eavg = emax = 0
+        print("%-10s %5d %10.1f %10.1f %10.1f %10.1f %10.1f %7d"
+              % (name, len(s.exec), us(emin, hz), us(eavg, hz), us(emax, hz),
+                 us(max(s.resp, default=0), hz), us(max(s.lat, default=0), hz), s.overrun))
+    print("(đơn vị µs)")
+    if span:
+        print("CPU load: %.1f %%" % (100.0 * (1.0 - float(idle_cyc) / span)))
+
+
+def chrome_trace(hz, recs, slices, names):
+    t0 = recs[0][0] if recs else 0
+    ev = []
+    for tid, a, b in slices:
+        ev.append({"name": names[tid] if tid < len(names) else "T%d" % tid,
+                   "ph": "X", "pid": 0, "tid": tid,
+                   "ts": us(a - t0, hz), "dur": us(b - a, hz)})
+    for ts, typ, tid, arg in recs:
+        if typ in (EV_ACTIVATE, EV_OVERRUN):
+            ev.append({"name": "activate" if typ == EV_ACTIVATE else "overrun",
+                       "ph": "i", "s": "t", "pid": 0, "tid": tid,
+                       "ts": us(ts - t0, hz), "args": {"count": arg}})
+    for tid, name in enumerate(names):
+        ev.append({"name": "thread_name", "ph": "M", "pid": 0, "tid": tid,
+                   "args": {"name": name}})
+    return {"traceEvents": ev, "displayTimeUnit": "ns"}
+
+
+def main():
+    ap = argparse.ArgumentParser(description="Giải mã Os_TraceBuf")
+    ap.add_argument("dump", help="file dump nhị phân của Os_TraceBuf")
+    ap.add_argument("-j", "--json", help="ghi Chrome trace JSON ra file")
+    ap.add_argument("--names", default=DEFAULT_NAMES,
+                    help="tên task theo thứ tự TaskId_e, phân tách bằng dấu phẩy")
+    ap.add_argument("--idle", type=int, default=None,
+                    help="TaskId của Task_Idle (mặc định: TASK_IDLE trong --cfg)")
+    ap.add_argument("--cfg", default=DEFAULT_CFG,
+                    help="Os_Cfg.h để lấy TaskId_e (mặc định: của cây nguồn)")
+    args = ap.parse_args()
+
+    names = args.names.split(",")
+    ids = task_ids(args.cfg)
+    if ids is not None and len(ids) != len(names):
+        print("cảnh báo: --names có %d tên, TaskId_e có %d task"
+              % (len(names), len(ids)), file=sys.stderr)
+    if args.idle is not None:
+        idle = args.idle
+    elif ids is not None and "TASK_IDLE" in ids:
+        idle = ids.index("TASK_IDLE")
+    else:
+        idle = len(names) - 1
+    hz, head, recs = load(args.dump)
+    if not recs:
+        sys.exit("buffer rỗng")
+    stats, slices, idle_cyc, span = analyse(hz, recs, names, idle)
+    print_table(hz, head, recs, names, stats, idle_cyc, span)
+    if args.json:
+        with open(args.json, "w") as f:
+            json.dump(chrome_trace(hz, recs, slices, names), f)
+
+
+if __name__ == "__main__":
+    main()
@@ -63,14 +63,12 @@ typedef uint8_t Std_ReturnType;
  * @details Bao gồm các kiểu dữ liệu nguyên thủy như uint8_t, sint16_t, vuint32_t, vuint64_t, vfloat32_t, vfloat64_t.
  * @note This file is part of the AUTOSAR standard and should be used in compliance with the AUTOSAR guidelines.
  ****************************************************************/
-typedef unsigned char uint8_t;
-typedef unsigned short uint16_t;
-typedef unsigned long uint32_t;
-typedef unsigned long long uint64_t;
-typedef signed char sint8_t;
-typedef signed short sint16_t;
-typedef signed long sint32_t;
-typedef signed long long sint64_t;
+/* uint8_t..uint64_t lấy từ <stdint.h>; sint*_t ánh xạ theo độ rộng cố định
+ * để giữ đúng kích thước cả trên host 64-bit (long = 8 byte) */
+typedef int8_t  sint8_t;
+typedef int16_t sint16_t;
+typedef int32_t sint32_t;
+typedef int64_t sint64_t;
 
 typedef float float32_t;
 typedef double float64_t;
@@ -0,0 +1,137 @@
+/**********************************************************
+ * @file    Sim_DriveCycle.c
+ * @brief   Chu trình lái giả lập cho bản host (make host)
+ * @details Bảng điểm mốc 60 s, lặp lại vô hạn:
+ *            - gear/brake/mode: giữ theo mốc gần nhất phía trước
+ *            - pedal (%): nội suy tuyến tính giữa hai mốc
+ *          Đầu vào ánh xạ đúng kênh IoHwAb của target:
+ *            - Pedal : ADC_GROUP_PEDAL, 0..PEDAL_RAW_MAX (4029)
+ *            - Brake : DIO 16 (PB0), HIGH = đạp
+ *            - Gear  : DIO 8 (b0), DIO 10 (b1): P=0, R=1, N=2, D=3
+ *            - Mode  : DIO 17 (PB1), HIGH = NORMAL
+ *          Mô hình động cơ: mỗi 10 ms gửi Engine_Status (0x200),
+ *          rpm = 800 + 55 * pedal%; byte 0 theo đúng tín hiệu
+ *          EngineSpeedRpm của Com_Cfg.c (u8, không scaling) → bão hoà
+ *          ở 255.
+ *          VCU_SIM_DIOBOUNCE=ms: sau mỗi cạnh, chân DIO dội ngẫu nhiên
+ *          trong ms mili giây (rung tiếp điểm) để thử debounce IoHwAb.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Sim_Mcal.h"
+#include "IoHwAb.h"
+#include <stdlib.h>
+
+#define SIM_CYCLE_MS         60000u
+#define SIM_PEDAL_RAW_MAX    4029u
+#define SIM_ENGINE_PERIOD    10u
+#define SIM_ENGINE_CAN_ID    0x200u
+
+#define SIM_DIO_BRAKE        16u
+#define SIM_DIO_GEAR_B0      8u
+#define SIM_DIO_GEAR_B1      10u
+#define SIM_DIO_MODE         17u
+
+typedef struct {
+    uint32_t t_ms;     /* mốc trong chu trình */
+    uint8_t  gear;     /* 0=P 1=R 2=N 3=D (mã hoá DIO) */
+    uint8_t  brake;
+    uint8_t  normal;   /* 1 = NORMAL, 0 = ECO */
+    uint8_t  pedal;    /* % tại mốc */
+} Sim_CyclePoint;
+
+static const Sim_CyclePoint cycle[] = {
+    {     0u, 0u, 1u, 0u,  0u },   /* P, đạp phanh, khởi động */
+    {  2000u, 3u, 1u, 0u,  0u },   /* vào D */
+    {  3000u, 3u, 0u, 0u,  0u },   /* nhả phanh */
+    { 10000u, 3u, 0u, 0u, 60u },   /* tăng tốc (ECO) */
+    { 25000u, 3u, 0u, 1u, 60u },   /* đi đều, chuyển NORMAL */
+    { 28000u, 3u, 0u, 1u, 90u },   /* vượt */
+    { 30000u, 3u, 0u, 1u,  0u },   /* nhả ga */
+    { 32000u, 3u, 1u, 1u,  0u },   /* phanh tới dừng */
+    { 40000u, 2u, 1u, 1u,  0u },   /* N */
+    { 42000u, 1u, 1u, 1u,  0u },   /* R */
+    { 43000u, 1u, 0u, 1u,  0u },
+    { 48000u, 1u, 0u, 1u, 20u },   /* lùi chậm */
+    { 52000u, 1u, 0u, 1u,  0u },
+    { 53000u, 1u, 1u, 1u,  0u },
+    { 56000u, 0u, 1u, 0u,  0u },   /* về P */
+};
+#define SIM_CYCLE_POINTS   (sizeof(cycle) / sizeof(cycle[0]))
+
+static TickType engine_last;
+
+/* Rung tiếp điểm (VCU_SIM_DIOBOUNCE) */
+#define SIM_DIO_INPUTS       4u
+static const Dio_ChannelType sim_dio_ch[SIM_DIO_INPUTS] = {
+    SIM_DIO_BRAKE, SIM_DIO_GEAR_B0, SIM_DIO_GEAR_B1, SIM_DIO_MODE
+};
+static TickType       bounce_ticks;
+static bool           bounce_read;
+static uint32_t       bounce_rng = 0x2545F491u;
+static Dio_LevelType  dio_level[SIM_DIO_INPUTS];
+static TickType       dio_edge[SIM_DIO_INPUTS];
+
+static void sim_set_input(uint32_t k, Dio_LevelType lv, TickType now)
+{
+    if (lv != dio_level[k]) {
+        dio_level[k] = lv;
+        dio_edge[k]  = now;
+    }
+    if ((now - dio_edge[k]) < bounce_ticks) {
+        bounce_rng ^= bounce_rng << 13;
+        bounce_rng ^= bounce_rng >> 17;
+        bounce_rng ^= bounce_rng << 5;
+        lv = (bounce_rng & 1u) ? STD_HIGH : STD_LOW;
+    }
+    Sim_SetDio(sim_dio_ch[k], lv);
+}
+
+static uint8_t sim_pedal_at(uint32_t t, uint32_t i)
+{
+    if ((i + 1u) >= SIM_CYCLE_POINTS) {
+        return cycle[i].pedal;
+    }
+    const Sim_CyclePoint *a = &cycle[i];
+    const Sim_CyclePoint *b = &cycle[i + 1u];
+    int32_t dp = (int32_t)b->pedal - (int32_t)a->pedal;
+    return (uint8_t)((int32_t)a->pedal +
+                     (dp * (int32_t)(t - a->t_ms)) / (int32_t)(b->t_ms - a->t_ms));
+}
+
+uint32_t Sim_DriveCycle_Count(TickType now)
+{
+    return (uint32_t)(((uint64_t)now * 1000u / OS_TICK_HZ) / SIM_CYCLE_MS);
+}
+
+void Sim_DriveCycle_Step(TickType now)
+{
+    uint32_t t = (uint32_t)((((uint64_t)now * 1000u) / OS_TICK_HZ) % SIM_CYCLE_MS);
+    uint32_t i = 0u;
+
+    while (((i + 1u) < SIM_CYCLE_POINTS) && (cycle[i + 1u].t_ms <= t)) {
+        i++;
+    }
+    uint8_t pedal = sim_pedal_at(t, i);
+
+    if (!bounce_read) {
+        const char *b = getenv("VCU_SIM_DIOBOUNCE");
+        bounce_read  = true;
+        bounce_ticks = (b != NULL) ? (TickType)((strtoul(b, NULL, 10) * OS_TICK_HZ) / 1000u) : 0u;
+    }
+
+    Sim_SetAdc(ADC_GROUP_PEDAL, (Adc_ValueGroupType)((SIM_PEDAL_RAW_MAX * pedal) / 100u));
+    sim_set_input(0u, cycle[i].brake ? STD_HIGH : STD_LOW, now);
+    sim_set_input(1u, (cycle[i].gear & 1u) ? STD_HIGH : STD_LOW, now);
+    sim_set_input(2u, (cycle[i].gear & 2u) ? STD_HIGH : STD_LOW, now);
+    sim_set_input(3u, cycle[i].normal ? STD_HIGH : STD_LOW, now);
+
+    if ((now - engine_last) >= SIM_ENGINE_PERIOD) {
+        uint32_t rpm = 800u + 55u * pedal;
+        uint8_t data[8] = { (uint8_t)((rpm > 0xFFu) ? 0xFFu : rpm) };
+        engine_last = now;
+        (void)Sim_CanInject(SIM_ENGINE_CAN_ID, data, 8u);
+    }
+}
@@ -0,0 +1,920 @@
+/**********************************************************
+ * @file    Sim_Mcal.c
+ * @brief   MCAL giả lập cho bản host POSIX (xem Sim_Mcal.h)
+ * @details Thay bsw/mcal/ (*.c) và platform/spl/src trong make host.
+ *          Chỉ hiện thực phần API mà IoHwAb/CanIf dùng; cấu hình
+ *          (cfg/mcal, cfg/ecua) vẫn là bản thật của target.
+ *
+ *          Đồng bộ: trên host "ISR" (tick) chỉ chen vào task tại
+ *          __enable_irq/WFI, nên hàng đợi RX (task ghi qua loopback,
+ *          tick ghi/đọc) và hàng đợi TxConfirmation không cần vùng
+ *          găng riêng.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Sim_Mcal.h"
+#include "Os_Arch.h"
+#include "Port.h"
+#include "Can.h"
+#include "Can_Cfg.h"
+#include "Adc_Cfg.h"
+#include "CanIf.h"
+#include "Log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+uint32_t SystemCoreClock = 72000000u;
+
+static Adc_ValueGroupType sim_adc[SIM_ADC_GROUPS];
+static Adc_StatusType     sim_adc_status[SIM_ADC_GROUPS];
+static Dio_LevelType      sim_dio[SIM_DIO_CHANNELS];
+
+static CanRxMsg  rx_q[SIM_CAN_RX_QUEUE];
+static uint32_t  rx_head;
+static uint32_t  rx_tail;
+static uint32_t  tx_count;
+static uint32_t  rx_count;
+static uint32_t  rx_drops;
+static bool      rx_fov0;                   /* cờ FOVR0 như bxCAN */
+static uint32_t  bus_load;                  /* VCU_SIM_BUSLOAD: frame nền mỗi ms */
+static uint32_t  bus_load_seq;
+static TickType  bus_load_last;
+static PduIdType txc_q[SIM_CAN_TX_QUEUE];   /* frame đã "lên bus", chờ ngắt TX */
+static uint32_t  txc_head;
+static uint32_t  txc_tail;
+static uint32_t  txc_count;
+static bool      can_log;
+static uint32_t  dma_flags;                 /* DMA1_IT_HT1 / DMA1_IT_TC1 đang chờ */
+static uint32_t  dma_pos;                   /* mẫu DMA ghi tiếp trong buffer */
+static bool      tim_ok;                    /* timer kích hợp lệ (TriggerSource/Period/Lead) */
+static bool      trig_hw;                   /* chuỗi regular kích bằng timer (không: liên tục) */
+static bool      trig_running;              /* timer đã chạy (Adc_SyncTrigger đầu tiên) */
+static bool      trig_sync;                 /* Adc_SyncTrigger chờ áp ở tick hook */
+static uint64_t  trig_next_ns;              /* lần kích regular kế tiếp */
+static uint32_t  trig_period_us;
+static bool      inj_hw;                    /* injected kích bằng CC của cùng timer */
+static bool      inj_sw;                    /* JSWSTART chờ (Adc_StartGroupConversion) */
+static uint64_t  inj_next_ns;               /* lần kích injected kế tiếp */
+static uint64_t  seq_now_ns;                /* bộ tuần tự đã chạy tới */
+static uint64_t  conv_end_ns;               /* chuyển đổi đang chạy xong lúc */
+static bool      reg_busy;                  /* chuỗi regular đang chạy (liên tục: luôn) */
+static bool      reg_pending;               /* kích regular tới khi injected đang chạy */
+static uint32_t  reg_rank;
+static uint32_t  reg_len;                   /* rank mỗi chuỗi regular, 0 = không quét */
+static uint32_t  reg_conv_ns[ADC_SCAN_MAX_CHANNELS];   /* theo Rank */
+static uint64_t  reg_trig_ns;
+static uint64_t  reg_max_ns;                /* kích → xong chuỗi regular lâu nhất */
+static uint32_t  reg_lost;                  /* kích regular khi chuỗi trước chưa xong */
+static bool      inj_busy;
+static uint32_t  inj_rank;
+static uint32_t  inj_len;                   /* rank injected, 0 = không có nhóm ưu tiên */
+static uint32_t  inj_conv_ns;
+static Adc_GroupType inj_grp[ADC_INJ_MAX_CHANNELS];    /* rank → group cấp giá trị */
+static Adc_ValueGroupType inj_jdr[ADC_INJ_MAX_CHANNELS];
+static bool      inj_jeoc;                  /* cờ JEOC chờ ISR */
+static uint64_t  inj_trig_ns;
+static uint64_t  inj_max_ns;                /* kích → JEOC lâu nhất */
+static uint32_t  inj_trig;                  /* lần kích injected */
+static uint32_t  inj_preempt;               /* chuyển đổi regular bị injected ngắt */
+static uint32_t  inj_lost;                  /* kích injected khi chuỗi trước chưa xong */
+static uint32_t  adc_max_age;               /* tuổi mẫu bàn đạp lớn nhất lúc đọc (ms) */
+static TickType  adc_stall;                 /* VCU_SIM_ADCSTALL: ADC ngừng từ ms này (0 = không) */
+static Adc_GroupType dma_grp[ADC_SCAN_MAX_CHANNELS];   /* Rank → group cấp giá trị */
+static uint32_t  adc_noise;                 /* VCU_SIM_ADCNOISE: ± LSB mỗi mẫu */
+static uint32_t  adc_rng = 0x9E3779B9u;
+static uint32_t  adc_reads;
+static uint32_t  adc_max_err;               /* |đọc - đầu vào hiện tại| lớn nhất, group 0 */
+static Can_FilterLayoutType filter;         /* bộ lọc "phần cứng" (Can_SetRxFilter) */
+static Can_IdType filter_ids[CAN_FILTER_MAX_IDS];   /* ID cấu hình: CanIf + VCU_SIM_RXIDS */
+static uint8_t   filter_num_ids;
+static Can_IdType extra_ids[CAN_FILTER_MAX_IDS];
+static uint8_t   extra_num_ids;
+static uint32_t  bus_frames;                /* frame tới node (trước bộ lọc) */
+static uint32_t  bus_rejected;              /* bị filter bank loại */
+static uint32_t  bus_false_accept;          /* lọt bộ lọc nhưng không cấu hình */
+
+/* =========================================================
+ * 1) In log kiểu candump (VCU_SIM_CANLOG=1)
+ * =======================================================*/
+static void sim_can_log(const char *dir, uint32_t id, const uint8_t *data, uint8_t dlc)
+{
+    TickType now = Os_Posix_Now();
+    printf("(%lu.%03lu) vcan0 %s %03lX#", (unsigned long)(now / 1000u),
+           (unsigned long)(now % 1000u), dir, (unsigned long)id);
+    for (uint8_t i = 0u; i < dlc; i++) {
+        printf("%02X", data[i]);
+    }
+    printf("\n");
+}
+
+static void sim_report_filter(void)
+{
+    static const char *const kind[2][2] = { { "mask32", "list32" }, { "mask16", "list16" } };
+    fprintf(stderr, "[sim] CAN filter: %u/%u bank(s) for %u id(s), FIFO0/1 %u/%u id(s), "
+            "false-accept space %lu id(s)\n",
+            (unsigned)filter.numBanks, (unsigned)CAN_MAX_FILTER_BANKS, (unsigned)filter_num_ids,
+            (unsigned)filter.numIds[CAN_FIFO0], (unsigned)filter.numIds[CAN_FIFO1],
+            (unsigned long)filter.falseAcceptIds);
+    for (uint8_t i = 0u; i < filter.numBanks; i++) {
+        const Can_FilterBankType *b = &filter.bank[i];
+        fprintf(stderr, "[sim]   bank %2u %s FIFO%u %u id(s) %04X %04X %04X %04X\n", (unsigned)i,
+                kind[b->FilterScale == CAN_FilterScale_16bit][b->FilterMode == CAN_FilterMode_IdList],
+                (unsigned)b->FilterFIFOAssignment, (unsigned)b->numIds,
+                b->FilterIdHigh, b->FilterIdLow, b->FilterMaskIdHigh, b->FilterMaskIdLow);
+    }
+    fprintf(stderr, "[sim] CAN bus %lu frame(s): rejected %lu, false-accept %lu (%.2f%%)\n",
+            (unsigned long)bus_frames, (unsigned long)bus_rejected,
+            (unsigned long)bus_false_accept,
+            (bus_frames != 0u) ? (100.0 * bus_false_accept / bus_frames) : 0.0);
+}
+
+static void sim_report(void)
+{
+    TickType now = Os_Posix_Now();
+    CanIf_RxStatsType st;
+    fprintf(stderr, "[sim] %lu drive cycle(s), CAN tx %lu (conf %lu) rx %lu (drop %lu)\n",
+            (unsigned long)Sim_DriveCycle_Count(now), (unsigned long)tx_count,
+            (unsigned long)txc_count, (unsigned long)rx_count, (unsigned long)rx_drops);
+    if (CanIf_GetRxStats(&st) == E_OK) {
+        fprintf(stderr, "[sim] CanIf rx ring: %lu frame(s), drop %lu, high-water %u/%u, FIFO overrun %lu\n",
+                (unsigned long)st.received, (unsigned long)st.ringDrops,
+                (unsigned)st.ringHighWater, (unsigned)CANIF_RX_RING_SIZE,
+                (unsigned long)st.fifoOverruns);
+    }
+    sim_report_filter();
+    if (Adc_Scan_GetCount() != 0u) {
+        fprintf(stderr, "[sim] ADC scan (%s): %lu set(s), longest sequence %.1f us, lost trigger(s) %lu\n",
+                trig_hw ? "timer-triggered" : "continuous", (unsigned long)Adc_Scan_GetCount(),
+                reg_max_ns / 1000.0, (unsigned long)reg_lost);
+    }
+    if (Adc_Inj_GetCount() != 0u) {
+        fprintf(stderr, "[sim] ADC injected (%s): %lu seq, preempted %lu regular conv, "
+                "max trigger->JEOC %.1f us (bound %.1f us), lost trigger(s) %lu\n",
+                inj_hw ? "timer-triggered" : "software", (unsigned long)Adc_Inj_GetCount(),
+                (unsigned long)inj_preempt, inj_max_ns / 1000.0,
+                (inj_len * inj_conv_ns) / 1000.0, (unsigned long)inj_lost);
+    }
+    if (adc_reads != 0u) {
+        fprintf(stderr, "[sim] ADC pedal: %lu read(s), max |err| %lu LSB (noise +-%lu), max age %lu ms\n",
+                (unsigned long)adc_reads, (unsigned long)adc_max_err, (unsigned long)adc_noise,
+                (unsigned long)adc_max_age);
+    }
+    fprintf(stderr, "[sim] log: %lu record(s), drop %lu\n",
+            (unsigned long)Log_Buf.tail, (unsigned long)Log_GetDropCount());
+}
+
+/* =========================================================
+ * 2) Đầu vào giả lập
+ * =======================================================*/
+void Sim_SetAdc(Adc_GroupType group, Adc_ValueGroupType raw)
+{
+    if (group < SIM_ADC_GROUPS) {
+        sim_adc[group] = raw;
+    }
+}
+
+void Sim_SetDio(Dio_ChannelType ch, Dio_LevelType level)
+{
+    if (ch < SIM_DIO_CHANNELS) {
+        sim_dio[ch] = (level != STD_LOW) ? STD_HIGH : STD_LOW;
+    }
+}
+
+static bool sim_can_configured(uint32_t id)
+{
+    for (uint8_t i = 0u; i < filter_num_ids; i++) {
+        if (filter_ids[i] == id) {
+            return true;
+        }
+    }
+    return false;
+}
+
+Std_ReturnType Sim_CanInject(uint32_t id, const uint8_t *data, uint8_t dlc)
+{
+    const uint8_t ide = (id > 0x7FFu) ? CAN_Id_Extended : CAN_Id_Standard;
+
+    if ((data == NULL) || (dlc > 8u)) {
+        return E_NOT_OK;
+    }
+    bus_frames++;
+    if (!Can_FilterMatch(&filter, id, ide, NULL)) {
+        bus_rejected++;              /* filter bank loại: không vào FIFO, không ngắt */
+        return E_OK;
+    }
+    if (!sim_can_configured(id)) {
+        bus_false_accept++;
+    }
+    if ((rx_head - rx_tail) >= SIM_CAN_RX_QUEUE) {
+        rx_drops++;                  /* FIFO đầy: như overrun FOVR0 */
+        rx_fov0 = true;
+        return E_NOT_OK;
+    }
+    CanRxMsg *m = &rx_q[rx_head & (SIM_CAN_RX_QUEUE - 1u)];
+    memset(m, 0, sizeof(*m));
+    m->StdId = (ide == CAN_Id_Standard) ? id : 0u;
+    m->ExtId = (ide == CAN_Id_Extended) ? id : 0u;
+    m->IDE   = ide;
+    m->RTR   = CAN_RTR_Data;
+    m->DLC   = dlc;
+    memcpy(m->Data, data, dlc);
+    rx_head++;
+    return E_OK;
+}
+
+/* =========================================================
+ * 3) "ISR" tick: kích thích đầu vào rồi giao khung RX đang chờ
+ *    và TxConfirmation qua handler RX/TX thật (cfg/mcal/Can_Cfg.c)
+ * =======================================================*/
+/* Tải bus nền (VCU_SIM_BUSLOAD=n): n frame mỗi ms, ID 0x300..0x30F,
+ * không có định tuyến RX → filter bank loại, trừ khi VCU_SIM_RXIDS
+ * thêm các ID này vào bộ lọc (khi đó chỉ tốn đường nhận của CanIf).
+ * Tickless idle gọi hook thưa: bù từng ms đã trôi qua, mỗi ms một
+ * lần ngắt RX như bus thật. */
+static void sim_bus_load(TickType now)
+{
+    if (bus_load == 0u) {
+        bus_load_last = now;
+        return;
+    }
+    while (bus_load_last != now) {
+        bus_load_last++;
+        for (uint32_t i = 0u; i < bus_load; i++) {
+            uint8_t data[8] = { (uint8_t)bus_load_seq, (uint8_t)(bus_load_seq >> 8) };
+            (void)Sim_CanInject(0x300u + (bus_load_seq & 0x0Fu), data, 8u);
+            bus_load_seq++;
+        }
+        USB_LP_CAN1_RX0_IRQHandler();
+    }
+}
+
+/* Bộ tuần tự ADC1 giả lập, theo từng chuyển đổi (ns ảo, (SamplingTime +
+ * 12.5) chu kỳ ADCCLK mỗi rank) như RM0008:
+ *   - regular: mỗi mẫu ghi vào buffer DMA của Adc_Scan.c, đủ nửa buffer
+ *     thì bật cờ HT/TC rồi gọi DMA1_Channel1_IRQHandler thật. Liên tục:
+ *     chuỗi chạy lại ngay; kích timer: mỗi TriggerPeriodUs một chuỗi
+ *     (Rank lặp K lần = một nửa buffer), kích tới khi chuỗi chưa xong bị
+ *     bỏ;
+ *   - injected: kích (CC của cùng timer, hoặc JSWSTART) huỷ chuyển đổi
+ *     regular dở, chạy cả chuỗi injected, JEOC gọi ADC1_2_IRQHandler thật,
+ *     rồi regular làm lại từ rank bị ngắt; kích regular tới trong lúc đó
+ *     chạy ngay sau injected.
+ * Timer chạy từ Adc_SyncTrigger đầu tiên; mỗi lần sync lần kích kế tiếp =
+ * now + period - lead. Hook chạy sau os_on_tick: mô phỏng tới 'now' (gồm
+ * các lần kích ngay trước nhịp nhả Task_A) rồi mới áp sync của nhịp này. */
+static Adc_GroupType sim_adc_group_of(Adc_ChannelType ch)
+{
+    Adc_GroupType g = 0u;
+
+    while ((g < ADC_MAX_GROUPS) && (Adc_GroupConfigs[g].Channels[0] != ch)) {
+        g++;
+    }
+    return g;
+}
+
+/* (SamplingTime + 12.5) chu kỳ ADCCLK = PCLK2 / ClockPrescaler, ra ns */
+static uint32_t sim_adc_conv_ns(const Adc_ConfigType *cfg, Adc_SamplingTimeType smp)
+{
+    static const uint16_t half_cycles[8] = { 3u, 15u, 27u, 57u, 83u, 111u, 143u, 479u };
+    uint32_t presc = cfg->ClockPrescaler;
+
+    if ((presc != 2u) && (presc != 4u) && (presc != 6u) && (presc != 8u)) {
+        presc = 2u;                                 /* như Adc_Init */
+    }
+    return ((half_cycles[smp & 7u] + 25u) * presc * 1000u) / (2u * (SystemCoreClock / 1000000u));
+}
+
+static Adc_ValueGroupType sim_adc_sample(Adc_GroupType g)
+{
+    int32_t v = (g < SIM_ADC_GROUPS) ? (int32_t)sim_adc[g] : 0;
+
+    if (adc_noise != 0u) {
+        adc_rng ^= adc_rng << 13;
+        adc_rng ^= adc_rng >> 17;
+        adc_rng ^= adc_rng << 5;
+        v += (int32_t)(adc_rng % (2u * adc_noise + 1u)) - (int32_t)adc_noise;
+    }
+    return (Adc_ValueGroupType)((v < 0) ? 0 : ((v > 4095) ? 4095 : v));
+}
+
+static void sim_adc_dma_put(Adc_ValueGroupType v)
+{
+    uint32_t n;
+    Adc_ValueGroupType *buf = Adc_Scan_DmaBuffer(&n);
+
+    buf[dma_pos++] = v;
+    if ((dma_pos == n / 2u) || (dma_pos == n)) {
+        dma_flags |= (dma_pos == n) ? DMA1_IT_TC1 : DMA1_IT_HT1;
+        if (dma_pos == n) {
+            dma_pos = 0u;               /* DMA vòng */
+        }
+        DMA1_Channel1_IRQHandler();
+    }
+}
+
+/* Một chuyển đổi xong lúc t */
+static void sim_adc_conv_done(uint64_t t)
+{
+    const uint32_t nch = Adc_Configs[0].NumChannels;
+
+    if (inj_busy) {
+        inj_jdr[inj_rank] = sim_adc_sample(inj_grp[inj_rank]);
+        if (++inj_rank < inj_len) {
+            conv_end_ns = t + inj_conv_ns;
+            return;
+        }
+        inj_busy = false;
+        if ((t - inj_trig_ns) > inj_max_ns) {
+            inj_max_ns = t - inj_trig_ns;
+        }
+        inj_jeoc = true;
+        ADC1_2_IRQHandler();
+        if (!reg_busy && reg_pending) {
+            reg_pending = false;
+            reg_busy = true;
+            reg_rank = 0u;
+        }
+        if (reg_busy) {
+            conv_end_ns = t + reg_conv_ns[reg_rank % nch];      /* làm lại rank bị ngắt */
+        }
+        return;
+    }
+
+    sim_adc_dma_put(sim_adc_sample(dma_grp[reg_rank % nch]));
+    if (++reg_rank == reg_len) {
+        reg_rank = 0u;
+        if (trig_hw) {
+            reg_busy = false;
+            if ((t - reg_trig_ns) > reg_max_ns) {
+                reg_max_ns = t - reg_trig_ns;
+            }
+        }
+    }
+    if (reg_busy) {
+        conv_end_ns = t + reg_conv_ns[reg_rank % nch];
+    }
+}
+
+static void sim_adc_trigger_regular(uint64_t t)
+{
+    trig_next_ns += (uint64_t)trig_period_us * 1000u;
+    if (reg_len == 0u) {
+        return;
+    }
+    if (reg_busy || reg_pending) {
+        reg_lost++;                     /* RM0008: kích khi đang chuyển đổi bị bỏ qua */
+        return;
+    }
+    reg_trig_ns = t;
+    if (inj_busy) {
+        reg_pending = true;             /* chạy ngay sau chuỗi injected */
+        return;
+    }
+    reg_busy = true;
+    reg_rank = 0u;
+    conv_end_ns = t + reg_conv_ns[0];
+}
+
+static void sim_adc_trigger_injected(uint64_t t)
+{
+    inj_trig++;
+    if (inj_busy) {
+        inj_lost++;
+        return;
+    }
+    if (reg_busy) {
+        inj_preempt++;                  /* chuyển đổi regular dở bị huỷ */
+    }
+    inj_busy = true;
+    inj_rank = 0u;
+    inj_trig_ns = t;
+    conv_end_ns = t + inj_conv_ns;
+}
+
+static void sim_adc_seq(TickType now)
+{
+    const uint64_t now_ns = (uint64_t)now * 1000000u;
+    const uint64_t none = UINT64_MAX;
+
+    if ((adc_stall != 0u) && (now >= adc_stall)) {
+        return;                         /* ADC ngừng hẳn: không mẫu, không ngắt */
+    }
+    for (;;) {
+        uint64_t t = (reg_busy || inj_busy) ? conv_end_ns : none;
+        uint8_t ev = 0u;                /* 0 = chuyển đổi xong, 1 = kích regular, 2 = kích injected */
+
+        if (trig_running && trig_hw && (trig_next_ns < t)) {
+            t = trig_next_ns;
+            ev = 1u;
+        }
+        if (trig_running && inj_hw && (inj_next_ns < t)) {
+            t = inj_next_ns;
+            ev = 2u;
+        }
+        if (inj_sw && (seq_now_ns < t)) {
+            t = seq_now_ns;             /* JSWSTART từ task: ngay sau nhịp trước */
+            ev = 3u;
+        }
+        if ((t == none) || (t > now_ns)) {
+            break;
+        }
+        switch (ev) {
+        case 0u:
+            sim_adc_conv_done(t);
+            break;
+        case 1u:
+            sim_adc_trigger_regular(t);
+            break;
+        case 2u:
+            inj_next_ns += (uint64_t)trig_period_us * 1000u;
+            sim_adc_trigger_injected(t);
+            break;
+        default:
+            inj_sw = false;
+            sim_adc_trigger_injected(t);
+            break;
+        }
+    }
+    seq_now_ns = now_ns;
+    if (trig_sync) {
+        trig_sync = false;
+        trig_next_ns = now_ns + ((uint64_t)trig_period_us - Adc_Configs[0].TriggerLeadUs) * 1000u;
+        inj_next_ns = now_ns + ((uint64_t)trig_period_us - Adc_Configs[0].InjTriggerLeadUs) * 1000u;
+    }
+}
+
+void Os_Posix_TickHook(TickType now)
+{
+    Sim_DriveCycle_Step(now);
+    sim_bus_load(now);
+    sim_adc_seq(now);
+    if ((rx_head != rx_tail) || rx_fov0) {
+        USB_LP_CAN1_RX0_IRQHandler();    /* vét hết FIFO0 trong một lần ngắt */
+    }
+    if (txc_head != txc_tail) {
+        USB_HP_CAN1_TX_IRQHandler();
+    }
+}
+
+/* SPL mà các handler CAN gọi: FIFO0 = rx_q, TME = txc_q */
+ITStatus CAN_GetITStatus(CAN_TypeDef *CANx, uint32_t CAN_IT)
+{
+    (void)CANx;
+    if (CAN_IT == CAN_IT_TME) {
+        return (txc_head != txc_tail) ? SET : RESET;
+    }
+    return ((CAN_IT == CAN_IT_FMP0) && (rx_head != rx_tail)) ? SET : RESET;
+}
+
+void CAN_Receive(CAN_TypeDef *CANx, uint8_t FIFONumber, CanRxMsg *RxMessage)
+{
+    (void)CANx;
+    (void)FIFONumber;
+    if (rx_head == rx_tail) {
+        return;
+    }
+    *RxMessage = rx_q[rx_tail & (SIM_CAN_RX_QUEUE - 1u)];
+    rx_tail++;
+    rx_count++;
+    if (can_log) {
+        sim_can_log("RX", RxMessage->StdId, RxMessage->Data, RxMessage->DLC);
+    }
+}
+
+void CAN_ClearITPendingBit(CAN_TypeDef *CANx, uint32_t CAN_IT)
+{
+    (void)CANx;
+    (void)CAN_IT;
+}
+
+uint8_t CAN_MessagePending(CAN_TypeDef *CANx, uint8_t FIFONumber)
+{
+    (void)CANx;
+    return (FIFONumber == CAN_FIFO0) ? (uint8_t)(rx_head - rx_tail) : 0u;
+}
+
+FlagStatus CAN_GetFlagStatus(CAN_TypeDef *CANx, uint32_t CAN_FLAG)
+{
+    (void)CANx;
+    return ((CAN_FLAG == CAN_FLAG_FOV0) && rx_fov0) ? SET : RESET;
+}
+
+void CAN_ClearFlag(CAN_TypeDef *CANx, uint32_t CAN_FLAG)
+{
+    (void)CANx;
+    if (CAN_FLAG == CAN_FLAG_FOV0) {
+        rx_fov0 = false;
+    }
+}
+
+/* SPL mà handler ADC1_2 (JEOC) gọi */
+ITStatus ADC_GetITStatus(ADC_TypeDef *ADCx, uint16_t ADC_IT)
+{
+    (void)ADCx;
+    return ((ADC_IT == ADC_IT_JEOC) && inj_jeoc) ? SET : RESET;
+}
+
+void ADC_ClearITPendingBit(ADC_TypeDef *ADCx, uint16_t ADC_IT)
+{
+    (void)ADCx;
+    if (ADC_IT == ADC_IT_JEOC) {
+        inj_jeoc = false;
+    }
+}
+
+uint16_t ADC_GetInjectedConversionValue(ADC_TypeDef *ADCx, uint8_t ADC_InjectedChannel)
+{
+    uint32_t r = (uint32_t)(ADC_InjectedChannel - ADC_InjectedChannel_1) / 4u;   /* JDR1..4 */
+
+    (void)ADCx;
+    return (r < inj_len) ? inj_jdr[r] : 0u;
+}
+
+/* SPL mà handler DMA của ADC gọi */
+ITStatus DMA_GetITStatus(uint32_t DMAy_IT)
+{
+    return ((dma_flags & DMAy_IT) != 0u) ? SET : RESET;
+}
+
+void DMA_ClearITPendingBit(uint32_t DMAy_IT)
+{
+    dma_flags &= ~DMAy_IT;
+}
+
+/* =========================================================
+ * 4) MCAL: Port / Adc / Dio
+ * =======================================================*/
+void SystemInit(void)
+{
+}
+
+/* VCU_SIM_RXIDS="0x300-0x30F,0x401": danh sách/khoảng ID thêm vào bộ lọc */
+static void sim_parse_rx_ids(const char *s)
+{
+    extra_num_ids = 0u;
+    while ((s != NULL) && (*s != '\0')) {
+        char *end;
+        uint32_t lo = (uint32_t)strtoul(s, &end, 0);
+        uint32_t hi = lo;
+        if (end == s) {
+            break;
+        }
+        if (*end == '-') {
+            s = end + 1;
+            hi = (uint32_t)strtoul(s, &end, 0);
+        }
+        for (uint32_t id = lo; (id <= hi) && (extra_num_ids < CAN_FILTER_MAX_IDS); id++) {
+            extra_ids[extra_num_ids++] = id;
+        }
+        s = (*end == ',') ? end + 1 : end;
+    }
+}
+
+void Port_Init(const Port_ConfigType *ConfigPtr)
+{
+    const char *log = getenv("VCU_SIM_CANLOG");
+    const char *load = getenv("VCU_SIM_BUSLOAD");
+    static bool once;
+
+    (void)ConfigPtr;
+    can_log = (log != NULL) && (log[0] == '1');
+    bus_load = (load != NULL) ? (uint32_t)strtoul(load, NULL, 10) : 0u;
+    sim_parse_rx_ids(getenv("VCU_SIM_RXIDS"));
+    if (!once) {
+        once = true;
+        atexit(sim_report);
+    }
+}
+
+/* Timer của nguồn kích injected phải trùng timer kích regular (như Adc_InjTriggerInit) */
+static bool sim_adc_inj_timer_ok(const Adc_ConfigType *cfg)
+{
+    uint32_t sync = cfg->TriggerLeadUs + ((cfg->TriggerSource == ADC_TRIGGER_TIM3_TRGO) ? 0u : 1u);
+
+    switch (cfg->InjTriggerSource) {
+    case ADC_INJ_TRIGGER_TIM1_CC4:
+        if ((cfg->TriggerSource < ADC_TRIGGER_TIM1_CC1) || (cfg->TriggerSource > ADC_TRIGGER_TIM1_CC3)) {
+            return false;
+        }
+        break;
+    case ADC_INJ_TRIGGER_TIM2_CC1:
+        if (cfg->TriggerSource != ADC_TRIGGER_TIM2_CC2) {
+            return false;
+        }
+        break;
+    case ADC_INJ_TRIGGER_TIM3_CC4:
+        if (cfg->TriggerSource != ADC_TRIGGER_TIM3_TRGO) {
+            return false;
+        }
+        break;
+    default:
+        return false;
+    }
+    return (cfg->InjTriggerLeadUs < cfg->TriggerPeriodUs) &&
+           (((sync + cfg->TriggerPeriodUs - cfg->InjTriggerLeadUs) % cfg->TriggerPeriodUs) != 0u);
+}
+
+void Adc_Init(const Adc_ConfigType *ConfigPtr)
+{
+    const char *noise = getenv("VCU_SIM_ADCNOISE");
+    const char *stall = getenv("VCU_SIM_ADCSTALL");
+    const char *scan = getenv("VCU_SIM_ADCSCAN");
+    Adc_ConfigType cfg;
+    Adc_ChannelType inj_ch[ADC_INJ_MAX_CHANNELS];
+    uint32_t n = 0u;
+
+    for (uint32_t g = 0u; g < SIM_ADC_GROUPS; g++) {
+        sim_adc_status[g] = ADC_IDLE;
+    }
+    adc_noise = (noise != NULL) ? (uint32_t)strtoul(noise, NULL, 10) : 0u;
+    adc_stall = (stall != NULL) ? (TickType)strtoul(stall, NULL, 10) : 0u;
+    dma_flags = 0u;
+    dma_pos = 0u;
+    tim_ok = false;
+    trig_hw = false;
+    trig_running = false;
+    trig_sync = false;
+    inj_hw = false;
+    inj_sw = false;
+    inj_busy = false;
+    inj_jeoc = false;
+    reg_busy = false;
+    reg_pending = false;
+    reg_rank = 0u;
+    reg_lost = 0u;
+    reg_max_ns = 0u;
+    inj_trig = 0u;
+    inj_preempt = 0u;
+    inj_lost = 0u;
+    inj_max_ns = 0u;
+    seq_now_ns = 0u;
+    (void)Adc_Inj_Init(ConfigPtr);
+    inj_len = Adc_Inj_Sequence(inj_ch);
+    if (ConfigPtr == NULL) {
+        (void)Adc_Scan_Init(NULL);
+        reg_len = 0u;
+        return;
+    }
+
+    /* Như Adc_TriggerInit: cấu hình timer sai → chuỗi regular chạy liên tục.
+     * VCU_SIM_ADCSCAN=cont: timer vẫn chạy (kích injected) nhưng chuỗi nền
+     * chạy liên tục → mọi lần kích injected đều chen ngang. */
+    cfg = *ConfigPtr;
+    trig_period_us = cfg.TriggerPeriodUs;
+    tim_ok = (cfg.TriggerSource != ADC_TRIGGER_SOFTWARE) && (trig_period_us >= 2u) &&
+             ((uint32_t)cfg.TriggerLeadUs + 1u < trig_period_us);
+    trig_hw = tim_ok && !((scan != NULL) && (strcmp(scan, "cont") == 0));
+    inj_hw = (inj_len != 0u) && tim_ok && sim_adc_inj_timer_ok(&cfg);
+    if (!trig_hw) {
+        cfg.TriggerSource = ADC_TRIGGER_SOFTWARE;
+    }
+    for (uint32_t r = 0u; r < inj_len; r++) {
+        inj_grp[r] = sim_adc_group_of(inj_ch[r]);
+    }
+    inj_conv_ns = sim_adc_conv_ns(&cfg, cfg.InjSamplingTime);
+
+    if (Adc_Scan_Init(&cfg) != E_OK) {
+        (void)Adc_Scan_Init(NULL);          /* như target: về chế độ từng group */
+    }
+    (void)Adc_Scan_DmaBuffer(&n);
+    reg_len = (n == 0u) ? 0u : (trig_hw ? (n / 2u) : cfg.NumChannels);
+    /* Rank → group đầu tiên có kênh đó (nguồn giá trị sim_adc[]) */
+    for (uint8_t i = 0u; (i < cfg.NumChannels) && (i < ADC_SCAN_MAX_CHANNELS); i++) {
+        uint8_t r = (uint8_t)(cfg.Channels[i].Rank - 1u);
+        if (r < ADC_SCAN_MAX_CHANNELS) {
+            dma_grp[r] = sim_adc_group_of(cfg.Channels[i].Channel);
+            reg_conv_ns[r] = sim_adc_conv_ns(&cfg, cfg.Channels[i].SamplingTime);
+        }
+    }
+    if ((reg_len != 0u) && !trig_hw) {
+        reg_busy = true;                    /* quét liên tục chạy ngay từ Adc_Init */
+        conv_end_ns = reg_conv_ns[0];
+    }
+}
+
+void Sim_GetAdcStats(Sim_AdcStatsType *stats)
+{
+    if (stats == NULL) {
+        return;
+    }
+    stats->injTriggers  = inj_trig;
+    stats->injPreempted = inj_preempt;
+    stats->injLost      = inj_lost;
+    stats->regLost      = reg_lost;
+    stats->injLen       = inj_len;
+    stats->injConvNs    = inj_conv_ns;
+    stats->injMaxNs     = inj_max_ns;
+    stats->injTimer     = inj_hw ? TRUE : FALSE;
+    stats->regTimer     = trig_hw ? TRUE : FALSE;
+}
+
+void Adc_StartGroupConversion(Adc_GroupType Group)
+{
+    if (Adc_Inj_OwnsGroup(Group)) {
+        inj_sw = !inj_hw;                       /* JSWSTART; kích timer: không cần */
+        return;
+    }
+    if (Adc_Scan_OwnsGroup(Group)) {
+        return;                                 /* quét liên tục: không cần kích */
+    }
+    if (Group < SIM_ADC_GROUPS) {
+        sim_adc_status[Group] = ADC_COMPLETED;   /* chuyển đổi tức thì */
+    }
+}
+
+/* Thống kê bàn đạp (group 0): sai số so với đầu vào hiện tại, tuổi mẫu */
+static void sim_adc_stat(Adc_GroupType Group, const Adc_ValueGroupType *v, const uint32_t *ts)
+{
+    if (Group != 0u) {
+        return;
+    }
+    uint32_t err = (v[0] > sim_adc[0]) ? (uint32_t)(v[0] - sim_adc[0]) : (uint32_t)(sim_adc[0] - v[0]);
+    adc_reads++;
+    if (err > adc_max_err) {
+        adc_max_err = err;
+    }
+    if ((ts != NULL) && ((OS_TickCount() - *ts) > adc_max_age)) {
+        adc_max_age = OS_TickCount() - *ts;
+    }
+}
+
+Std_ReturnType Adc_ReadGroup(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr)
+{
+    Std_ReturnType ret;
+
+    if (Adc_Inj_OwnsGroup(Group)) {
+        ret = Adc_Inj_ReadGroup(Group, DataBufferPtr, NULL);
+    } else if (Adc_Scan_OwnsGroup(Group)) {
+        ret = Adc_Scan_ReadGroup(Group, DataBufferPtr, NULL);
+    } else {
+        if ((Group >= SIM_ADC_GROUPS) || (DataBufferPtr == NULL)) {
+            return E_NOT_OK;
+        }
+        DataBufferPtr[0] = sim_adc[Group];
+        sim_adc_status[Group] = ADC_IDLE;
+        return E_OK;
+    }
+    if (ret == E_OK) {
+        sim_adc_stat(Group, DataBufferPtr, NULL);
+    }
+    return ret;
+}
+
+Std_ReturnType Adc_ReadGroupTimestamp(Adc_GroupType Group, Adc_ValueGroupType *DataBufferPtr,
+                                      uint32_t *TimestampPtr)
+{
+    Std_ReturnType ret;
+
+    if (TimestampPtr == NULL) {
+        return E_NOT_OK;
+    }
+    if (Adc_Inj_OwnsGroup(Group)) {
+        ret = Adc_Inj_ReadGroup(Group, DataBufferPtr, TimestampPtr);
+    } else if (Adc_Scan_OwnsGroup(Group)) {
+        ret = Adc_Scan_ReadGroup(Group, DataBufferPtr, TimestampPtr);
+    } else {
+        *TimestampPtr = OS_TickCount();
+        return Adc_ReadGroup(Group, DataBufferPtr);
+    }
+    if (ret == E_OK) {
+        sim_adc_stat(Group, DataBufferPtr, TimestampPtr);
+    }
+    return ret;
+}
+
+void Adc_SyncTrigger(void)
+{
+    if (tim_ok) {
+        trig_running = true;
+        trig_sync = true;
+    }
+}
+
+Adc_StatusType Adc_GetGroupStatus(Adc_GroupType Group)
+{
+    if (Adc_Inj_OwnsGroup(Group)) {
+        return (Adc_Inj_GetCount() != 0u) ? ADC_COMPLETED : ADC_BUSY;
+    }
+    if (Adc_Scan_OwnsGroup(Group)) {
+        return (Adc_Scan_GetCount() != 0u) ? ADC_COMPLETED : ADC_BUSY;
+    }
+    return (Group < SIM_ADC_GROUPS) ? sim_adc_status[Group] : ADC_ERROR;
+}
+
+Dio_LevelType DIO_ReadChannel(Dio_ChannelType ChannelId)
+{
+    return (ChannelId < SIM_DIO_CHANNELS) ? sim_dio[ChannelId] : STD_LOW;
+}
+
+void DIO_WriteChannel(Dio_ChannelType ChannelId, Dio_LevelType Level)
+{
+    Sim_SetDio(ChannelId, Level);
+}
+
+Dio_PortLevelType DIO_ReadPort(Dio_PortType PortId)
+{
+    Dio_PortLevelType lv = 0u;
+
+    for (uint32_t pin = 0u; pin < 16u; pin++) {
+        uint32_t ch = DIO_CHANNEL(PortId, pin);
+        if ((ch < SIM_DIO_CHANNELS) && (sim_dio[ch] != STD_LOW)) {
+            lv |= (Dio_PortLevelType)(1u << pin);
+        }
+    }
+    return lv;
+}
+
+/* =========================================================
+ * 5) MCAL: Can
+ *    - Bộ lọc sinh bằng Can_BuildFilterLayout (Can_Filter.c, như
+ *      target); mọi frame tới node (inject, loopback) đi qua nó.
+ *    - Loopback (CAN_Mode bit 0): khung TX quay lại đầu vào RX.
+ * =======================================================*/
+void Can_Init(const Can_ConfigType *config)
+{
+    (void)config;
+    rx_head = rx_tail = 0u;
+    rx_fov0 = false;
+    txc_head = txc_tail = 0u;
+    memset(&filter, 0, sizeof(filter));     /* mọi bank tắt */
+}
+
+/* ID của CanIf cộng ID thêm từ VCU_SIM_RXIDS (ước lượng số bank và tỉ lệ
+ * nhận nhầm cho một ma trận CAN lớn hơn) */
+Std_ReturnType Can_SetRxFilter(const Can_IdType *ids, uint8_t numIds)
+{
+    filter_num_ids = 0u;
+    for (uint8_t i = 0u; (i < numIds) && (filter_num_ids < CAN_FILTER_MAX_IDS); i++) {
+        filter_ids[filter_num_ids++] = ids[i];
+    }
+    for (uint8_t i = 0u; (i < extra_num_ids) && (filter_num_ids < CAN_FILTER_MAX_IDS); i++) {
+        if (!sim_can_configured(extra_ids[i])) {
+            filter_ids[filter_num_ids++] = extra_ids[i];
+        }
+    }
+    return Can_BuildFilterLayout(filter_ids, filter_num_ids, CAN_MAX_FILTER_BANKS, &filter);
+}
+
+const Can_FilterLayoutType *Can_GetFilterLayout(void)
+{
+    return &filter;
+}
+
+Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType *PduInfo)
+{
+    (void)Hth;
+    if ((PduInfo == NULL) || (PduInfo->sdu == NULL) || (PduInfo->length > 8u)) {
+        return E_NOT_OK;
+    }
+    tx_count++;
+    if (can_log) {
+        sim_can_log("TX", PduInfo->id, PduInfo->sdu, PduInfo->length);
+    }
+    if ((txc_head - txc_tail) < SIM_CAN_TX_QUEUE) {
+        txc_q[txc_head & (SIM_CAN_TX_QUEUE - 1u)] = PduInfo->swPduHandle;
+        txc_head++;
+    }
+    if ((Can_Config.Basic_Config.CAN_Mode & CAN_Mode_LoopBack) != 0u) {
+        (void)Sim_CanInject(PduInfo->id, PduInfo->sdu, PduInfo->length);
+    }
+    return E_OK;
+}
+
+/* Bus giả lập không nghẽn: mọi frame đã ghi "lên bus" ngay, ngắt TX
+ * ở tick kế tiếp báo TxConfirmation như mailbox thật */
+void Can_MainFunction_Write(void)
+{
+    while (txc_head != txc_tail) {
+        PduIdType h = txc_q[txc_tail & (SIM_CAN_TX_QUEUE - 1u)];
+        txc_tail++;
+        txc_count++;
+        Can_NotifyTxConfirmation(h);
+    }
+}
+
+Std_ReturnType Can_SetControllerMode(uint8_t Controller, Can_ControllerStateType Transition)
+{
+    (void)Controller;
+    (void)Transition;
+    return E_OK;
+}
+
+Std_ReturnType Can_GetControllerErrorState(uint8_t ControllerID, Can_ErrorStateType *ErrorStatePtr)
+{
+    (void)ControllerID;
+    if (ErrorStatePtr == NULL) {
+        return E_NOT_OK;
+    }
+    *ErrorStatePtr = CAN_ERRORSTATE_ACTIVE;
+    return E_OK;
+}
+
+Std_ReturnType Can_SetBaudrate(uint8_t Controller, uint16_t BaudRateConfigID)
+{
+    (void)Controller;
+    (void)BaudRateConfigID;
+    return E_OK;
+}
@@ -0,0 +1,94 @@
+/**********************************************************
+ * @file    Sim_Mcal.h
+ * @brief   Phần cứng giả lập cho bản host POSIX (make host)
+ * @details Sim_Mcal.c hiện thực API MCAL (Port/Adc/Dio/Can) trên
+ *          một "ảnh I/O" trong RAM thay cho bsw/mcal + SPL:
+ *            - ADC: giá trị thô theo group (Sim_SetAdc); tick chạy bộ
+ *                   tuần tự ADC1 theo từng chuyển đổi: chuỗi regular ghi
+ *                   buffer DMA của Adc_Scan.c rồi gọi DMA1_Channel1_IRQHandler
+ *                   thật (HT/TC), chuỗi injected của nhóm ưu tiên ngắt
+ *                   ngang regular và gọi ADC1_2_IRQHandler thật (JEOC);
+ *                   timer kích chạy theo Adc_SyncTrigger (hook nhả
+ *                   Task_A). Khi thoát in số lần chen ngang, độ trễ kích →
+ *                   JEOC lớn nhất so với cận tính từ cấu hình, tuổi mẫu
+ *                   bàn đạp lớn nhất lúc đọc
+ *            - DIO: mức logic theo kênh port*16 + pin (Sim_SetDio)
+ *            - CAN: Can_Write ghi log/đếm khung TX, loopback theo
+ *                   Can_Config (Silent_LoopBack) như target; mọi khung
+ *                   tới node qua bộ lọc sinh từ CAN ID Rx của CanIf
+ *                   (Can_SetRxFilter, Can_Filter.c);
+ *                   Sim_CanInject xếp khung RX, giao ở tick kế tiếp
+ *                   qua USB_LP_CAN1_RX0_IRQHandler thật (Can_Cfg.c)
+ *                   → CanIf → PduR → Com; mỗi khung TX được báo
+ *                   TxConfirmation ở tick kế tiếp qua
+ *                   USB_HP_CAN1_TX_IRQHandler thật.
+ *          Sim_DriveCycle.c lái các đầu vào theo một chu trình lái
+ *          60 s lặp lại (Os_Posix_TickHook).
+ *
+ *          Biến môi trường:
+ *            - VCU_SIM_CANLOG=1: in mỗi khung TX/RX kiểu candump
+ *              "(giây) vcan0 123#0011..." ra stdout.
+ *            - VCU_SIM_BUSLOAD=n: thêm n frame nền mỗi ms (ID
+ *              0x300..0x30F) để thử tải đường nhận; khi thoát in
+ *              thống kê vòng RX của CanIf (drop, high-water, overrun).
+ *            - VCU_SIM_RXIDS="0x300-0x30F,0x401": thêm ID vào bộ lọc
+ *              như thể có trong bảng định tuyến, để xem số filter bank
+ *              và tỉ lệ nhận nhầm của một ma trận CAN lớn hơn.
+ *            - VCU_SIM_DIOBOUNCE=ms: đầu vào DIO của chu trình lái dội
+ *              ngẫu nhiên ms mili giây sau mỗi cạnh (thử debounce).
+ *            - VCU_SIM_ADCNOISE=lsb: cộng nhiễu đều ±lsb vào mỗi mẫu
+ *              của ADC; khi thoát in số bộ kết quả và sai số lớn nhất
+ *              của bàn đạp so với đầu vào (thử lấy trung bình).
+ *            - VCU_SIM_ADCSTALL=ms: ADC (quét + injected) ngừng từ thời
+ *              điểm ms (thử SafetyManager loại mẫu bàn đạp quá tuổi).
+ *            - VCU_SIM_ADCSCAN=cont: chuỗi quét nền chạy liên tục thay
+ *              vì theo timer → mọi lần kích injected chen ngang một
+ *              chuyển đổi regular (thử ưu tiên/độ trễ có chặn).
+ *          Khi thoát luôn in bố trí filter bank, số frame bị loại và
+ *          tỉ lệ nhận nhầm (frame lọt bộ lọc nhưng không cấu hình).
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#ifndef SIM_MCAL_H
+#define SIM_MCAL_H
+
+#include "Std_Types.h"
+#include "Os.h"
+#include "Adc.h"
+#include "Dio.h"
+
+#define SIM_ADC_GROUPS        2u
+#define SIM_DIO_CHANNELS      64u    /* PA0..PD15 */
+#define SIM_CAN_RX_QUEUE      16u    /* lũy thừa của 2 */
+#define SIM_CAN_TX_QUEUE      16u    /* TxConfirmation chờ ngắt TX, lũy thừa của 2 */
+
+/**
+ * @brief Thống kê bộ tuần tự ADC1 giả lập (Sim_GetAdcStats), thời gian ns ảo.
+ */
+typedef struct {
+    uint32_t injTriggers;      /*!< Lần kích injected (timer CC hoặc JSWSTART). */
+    uint32_t injPreempted;     /*!< Lần kích gặp chuỗi regular đang chạy và huỷ chuyển đổi dở. */
+    uint32_t injLost;          /*!< Lần kích khi chuỗi injected trước chưa xong (bị bỏ). */
+    uint32_t regLost;          /*!< Lần kích regular khi chuỗi trước chưa xong (bị bỏ). */
+    uint32_t injLen;           /*!< Số rank injected (0 = không có nhóm ưu tiên). */
+    uint32_t injConvNs;        /*!< Một chuyển đổi injected: (InjSamplingTime + 12.5) chu kỳ ADCCLK. */
+    uint64_t injMaxNs;         /*!< Kích → JEOC lâu nhất. */
+    boolean  injTimer;         /*!< TRUE = injected kích bằng timer. */
+    boolean  regTimer;         /*!< TRUE = chuỗi regular kích bằng timer (FALSE = liên tục). */
+} Sim_AdcStatsType;
+
+/* Đầu vào giả lập (gọi từ Os_Posix_TickHook hoặc trước StartOS) */
+void Sim_SetAdc(Adc_GroupType group, Adc_ValueGroupType raw);
+void Sim_SetDio(Dio_ChannelType ch, Dio_LevelType level);
+Std_ReturnType Sim_CanInject(uint32_t id, const uint8_t *data, uint8_t dlc);
+
+/* Thống kê bộ tuần tự ADC1 kể từ Adc_Init (cũng in ra khi thoát) */
+void Sim_GetAdcStats(Sim_AdcStatsType *stats);
+
+/* Chu trình lái (Sim_DriveCycle.c): cập nhật đầu vào theo 'now' */
+void Sim_DriveCycle_Step(TickType now);
+uint32_t Sim_DriveCycle_Count(TickType now);
+
+#endif /* SIM_MCAL_H */
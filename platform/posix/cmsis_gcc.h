@@ -0,0 +1,51 @@
+/**********************************************************
+ * @file    cmsis_gcc.h
+ * @brief   Thay thế CMSIS cmsis_gcc.h cho bản host POSIX
+ * @details Chỉ các intrinsic mà kernel/BSW/RTE/SWC dùng:
+ *            - __disable_irq/__enable_irq → PRIMASK giả lập
+ *              (bsw/services/os/arch/posix/Os_Arch.c)
+ *            - __WFI → chờ/nhảy tới tick kế tiếp
+ *            - __DMB/__DSB → hàng rào bộ nhớ của compiler host
+ *          Thư mục platform/posix đứng TRƯỚC platform/bsp/cmsis
+ *          (không có trong INC của make host).
+ **********************************************************/
+#ifndef __CMSIS_GCC_H
+#define __CMSIS_GCC_H
+
+#include <stdint.h>
+
+#ifndef   __ASM
+  #define __ASM                 __asm
+#endif
+#ifndef   __INLINE
+  #define __INLINE              inline
+#endif
+#ifndef   __STATIC_INLINE
+  #define __STATIC_INLINE       static inline
+#endif
+#ifndef   __STATIC_FORCEINLINE
+  #define __STATIC_FORCEINLINE  __attribute__((always_inline)) static inline
+#endif
+
+extern void Os_Posix_DisableIrq(void);
+extern void Os_Posix_EnableIrq(void);
+extern void Os_Posix_Wfi(void);
+
+__STATIC_FORCEINLINE void __disable_irq(void)
+{
+  Os_Posix_DisableIrq();
+}
+
+__STATIC_FORCEINLINE void __enable_irq(void)
+{
+  Os_Posix_EnableIrq();
+}
+
+#define __NOP()             do { } while (0)
+#define __WFI()             Os_Posix_Wfi()
+#define __ISB()             __atomic_signal_fence(__ATOMIC_SEQ_CST)
+#define __DSB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __DMB()             __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#define __CLZ               (uint8_t)__builtin_clz
+
+#endif /* __CMSIS_GCC_H */
@@ -0,0 +1,28 @@
+/**********************************************************
+ * @file    core_cm3.h
+ * @brief   Thay thế CMSIS core_cm3.h cho bản host POSIX
+ * @details stm32f10x.h/SPL header chỉ cần qualifier __I/__O/__IO
+ *          và intrinsic (cmsis_gcc.h host). Không có NVIC/SCB/
+ *          SysTick/DWT: code truy cập thanh ghi lõi chỉ nằm trong
+ *          arch/cortexm3_stm32f1, MCAL và SPL — các phần này được
+ *          thay bằng arch/posix và platform/posix/Sim_Mcal.c.
+ **********************************************************/
+#ifndef __CORE_CM3_H_GENERIC
+#define __CORE_CM3_H_GENERIC
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+  #define   __I     volatile
+#else
+  #define   __I     volatile const
+#endif
+#define     __O     volatile
+#define     __IO    volatile
+#define     __IM    volatile const
+#define     __OM    volatile
+#define     __IOM   volatile
+
+#include "cmsis_gcc.h"
+
+#endif /* __CORE_CM3_H_GENERIC */
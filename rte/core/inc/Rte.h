@@ -104,7 +104,8 @@ Std_ReturnType Rte_Write_Com_EngineSpeed(EngineSpeedRpm_t rpm);
  * 4) Sender/Receiver — Require ports (SWC đọc dữ liệu)
  *    Quy ước trả về:
  *      - E_OK     : đọc thành công, *out hợp lệ (đã từng được cập nhật)
- *      - E_NOT_OK : tham số NULL hoặc nguồn chưa từng cập nhật
+ *      - E_NOT_OK : tham số NULL, hoặc RTE_E_NEVER_RECEIVED — nguồn
+ *                   chưa từng cập nhật (*out = giá trị khởi tạo)
  * =======================================================*/
 /* SafetyManager đọc các tín hiệu đã được các acquisition SWC cung cấp */
 Std_ReturnType Rte_Read_SafetyManager_PedalOut(uint8_t* v);
@@ -118,6 +119,28 @@ Std_ReturnType Rte_Read_CmdComposer_SafeOut(Safe_s* s);
 /* Ví dụ: MotorCtrl tiêu thụ tốc độ động cơ đã lưu trong RTE */
 Std_ReturnType Rte_Read_MotorCtrl_EngineSpeed(EngineSpeedRpm_t* rpm);
 
+/* =========================================================
+ * 4b) Sender/Receiver — Implicit (Rte_IRead / Rte_IWrite)
+ *    - Đọc/ghi ảnh dữ liệu của task đang chạy, chụp ở
+ *      Rte_Task_Begin() (Rte_Main.h), công bố ở Rte_Task_End().
+ *    - Mọi Rte_IRead_* trong một lần chạy task trả cùng một bộ
+ *      giá trị nhất quán, không tắt ngắt theo từng signal.
+ *    - Rte_IStatus_*: E_OK hoặc RTE_E_NEVER_RECEIVED.
+ *    - Gọi ngoài cặp Begin/End → như truy cập explicit.
+ * =======================================================*/
+uint8_t        Rte_IRead_SafetyManager_PedalOut(void);
+boolean        Rte_IRead_SafetyManager_BrakeOut(void);
+Gear_e         Rte_IRead_SafetyManager_GearOut(void);
+DriveMode_e    Rte_IRead_SafetyManager_DriveModeOut(void);
+Std_ReturnType Rte_IStatus_SafetyManager_PedalOut(void);
+Std_ReturnType Rte_IStatus_SafetyManager_BrakeOut(void);
+Std_ReturnType Rte_IStatus_SafetyManager_GearOut(void);
+Std_ReturnType Rte_IStatus_SafetyManager_DriveModeOut(void);
+void           Rte_IWrite_SafetyManager_SafeOut(const Safe_s* s);
+
+Safe_s         Rte_IRead_CmdComposer_SafeOut(void);
+Std_ReturnType Rte_IStatus_CmdComposer_SafeOut(void);
+
 /* =========================================================
  * 5) Client/Server — gọi dịch vụ IoHwAb (đồng bộ)
  *    Lưu ý:
@@ -130,6 +153,12 @@ Std_ReturnType Rte_Read_MotorCtrl_EngineSpeed(EngineSpeedRpm_t* rpm);
  */
 Std_ReturnType Rte_Call_PedalAcq_IoHwAb_Pedal_ReadPct(uint8_t* pct);
 
+/**
+ * @brief  Tuổi (ms) của mẫu bàn đạp gần nhất (IoHwAb) để loại dữ liệu cũ.
+ * @param  ageMs  Con trỏ nhận tuổi mẫu.
+ */
+Std_ReturnType Rte_Call_SafetyManager_IoHwAb_Pedal_GetSampleAge(uint32_t* ageMs);
+
 /**
  * @brief  Đọc trạng thái phanh từ IoHwAb (GPIO/công tắc).
  * @param  pressed  Con trỏ nhận TRUE/FALSE.
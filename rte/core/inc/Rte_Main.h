@@ -24,6 +24,15 @@ extern "C"
     /** Cho phép các Timing/Background Event bắt đầu chạy (ví dụ tick 10ms) */
     void Rte_StartTiming(void);
 
+    /** Implicit access: chụp buffer SR vào ảnh của task đang chạy
+     *  (gọi đầu task / trước runnable) và công bố Rte_IWrite_* (cuối) */
+    void Rte_Task_Begin(void);
+    void Rte_Task_End(void);
+
+    /** Thân task RTE hướng sự kiện (RTE_EVENT_TASK, RTE_EVENT_DRIVEN = 1),
+     *  chạy runnable consumer khi cổng đổi giá trị hoặc timeout. Không quay lại. */
+    void Rte_EventTask(void);
+
     /* (tùy chọn) Nếu bạn phân nhóm init khác nhau, có thể thêm:
      * void Rte_Init_<GroupA>(void);
      * void Rte_Init_<GroupB>(void);
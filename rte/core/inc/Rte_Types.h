@@ -92,6 +92,7 @@ typedef uint16_t EngineSpeedRpm_t;
 #define RTE_E_INVALID ((Std_ReturnType)E_NOT_OK)
 #define RTE_E_NO_DATA ((Std_ReturnType)E_NOT_OK)
 #define RTE_E_LIMIT ((Std_ReturnType)E_NOT_OK)
+#define RTE_E_NEVER_RECEIVED ((Std_ReturnType)E_NOT_OK) /* chưa từng được ghi */
 #ifdef __cplusplus
 }
 #endif
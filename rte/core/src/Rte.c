@@ -7,14 +7,26 @@
  *              Rte_Read_*() đọc lại giá trị hiện hành.
  *          - Client/Server (CS): ủy quyền trực tiếp xuống IoHwAb_*().
  *          - Truyền thông (Tx/Rx) qua AUTOSAR COM:
- *              Com_SendSignal() / Com_TriggerIPDUSend() / Com_ReceiveSignal().
+ *              Com_UpdateShadowSignal() + Com_SendSignalGroup() /
+ *              Com_TriggerIPDUSend() / Com_ReceiveSignal().
  *
  *          Lưu ý vận hành trên MCU (không mô phỏng PC):
  *            • Khởi tạo COM/MCAL/IoHwAb phải được thực hiện ở lớp BSW
  *              (EcuM/ComM/SchM/InitTask). RTE **không** gọi Com_Init().
  *            • Nếu SR buffers có thể được truy cập từ ISR và Task khác
  *              nhau, cần đảm bảo bảo vệ truy cập (tắt IRQ ngắn / spinlock).
+ *              Cổng nhiều byte (Safe_s) dùng bộ đệm đôi + số thứ tự
+ *              (Rte_SeqBuf_*): writer wait-free, không tắt ngắt.
  *            • Các API dưới đây là synchronous, non-reentrant theo mặc định.
+ *            • Explicit (Rte_Read/Rte_Write): truy cập buffer chung ngay;
+ *              Rte_Read_* trả RTE_E_NEVER_RECEIVED (kèm giá trị init)
+ *              tới khi producer ghi lần đầu.
+ *            • Implicit (Rte_IRead/Rte_IWrite): đọc/ghi ảnh riêng của
+ *              task, chụp một lần ở Rte_Task_Begin() và công bố ở
+ *              Rte_Task_End() → bộ giá trị nhất quán suốt một chu kỳ.
+ *            • RTE_EVENT_DRIVEN (cfg/rte/Rte_Cfg.h): Rte_Write_* đổi giá
+ *              trị → SetEvent() cho runnable consumer trong RTE_EVENT_TASK
+ *              (DataReceivedEvent), thay cho polling mỗi 10 ms.
  *
  * @version 1.2
  * @date    2025-09-10
@@ -22,7 +34,11 @@
  **********************************************************/
 /* rte/core/src/Rte.c */
 #include "Rte.h"
+#include "Rte_Main.h"
 #include "Rte_Types.h"
+#include "Rte_Cfg.h"
+#include "Os.h"
+#include <string.h>
 
 /* Kéo vào các Application Headers để bảo đảm prototype khớp */
 #include "Rte_Swc_PedalAcq.h"
@@ -63,8 +79,15 @@ extern "C"
     static Gear_e Rte_Buffer_GearOut_Gear = GEAR_P;
     static boolean Rte_IsUpdated_GearOut_Gear_Flag = FALSE;
 
-    /* SafetyManager -> SafeOut.Cmd (Safe_s) */
-    static Safe_s Rte_Buffer_SafeOut_Cmd = {0};
+    /* SafetyManager -> SafeOut.Cmd (Safe_s, nhiều byte → Rte_SeqBuf) */
+    typedef struct
+    {
+        volatile uint32_t wr;       /* số bản đã công bố, 0 = rỗng */
+        volatile uint32_t seq[2];   /* số bản đang nằm trong slot, 0 = đang ghi */
+    } Rte_SeqBufType;
+
+    static Safe_s Rte_Buffer_SafeOut_Cmd[2];
+    static Rte_SeqBufType Rte_SeqBuf_SafeOut_Cmd;
     static boolean Rte_IsUpdated_SafeOut_Cmd_Flag = FALSE;
 
     /* COM Proxy Buffers for VCU_Command Tx PDU */
@@ -78,10 +101,144 @@ extern "C"
     static DriveMode_e Rte_Mode_DriveMode_Value = DRIVEMODE_ECO;
     static boolean Rte_Mode_DriveMode_SwitchPendingAck = FALSE;
 
+    /* EngineSpeed (COM → MotorCtrl) */
+    static EngineSpeedRpm_t Rte_Buffer_EngineSpeed = 0u;
+    static boolean Rte_Received_EngineSpeed = FALSE;
+
+    /* Cổng SR đã từng được ghi (bit RTE_PORT_*) */
+#define RTE_PORT_BIT(port)   ((uint32_t)1u << (port))
+    static uint32_t Rte_Received = 0u;
+
     /* Lifecycle state (đơn giản) */
     static boolean Rte_Core_Started = FALSE;
     static boolean Rte_Timing_Activated = FALSE;
 
+    /* =======================================================
+     *            IMPLICIT ACCESS — ảnh dữ liệu theo task
+     *  - Rte_Task_Begin(): chụp mọi buffer SR vào ảnh của task
+     *    đang chạy: cổng 1 byte trong MỘT vùng găng ngắn (thay vì
+     *    tắt ngắt từng signal), Safe_s qua Rte_SeqBuf_Read().
+     *  - Rte_IRead_*: đọc ảnh → các runnable của task thấy cùng
+     *    một bộ giá trị dù task ưu tiên cao hơn ghi chen vào.
+     *  - Rte_IWrite_*: ghi ảnh + đánh dấu dirty; Rte_Task_End()
+     *    công bố qua Rte_Write_* (IsUpdated/DataReceivedEvent).
+     *  - Rte_Write_* từ chính task đó cũng cập nhật ảnh: runnable
+     *    sau trong cùng task thấy ngay dữ liệu runnable trước ghi.
+     *  - Task chưa Begin: IRead/IWrite rơi về truy cập explicit.
+     * ======================================================= */
+    typedef struct
+    {
+        uint8_t     pedalPct;
+        boolean     brakePressed;
+        Gear_e      gear;
+        DriveMode_e driveMode;
+        Safe_s      safe;
+        uint32_t    dirty;      /* bit RTE_PORT_* chờ công bố */
+        boolean     active;
+    } Rte_TaskImage_t;
+
+    static Rte_TaskImage_t Rte_Image[OS_MAX_TASKS];
+
+    static Rte_TaskImage_t *Rte_ActiveImage(void)
+    {
+        TaskType tid = INVALID_TASK;
+        (void)GetTaskID(&tid);
+        if ((tid < OS_MAX_TASKS) && (Rte_Image[tid].active == TRUE))
+        {
+            return &Rte_Image[tid];
+        }
+        return NULL;
+    }
+
+    /* =======================================================
+     *             DATA RECEIVED EVENT (RTE_EVENT_DRIVEN)
+     *  - Gọi sau khi Rte_Write_* cập nhật buffer; đánh dấu cổng
+     *    đã nhận dữ liệu. Rte_Received dùng chung cho mọi producer
+     *    (Task_A, Task_C...) → read-modify-write trong vùng găng,
+     *    task ưu tiên cao hơn chen vào không làm mất bit.
+     *  - Chỉ kích consumer khi giá trị thực sự đổi: producer ghi
+     *    lại giá trị cũ mỗi chu kỳ không đánh thức ai.
+     * ======================================================= */
+    static void Rte_Notify(Rte_PortId_e port, boolean changed)
+    {
+        __disable_irq();
+        Rte_Received |= RTE_PORT_BIT(port);
+        __enable_irq();
+#if (RTE_EVENT_DRIVEN == 1u)
+        if (changed == TRUE)
+        {
+            (void)SetEvent(RTE_EVENT_TASK, Rte_PortEvent[port]);
+        }
+#else
+        (void)port;
+        (void)changed;
+#endif
+    }
+
+    /* =======================================================
+     *        CỔNG NHIỀU BYTE — bộ đệm đôi + số thứ tự (seqlock)
+     *  - Cổng SR mà một lần ghi không nguyên tử (struct) giữ 2
+     *    slot; cổng 1 byte / enum 32 bit vẫn dùng buffer đơn vì
+     *    LDR/STR căn hàng đã nguyên tử trên Cortex-M3.
+     *  - Một writer / cổng (SR 1:N). Writer ghi vào slot KHÁC slot
+     *    mới nhất rồi mới công bố wr → wait-free, không tắt ngắt,
+     *    reader chen vào giữa luôn có một bản trọn vẹn để đọc.
+     *  - Reader kiểm seq trước/sau khi copy; bản chỉ hỏng khi
+     *    writer công bố >= 2 lần trong lúc copy → thử lại tối đa
+     *    RTE_SEQBUF_MAX_RETRY lần, sau đó copy trong vùng găng
+     *    ngắn (không xảy ra với chu kỳ 10 ms hiện tại).
+     *  - Cùng giao thức với kênh unqueued của IOC (Os_Ioc.c).
+     * ======================================================= */
+#define RTE_SEQBUF_MAX_RETRY   3u
+
+    static void Rte_SeqBuf_Write(Rte_SeqBufType *sb, void *slots, const void *src, uint32_t size)
+    {
+        const uint32_t w = sb->wr;
+        const uint32_t slot = w & 1u;             /* khác slot mới nhất (w-1) & 1 */
+
+        sb->seq[slot] = 0u;
+        __DMB();
+        memcpy((uint8_t *)slots + (slot * size), src, size);
+        __DMB();
+        sb->seq[slot] = w + 1u;
+        __DMB();
+        sb->wr = w + 1u;                          /* công bố */
+    }
+
+    static void Rte_SeqBuf_Read(const Rte_SeqBufType *sb, const void *slots, void *dst, uint32_t size)
+    {
+        for (uint32_t i = 0u; i < RTE_SEQBUF_MAX_RETRY; i++)
+        {
+            const uint32_t w = sb->wr;
+            const uint32_t slot = (w - 1u) & 1u;
+            if (sb->seq[slot] == w)
+            {
+                __DMB();
+                memcpy(dst, (const uint8_t *)slots + (slot * size), size);
+                __DMB();
+                if (sb->seq[slot] == w)
+                {
+                    return;
+                }
+            }
+        }
+        __disable_irq();
+        memcpy(dst, (const uint8_t *)slots + (((sb->wr - 1u) & 1u) * size), size);
+        __enable_irq();
+    }
+
+    /* Bản mới nhất — chỉ writer của cổng được đọc trực tiếp */
+    static const void *Rte_SeqBuf_Latest(const Rte_SeqBufType *sb, const void *slots, uint32_t size)
+    {
+        return (const uint8_t *)slots + (((sb->wr - 1u) & 1u) * size);
+    }
+
+    static boolean Rte_SafeDiffers(const Safe_s *a, const Safe_s *b)
+    {
+        return (a->throttle_pct != b->throttle_pct) || (a->gear != b->gear) ||
+               (a->driveMode != b->driveMode) || (a->brakeActive != b->brakeActive);
+    }
+
     /* =======================================================
      *                     LIFECYCLE API
      * ======================================================= */
@@ -98,15 +255,28 @@ extern "C"
         Rte_Buffer_GearOut_Gear = GEAR_P;
         Rte_IsUpdated_GearOut_Gear_Flag = FALSE;
 
-        Rte_Buffer_SafeOut_Cmd.throttle_pct = 0u;
-        Rte_Buffer_SafeOut_Cmd.gear = GEAR_P;
-        Rte_Buffer_SafeOut_Cmd.driveMode = DRIVEMODE_ECO;
-        Rte_Buffer_SafeOut_Cmd.brakeActive = FALSE;
+        const Safe_s safeInit = {
+            .throttle_pct = 0u,
+            .gear = GEAR_P,
+            .driveMode = DRIVEMODE_ECO,
+            .brakeActive = FALSE,
+        };
+        Rte_SeqBuf_SafeOut_Cmd.wr = 0u;
+        Rte_SeqBuf_Write(&Rte_SeqBuf_SafeOut_Cmd, Rte_Buffer_SafeOut_Cmd, &safeInit, sizeof(Safe_s));
         Rte_IsUpdated_SafeOut_Cmd_Flag = FALSE;
 
         Rte_Mode_DriveMode_Value = DRIVEMODE_ECO;
         Rte_Mode_DriveMode_SwitchPendingAck = FALSE;
 
+        Rte_Buffer_EngineSpeed = 0u;
+        Rte_Received_EngineSpeed = FALSE;
+        Rte_Received = 0u;
+        for (uint8_t t = 0u; t < (uint8_t)OS_MAX_TASKS; t++)
+        {
+            Rte_Image[t].active = FALSE;
+            Rte_Image[t].dirty = 0u;
+        }
+
         Rte_Core_Started = TRUE;
         return RTE_E_OK;
     }
@@ -128,11 +298,70 @@ extern "C"
 
     void Rte_StartTiming(void)
     {
-        /* Cho phép OS/Scheduler kích runnable theo tick; RTE bản tối giản không tự lập lịch */
+        /* Cho phép OS/Scheduler kích runnable theo tick */
         Rte_Timing_Activated = TRUE;
         (void)Rte_Timing_Activated; /* tránh cảnh báo nếu chưa dùng */
+#if (RTE_EVENT_DRIVEN == 1u)
+        /* Task RTE chờ event; các SWC init sau đó ghi cổng → event
+           được giữ tới lần WaitEvent đầu tiên. */
+        (void)ActivateTask(RTE_EVENT_TASK);
+        (void)SetRelAlarm(RTE_TIMING_ALARM, RTE_TIMING_BASE_MS, RTE_TIMING_BASE_MS);
+#endif
     }
 
+#if (RTE_EVENT_DRIVEN == 1u)
+    /**
+     * @brief Thân task RTE hướng sự kiện (RTE_EVENT_TASK), không quay lại.
+     * @details Mỗi vòng:
+     *          1) Chờ event của bất kỳ runnable nào hoặc EV_RTE_TIMING.
+     *          2) Duyệt runnable theo thứ tự Rte_RunnableCfg[]: chạy nếu
+     *             event của nó đang set (đọc lại sau mỗi runnable, để
+     *             consumer của cổng vừa được ghi chạy ngay trong vòng
+     *             này) hoặc đã đủ 'timeout' nhịp không chạy.
+     */
+    void Rte_EventTask(void)
+    {
+        EventMaskType waitMask = EV_RTE_TIMING;
+        uint16_t idle[RTE_RUN_COUNT] = {0u};
+
+        for (uint8_t r = 0u; r < (uint8_t)RTE_RUN_COUNT; r++)
+        {
+            waitMask |= RTE_EV_RUNNABLE(r);
+        }
+
+        for (;;)
+        {
+            EventMaskType ev = 0u;
+            (void)WaitEvent(waitMask);
+            (void)GetEvent(RTE_EVENT_TASK, &ev);
+            const boolean timing = ((ev & EV_RTE_TIMING) != 0u) ? TRUE : FALSE;
+            (void)ClearEvent(EV_RTE_TIMING);
+
+            for (uint8_t r = 0u; r < (uint8_t)RTE_RUN_COUNT; r++)
+            {
+                const Rte_RunnableCfgType *run = &Rte_RunnableCfg[r];
+                boolean due;
+
+                (void)GetEvent(RTE_EVENT_TASK, &ev);
+                due = ((ev & RTE_EV_RUNNABLE(r)) != 0u) ? TRUE : FALSE;
+                if ((due == FALSE) && (timing == TRUE) && (run->timeout != 0u))
+                {
+                    idle[r]++;
+                    due = (idle[r] >= run->timeout) ? TRUE : FALSE;
+                }
+                if (due == TRUE)
+                {
+                    (void)ClearEvent(RTE_EV_RUNNABLE(r));
+                    idle[r] = 0u;
+                    Rte_Task_Begin();
+                    run->runnable();
+                    Rte_Task_End();
+                }
+            }
+        }
+    }
+#endif
+
        /**
      * @brief Khởi tạo RTE, được gọi từ InitTask.
      * @details Hàm này là điểm vào công khai để bắt đầu RTE. Nó gọi các
@@ -150,24 +379,45 @@ extern "C"
     /* PedalAcq -> PedalOut.PedalPct */
     Std_ReturnType Rte_Write_PedalAcq_PedalOut(uint8_t data)
     {
+        const boolean changed = (Rte_Buffer_PedalOut_PedalPct != data) ? TRUE : FALSE;
+        Rte_TaskImage_t *img = Rte_ActiveImage();
         Rte_Buffer_PedalOut_PedalPct = data;
         Rte_IsUpdated_PedalOut_PedalPct_Flag = TRUE;
+        if (img != NULL)
+        {
+            img->pedalPct = data;
+        }
+        Rte_Notify(RTE_PORT_PedalOut, changed);
         return RTE_E_OK;
     }
 
     /* BrakeAcq -> BrakeOut.BracePressed */
     Std_ReturnType Rte_Write_BrakeAcq_BrakeOut(boolean data)
     {
+        const boolean changed = (Rte_Buffer_BrakeOut_BrakePressed != data) ? TRUE : FALSE;
+        Rte_TaskImage_t *img = Rte_ActiveImage();
         Rte_Buffer_BrakeOut_BrakePressed = data;
         Rte_IsUpdated_BrakeOut_BrakePressed_Flag = TRUE;
+        if (img != NULL)
+        {
+            img->brakePressed = data;
+        }
+        Rte_Notify(RTE_PORT_BrakeOut, changed);
         return RTE_E_OK;
     }
 
     /* GearSelector -> GearOut.Gear */
     Std_ReturnType Rte_Write_GearSelector_GearOut(Gear_e data)
     {
+        const boolean changed = (Rte_Buffer_GearOut_Gear != data) ? TRUE : FALSE;
+        Rte_TaskImage_t *img = Rte_ActiveImage();
         Rte_Buffer_GearOut_Gear = data;
         Rte_IsUpdated_GearOut_Gear_Flag = TRUE;
+        if (img != NULL)
+        {
+            img->gear = data;
+        }
+        Rte_Notify(RTE_PORT_GearOut, changed);
         return RTE_E_OK;
     }
 
@@ -178,15 +428,30 @@ extern "C"
         {
             return RTE_E_INVALID;
         }
-        Rte_Buffer_SafeOut_Cmd = *data;
+        Rte_TaskImage_t *img = Rte_ActiveImage();
+        const boolean changed = Rte_SafeDiffers(
+            Rte_SeqBuf_Latest(&Rte_SeqBuf_SafeOut_Cmd, Rte_Buffer_SafeOut_Cmd, sizeof(Safe_s)), data);
+        Rte_SeqBuf_Write(&Rte_SeqBuf_SafeOut_Cmd, Rte_Buffer_SafeOut_Cmd, data, sizeof(Safe_s));
         Rte_IsUpdated_SafeOut_Cmd_Flag = TRUE;
+        if (img != NULL)
+        {
+            img->safe = *data;
+        }
+        Rte_Notify(RTE_PORT_SafeOut, changed);
         return RTE_E_OK;
     }
 
     /* =======================================================
      *           SENDER-RECEIVER — READ (Require)
-     * (clear IsUpdated flag khi đọc để báo đã tiêu thụ)
+     * - Luôn trả giá trị hiện hành (init value nếu chưa có).
+     * - Clear IsUpdated flag khi đọc để báo đã tiêu thụ.
+     * - RTE_E_NEVER_RECEIVED: producer chưa ghi lần nào.
      * ======================================================= */
+    static Std_ReturnType Rte_ReadStatus(Rte_PortId_e port)
+    {
+        return ((Rte_Received & RTE_PORT_BIT(port)) != 0u) ? RTE_E_OK : RTE_E_NEVER_RECEIVED;
+    }
+
     Std_ReturnType Rte_Read_SafetyManager_PedalOut(uint8_t *data)
     {
         if (data == NULL)
@@ -195,7 +460,7 @@ extern "C"
         }
         *data = Rte_Buffer_PedalOut_PedalPct;
         Rte_IsUpdated_PedalOut_PedalPct_Flag = FALSE;
-        return RTE_E_OK;
+        return Rte_ReadStatus(RTE_PORT_PedalOut);
     }
 
     Std_ReturnType Rte_Read_SafetyManager_BrakeOut(boolean *data)
@@ -206,7 +471,7 @@ extern "C"
         }
         *data = Rte_Buffer_BrakeOut_BrakePressed;
         Rte_IsUpdated_BrakeOut_BrakePressed_Flag = FALSE;
-        return RTE_E_OK;
+        return Rte_ReadStatus(RTE_PORT_BrakeOut);
     }
 
     Std_ReturnType Rte_Read_SafetyManager_GearOut(Gear_e *data)
@@ -217,7 +482,7 @@ extern "C"
         }
         *data = Rte_Buffer_GearOut_Gear;
         Rte_IsUpdated_GearOut_Gear_Flag = FALSE;
-        return RTE_E_OK;
+        return Rte_ReadStatus(RTE_PORT_GearOut);
     }
 
     Std_ReturnType Rte_Read_CmdComposer_SafeOut(Safe_s *data)
@@ -226,9 +491,9 @@ extern "C"
         {
             return RTE_E_INVALID;
         }
-        *data = Rte_Buffer_SafeOut_Cmd;
+        Rte_SeqBuf_Read(&Rte_SeqBuf_SafeOut_Cmd, Rte_Buffer_SafeOut_Cmd, data, sizeof(Safe_s));
         Rte_IsUpdated_SafeOut_Cmd_Flag = FALSE;
-        return RTE_E_OK;
+        return Rte_ReadStatus(RTE_PORT_SafeOut);
     }
 
     /* =======================================================
@@ -274,6 +539,147 @@ extern "C"
         return RTE_E_OK;
     }
 
+    /* =======================================================
+     *        IMPLICIT ACCESS — Rte_Task_Begin / Rte_Task_End
+     * ======================================================= */
+    void Rte_Task_Begin(void)
+    {
+        TaskType tid = INVALID_TASK;
+        (void)GetTaskID(&tid);
+        if (tid >= OS_MAX_TASKS)
+        {
+            return;
+        }
+        Rte_TaskImage_t *img = &Rte_Image[tid];
+
+        __disable_irq();
+        img->pedalPct     = Rte_Buffer_PedalOut_PedalPct;
+        img->brakePressed = Rte_Buffer_BrakeOut_BrakePressed;
+        img->gear         = Rte_Buffer_GearOut_Gear;
+        img->driveMode    = Rte_Mode_DriveMode_Value;
+        __enable_irq();
+        Rte_SeqBuf_Read(&Rte_SeqBuf_SafeOut_Cmd, Rte_Buffer_SafeOut_Cmd, &img->safe, sizeof(Safe_s));
+
+        img->dirty  = 0u;
+        img->active = TRUE;
+    }
+
+    void Rte_Task_End(void)
+    {
+        TaskType tid = INVALID_TASK;
+        (void)GetTaskID(&tid);
+        if ((tid >= OS_MAX_TASKS) || (Rte_Image[tid].active == FALSE))
+        {
+            return;
+        }
+        Rte_TaskImage_t *img = &Rte_Image[tid];
+        const uint32_t dirty = img->dirty;
+
+        img->active = FALSE;   /* Rte_Write_* bên dưới không ghi lại ảnh */
+        img->dirty  = 0u;
+        if ((dirty & RTE_PORT_BIT(RTE_PORT_PedalOut)) != 0u)
+        {
+            (void)Rte_Write_PedalAcq_PedalOut(img->pedalPct);
+        }
+        if ((dirty & RTE_PORT_BIT(RTE_PORT_BrakeOut)) != 0u)
+        {
+            (void)Rte_Write_BrakeAcq_BrakeOut(img->brakePressed);
+        }
+        if ((dirty & RTE_PORT_BIT(RTE_PORT_GearOut)) != 0u)
+        {
+            (void)Rte_Write_GearSelector_GearOut(img->gear);
+        }
+        if ((dirty & RTE_PORT_BIT(RTE_PORT_DriveModeOut)) != 0u)
+        {
+            (void)Rte_Write_DriveModeMgr_DriveModeOut(img->driveMode);
+        }
+        if ((dirty & RTE_PORT_BIT(RTE_PORT_SafeOut)) != 0u)
+        {
+            (void)Rte_Write_SafetyManager_SafeOut(&img->safe);
+        }
+    }
+
+    /* =======================================================
+     *        IMPLICIT ACCESS — Rte_IRead_* / Rte_IWrite_*
+     * ======================================================= */
+    uint8_t Rte_IRead_SafetyManager_PedalOut(void)
+    {
+        const Rte_TaskImage_t *img = Rte_ActiveImage();
+        return (img != NULL) ? img->pedalPct : Rte_Buffer_PedalOut_PedalPct;
+    }
+
+    boolean Rte_IRead_SafetyManager_BrakeOut(void)
+    {
+        const Rte_TaskImage_t *img = Rte_ActiveImage();
+        return (img != NULL) ? img->brakePressed : Rte_Buffer_BrakeOut_BrakePressed;
+    }
+
+    Gear_e Rte_IRead_SafetyManager_GearOut(void)
+    {
+        const Rte_TaskImage_t *img = Rte_ActiveImage();
+        return (img != NULL) ? img->gear : Rte_Buffer_GearOut_Gear;
+    }
+
+    DriveMode_e Rte_IRead_SafetyManager_DriveModeOut(void)
+    {
+        const Rte_TaskImage_t *img = Rte_ActiveImage();
+        return (img != NULL) ? img->driveMode : Rte_Mode_DriveMode_Value;
+    }
+
+    Safe_s Rte_IRead_CmdComposer_SafeOut(void)
+    {
+        const Rte_TaskImage_t *img = Rte_ActiveImage();
+        Safe_s safe;
+        if (img != NULL)
+        {
+            return img->safe;
+        }
+        Rte_SeqBuf_Read(&Rte_SeqBuf_SafeOut_Cmd, Rte_Buffer_SafeOut_Cmd, &safe, sizeof(Safe_s));
+        return safe;
+    }
+
+    void Rte_IWrite_SafetyManager_SafeOut(const Safe_s *data)
+    {
+        Rte_TaskImage_t *img = Rte_ActiveImage();
+        if (data == NULL)
+        {
+            return;
+        }
+        if (img == NULL)
+        {
+            (void)Rte_Write_SafetyManager_SafeOut(data);
+            return;
+        }
+        img->safe   = *data;
+        img->dirty |= RTE_PORT_BIT(RTE_PORT_SafeOut);
+    }
+
+    /* Trạng thái nhận của cổng đi kèm Rte_IRead_* (IRead chỉ trả giá trị) */
+    Std_ReturnType Rte_IStatus_SafetyManager_PedalOut(void)
+    {
+        return Rte_ReadStatus(RTE_PORT_PedalOut);
+    }
+
+    Std_ReturnType Rte_IStatus_SafetyManager_BrakeOut(void)
+    {
+        return Rte_ReadStatus(RTE_PORT_BrakeOut);
+    }
+
+    Std_ReturnType Rte_IStatus_SafetyManager_GearOut(void)
+    {
+        return Rte_ReadStatus(RTE_PORT_GearOut);
+    }
+
+    Std_ReturnType Rte_IStatus_SafetyManager_DriveModeOut(void)
+    {
+        return Rte_ReadStatus(RTE_PORT_DriveModeOut);
+    }
+
+    Std_ReturnType Rte_IStatus_CmdComposer_SafeOut(void)
+    {
+        return Rte_ReadStatus(RTE_PORT_SafeOut);
+    }
+
     /* =======================================================
      *               MODE MANAGEMENT — DriveMode
      * ======================================================= */
@@ -284,8 +690,15 @@ extern "C"
         {
             return RTE_E_LIMIT;
         }
+        const boolean changed = (Rte_Mode_DriveMode_Value != mode) ? TRUE : FALSE;
+        Rte_TaskImage_t *img = Rte_ActiveImage();
         Rte_Mode_DriveMode_Value = mode;
         Rte_Mode_DriveMode_SwitchPendingAck = TRUE;
+        if (img != NULL)
+        {
+            img->driveMode = mode;
+        }
+        Rte_Notify(RTE_PORT_DriveModeOut, changed);
         return RTE_E_OK;
     }
 
@@ -301,8 +714,7 @@ extern "C"
             return RTE_E_INVALID;
         }
         *data = Rte_Mode_DriveMode_Value;
-        Rte_Mode_DriveMode_SwitchPendingAck = TRUE;
-        return RTE_E_OK;
+        return Rte_ReadStatus(RTE_PORT_DriveModeOut);
     }
 
     Std_ReturnType Rte_SwitchAck_Swc_DriveModeMgr_DriveMode_Mode(void)
@@ -315,6 +727,90 @@ extern "C"
         return RTE_E_NO_DATA; /* không có switch đang chờ ACK */
     }
 
+    /* =======================================================
+     *     TÊN THEO SWC (rte/core/swc_if) → hiện thực chung
+     * ======================================================= */
+    Std_ReturnType Rte_Write_Swc_PedalAcq_PedalOut_PedalPct(uint8_t data)
+    {
+        return Rte_Write_PedalAcq_PedalOut(data);
+    }
+
+    Std_ReturnType Rte_Write_Swc_BrakeAcq_BrakeOut_BrakePressed(boolean data)
+    {
+        return Rte_Write_BrakeAcq_BrakeOut(data);
+    }
+
+    Std_ReturnType Rte_Write_Swc_GearSelector_GearOut_Gear(Gear_e data)
+    {
+        return Rte_Write_GearSelector_GearOut(data);
+    }
+
+    Std_ReturnType Rte_Write_Swc_SafetyManager_SafeOut_Cmd(const Safe_s *data)
+    {
+        return Rte_Write_SafetyManager_SafeOut(data);
+    }
+
+    Std_ReturnType Rte_Switch_Swc_DriveModeMgr_DriveMode_Mode(DriveMode_e mode)
+    {
+        return Rte_Write_DriveModeMgr_DriveModeOut(mode);
+    }
+
+    Std_ReturnType Rte_Read_Swc_SafetyManager_PedalOut_PedalPct(uint8_t *data)
+    {
+        return Rte_Read_SafetyManager_PedalOut(data);
+    }
+
+    Std_ReturnType Rte_Read_Swc_SafetyManager_BrakeOut_BrakePressed(boolean *data)
+    {
+        return Rte_Read_SafetyManager_BrakeOut(data);
+    }
+
+    Std_ReturnType Rte_Read_Swc_SafetyManager_GearOut_Gear(Gear_e *data)
+    {
+        return Rte_Read_SafetyManager_GearOut(data);
+    }
+
+    Std_ReturnType Rte_Read_Swc_CmdComposer_SafeOut_Cmd(Safe_s *data)
+    {
+        return Rte_Read_CmdComposer_SafeOut(data);
+    }
+
+    DriveMode_e Rte_Mode_Swc_SafetyManager_DriveMode_Mode(void)
+    {
+        return Rte_Mode_DriveMode_Value;
+    }
+
+    /* Exclusive Area: tắt ngắt ngắn, không lồng nhau */
+    void Rte_Enter_Swc_SafetyManager_EA(void)
+    {
+        __disable_irq();
+    }
+
+    void Rte_Exit_Swc_SafetyManager_EA(void)
+    {
+        __enable_irq();
+    }
+
+    /* =======================================================
+     *          EngineSpeed (COM → MotorCtrl)
+     * ======================================================= */
+    Std_ReturnType Rte_Write_Com_EngineSpeed(EngineSpeedRpm_t rpm)
+    {
+        Rte_Buffer_EngineSpeed = rpm;
+        Rte_Received_EngineSpeed = TRUE;
+        return RTE_E_OK;
+    }
+
+    Std_ReturnType Rte_Read_MotorCtrl_EngineSpeed(EngineSpeedRpm_t *rpm)
+    {
+        if (rpm == NULL)
+        {
+            return RTE_E_INVALID;
+        }
+        *rpm = Rte_Buffer_EngineSpeed;
+        return (Rte_Received_EngineSpeed == TRUE) ? RTE_E_OK : RTE_E_NEVER_RECEIVED;
+    }
+
     /* =======================================================
      *          PROXY for COM Tx (VCU_Command)
      * ======================================================= */
@@ -353,20 +849,24 @@ extern "C"
         Std_ReturnType ret = RTE_E_OK;
         Std_ReturnType op_ret;
 
-        /* 1. Gửi từng signal vào shadow buffer của COM */
-        op_ret = Com_SendSignal(ComConf_ComSignal_VCU_ThrottleReq_pct, &Rte_Buffer_VcuCmdTx_Throttle);
+        /* 1. Dựng ảnh frame trong shadow của signal group, chép vào
+         *    I-PDU một lần → 5 tín hiệu luôn đi cùng một frame */
+        op_ret = Com_UpdateShadowSignal(ComConf_ComSignal_VCU_ThrottleReq_pct, &Rte_Buffer_VcuCmdTx_Throttle);
+        if (op_ret != E_OK) { ret = RTE_E_NOT_OK; }
+
+        op_ret = Com_UpdateShadowSignal(ComConf_ComSignal_VCU_GearSel, &Rte_Buffer_VcuCmdTx_Gear);
         if (op_ret != E_OK) { ret = RTE_E_NOT_OK; }
 
-        op_ret = Com_SendSignal(ComConf_ComSignal_VCU_GearSel, &Rte_Buffer_VcuCmdTx_Gear);
+        op_ret = Com_UpdateShadowSignal(ComConf_ComSignal_VCU_DriveMode, &Rte_Buffer_VcuCmdTx_Mode);
         if (op_ret != E_OK) { ret = RTE_E_NOT_OK; }
 
-        op_ret = Com_SendSignal(ComConf_ComSignal_VCU_DriveMode, &Rte_Buffer_VcuCmdTx_Mode);
+        op_ret = Com_UpdateShadowSignal(ComConf_ComSignal_VCU_BrakeActive, &Rte_Buffer_VcuCmdTx_Brake);
         if (op_ret != E_OK) { ret = RTE_E_NOT_OK; }
 
-        op_ret = Com_SendSignal(ComConf_ComSignal_VCU_BrakeActive, &Rte_Buffer_VcuCmdTx_Brake);
+        op_ret = Com_UpdateShadowSignal(ComConf_ComSignal_VCU_Alive, &Rte_Buffer_VcuCmdTx_Alive);
         if (op_ret != E_OK) { ret = RTE_E_NOT_OK; }
 
-        op_ret = Com_SendSignal(ComConf_ComSignal_VCU_Alive, &Rte_Buffer_VcuCmdTx_Alive);
+        op_ret = Com_SendSignalGroup(ComConf_ComSignalGroup_VCU_Command);
         if (op_ret != E_OK) { ret = RTE_E_NOT_OK; }
 
         /* 2. Yêu cầu COM phát PDU đã được cập nhật */
@@ -435,6 +935,11 @@ extern "C"
         return IoHwAb_Pedal_ReadPct(pct);
     }
 
+    Std_ReturnType Rte_Call_SafetyManager_IoHwAb_Pedal_GetSampleAge(uint32_t *ageMs)
+    {
+        return IoHwAb_Pedal_GetSampleAge(ageMs);
+    }
+
 
 #ifdef __cplusplus
 }
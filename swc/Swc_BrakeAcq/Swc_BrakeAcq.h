@@ -5,7 +5,7 @@
  *          nhiệm:
  *            - Lấy mẫu tín hiệu phanh thô từ lớp IoHwAb (DIO/cảm biến)
  *              thông qua RTE (Client/Server).
- *            - Lọc nhiễu/debounce theo thời gian.
+ *            - Nhận mức đã debounce (IoHwAb_Digital_MainFunction).
  *            - Phát hành (publish) trạng thái phanh ổn định qua RTE
  *              (Sender/Receiver – Provide port).
  *
@@ -31,13 +31,13 @@ extern "C" {
 #include "Std_Types.h"
 
 /**
- * @brief Khởi tạo nội bộ SWC (trạng thái, debounce, seed giá trị ban đầu).
+ * @brief Khởi tạo nội bộ SWC (trạng thái, seed giá trị ban đầu).
  * @note  Gọi trong InitTask sau khi Rte_Init().
  */
 void Swc_BrakeAcq_Init(void);
 
 /**
- * @brief Hàm định kỳ 10 ms: đọc tín hiệu phanh, debounce, publish ra RTE.
+ * @brief Hàm định kỳ 10 ms: đọc tín hiệu phanh đã debounce, publish khi đổi.
  * @note  Gọi từ Task_10ms (hay lịch tương đương).
  */
 void Swc_BrakeAcq_Run10ms(void);
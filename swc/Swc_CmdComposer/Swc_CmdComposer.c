@@ -2,7 +2,7 @@
  * @file    Swc_CmdComposer.c
  * @brief   SWC – Command Composer (biên soạn lệnh VCU)
  * @details Luồng xử lý mỗi chu kỳ:
- *   1) Đọc gói Safe_s từ RTE (Rte_Read_CmdComposer_SafeOut).
+ *   1) Đọc gói Safe_s từ RTE (implicit Rte_IRead_CmdComposer_SafeOut).
  *   2) Chuẩn hoá/ánh xạ:
  *        - throttle_pct → ThrottleReq_pct (0..100, clamp).
  *        - gear (P/R/N/D) → GearSel (0..3).
@@ -24,6 +24,7 @@
 #include "Swc_CmdComposer.h"
 #include "Rte.h"
 #include "Rte_Types.h"
+#include "Log.h"   /* LOG(): log trì hoãn */
 
 /* ================== Cấu hình nhanh ================== */
 #ifndef CMDC_TASK_PERIOD_MS
@@ -114,8 +115,8 @@ void Swc_CmdComposer_Init(void)
   s_cmd.inited = FALSE;
   CmdComposer_Seed();
 
-  printf("CmdComposer: init done, throttle=%d, gear=%d, mode=%d, brake=%d\n",
-         s_cmd.lastThrottle, s_cmd.lastGearU8, s_cmd.lastModeU8, s_cmd.lastBrake);
+  LOG("CmdComposer: init done, throttle=%d, gear=%d, mode=%d, brake=%d\n",
+      s_cmd.lastThrottle, s_cmd.lastGearU8, s_cmd.lastModeU8, s_cmd.lastBrake);
 }
 
 void Swc_CmdComposer_Run10ms(void)
@@ -124,8 +125,8 @@ void Swc_CmdComposer_Run10ms(void)
     CmdComposer_Seed();
   }
 
-  Safe_s safe;
-  const boolean haveSafe = (Rte_Read_CmdComposer_SafeOut(&safe) == E_OK);
+  const Safe_s safe = Rte_IRead_CmdComposer_SafeOut();
+  const boolean haveSafe = (Rte_IStatus_CmdComposer_SafeOut() == E_OK);
 
   /* 1) Lấy giá trị mục tiêu từ Safe_s hoặc fallback từ last */
   uint8_t  thr  = haveSafe ? clamp_0_100((int)safe.throttle_pct) : s_cmd.lastThrottle;
@@ -4,7 +4,7 @@
  * @details Thành phần phần mềm chịu trách nhiệm:
  *          - Lấy mẫu chế độ lái thô từ lớp IoHwAb (công tắc/ECU khác)
  *            thông qua RTE (Client/Server).
- *          - Lọc nhiễu/debounce theo thời gian để có giá trị ổn định.
+ *          - Nhận giá trị ổn định đã debounce (IoHwAb_Digital_MainFunction).
  *          - Phát hành (publish) chế độ lái ổn định qua RTE
  *            (Sender/Receiver – Provide port).
  *
@@ -35,7 +35,7 @@ extern "C" {
 void Swc_DriveModeMgr_Init(void);
 
 /**
- * @brief Hàm định kỳ 10 ms: đọc chế độ lái, debounce, publish ra RTE.
+ * @brief Hàm định kỳ 10 ms: đọc chế độ lái đã debounce, publish khi đổi.
  * @note  Gọi từ Task_10ms (hoặc lịch tương đương).
  */
 void Swc_DriveModeMgr_Run10ms(void);
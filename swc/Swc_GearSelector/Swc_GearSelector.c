@@ -2,19 +2,21 @@
  * @file    Swc_GearSelector.c
  * @brief   SWC – Gear Selector (đọc & quản lý vị trí cần số)
  * @details Luồng xử lý:
- *            1) Lấy mẫu vị trí số thô từ IoHwAb qua RTE:
+ *            1) Lấy vị trí số đã debounce từ IoHwAb qua RTE:
  *               Rte_Call_GearSelector_IoHwAb_Gear_Get(&raw, &valid).
- *            2) Nếu valid == TRUE → debounce theo thời gian.
- *            3) Khi trạng thái ổn định thay đổi → publish:
+ *               (Hai bit mã số được IoHwAb_Digital_MainFunction lọc
+ *               nhiễu; ngưỡng IOHWAB_DIN_GEAR_Bx trong IoHwAb_Digital_Cfg.c.)
+ *            2) Nếu valid == TRUE và khác trạng thái ổn định → publish:
  *               Rte_Write_GearSelector_GearOut(stable).
  *
  *          Mặc định:
  *            - Chu kỳ gọi Run10ms: 10 ms.
- *            - Cửa sổ debounce: 30 ms (3 chu kỳ).
+ *            - Cửa sổ debounce: 20 ms (2 mẫu, cấu hình ở IoHwAb).
  *
  *          Ghi chú:
  *            - Giá trị hợp lệ: GEAR_P/GEAR_R/GEAR_N/GEAR_D.
- *            - Nếu IoHwAb báo invalid → bỏ qua chu kỳ đó.
+ *            - Nếu IoHwAb báo invalid (một bit còn đang debounce)
+ *              → bỏ qua chu kỳ đó.
  *
  * @version 1.0
  * @date    2025-09-10
@@ -24,24 +26,11 @@
 #include "Swc_GearSelector.h"
 #include "Rte.h"        /* Rte_Call_* & Rte_Write_* */
 #include "Rte_Types.h"   /* Gear_e */
+#include "Log.h"   /* LOG(): log trì hoãn */
 
-#ifndef GEARSEL_TASK_PERIOD_MS
-#define GEARSEL_TASK_PERIOD_MS   (10u)  /* chu kỳ gọi Run10ms */
-#endif
-
-#ifndef GEARSEL_DEBOUNCE_MS
-#define GEARSEL_DEBOUNCE_MS      (20u)  /* yêu cầu ổn định 30 ms */
-#endif
-
-/* Số mẫu cần liên tiếp giống nhau để coi là ổn định */
-#define GEARSEL_DEBOUNCE_TICKS \
-  ((uint8_t)((GEARSEL_DEBOUNCE_MS + (GEARSEL_TASK_PERIOD_MS - 1u)) / GEARSEL_TASK_PERIOD_MS))
-
-/* Trạng thái nội bộ cho thuật toán debounce */
+/* Trạng thái nội bộ */
 typedef struct {
-  Gear_e  lastRaw;  /* mẫu vừa đọc (kỳ trước)       */
-  Gear_e  stable;   /* vị trí số đã ổn định         */
-  uint8_t   cnt;      /* số lần liên tiếp cùng giá trị*/
+  Gear_e  stable;   /* vị trí số đã publish         */
   boolean inited;   /* đã seed lần đầu chưa         */
 } GearSel_State_t;
 
@@ -63,9 +52,7 @@ static void GearSel_SeedFromHw(void)
     raw = GEAR_P; /* fallback an toàn */
   }
 
-  s_gear.lastRaw = raw;
   s_gear.stable  = raw;
-  s_gear.cnt     = 0u;
   s_gear.inited  = TRUE;
 
   /* Publish giá trị seed để các SWC khác có dữ liệu ngay */
@@ -74,14 +61,12 @@ static void GearSel_SeedFromHw(void)
 
 void Swc_GearSelector_Init(void)
 {
-  s_gear.lastRaw = GEAR_P;
   s_gear.stable  = GEAR_P;
-  s_gear.cnt     = 0u;
   s_gear.inited  = FALSE;
 
   GearSel_SeedFromHw();
 
-  printf("GearSelector: init done, stable=%d\n", s_gear.stable);
+  LOG("GearSelector: init done, stable=%d\n", s_gear.stable);
 }
 
 void Swc_GearSelector_Run10ms(void)
@@ -89,7 +74,7 @@ void Swc_GearSelector_Run10ms(void)
   Gear_e  raw;
   boolean valid;
 
-  /* 1) Lấy mẫu thô từ IoHwAb (qua RTE) */
+  /* 1) Lấy vị trí số đã debounce từ IoHwAb (qua RTE) */
   if (Rte_Call_GearSelector_IoHwAb_Gear_Get(&raw, &valid) != E_OK) {
     /* Không cập nhật khi IoHwAb lỗi; giữ nguyên trạng thái hiện hành */
     return;
@@ -99,18 +84,9 @@ void Swc_GearSelector_Run10ms(void)
     return;
   }
 
-  /* 2) Debounce: nếu giống mẫu trước → tăng đếm; khác → reset đếm */
-  if (raw == s_gear.lastRaw) {
-    if (s_gear.cnt < 0xFFu) { s_gear.cnt++; }
-  } else {
-    s_gear.lastRaw = raw;
-    s_gear.cnt     = 1u;  /* bắt đầu chuỗi mới */
-  }
-
-  /* 3) Khi đủ số mẫu liên tiếp và khác với stable → cập nhật & publish */
-  if ((s_gear.cnt >= GEARSEL_DEBOUNCE_TICKS) && (raw != s_gear.stable)) {
+  /* 2) Khác với stable → cập nhật & publish */
+  if (raw != s_gear.stable) {
     s_gear.stable = raw;
     (void)Rte_Write_GearSelector_GearOut(s_gear.stable);
-    /* Giữ lastRaw/cnt để tiếp tục debounce chuỗi kế tiếp */
   }
 }
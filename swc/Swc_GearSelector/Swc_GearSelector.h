@@ -4,7 +4,7 @@
  * @details Thành phần phần mềm chịu trách nhiệm:
  *          - Đọc vị trí số thô từ IoHwAb (công tắc/cảm biến) thông
  *            qua RTE (Client/Server).
- *          - Lọc nhiễu/debounce theo thời gian.
+ *          - Nhận mức đã debounce (IoHwAb_Digital_MainFunction).
  *          - Phát hành (publish) vị trí số ổn định qua RTE
  *            (Sender/Receiver – Provide port).
  *
@@ -35,7 +35,7 @@ extern "C" {
 void Swc_GearSelector_Init(void);
 
 /**
- * @brief Hàm định kỳ 10 ms: đọc vị trí số, debounce, publish ra RTE.
+ * @brief Hàm định kỳ 10 ms: đọc vị trí số đã debounce, publish khi đổi.
  * @note  Gọi từ Task_10ms (hoặc lịch tương đương).
  */
 void Swc_GearSelector_Run10ms(void);
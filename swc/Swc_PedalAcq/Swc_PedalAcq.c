@@ -26,6 +26,7 @@
 
 #include "Swc_PedalAcq.h"
 #include "Rte.h"   /* Rte_Call_* & Rte_Write_* */
+#include "Log.h"   /* LOG(): log trì hoãn */
 
 /* ================== Cấu hình nhanh ================== */
 #ifndef PEDAL_TASK_PERIOD_MS
@@ -86,7 +87,7 @@ void Swc_PedalAcq_Init(void)
 
   PedalAcq_SeedFromHw();
 
-  printf("PedalAcq: init done, stable=%d\n", s_pedal.outPct);
+  LOG("PedalAcq: init done, stable=%d\n", s_pedal.outPct);
 }
 
 void Swc_PedalAcq_Run10ms(void)
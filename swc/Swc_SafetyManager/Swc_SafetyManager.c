@@ -2,9 +2,11 @@
  * @file    Swc_SafetyManager.c
  * @brief   SWC – Safety Manager (tổng hợp & áp ràng buộc an toàn)
  * @details Luồng xử lý mỗi chu kỳ:
- *   1) Đọc các tín hiệu từ RTE (SR-Require):
+ *   1) Đọc các tín hiệu từ RTE (SR-Require, implicit Rte_IRead):
  *      - PedalOut (%), BrakeOut (bool), GearOut (PRND), DriveModeOut.
- *      - Kiểm tra E_OK/E_NOT_OK để phát hiện thiếu cập nhật.
+ *      - Cả bộ lấy từ ảnh chụp đầu task → nhất quán trong chu kỳ.
+ *      - Kiểm tra Rte_IStatus (E_OK/E_NOT_OK) để phát hiện nguồn
+ *        chưa từng cập nhật.
  *   2) Ràng buộc an toàn:
  *      - Interlock chuyển số (thuật toán yêu cầu):
  *          **Từ P sang R/D hoặc từ R/D về P đều yêu cầu đạp phanh.**
@@ -13,7 +15,11 @@
  *      - Brake override: đang phanh → hạn chế % ga tối đa.
  *      - Timeout: nguồn dữ liệu quá hạn → fallback an toàn (ví dụ
  *        throttle=0, gear=P, mode=ECO).
- *   3) Đóng gói Safe_s và xuất qua RTE (SR-Provide).
+ *      - Mẫu bàn đạp cũ hơn SAFETY_PEDAL_MAX_AGE_MS (dấu thời gian ADC
+ *        qua IoHwAb) được coi như không cập nhật → giữ giá trị an toàn
+ *        trước; tuổi ≥ SAFETY_TIMEOUT_MS thì throttle=0.
+ *   3) Đóng gói Safe_s và xuất qua RTE (SR-Provide, Rte_IWrite:
+ *      công bố khi runnable/task kết thúc).
  *
  * @version 1.1
  * @date    2025-09-10 
@@ -23,6 +29,7 @@
 #include "Swc_SafetyManager.h"
 #include "Rte.h"
 #include "Rte_Types.h"
+#include "Log.h"   /* LOG(): log trì hoãn */
 
 /* ========= Cấu hình nhanh (điều chỉnh tuỳ yêu cầu hệ thống) ========= */
 
@@ -41,6 +48,11 @@
 #define SAFETY_TIMEOUT_MS                 (100u) /* 100 ms */
 #endif
 
+/* Tuổi tối đa (ms) của mẫu ADC bàn đạp; ADC khoá pha Task_A → bình thường ≤ 1 ms */
+#ifndef SAFETY_PEDAL_MAX_AGE_MS
+#define SAFETY_PEDAL_MAX_AGE_MS           (2u * SAFETY_TASK_PERIOD_MS)
+#endif
+
 /* Số tick tương ứng timeout */
 #define SAFETY_TIMEOUT_TICKS \
   ((uint8_t)((SAFETY_TIMEOUT_MS + (SAFETY_TASK_PERIOD_MS - 1u)) / SAFETY_TASK_PERIOD_MS))
@@ -146,9 +158,9 @@ void Swc_SafetyManager_Init(void)
   s_safety.inited = FALSE;
   Safety_Seed(); /* seed mặc định an toàn */
 
-  printf("SafetyManager: init done, throttle=%d, gear=%d, mode=%d, brake=%d\n",
-         s_safety.lastSafe.throttle_pct, s_safety.lastSafe.gear,
-         s_safety.lastSafe.driveMode, s_safety.lastSafe.brakeActive);
+  LOG("SafetyManager: init done, throttle=%d, gear=%d, mode=%d, brake=%d\n",
+      s_safety.lastSafe.throttle_pct, s_safety.lastSafe.gear,
+      s_safety.lastSafe.driveMode, s_safety.lastSafe.brakeActive);
 }
 
 void Swc_SafetyManager_Run10ms(void)
@@ -157,16 +169,20 @@ void Swc_SafetyManager_Run10ms(void)
     Safety_Seed();
   }
 
-  /* 1) Đọc nguồn dữ liệu từ RTE */
-  uint8_t     pedalPctTmp;
-  boolean     brakeTmp;
-  Gear_e      gearTmp;
-  DriveMode_e modeTmp;
+  /* 1) Đọc nguồn dữ liệu từ RTE (implicit: ảnh chụp của task) */
+  uint8_t     pedalPctTmp = Rte_IRead_SafetyManager_PedalOut();
+  boolean     brakeTmp    = Rte_IRead_SafetyManager_BrakeOut();
+  Gear_e      gearTmp     = Rte_IRead_SafetyManager_GearOut();
+  DriveMode_e modeTmp     = Rte_IRead_SafetyManager_DriveModeOut();
+
+  uint32_t    pedalAge    = 0u;
+  boolean     pedalAgeOk  = (Rte_Call_SafetyManager_IoHwAb_Pedal_GetSampleAge(&pedalAge) == E_OK);
 
-  boolean havePedal = (Rte_Read_SafetyManager_PedalOut(&pedalPctTmp) == E_OK);
-  boolean haveBrake = (Rte_Read_SafetyManager_BrakeOut(&brakeTmp)   == E_OK);
-  boolean haveGear  = (Rte_Read_SafetyManager_GearOut(&gearTmp)     == E_OK);
-  boolean haveMode  = (Rte_Read_SafetyManager_DriveModeOut(&modeTmp)== E_OK);
+  boolean havePedal = (Rte_IStatus_SafetyManager_PedalOut()    == E_OK) &&
+                      pedalAgeOk && (pedalAge <= SAFETY_PEDAL_MAX_AGE_MS);
+  boolean haveBrake = (Rte_IStatus_SafetyManager_BrakeOut()    == E_OK);
+  boolean haveGear  = (Rte_IStatus_SafetyManager_GearOut()     == E_OK);
+  boolean haveMode  = (Rte_IStatus_SafetyManager_DriveModeOut()== E_OK);
 
   /* 2) Quản lý timeout nguồn dữ liệu */
   s_safety.missPedal = (havePedal ? 0u : (uint8_t)((s_safety.missPedal < 0xFFu) ? s_safety.missPedal + 1u : 0xFFu));
@@ -174,7 +190,9 @@ void Swc_SafetyManager_Run10ms(void)
   s_safety.missGear  = (haveGear  ? 0u : (uint8_t)((s_safety.missGear  < 0xFFu) ? s_safety.missGear  + 1u : 0xFFu));
   s_safety.missMode  = (haveMode  ? 0u : (uint8_t)((s_safety.missMode  < 0xFFu) ? s_safety.missMode  + 1u : 0xFFu));
 
-  const boolean pedalTimeout = (s_safety.missPedal >= SAFETY_TIMEOUT_TICKS);
+  /* Pedal: tuổi mẫu đo thẳng thời gian → đúng cả khi runnable chạy thưa (RTE sự kiện) */
+  const boolean pedalTimeout = (s_safety.missPedal >= SAFETY_TIMEOUT_TICKS) ||
+                               (pedalAgeOk && (pedalAge >= SAFETY_TIMEOUT_MS));
   const boolean brakeTimeout = (s_safety.missBrake >= SAFETY_TIMEOUT_TICKS);
   const boolean gearTimeout  = (s_safety.missGear  >= SAFETY_TIMEOUT_TICKS);
   const boolean modeTimeout  = (s_safety.missMode  >= SAFETY_TIMEOUT_TICKS);
@@ -199,7 +217,7 @@ void Swc_SafetyManager_Run10ms(void)
   out.gear         = safeGear;
   out.driveMode    = reqMode;
 
-  (void)Rte_Write_SafetyManager_SafeOut(&out);
+  Rte_IWrite_SafetyManager_SafeOut(&out);
 
   /* 6) Lưu lại bản “an toàn” làm tham chiếu cho chu kỳ sau */
   s_safety.lastSafe = out;
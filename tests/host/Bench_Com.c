@@ -0,0 +1,187 @@
+/**********************************************************
+ * @file    Bench_Com.c
+ * @brief   Benchmark pack/unpack COM trên một bộ I-PDU cỡ DBC
+ * @details Biên dịch Com.c ngay trong file này. Sinh 60 I-PDU 8 byte
+ *          (cỡ một bus CAN đầy), mỗi I-PDU lấp kín 64 bit bằng các
+ *          signal dài 1..32 bit, Intel hoặc Motorola, vị trí lệch byte.
+ *          Layout tính bằng prv_build_layout() (như Com_Init) trên
+ *          I-PDU 8 byte của cấu hình test rồi trỏ sang buffer từng
+ *          I-PDU. Đo ns/signal và ns/I-PDU:
+ *          - pack: prv_to_raw + prv_pack (Com_SendSignal không vùng găng)
+ *          - unpack: prv_unpack + prv_from_raw (Com_ReceiveSignal)
+ *          - tham chiếu: pack/unpack từng bit (cách put_bit cũ, tổng
+ *            quát hoá cho mọi độ dài).
+ *          Sau mỗi vòng, mọi signal được đọc lại và đối chiếu giá trị.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "../../bsw/communication/com/Com.c"
+
+#define BENCH_PDUS          60u
+#define BENCH_PDU_LEN       8u
+#define BENCH_MAX_SIGNALS   (BENCH_PDUS * 64u)
+#define BENCH_ROUNDS        2000u
+
+static uint8_t bench_cfg_buf[BENCH_PDU_LEN];
+
+const Com_IPduCfgType Com_IPduCfg[COM_NUM_IPDUS] =
+{
+    [0] = { .PduId = 0u, .Length = BENCH_PDU_LEN, .direction = COM_PDU_DIR_TX, .buffer = bench_cfg_buf },
+    [1] = { .PduId = 1u, .Length = BENCH_PDU_LEN, .direction = COM_PDU_DIR_RX, .buffer = bench_cfg_buf }
+};
+
+void Os_Posix_DisableIrq(void) {}
+void Os_Posix_EnableIrq(void) {}
+
+static uint8_t              bench_pdu[BENCH_PDUS][BENCH_PDU_LEN];
+static Com_SignalCfgType    bench_cfg[BENCH_MAX_SIGNALS];
+static Com_SignalLayoutType bench_layout[BENCH_MAX_SIGNALS];
+static uint32_t             bench_value[BENCH_MAX_SIGNALS];
+static uint32_t             bench_nsig;
+static volatile uint32_t    bench_sink;
+
+/* Lấp kín mỗi I-PDU; Motorola cấp phát theo chỉ số bit Motorola
+ * (7 - byte)*8 + bit để các signal không chồng nhau */
+static void bench_build(void)
+{
+    for (uint32_t p = 0u; p < BENCH_PDUS; p++) {
+        const boolean motorola = ((p % 3u) == 2u);
+        uint32_t c = 0u;
+        while (c < 64u) {
+            uint32_t len = 1u + (Test_Rand() % (((Test_Rand() & 3u) == 0u) ? 32u : 12u));
+            if ((c + len) > 64u) {
+                len = 64u - c;
+            }
+            Com_SignalCfgType *cfg = &bench_cfg[bench_nsig];
+            cfg->PduId       = 0u;
+            cfg->bitLength   = (uint8_t)len;
+            cfg->endianness  = motorola ? COM_BIG_ENDIAN : COM_LITTLE_ENDIAN;
+            cfg->bitPosition = motorola ? (uint16_t)(((7u - (c >> 3)) * 8u) + (c & 7u)) : (uint16_t)c;
+            cfg->type        = (len <= 8u) ? COM_SIGTYPE_UINT8 : (len <= 16u) ? COM_SIGTYPE_UINT16
+                                                                               : COM_SIGTYPE_UINT32;
+            cfg->direction   = COM_PDU_DIR_TX;
+            TEST_CHECK(prv_build_layout(cfg, &bench_layout[bench_nsig]) == TRUE);
+            bench_layout[bench_nsig].pdu = bench_pdu[p];
+            bench_nsig++;
+            c += len;
+        }
+    }
+}
+
+/* Tham chiếu từng bit, cùng quy ước vị trí như test_ref_pack (Test_Com.c) */
+static void bench_bit_pack(uint8_t *pdu, const Com_SignalCfgType *cfg, uint64_t raw)
+{
+    const boolean motorola = (cfg->endianness == COM_BIG_ENDIAN);
+    for (uint8_t i = 0u; i < cfg->bitLength; i++) {
+        const uint32_t pos  = (cfg->bitPosition & 7u) + i;
+        const uint32_t byte = motorola ? ((cfg->bitPosition >> 3) - (pos >> 3)) : ((cfg->bitPosition >> 3) + (pos >> 3));
+        const uint8_t  bit  = (uint8_t)(1u << (pos & 7u));
+        pdu[byte] = ((raw >> i) & 1u) ? (uint8_t)(pdu[byte] | bit) : (uint8_t)(pdu[byte] & (uint8_t)~bit);
+    }
+}
+
+static uint64_t bench_bit_unpack(const uint8_t *pdu, const Com_SignalCfgType *cfg)
+{
+    const boolean motorola = (cfg->endianness == COM_BIG_ENDIAN);
+    uint64_t raw = 0u;
+    for (uint8_t i = 0u; i < cfg->bitLength; i++) {
+        const uint32_t pos  = (cfg->bitPosition & 7u) + i;
+        const uint32_t byte = motorola ? ((cfg->bitPosition >> 3) - (pos >> 3)) : ((cfg->bitPosition >> 3) + (pos >> 3));
+        raw |= (uint64_t)((pdu[byte] >> (pos & 7u)) & 1u) << i;
+    }
+    return raw;
+}
+
+static void bench_new_values(uint32_t r)
+{
+    for (uint32_t s = 0u; s < bench_nsig; s++) {
+        bench_value[s] = (uint32_t)((Test_Rand() + r) & bench_layout[s].mask);
+    }
+}
+
+static uint32_t bench_verify(void)
+{
+    uint32_t bad = 0u;
+    for (uint32_t s = 0u; s < bench_nsig; s++) {
+        if (bench_bit_unpack(bench_layout[s].pdu, &bench_cfg[s]) != bench_value[s]) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+static void bench_report(const char *what, uint64_t ns)
+{
+    const double sig = (double)ns / ((double)BENCH_ROUNDS * bench_nsig);
+    printf("[bench] com %-18s %6.2f ns/signal, %7.1f ns/I-PDU\n", what, sig,
+           sig * bench_nsig / BENCH_PDUS);
+}
+
+int main(void)
+{
+    uint64_t tPack = 0u, tUnpack = 0u, tBitPack = 0u, tBitUnpack = 0u;
+    uint32_t badPack = 0u, badUnpack = 0u, badBit = 0u;
+
+    bench_build();
+    printf("[bench] com %u I-PDU x %u byte, %u signal\n", (unsigned)BENCH_PDUS,
+           (unsigned)BENCH_PDU_LEN, (unsigned)bench_nsig);
+
+    for (uint32_t r = 0u; r < BENCH_ROUNDS; r++) {
+        uint64_t t0;
+        uint32_t acc = 0u;
+
+        /* Bảng layout */
+        bench_new_values(r);
+        t0 = Test_NowNs();
+        for (uint32_t s = 0u; s < bench_nsig; s++) {
+            const Com_SignalLayoutType *l = &bench_layout[s];
+            const uint8_t  u8  = (uint8_t)bench_value[s];
+            const uint16_t u16 = (uint16_t)bench_value[s];
+            const void *src = (bench_cfg[s].type == COM_SIGTYPE_UINT8)  ? (const void *)&u8 :
+                              (bench_cfg[s].type == COM_SIGTYPE_UINT16) ? (const void *)&u16 :
+                                                                          (const void *)&bench_value[s];
+            prv_pack(l->pdu, l, prv_to_raw(&bench_cfg[s], src));
+        }
+        tPack += Test_NowNs() - t0;
+        badPack += bench_verify();
+
+        t0 = Test_NowNs();
+        for (uint32_t s = 0u; s < bench_nsig; s++) {
+            uint32_t v = 0u;
+            prv_from_raw(&bench_cfg[s], prv_unpack(bench_layout[s].pdu, &bench_layout[s]), &v);
+            acc += v;
+            badUnpack += (v != bench_value[s]) ? 1u : 0u;
+        }
+        tUnpack += Test_NowNs() - t0;
+
+        /* Tham chiếu từng bit */
+        bench_new_values(r);
+        t0 = Test_NowNs();
+        for (uint32_t s = 0u; s < bench_nsig; s++) {
+            bench_bit_pack(bench_layout[s].pdu, &bench_cfg[s], bench_value[s]);
+        }
+        tBitPack += Test_NowNs() - t0;
+        badBit += bench_verify();
+
+        t0 = Test_NowNs();
+        for (uint32_t s = 0u; s < bench_nsig; s++) {
+            acc += (uint32_t)bench_bit_unpack(bench_layout[s].pdu, &bench_cfg[s]);
+        }
+        tBitUnpack += Test_NowNs() - t0;
+        bench_sink = acc;
+    }
+
+    bench_report("layout pack", tPack);
+    bench_report("layout unpack", tUnpack);
+    bench_report("bit-loop pack", tBitPack);
+    bench_report("bit-loop unpack", tBitUnpack);
+    TEST_CHECK_EQ(badPack, 0u);
+    TEST_CHECK_EQ(badUnpack, 0u);
+    TEST_CHECK_EQ(badBit, 0u);
+
+    Test_Exit("Com bench");
+    return 0;
+}
@@ -0,0 +1,243 @@
+/**********************************************************
+ * @file    Bench_ComStack.c
+ * @brief   Benchmark ns/frame CanIf → PduR → COM theo số mục định tuyến
+ * @details Biên dịch Com.c, PduR.c, CanIf.c ngay trong file này với
+ *          giới hạn cấu hình nâng lên 64 (COM_NUM_IPDUS, bảng PduR,
+ *          CANIF_MAX_*) và bảng cấu hình riêng của benchmark
+ *          (Com_IPduCfg, PduR_Config được đổi tên bằng macro), để so
+ *          cùng một đường code với bus 2 message và bus 60 message:
+ *          - RX: CanIf_RxIndication (ISR) + CanIf_MainFunctionRx:
+ *            prv_find_by_canid (tìm nhị phân RxRouteByCanId) →
+ *            PduR_CanIfRxIndication (bảng theo PduId) →
+ *            Com_RxIndication (prv_get_pdu_buf).
+ *          - TX: PduR_ComTransmit → CanIf_Transmit (TxRouteIdx) →
+ *            Can_Write (giả lập, xác nhận ngay như ISR TX) →
+ *            CanIf_TxConfirmation → PduR → Com_TxConfirmation.
+ *          - Tham chiếu: quét tuyến tính bảng định tuyến theo CAN ID
+ *            mỗi frame (cách cũ của CanIf_RxIndication).
+ *          CAN ID ngẫu nhiên, bảng định tuyến không sắp; mỗi frame RX
+ *          được đối chiếu với buffer I-PDU COM đích, mỗi frame TX với
+ *          số lần txNotification.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Com.h"
+#include "CanIf.h"
+#include "CanIf_Cfg.h"
+#include "PduR_Cfg.h"
+
+#define BENCH_MAX_MSGS      64u
+#undef  COM_NUM_IPDUS
+#define COM_NUM_IPDUS       BENCH_MAX_MSGS
+#undef  PDUR_NUM_CAN_RX_ROUTES
+#define PDUR_NUM_CAN_RX_ROUTES  BENCH_MAX_MSGS
+#undef  PDUR_NUM_CAN_TX_ROUTES
+#define PDUR_NUM_CAN_TX_ROUTES  BENCH_MAX_MSGS
+#undef  CANIF_MAX_TX_PDUS
+#define CANIF_MAX_TX_PDUS   BENCH_MAX_MSGS
+#undef  CANIF_MAX_RX_PDUS
+#define CANIF_MAX_RX_PDUS   BENCH_MAX_MSGS
+#undef  CANIF_MAX_ROUTING_ENTRIES
+#define CANIF_MAX_ROUTING_ENTRIES  BENCH_MAX_MSGS
+
+#define Com_IPduCfg         Bench_ComIPduCfg
+#define PduR_Config         Bench_PduRConfig
+static Com_IPduCfgType   Bench_ComIPduCfg[COM_NUM_IPDUS];
+static PduR_PBConfigType Bench_PduRConfig;
+
+#include "../../bsw/communication/com/Com.c"
+#include "../../bsw/communication/pdur/PduR.c"
+#include "../../bsw/communication/canif/CanIf.c"
+
+#define BENCH_FRAMES        1000000u
+#define BENCH_BATCH         16u     /* frame mỗi lần CanIf_MainFunctionRx */
+
+void Os_Posix_DisableIrq(void) {}
+void Os_Posix_EnableIrq(void) {}
+
+static uint8_t              bench_buf[BENCH_MAX_MSGS][8];
+static PduR_Route_1to1_Type bench_comTx[BENCH_MAX_MSGS];
+static PduR_Route_1to1_Type bench_canRx[BENCH_MAX_MSGS];
+static PduR_Route_1to1_Type bench_canTx[BENCH_MAX_MSGS];
+static CanIf_RoutingEntry   bench_routes[BENCH_MAX_MSGS];
+static Can_IdType           bench_rxIds[BENCH_MAX_MSGS];
+static PduIdType            bench_rxCom[BENCH_MAX_MSGS];
+static PduIdType            bench_txCom[BENCH_MAX_MSGS];
+static uint32_t             bench_numRx;
+static uint32_t             bench_numTx;
+static uint32_t             bench_txNotif;
+
+/* CanDrv giả lập: frame lên bus ngay → TxConfirmation như ISR TX */
+Std_ReturnType Can_Write(Can_HwHandleType Hth, const Can_PduType* PduInfo)
+{
+    (void)Hth;
+    CanIf_TxConfirmation(PduInfo->swPduHandle);
+    return E_OK;
+}
+
+static void bench_tx_notification(void)
+{
+    bench_txNotif++;
+}
+
+static boolean bench_id_used(Can_IdType id, uint32_t n)
+{
+    for (uint32_t i = 0u; i < n; i++) {
+        if (bench_routes[i].CanId == id) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* n message: chẵn = RX, lẻ = TX; COM PduId = thứ tự message */
+static void bench_configure(uint32_t n)
+{
+    const PduR_Route_1to1_Type none = PDUR_NO_ROUTE;
+
+    memset(Bench_ComIPduCfg, 0, sizeof(Bench_ComIPduCfg));
+    for (uint32_t i = 0u; i < BENCH_MAX_MSGS; i++) {
+        Bench_ComIPduCfg[i].PduId = PDUR_INVALID_PDUID;
+        bench_comTx[i] = none;
+        bench_canRx[i] = none;
+        bench_canTx[i] = none;
+    }
+    bench_numRx = 0u;
+    bench_numTx = 0u;
+    for (uint32_t i = 0u; i < n; i++) {
+        Can_IdType id;
+        do {
+            id = (Can_IdType)(Test_Rand() & 0x7FFu);
+        } while (bench_id_used(id, i));
+
+        Com_IPduCfgType *c = &Bench_ComIPduCfg[i];
+        c->PduId  = (PduIdType)i;
+        c->Length = 8u;
+        c->buffer = bench_buf[i];
+        bench_routes[i].CanId = id;
+        bench_routes[i].Hth   = 0u;
+        if ((i & 1u) == 0u) {
+            const PduIdType r = (PduIdType)bench_numRx;
+            c->direction = COM_PDU_DIR_RX;
+            bench_routes[i].id   = r;
+            bench_routes[i].isTX = 0u;
+            bench_canRx[r] = (PduR_Route_1to1_Type){ .srcPduId = r, .desPduId = (PduIdType)i };
+            bench_rxIds[r] = id;
+            bench_rxCom[r] = (PduIdType)i;
+            bench_numRx++;
+        } else {
+            const PduIdType t = (PduIdType)bench_numTx;
+            c->direction      = COM_PDU_DIR_TX;
+            c->txNotification = bench_tx_notification;
+            bench_routes[i].id   = t;
+            bench_routes[i].isTX = 1u;
+            bench_comTx[i] = (PduR_Route_1to1_Type){ .srcPduId = (PduIdType)i, .desPduId = t };
+            bench_canTx[t] = (PduR_Route_1to1_Type){ .srcPduId = t, .desPduId = (PduIdType)i };
+            bench_txCom[t] = (PduIdType)i;
+            bench_numTx++;
+        }
+    }
+
+    Bench_PduRConfig.ComTxRoutingTable   = bench_comTx;
+    Bench_PduRConfig.CanIfRxRoutingTable = bench_canRx;
+    Bench_PduRConfig.CanIfTxRoutingTable = bench_canTx;
+    PduR_State = PDUR_UNINIT;
+    PduR_Init(&Bench_PduRConfig);
+
+    /* Phần dữ liệu của CanIf_Init (không gọi CanDrv/bộ lọc thật) */
+    numTxPdus = (uint8_t)bench_numTx;
+    numRxPdus = (uint8_t)bench_numRx;
+    numRoutingEntries = (uint8_t)n;
+    routingTable = bench_routes;
+    prv_build_route_index();
+    for (uint32_t i = 0u; i < CANIF_MAX_TX_PDUS; i++) {
+        TxPduMode[i] = CANIF_ONLINE;
+    }
+    rxIndicationCallback   = PduR_CanIfRxIndication;
+    txConfirmationCallback = PduR_CanIfTxConfirmation;
+    rxRingTail = rxRingHead;
+}
+
+/* Cách cũ: duyệt bảng định tuyến mỗi frame */
+static int32_t bench_linear_find(Can_IdType id)
+{
+    for (uint32_t i = 0u; i < numRoutingEntries; i++) {
+        if ((routingTable[i].isTX == 0u) && (routingTable[i].CanId == id)) {
+            return (int32_t)routingTable[i].id;
+        }
+    }
+    return -1;
+}
+
+static void bench_run(uint32_t n)
+{
+    uint8_t data[8] = { 0 };
+    PduInfoType info = { .SduDataPtr = data, .SduLength = 8u };
+    Can_HwType hw = { 0 };
+    uint32_t badRx = 0u;
+    uint32_t badLin = 0u;
+    uint64_t t0, tRx, tTx, tLin;
+    volatile int32_t sink = 0;
+
+    bench_configure(n);
+
+    /* RX: lô BENCH_BATCH frame rồi main function, như ISR + Task_Com */
+    t0 = Test_NowNs();
+    for (uint32_t f = 0u; f < BENCH_FRAMES; f += BENCH_BATCH) {
+        for (uint32_t k = 0u; k < BENCH_BATCH; k++) {
+            const uint32_t r = (f + k) % bench_numRx;
+            hw.CanId = bench_rxIds[r];
+            data[0] = (uint8_t)(f + k);
+            CanIf_RxIndication(&hw, &info);
+        }
+        CanIf_MainFunctionRx();
+        /* frame cuối của lô phải nằm trong buffer COM của message đó */
+        const uint32_t last = (f + BENCH_BATCH - 1u) % bench_numRx;
+        if (bench_buf[bench_rxCom[last]][0] != (uint8_t)(f + BENCH_BATCH - 1u)) {
+            badRx++;
+        }
+    }
+    tRx = Test_NowNs() - t0;
+
+    /* TX + TxConfirmation */
+    bench_txNotif = 0u;
+    t0 = Test_NowNs();
+    for (uint32_t f = 0u; f < BENCH_FRAMES; f++) {
+        (void)PduR_ComTransmit(bench_txCom[f % bench_numTx], &info);
+    }
+    tTx = Test_NowNs() - t0;
+
+    /* Tham chiếu: chỉ phần tra CAN ID, quét tuyến tính */
+    t0 = Test_NowNs();
+    for (uint32_t f = 0u; f < BENCH_FRAMES; f++) {
+        const uint32_t r = f % bench_numRx;
+        const int32_t pdu = bench_linear_find(bench_rxIds[r]);
+        badLin += (pdu != (int32_t)r) ? 1u : 0u;
+        sink = pdu;
+    }
+    tLin = Test_NowNs() - t0;
+    (void)sink;
+
+    printf("[bench] comstack %2u msg (%2u RX/%2u TX): RX %6.1f ns/frame, TX+conf %6.1f ns/frame,"
+           " linear RX lookup %6.1f ns/frame\n",
+           (unsigned)n, (unsigned)bench_numRx, (unsigned)bench_numTx,
+           (double)tRx / BENCH_FRAMES, (double)tTx / BENCH_FRAMES, (double)tLin / BENCH_FRAMES);
+    TEST_CHECK_EQ(badRx, 0u);
+    TEST_CHECK_EQ(badLin, 0u);
+    TEST_CHECK_EQ(bench_txNotif, BENCH_FRAMES);
+    TEST_CHECK_EQ(rxRingDrops, 0u);
+}
+
+int main(void)
+{
+    static const uint32_t sizes[] = { 2u, 8u, 30u, 60u };
+
+    for (uint32_t i = 0u; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        bench_run(sizes[i]);
+    }
+    Test_Exit("ComStack bench");
+    return 0;
+}
@@ -0,0 +1,135 @@
+/**********************************************************
+ * @file    Bench_OsAlarm.c
+ * @brief   Benchmark min-heap alarm (Os_Alarm.c) theo số alarm N
+ * @details Biên dịch Os_Alarm.c ngay trong file này với OS_MAX_ALARMS
+ *          lớn hơn cấu hình thật để đo trực tiếp các hàm static:
+ *          - heap_insert + heap_remove một alarm khi heap đã có N-1
+ *            alarm (Set/CancelAlarm không tính vùng găng).
+ *          - Chi phí mỗi tick: IncrementCounter(0) → os_alarm_tick()
+ *            với N alarm chu kỳ ngẫu nhiên 10..1000 tick (ns/tick,
+ *            kèm số alarm tới hạn trung bình mỗi tick).
+ *          - Tham chiếu: quét tuyến tính toàn bảng mỗi tick (cách cũ).
+ *          Số lần kích task được đối chiếu với số lần tới hạn tính
+ *          trước → benchmark cũng kiểm tra tính đúng.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os_Cfg.h"
+#undef  OS_MAX_ALARMS
+#define OS_MAX_ALARMS           250u
+#include "../../bsw/services/os/src/Os_Alarm.c"
+
+#define BENCH_TICKS             200000u
+#define BENCH_HEAP_OPS          200000u
+
+static uint32_t activations;
+static volatile uint32_t sink;
+
+/* Vùng găng rỗng: trên Cortex-M3 là CPSID/CPSIE, không đáng kể */
+void Os_Posix_DisableIrq(void) {}
+void Os_Posix_EnableIrq(void) {}
+
+StatusType ActivateTask(TaskType tid)
+{
+    (void)tid;
+    activations++;
+    return E_OK;
+}
+
+StatusType SetEvent(TaskType tid, EventMaskType mask)
+{
+    (void)tid;
+    (void)mask;
+    activations++;
+    return E_OK;
+}
+
+static void bench_reset(void)
+{
+    Os_Alarm_Init();
+    for (uint32_t i = 0u; i < OS_MAX_ALARMS; i++) {
+        alarm_tbl[i].counter        = &Counter_tbl[0];
+        alarm_tbl[i].action_type    = ALARMACTION_ACTIVATETASK;
+        alarm_tbl[i].action.task_id = TASK_A;
+    }
+}
+
+/* Quét tuyến tính: so Expiry_tick của mọi alarm active mỗi tick */
+static uint32_t bench_linear_tick(uint32_t n, TickType now)
+{
+    uint32_t hit = 0u;
+    for (uint32_t i = 0u; i < n; i++) {
+        if ((alarm_tbl[i].active != 0u) && (alarm_tbl[i].Expiry_tick == now)) {
+            hit++;
+        }
+    }
+    return hit;
+}
+
+static void bench_run(uint32_t n)
+{
+    uint64_t expected = 0u;
+    uint64_t t0;
+    double   ns_heap, ns_tick, ns_linear;
+
+    /* 1) N alarm chu kỳ ngẫu nhiên; số lần tới hạn trong BENCH_TICKS */
+    bench_reset();
+    for (uint32_t i = 0u; i < n; i++) {
+        TickType cycle  = 10u + (Test_Rand() % 991u);
+        TickType offset = 1u + (Test_Rand() % cycle);
+        TEST_CHECK_EQ(SetRelAlarm((AlarmType)i, offset, cycle), E_OK);
+        expected += (offset <= BENCH_TICKS) ? (1u + ((BENCH_TICKS - offset) / cycle)) : 0u;
+    }
+
+    /* 2) Chi phí mỗi tick (đường ISR thật) */
+    activations = 0u;
+    t0 = Test_NowNs();
+    for (uint32_t t = 0u; t < BENCH_TICKS; t++) {
+        (void)IncrementCounter(0);
+    }
+    ns_tick = (double)(Test_NowNs() - t0) / BENCH_TICKS;
+    TEST_CHECK_EQ(activations, expected);
+
+    /* 3) Tham chiếu quét tuyến tính trên cùng bảng */
+    t0 = Test_NowNs();
+    for (uint32_t t = 0u; t < BENCH_TICKS; t++) {
+        sink += bench_linear_tick(n, (TickType)t);
+    }
+    ns_linear = (double)(Test_NowNs() - t0) / BENCH_TICKS;
+
+    /* 4) insert + remove khi heap có N-1 alarm */
+    if (n > 0u) {
+        const AlarmType probe = (AlarmType)(n - 1u);
+        (void)CancelAlarm(probe);
+        OsAlarmCtl *a = &alarm_tbl[probe];
+        TickType base = Counter_tbl[0].ticks_total;
+        t0 = Test_NowNs();
+        for (uint32_t k = 0u; k < BENCH_HEAP_OPS; k++) {
+            a->Expiry_tick = base + 1u + (Test_Rand() % 1000u);
+            heap_insert(0, probe);
+            heap_remove(0, probe);
+        }
+        ns_heap = (double)(Test_NowNs() - t0) / BENCH_HEAP_OPS;
+        TEST_CHECK_EQ(heap_len[0], n - 1u);
+    } else {
+        ns_heap = 0.0;
+    }
+
+    printf("[bench] alarm N=%3u: insert+remove %6.1f ns, tick %6.1f ns "
+           "(%.3f expiries/tick), linear scan %6.1f ns/tick\n",
+           (unsigned)n, ns_heap, ns_tick, (double)expected / BENCH_TICKS, ns_linear);
+}
+
+int main(void)
+{
+    static const uint32_t sizes[] = { 4u, 16u, 64u, 128u, OS_MAX_ALARMS };
+
+    for (uint32_t i = 0u; i < (sizeof(sizes) / sizeof(sizes[0])); i++) {
+        bench_run(sizes[i]);
+    }
+    Test_Exit("OsAlarm bench");
+    return 0;
+}
@@ -0,0 +1,235 @@
+/**********************************************************
+ * @file    Bench_OsIoc.c
+ * @brief   Benchmark Ioc_Write/Ioc_Read trên kênh unqueued và queued
+ * @details Không cần OS (SetEvent rỗng). Đo ns/bản tin trên host:
+ *          - Safe (Safe_s, unqueued): IocWrite + IocRead.
+ *          - Speed (uint16_t, queued depth 4, 2 receiver): IocSend +
+ *            IocReceive của cả hai receiver.
+ *          - Speed zero-copy: IocSendBegin/Commit + Peek/Release.
+ *          - Tham chiếu: bản sao ring uint16 cũ (Ioc_Send/Ioc_Receive
+ *            trước kênh typed, vùng găng PRIMASK, WaitEvent/GetEvent/
+ *            ClearEvent trong Ioc_Receive) cùng 1 send + 2 receiver,
+ *            in cạnh kênh queued để so tốc độ.
+ *          Os_Ioc.c được biên dịch ngay trong file này với __DMB() là
+ *          hàng rào compiler: bản host của __DMB() là fence seq_cst
+ *          (mfence, hàng chục ns) trong khi DMB trên Cortex-M3 chỉ vài
+ *          chu kỳ, như CPSID/CPSIE của ring cũ; benchmark chạy một luồng
+ *          nên không cần hàng rào CPU. Vùng găng và API event là hàm
+ *          rỗng. Mỗi vòng kiểm tra giá trị đọc được để trình biên dịch
+ *          không bỏ phép đo và để phát hiện sai dữ liệu.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "Os_Ioc_Cfg.h"
+#undef  __DMB
+#define __DMB() __asm volatile ("" ::: "memory")
+#include "../../bsw/services/os/src/Os_Ioc.c"
+#undef  __DMB
+
+#define BENCH_MSGS      2000000u
+
+/* Kích thước của ring cũ (Os_Cfg.h trước kênh typed) */
+#define BENCH_OLD_BUFFER_SIZE   4u
+#define BENCH_OLD_CHANNELS      1u
+
+StatusType SetEvent(TaskType tid, EventMaskType mask)
+{
+    (void)tid;
+    (void)mask;
+    return E_OK;
+}
+
+StatusType WaitEvent(EventMaskType mask)
+{
+    (void)mask;
+    return E_OK;
+}
+
+StatusType GetEvent(TaskType tid, EventMaskType *ev)
+{
+    (void)tid;
+    *ev = EV_RX;
+    return E_OK;
+}
+
+StatusType ClearEvent(EventMaskType mask)
+{
+    (void)mask;
+    return E_OK;
+}
+
+void Os_Posix_DisableIrq(void) {}
+void Os_Posix_EnableIrq(void) {}
+
+/* =========================================================
+ * Ring uint16 cũ (OsIocCtrl + Ioc_Send/Ioc_Receive), chép nguyên
+ * logic; chỉ đổi tên để cùng link với Os_Ioc.c mới.
+ * =======================================================*/
+typedef struct
+{
+    uint8_t used;
+    uint8_t num_receivers;
+    TaskType receivers[4];
+    uint8_t head, count;
+    uint16_t buffer[BENCH_OLD_CHANNELS][BENCH_OLD_BUFFER_SIZE];
+    uint8_t tail[4];
+} Bench_OldIocCtrl;
+
+static Bench_OldIocCtrl bench_old_chan[BENCH_OLD_CHANNELS];
+
+static void bench_old_init(uint8_t channel, uint8_t num, TaskType* receivers)
+{
+  if(channel >= BENCH_OLD_CHANNELS || !receivers) return;
+
+  bench_old_chan[channel].used = 1;
+  bench_old_chan[channel].num_receivers = num;
+  bench_old_chan[channel].head = 0;
+  bench_old_chan[channel].count = 0;
+
+  for(int i=0; i<num; i++) {
+    bench_old_chan[channel].receivers[i] = receivers[i];
+    bench_old_chan[channel].tail[i] = 0;
+  }
+}
+
+static uint8_t bench_old_send(uint8_t channel, uint16_t* data)
+{
+  if (channel >= BENCH_OLD_CHANNELS || !bench_old_chan[channel].used|| !data) return -1;
+    Bench_OldIocCtrl *I = &bench_old_chan[channel];
+  __disable_irq();
+
+    I->buffer[channel][I->head] = *data;
+    I->head = (I->head + 1u) % BENCH_OLD_BUFFER_SIZE;
+
+    if(I->count < BENCH_OLD_BUFFER_SIZE) I->count++;
+    else {
+      for (int i=0; i<I->num_receivers; i++){
+        I->tail[i] = (I->tail[i] + 1u) % BENCH_OLD_BUFFER_SIZE;
+      }
+    }
+    __enable_irq();
+    for(int i=0; i<I->num_receivers; i++) {
+      SetEvent(I->receivers[i], EV_RX);
+    }
+    return 0;
+}
+
+static uint8_t bench_old_receive(uint8_t channel, uint16_t* data, TaskType receiver)
+{
+  if (channel >= BENCH_OLD_CHANNELS|| !bench_old_chan[channel].used || !receiver || !data)
+   return -1;
+
+  Bench_OldIocCtrl *I = &bench_old_chan[channel];
+  EventMaskType ev;
+
+  WaitEvent(EV_RX);
+  GetEvent(receiver, &ev);
+
+  if(ev & EV_RX){
+    if (I->tail[receiver] == I->head) { /* Buffer rỗng */
+      return -1;
+    }
+    ClearEvent(EV_RX);
+    __disable_irq();
+
+    *data = I->buffer[channel][I->tail[receiver]];
+    I->tail[receiver] = (I->tail[receiver] + 1u) % BENCH_OLD_BUFFER_SIZE;
+    __enable_irq();
+  }
+    return 0;
+}
+
+static void bench_report(const char *what, uint64_t ns, uint32_t bad)
+{
+    const double per = (double)ns / BENCH_MSGS;
+    printf("[bench] ioc %-28s %6.1f ns/msg (%6.1f Mmsg/s)\n", what, per, 1000.0 / per);
+    TEST_CHECK_EQ(bad, 0u);
+}
+
+int main(void)
+{
+    uint64_t t0;
+    uint32_t bad;
+
+    Ioc_Init();
+
+    /* 1) Unqueued, copy */
+    Safe_s in = { .throttle_pct = 0u, .gear = GEAR_D, .driveMode = DRIVEMODE_ECO,
+                  .brakeActive = FALSE };
+    Safe_s out;
+    bad = 0u;
+    t0 = Test_NowNs();
+    for (uint32_t i = 0u; i < BENCH_MSGS; i++) {
+        in.throttle_pct = (uint8_t)i;
+        (void)IocWrite_Safe(&in);
+        if ((IocRead_Safe(&out) != IOC_E_OK) || (out.throttle_pct != (uint8_t)i)) {
+            bad++;
+        }
+    }
+    bench_report("unqueued Safe_s write+read", Test_NowNs() - t0, bad);
+
+    /* 2) Queued, copy, 2 receiver */
+    uint16_t v;
+    bad = 0u;
+    t0 = Test_NowNs();
+    for (uint32_t i = 0u; i < BENCH_MSGS; i++) {
+        uint16_t k = (uint16_t)i;
+        if (IocSend_Speed(&k) != IOC_E_OK) {
+            bad++;
+        }
+        if ((IocReceive_Speed(IOC_RX_Speed_TASK_B, &v) != IOC_E_OK) || (v != k)) {
+            bad++;
+        }
+        if ((IocReceive_Speed(IOC_RX_Speed_TASK_C, &v) != IOC_E_OK) || (v != k)) {
+            bad++;
+        }
+    }
+    bench_report("queued uint16 send+2 recv", Test_NowNs() - t0, bad);
+
+    /* 2b) Tham chiếu: ring uint16 cũ, cùng 1 send + 2 receiver */
+    TaskType oldRx[2] = { TASK_B, TASK_C };
+    bench_old_init(0u, 2u, oldRx);
+    bad = 0u;
+    t0 = Test_NowNs();
+    for (uint32_t i = 0u; i < BENCH_MSGS; i++) {
+        uint16_t k = (uint16_t)i;
+        if (bench_old_send(0u, &k) != 0u) {
+            bad++;
+        }
+        if ((bench_old_receive(0u, &v, TASK_B) != 0u) || (v != k)) {
+            bad++;
+        }
+        if ((bench_old_receive(0u, &v, TASK_C) != 0u) || (v != k)) {
+            bad++;
+        }
+    }
+    bench_report("old uint16 Ioc_Send+2 Receive", Test_NowNs() - t0, bad);
+
+    /* 3) Queued, zero-copy */
+    bad = 0u;
+    t0 = Test_NowNs();
+    for (uint32_t i = 0u; i < BENCH_MSGS; i++) {
+        uint16_t *slot = IocSendBegin_Speed();
+        if (slot == NULL) {
+            bad++;
+            continue;
+        }
+        *slot = (uint16_t)i;
+        (void)IocSendCommit_Speed();
+        for (uint8_t rx = 0u; rx < 2u; rx++) {
+            const uint16_t *p = IocReceivePeek_Speed(rx);
+            if ((p == NULL) || (*p != (uint16_t)i)) {
+                bad++;
+            }
+            (void)IocReceiveRelease_Speed(rx);
+        }
+    }
+    bench_report("queued zero-copy send+2 recv", Test_NowNs() - t0, bad);
+
+    Test_Exit("OsIoc bench");
+    return 0;
+}
@@ -0,0 +1,77 @@
+/**********************************************************
+ * @file    Test.h
+ * @brief   Tiện ích tối giản cho test/benchmark host (make host-test)
+ * @details Mỗi tests/host/Test_*.c, Bench_*.c là một chương trình
+ *          Linux riêng, link cùng module cần thử (xem Makefile,
+ *          TEST_SRCS_<tên>):
+ *          - TEST_CHECK / TEST_CHECK_EQ: đếm kiểm tra, in vị trí lỗi
+ *            nhưng không dừng → một lần chạy báo mọi lỗi.
+ *          - Test_Exit(): in tổng kết, exit(1) nếu có lỗi. Gọi được
+ *            từ main() hoặc từ trong task (bản POSIX của OS).
+ *          - Test_NowNs(): đồng hồ CLOCK_MONOTONIC cho benchmark.
+ *          - Test_Rand(): xorshift32 có seed cố định → tái lập được.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#ifndef TEST_H
+#define TEST_H
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+static uint32_t test_checks;
+static uint32_t test_failed;
+
+#define TEST_CHECK(cond)                                                        \
+    do {                                                                        \
+        test_checks++;                                                          \
+        if (!(cond)) {                                                          \
+            test_failed++;                                                      \
+            printf("  FAIL %s:%d: %s\n", __FILE__, __LINE__, #cond);            \
+        }                                                                       \
+    } while (0)
+
+#define TEST_CHECK_EQ(a, b)                                                     \
+    do {                                                                        \
+        long long test_a_ = (long long)(a);                                     \
+        long long test_b_ = (long long)(b);                                     \
+        test_checks++;                                                          \
+        if (test_a_ != test_b_) {                                               \
+            test_failed++;                                                      \
+            printf("  FAIL %s:%d: %s == %s (%lld != %lld)\n",                   \
+                   __FILE__, __LINE__, #a, #b, test_a_, test_b_);               \
+        }                                                                       \
+    } while (0)
+
+static inline void Test_Exit(const char *name)
+{
+    printf("[test] %s: %u checks, %u failed\n", name,
+           (unsigned)test_checks, (unsigned)test_failed);
+    fflush(stdout);
+    exit((test_failed != 0u) ? 1 : 0);
+}
+
+static inline uint64_t Test_NowNs(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ((uint64_t)ts.tv_sec * 1000000000u) + (uint64_t)ts.tv_nsec;
+}
+
+static uint32_t test_rand_state = 0x2545F491u;
+
+static inline uint32_t Test_Rand(void)
+{
+    uint32_t x = test_rand_state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    test_rand_state = x;
+    return x;
+}
+
+#endif /* TEST_H */
@@ -0,0 +1,227 @@
+/**********************************************************
+ * @file    Test_AdcInj.c
+ * @brief   Test nhóm ADC ưu tiên trên chuỗi injected (Adc_Inj.c + Sim_Mcal.c)
+ * @details 1) Chạy cả ứng dụng host trong tiến trình con (như
+ *          Test_CanBusLoad.c), TEST_SIM_MS ms ảo, cấu hình ADC thật
+ *          (Adc_cfg.c: bàn đạp Priority 1 trên injected, TIM1 CC4); khi
+ *          OS dừng gửi Sim_GetAdcStats() + số bộ kết quả về qua pipe:
+ *          - kích timer (mặc định) và VCU_SIM_ADCSCAN=cont (chuỗi nền
+ *            chạy liên tục): mọi lần kích injected ra đúng một JEOC,
+ *            không kích nào bị bỏ (injected lẫn regular), số lần kích
+ *            khớp chu kỳ timer (kể cả kích ở nhịp cuối);
+ *          - mọi lần kích đều chen ngang một chuyển đổi regular (timer:
+ *            kích injected rơi vào cuối chuỗi nền, xem Adc_cfg.c; cont:
+ *            chuỗi nền luôn chạy);
+ *          - kích → JEOC <= ADC_INJ_MAX_CHANNELS × (InjSamplingTime +
+ *            12.5) chu kỳ ADCCLK, tính lại từ Adc_Configs ở đây (không
+ *            lấy cận của bộ giả lập).
+ *          2) Gọi thẳng Adc_Inj_Init/Sequence/OnJeoc/ReadGroup với bảng
+ *          Adc_GroupConfigs sửa tạm: nhóm Priority cao nhất thắng, bằng
+ *          Priority thì id nhỏ hơn; bỏ qua Priority 0, nhóm quá
+ *          ADC_INJ_MAX_CHANNELS kênh, nhóm ADC khác; chuỗi lặp kênh
+ *          cho đủ rank và trung bình làm tròn theo kênh.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "EcuM.h"
+#include "Log.h"
+#include "Adc_Cfg.h"
+#include "Sim_Mcal.h"
+#include <string.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define TEST_SIM_MS         2000u
+
+typedef struct {
+    Sim_AdcStatsType sim;
+    uint32_t injSeq;            /* Adc_Inj_GetCount() */
+    uint32_t scanSets;          /* Adc_Scan_GetCount() */
+} Test_AdcResultType;
+
+static int test_pipe = -1;
+
+/* Tiến trình con: gửi thống kê khi Os_Arch_Shutdown gọi exit() */
+static void test_send_stats(void)
+{
+    Test_AdcResultType r;
+
+    Sim_GetAdcStats(&r.sim);
+    r.injSeq = Adc_Inj_GetCount();
+    r.scanSets = Adc_Scan_GetCount();
+    if (write(test_pipe, &r, sizeof(r)) != (ssize_t)sizeof(r)) {
+        _exit(2);
+    }
+}
+
+static boolean test_run(const char *scan, Test_AdcResultType *r)
+{
+    int fd[2];
+    int status = 0;
+    char buf[16];
+
+    if (pipe(fd) != 0) {
+        return FALSE;
+    }
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fd[0]);
+        test_pipe = fd[1];
+        (void)freopen("/dev/null", "w", stdout);
+        (void)freopen("/dev/null", "w", stderr);
+        snprintf(buf, sizeof(buf), "%u", (unsigned)TEST_SIM_MS);
+        setenv("VCU_SIM_MS", buf, 1);
+        if (scan != NULL) {
+            setenv("VCU_SIM_ADCSCAN", scan, 1);
+        } else {
+            unsetenv("VCU_SIM_ADCSCAN");
+        }
+        atexit(test_send_stats);
+
+        /* như app/main.c */
+        Log_Init();
+        EcuM_Init();
+        (void)StartOS(OSDEFAULTAPPMODE);
+        _exit(3);
+    }
+    close(fd[1]);
+    const ssize_t n = read(fd[0], r, sizeof(*r));
+    close(fd[0]);
+    (void)waitpid(pid, &status, 0);
+    TEST_CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+    return (n == (ssize_t)sizeof(*r)) ? TRUE : FALSE;
+}
+
+/* ADC_INJ_MAX_CHANNELS × (InjSamplingTime + 12.5) chu kỳ ADCCLK = 72 MHz / prescaler, ra ns */
+static uint64_t test_inj_bound_ns(void)
+{
+    static const uint32_t smp_half_cycles[8] = { 3u, 15u, 27u, 57u, 83u, 111u, 143u, 479u };   /* 1.5 .. 239.5 */
+    const Adc_ConfigType *cfg = &Adc_Configs[0];
+
+    return ((uint64_t)ADC_INJ_MAX_CHANNELS * (smp_half_cycles[cfg->InjSamplingTime & 7u] + 25u) *
+            cfg->ClockPrescaler * 1000u) / (2u * 72u);
+}
+
+static void test_sequencer(const char *scan)
+{
+    Test_AdcResultType r;
+    const uint64_t bound = test_inj_bound_ns();
+    /* kích đầu tiên sau Adc_SyncTrigger đầu (nhịp Task_A), kích cuối trước TEST_SIM_MS */
+    const uint32_t minTrig = (TEST_SIM_MS / ADC_TRIG_TASK_PERIOD_MS) - 2u;
+
+    memset(&r, 0, sizeof(r));
+    TEST_CHECK(test_run(scan, &r) == TRUE);
+    printf("[test] adc inj (%s scan): %lu trigger(s), %lu JEOC, preempted %lu, lost %lu/%lu,"
+           " max trigger->JEOC %.2f us (bound %.2f us), %lu scan set(s)\n",
+           r.sim.regTimer ? "timer" : "continuous", (unsigned long)r.sim.injTriggers,
+           (unsigned long)r.injSeq, (unsigned long)r.sim.injPreempted, (unsigned long)r.sim.injLost,
+           (unsigned long)r.sim.regLost, r.sim.injMaxNs / 1000.0, bound / 1000.0,
+           (unsigned long)r.scanSets);
+
+    TEST_CHECK(r.sim.injTimer == TRUE);
+    TEST_CHECK_EQ(r.sim.injLen, ADC_INJ_MAX_CHANNELS);
+    TEST_CHECK(r.sim.injTriggers >= minTrig);
+    TEST_CHECK(r.sim.injTriggers <= ((TEST_SIM_MS / ADC_TRIG_TASK_PERIOD_MS) + 1u));
+    TEST_CHECK_EQ(r.injSeq, r.sim.injTriggers);
+    TEST_CHECK_EQ(r.sim.injLost, 0u);
+    TEST_CHECK_EQ(r.sim.regLost, 0u);
+    TEST_CHECK(r.sim.injMaxNs > 0u);
+    TEST_CHECK(r.sim.injMaxNs <= bound);
+    TEST_CHECK(r.scanSets > 0u);
+    TEST_CHECK_EQ(r.sim.injPreempted, r.sim.injTriggers);
+    TEST_CHECK(r.sim.regTimer == ((scan == NULL) ? TRUE : FALSE));
+}
+
+/* Nhóm chọn cho injected với (Priority, NumChannels, ADC) của hai nhóm; ADC_MAX_GROUPS = không có */
+static Adc_GroupType test_pick(Adc_GroupPriorityType p0, uint8_t n0, Adc_InstanceType i0,
+                               Adc_GroupPriorityType p1, uint8_t n1, Adc_InstanceType i1)
+{
+    Adc_GroupConfigs[0].Priority = p0;
+    Adc_GroupConfigs[0].NumChannels = n0;
+    Adc_GroupConfigs[0].AdcInstance = i0;
+    Adc_GroupConfigs[1].Priority = p1;
+    Adc_GroupConfigs[1].NumChannels = n1;
+    Adc_GroupConfigs[1].AdcInstance = i1;
+    TEST_CHECK_EQ(Adc_Inj_Init(&Adc_Configs[0]), E_OK);
+    for (Adc_GroupType g = 0u; g < ADC_MAX_GROUPS; g++) {
+        if (Adc_Inj_OwnsGroup(g)) {
+            return g;
+        }
+    }
+    return ADC_MAX_GROUPS;
+}
+
+static void test_selection(void)
+{
+    const Adc_InstanceType a1 = ADC_INSTANCE_1;
+    const Adc_InstanceType a2 = ADC_INSTANCE_2;
+    Adc_GroupDefType saved[ADC_MAX_GROUPS];
+    Adc_ChannelType seq[ADC_INJ_MAX_CHANNELS];
+    Adc_ValueGroupType jdr[ADC_INJ_MAX_CHANNELS];
+    Adc_ValueGroupType out[ADC_INJ_MAX_CHANNELS];
+
+    memcpy(saved, Adc_GroupConfigs, sizeof(saved));
+
+    TEST_CHECK_EQ(test_pick(1u, 1u, a1, 0u, 1u, a1), 0u);           /* cấu hình thật */
+    TEST_CHECK_EQ(test_pick(1u, 1u, a1, 2u, 1u, a1), 1u);           /* Priority cao nhất */
+    TEST_CHECK_EQ(test_pick(3u, 1u, a1, 2u, 1u, a1), 0u);
+    TEST_CHECK_EQ(test_pick(2u, 1u, a1, 2u, 1u, a1), 0u);           /* bằng nhau: id nhỏ */
+    TEST_CHECK_EQ(test_pick(0u, 1u, a1, 0u, 1u, a1), ADC_MAX_GROUPS);   /* chỉ nền */
+    TEST_CHECK_EQ(test_pick(3u, ADC_INJ_MAX_CHANNELS + 1u, a1, 1u, 1u, a1), 1u);
+    TEST_CHECK_EQ(test_pick(3u, 0u, a1, 1u, 1u, a1), 1u);
+    TEST_CHECK_EQ(test_pick(1u, 1u, a1, 3u, 1u, a2), 0u);           /* ADC2 không có injected */
+    Adc_Configs[0].AdcInstance = a2;
+    TEST_CHECK_EQ(test_pick(1u, 1u, a2, 2u, 1u, a2), ADC_MAX_GROUPS);
+    Adc_Configs[0].AdcInstance = a1;
+
+    /* Chuỗi lặp kênh cho đủ rank; JEOC trung bình làm tròn theo kênh */
+    Adc_GroupConfigs[1].Channels[0] = 7u;
+    Adc_GroupConfigs[1].Channels[1] = 3u;
+    Adc_GroupConfigs[1].Channels[2] = 11u;
+    Adc_GroupConfigs[1].Channels[3] = 5u;
+    Adc_GroupConfigs[1].Result = NULL;
+    for (uint8_t n = 1u; n <= ADC_INJ_MAX_CHANNELS; n++) {
+        const uint8_t len = (uint8_t)((ADC_INJ_MAX_CHANNELS / n) * n);
+        uint32_t bad = 0u;
+
+        TEST_CHECK_EQ(test_pick(1u, 1u, a1, 2u, n, a1), 1u);
+        TEST_CHECK_EQ(Adc_Inj_GetCount(), 0u);
+        TEST_CHECK_EQ(Adc_Inj_Sequence(seq), len);
+        for (uint8_t r = 0u; r < len; r++) {
+            bad += (seq[r] != Adc_GroupConfigs[1].Channels[r % n]) ? 1u : 0u;
+        }
+        TEST_CHECK_EQ(Adc_Inj_ReadGroup(1u, out, NULL), E_NOT_OK);      /* chưa có JEOC */
+        for (uint8_t r = 0u; r < len; r++) {
+            jdr[r] = (Adc_ValueGroupType)(Test_Rand() & 0xFFFu);
+        }
+        Adc_Inj_OnJeoc(jdr);
+        TEST_CHECK_EQ(Adc_Inj_GetCount(), 1u);
+        TEST_CHECK_EQ(Adc_Inj_ReadGroup(1u, out, NULL), E_OK);
+        for (uint8_t c = 0u; c < n; c++) {
+            const uint32_t k = len / n;
+            uint32_t sum = k / 2u;
+            for (uint8_t r = c; r < len; r += n) {
+                sum += jdr[r];
+            }
+            bad += (out[c] != (Adc_ValueGroupType)(sum / k)) ? 1u : 0u;
+        }
+        TEST_CHECK_EQ(bad, 0u);
+        TEST_CHECK_EQ(Adc_Inj_ReadGroup(0u, out, NULL), E_NOT_OK);
+    }
+
+    memcpy(Adc_GroupConfigs, saved, sizeof(saved));
+}
+
+int main(void)
+{
+    test_sequencer(NULL);
+    test_sequencer("cont");
+    test_selection();
+    Test_Exit("AdcInj");
+    return 0;
+}
@@ -0,0 +1,271 @@
+/**********************************************************
+ * @file    Test_AdcScan.c
+ * @brief   Test quét ADC DMA vòng: trung bình, công bố, đọc nhóm (Adc_Scan.c)
+ * @details Biên dịch Adc_Scan.c ngay trong file này; __DMB() của
+ *          Adc_Scan.c được thay bằng test_dmb() để "ISR DMA" chen vào
+ *          giữa lúc reader đang chép, như ngắt trên Cortex-M3 (một lõi).
+ *          Bảng nhóm Adc_GroupConfigs, OS_TickCount, Adc_Inj_OwnsGroup
+ *          là bản của test.
+ *          - Adc_Scan_Init: kênh theo Rank, kẹp Oversampling, kẹp K × N
+ *            theo chuỗi regular khi kích timer, cấu hình sai.
+ *          - Nửa buffer (HT/TC) xen kẽ với dữ liệu ngẫu nhiên: mỗi kênh
+ *            = trung bình làm tròn K mẫu của đúng nửa vừa đầy, dấu thời
+ *            gian = OS_TickCount() lúc công bố, Adc_Scan_GetCount tăng 1.
+ *          - Adc_Scan_ReadGroup: kênh của nhóm (thứ tự bất kỳ) → đúng
+ *            vị trí Rank; nhóm có kênh ngoài chuỗi, nhóm injected, nhóm
+ *            ADC khác, chưa có bộ nào → E_NOT_OK.
+ *          - Seqlock: ISR công bố 1 lần giữa lúc chép → không chép lại,
+ *            trả bộ cũ nguyên vẹn; công bố 2 lần (ghi đè slot đang chép)
+ *            → chép lại đúng một lần, trả bộ mới nhất nguyên vẹn.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Adc.h"
+#include "Adc_Cfg.h"
+#include "Os.h"
+#include <string.h>
+
+static void test_dmb(void);
+#undef  __DMB
+#define __DMB() test_dmb()
+#include "../../bsw/mcal/adc/Adc_Scan.c"
+#undef  __DMB
+
+#define TEST_K          4u
+#define TEST_N          3u
+#define TEST_ROUNDS     200u
+#define TEST_GROUP_SCAN 0u
+#define TEST_GROUP_INJ  1u
+
+/* Chuỗi quét: Rank 1 = kênh 9, Rank 2 = kênh 5, Rank 3 = kênh 1 */
+static const Adc_ChannelType test_rank_ch[TEST_N] = { 9u, 5u, 1u };
+
+static Adc_ValueGroupType test_result[TEST_N];
+Adc_GroupDefType Adc_GroupConfigs[ADC_MAX_GROUPS];
+
+static TickType test_tick;
+static boolean  test_inj_owns;
+static boolean  test_in_isr;
+static uint32_t test_reader_dmb;    /* __DMB() của reader trong một lần đọc */
+static uint32_t test_inject;        /* số lần ISR công bố ở __DMB() đầu của reader */
+static uint32_t test_half;
+static Adc_ValueGroupType test_expect[TEST_N];
+
+TickType OS_TickCount(void)
+{
+    return test_tick;
+}
+
+boolean Adc_Inj_OwnsGroup(Adc_GroupType Group)
+{
+    return ((Group == TEST_GROUP_INJ) && test_inj_owns) ? TRUE : FALSE;
+}
+
+static Adc_ConfigType test_config(uint8_t k, Adc_TriggerSourceType trigger)
+{
+    Adc_ConfigType cfg = { 0 };
+    cfg.AdcInstance   = ADC_INSTANCE_1;
+    cfg.ScanMode      = ADC_SCAN_DMA_CIRCULAR;
+    cfg.TriggerSource = trigger;
+    cfg.Oversampling  = k;
+    cfg.NumChannels   = TEST_N;
+    /* khai báo lệch thứ tự Rank */
+    cfg.Channels[0] = (Adc_ChannelConfigType){ .Channel = test_rank_ch[1], .Rank = 2u };
+    cfg.Channels[1] = (Adc_ChannelConfigType){ .Channel = test_rank_ch[2], .Rank = 3u };
+    cfg.Channels[2] = (Adc_ChannelConfigType){ .Channel = test_rank_ch[0], .Rank = 1u };
+    return cfg;
+}
+
+/* "DMA" lấp nửa buffer tiếp theo bằng mẫu ngẫu nhiên, "ISR" HT/TC công bố;
+ * test_expect = trung bình làm tròn theo Rank */
+static void test_dma_half(void)
+{
+    uint32_t len = 0u;
+    Adc_ValueGroupType *buf = Adc_Scan_DmaBuffer(&len);
+    const uint32_t half = len / 2u;
+    Adc_ValueGroupType *dst = &buf[(test_half != 0u) ? half : 0u];
+    uint32_t sum[TEST_N] = { 0u };
+
+    for (uint32_t s = 0u; s < half; s++) {
+        dst[s] = (Adc_ValueGroupType)(Test_Rand() & 0xFFFu);
+        sum[s % TEST_N] += dst[s];
+    }
+    /* nửa kia DMA đang ghi: rác không được lọt vào trung bình */
+    for (uint32_t s = 0u; s < half; s++) {
+        buf[((test_half != 0u) ? 0u : half) + s] = 0xFFFFu;
+    }
+    for (uint32_t c = 0u; c < TEST_N; c++) {
+        test_expect[c] = (Adc_ValueGroupType)((sum[c] + (TEST_K / 2u)) / TEST_K);
+    }
+    test_tick++;
+    test_in_isr = TRUE;
+    Adc_Scan_OnDmaHalf((uint8_t)test_half);
+    test_in_isr = FALSE;
+    test_half ^= 1u;
+}
+
+static void test_dmb(void)
+{
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (test_in_isr) {
+        return;
+    }
+    if ((test_reader_dmb++ == 0u) && (test_inject != 0u)) {
+        for (uint32_t i = 0u; i < test_inject; i++) {
+            test_dma_half();
+        }
+    }
+}
+
+static void test_set_group(Adc_GroupType g, Adc_InstanceType inst, const Adc_ChannelType *ch, uint8_t n)
+{
+    Adc_GroupDefType *grp = &Adc_GroupConfigs[g];
+    memset(grp, 0, sizeof(*grp));
+    grp->id          = g;
+    grp->AdcInstance = inst;
+    grp->NumChannels = n;
+    grp->Result      = test_result;
+    for (uint8_t i = 0u; i < n; i++) {
+        grp->Channels[i] = ch[i];
+    }
+}
+
+/* 1) Init: Rank, kẹp K, cấu hình sai */
+static void test_init(void)
+{
+    Adc_ConfigType cfg;
+    uint32_t len = 0u;
+
+    cfg = test_config(0u, ADC_TRIGGER_SOFTWARE);
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_OK);
+    (void)Adc_Scan_DmaBuffer(&len);
+    TEST_CHECK_EQ(len, 2u * 1u * TEST_N);                   /* K = 0 → 1 */
+
+    cfg = test_config(ADC_SCAN_MAX_OVERSAMPLE + 1u, ADC_TRIGGER_SOFTWARE);
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_OK);
+    (void)Adc_Scan_DmaBuffer(&len);
+    TEST_CHECK_EQ(len, 2u * ADC_SCAN_MAX_OVERSAMPLE * TEST_N);
+
+    /* kích timer: K × N <= ADC_SCAN_MAX_SEQUENCE */
+    cfg = test_config(ADC_SCAN_MAX_OVERSAMPLE, ADC_TRIGGER_TIM1_CC1);
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_OK);
+    (void)Adc_Scan_DmaBuffer(&len);
+    TEST_CHECK_EQ(len, 2u * (ADC_SCAN_MAX_SEQUENCE / TEST_N) * TEST_N);
+
+    cfg = test_config(TEST_K, ADC_TRIGGER_SOFTWARE);
+    cfg.Channels[1].Rank = TEST_N + 1u;
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_NOT_OK);
+    cfg = test_config(TEST_K, ADC_TRIGGER_SOFTWARE);
+    cfg.AdcInstance = ADC_INSTANCE_2;
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_NOT_OK);
+    cfg.ScanMode = ADC_SCAN_DISABLED;
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_OK);
+    TEST_CHECK(Adc_Scan_OwnsGroup(TEST_GROUP_SCAN) == FALSE);
+
+    cfg = test_config(TEST_K, ADC_TRIGGER_SOFTWARE);
+    TEST_CHECK_EQ(Adc_Scan_Init(&cfg), E_OK);
+    for (uint32_t r = 0u; r < TEST_N; r++) {
+        TEST_CHECK_EQ(adc_ch[r], test_rank_ch[r]);
+    }
+    test_half = 0u;
+}
+
+/* 2) HT/TC xen kẽ: trung bình đúng nửa, map Rank, dấu thời gian */
+static void test_averaging(void)
+{
+    const Adc_ChannelType order[TEST_N] = { test_rank_ch[2], test_rank_ch[0], test_rank_ch[1] };
+    const uint8_t rank_of[TEST_N] = { 2u, 0u, 1u };
+    Adc_ValueGroupType out[TEST_N];
+    uint32_t ts = 0u;
+    uint32_t badAvg = 0u, badResult = 0u, badTs = 0u;
+
+    test_set_group(TEST_GROUP_SCAN, ADC_INSTANCE_1, order, TEST_N);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, out, &ts), E_NOT_OK);  /* chưa có bộ nào */
+
+    for (uint32_t r = 0u; r < TEST_ROUNDS; r++) {
+        const uint32_t before = Adc_Scan_GetCount();
+        test_dma_half();
+        TEST_CHECK_EQ(Adc_Scan_GetCount(), before + 1u);
+        TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, out, &ts), E_OK);
+        for (uint32_t i = 0u; i < TEST_N; i++) {
+            badAvg    += (out[i] != test_expect[rank_of[i]]) ? 1u : 0u;
+            badResult += (test_result[i] != out[i]) ? 1u : 0u;
+        }
+        badTs += (ts != test_tick) ? 1u : 0u;
+    }
+    TEST_CHECK_EQ(badAvg, 0u);
+    TEST_CHECK_EQ(badResult, 0u);
+    TEST_CHECK_EQ(badTs, 0u);
+}
+
+/* 3) Adc_Scan_ReadGroup: nhóm con, kênh ngoài chuỗi, nhóm không thuộc quét */
+static void test_read_group(void)
+{
+    const Adc_ChannelType one[1] = { test_rank_ch[1] };
+    const Adc_ChannelType bad[2] = { test_rank_ch[0], 3u };
+    Adc_ValueGroupType out[TEST_N];
+
+    test_dma_half();
+    test_set_group(TEST_GROUP_SCAN, ADC_INSTANCE_1, one, 1u);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, out, NULL), E_OK);
+    TEST_CHECK_EQ(out[0], test_expect[1]);
+
+    test_set_group(TEST_GROUP_SCAN, ADC_INSTANCE_1, bad, 2u);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, out, NULL), E_NOT_OK);
+    test_set_group(TEST_GROUP_SCAN, ADC_INSTANCE_2, one, 1u);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, out, NULL), E_NOT_OK);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(ADC_MAX_GROUPS, out, NULL), E_NOT_OK);
+
+    test_set_group(TEST_GROUP_INJ, ADC_INSTANCE_1, one, 1u);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_INJ, out, NULL), E_OK);
+    test_inj_owns = TRUE;
+    TEST_CHECK(Adc_Scan_OwnsGroup(TEST_GROUP_INJ) == FALSE);
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_INJ, out, NULL), E_NOT_OK);
+    test_inj_owns = FALSE;
+    TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, NULL, NULL), E_NOT_OK);
+}
+
+/* 4) Seqlock: ISR chen `inject` lần công bố giữa lúc reader chép */
+static void test_seqlock(uint32_t inject, uint32_t expect_tries)
+{
+    Adc_ValueGroupType out[TEST_N];
+    Adc_ValueGroupType before[TEST_N];
+    uint32_t ts = 0u;
+    uint32_t badValue = 0u, badTries = 0u, badTs = 0u;
+
+    test_set_group(TEST_GROUP_SCAN, ADC_INSTANCE_1, test_rank_ch, TEST_N);
+    for (uint32_t r = 0u; r < TEST_ROUNDS; r++) {
+        test_dma_half();
+        memcpy(before, test_expect, sizeof(before));
+        const uint32_t tsBefore = test_tick;
+
+        test_reader_dmb = 0u;
+        test_inject = inject;
+        TEST_CHECK_EQ(Adc_Scan_ReadGroup(TEST_GROUP_SCAN, out, &ts), E_OK);
+        test_inject = 0u;
+
+        /* 1 công bố: slot đang chép không bị đụng → bộ cũ; 2: chép lại → bộ mới nhất */
+        const Adc_ValueGroupType *want = (expect_tries == 1u) ? before : test_expect;
+        badValue += (memcmp(out, want, sizeof(out)) != 0) ? 1u : 0u;
+        badTs    += (ts != ((expect_tries == 1u) ? tsBefore : test_tick)) ? 1u : 0u;
+        badTries += (test_reader_dmb != (2u * expect_tries)) ? 1u : 0u;
+    }
+    TEST_CHECK_EQ(badValue, 0u);
+    TEST_CHECK_EQ(badTs, 0u);
+    TEST_CHECK_EQ(badTries, 0u);
+}
+
+int main(void)
+{
+    test_init();
+    test_averaging();
+    test_read_group();
+    test_seqlock(0u, 1u);
+    test_seqlock(1u, 1u);
+    test_seqlock(2u, 2u);
+    Test_Exit("AdcScan");
+    return 0;
+}
@@ -0,0 +1,114 @@
+/**********************************************************
+ * @file    Test_CanBusLoad.c
+ * @brief   Test đường nhận CAN dưới tải bus (VCU_SIM_BUSLOAD)
+ * @details Chạy cả ứng dụng host (mọi module của make host trừ
+ *          app/main.c) trong tiến trình con, thời gian ảo
+ *          TEST_SIM_MS, với VCU_SIM_BUSLOAD = n frame nền mỗi ms và
+ *          VCU_SIM_RXIDS đưa ID nền 0x300..0x30F qua bộ lọc → mọi
+ *          frame nền đi qua ISR RX → vòng RX của CanIf → Task_Com.
+ *          Khi OS dừng, tiến trình con gửi CanIf_GetRxStats() về qua
+ *          pipe; tiến trình cha kiểm tra:
+ *          - 3 frame/ms (tải bus 1 Mbit/s thực tế): không drop vòng,
+ *            không overrun FIFO, nhận đủ frame; high-water ít nhất
+ *            một chu kỳ Task_Com frame (RX thật sự được hoãn khỏi
+ *            ISR) và còn dư ít nhất TEST_RING_HEADROOM slot.
+ *          - 8 frame/ms (quá tải): vòng đầy, CanIf_GetRxStats đếm
+ *            drop; mọi frame nền hoặc được nhận hoặc được đếm drop.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "EcuM.h"
+#include "Log.h"
+#include "CanIf.h"
+#include "Com_Cfg.h"
+#include <unistd.h>
+#include <sys/wait.h>
+
+#define TEST_SIM_MS         2000u
+#define TEST_LOAD_OK        3u
+#define TEST_LOAD_OVER      8u
+#define TEST_RING_HEADROOM  8u
+
+static int test_pipe = -1;
+
+/* Tiến trình con: gửi thống kê khi Os_Arch_Shutdown gọi exit() */
+static void test_send_stats(void)
+{
+    CanIf_RxStatsType st;
+
+    if ((CanIf_GetRxStats(&st) == E_OK) &&
+        (write(test_pipe, &st, sizeof(st)) != (ssize_t)sizeof(st))) {
+        _exit(2);
+    }
+}
+
+static boolean test_run(uint32_t load, CanIf_RxStatsType *st)
+{
+    int fd[2];
+    int status = 0;
+    char buf[16];
+
+    if (pipe(fd) != 0) {
+        return FALSE;
+    }
+    fflush(stdout);
+    const pid_t pid = fork();
+    if (pid == 0) {
+        close(fd[0]);
+        test_pipe = fd[1];
+        (void)freopen("/dev/null", "w", stdout);
+        (void)freopen("/dev/null", "w", stderr);
+        snprintf(buf, sizeof(buf), "%u", (unsigned)TEST_SIM_MS);
+        setenv("VCU_SIM_MS", buf, 1);
+        snprintf(buf, sizeof(buf), "%u", (unsigned)load);
+        setenv("VCU_SIM_BUSLOAD", buf, 1);
+        setenv("VCU_SIM_RXIDS", "0x300-0x30F", 1);
+        atexit(test_send_stats);
+
+        /* như app/main.c */
+        Log_Init();
+        EcuM_Init();
+        (void)StartOS(OSDEFAULTAPPMODE);
+        _exit(3);
+    }
+    close(fd[1]);
+    const ssize_t n = read(fd[0], st, sizeof(*st));
+    close(fd[0]);
+    (void)waitpid(pid, &status, 0);
+    TEST_CHECK(WIFEXITED(status) && (WEXITSTATUS(status) == 0));
+    return (n == (ssize_t)sizeof(*st)) ? TRUE : FALSE;
+}
+
+int main(void)
+{
+    CanIf_RxStatsType st;
+    const uint32_t loadFrames = TEST_LOAD_OK * TEST_SIM_MS;
+    const uint32_t overFrames = TEST_LOAD_OVER * TEST_SIM_MS;
+
+    /* 1) 3 frame/ms: Task_Com (mỗi COM_MAINFUNCTION_PERIOD_MS) theo kịp */
+    TEST_CHECK(test_run(TEST_LOAD_OK, &st) == TRUE);
+    printf("[test] busload %u frame/ms: %lu received, drop %lu, overrun %lu, high-water %u/%u\n",
+           (unsigned)TEST_LOAD_OK, (unsigned long)st.received, (unsigned long)st.ringDrops,
+           (unsigned long)st.fifoOverruns, (unsigned)st.ringHighWater, (unsigned)CANIF_RX_RING_SIZE);
+    TEST_CHECK_EQ(st.ringDrops, 0u);
+    TEST_CHECK_EQ(st.fifoOverruns, 0u);
+    TEST_CHECK(st.received >= loadFrames);
+    TEST_CHECK(st.ringHighWater >= (TEST_LOAD_OK * COM_MAINFUNCTION_PERIOD_MS));
+    TEST_CHECK(st.ringHighWater <= (CANIF_RX_RING_SIZE - TEST_RING_HEADROOM));
+
+    /* 2) 8 frame/ms: vượt khả năng bus, vòng tràn → drop được đếm */
+    TEST_CHECK(test_run(TEST_LOAD_OVER, &st) == TRUE);
+    printf("[test] busload %u frame/ms: %lu received, drop %lu, overrun %lu, high-water %u/%u\n",
+           (unsigned)TEST_LOAD_OVER, (unsigned long)st.received, (unsigned long)st.ringDrops,
+           (unsigned long)st.fifoOverruns, (unsigned)st.ringHighWater, (unsigned)CANIF_RX_RING_SIZE);
+    TEST_CHECK(st.ringDrops > 0u);
+    TEST_CHECK_EQ(st.ringHighWater, CANIF_RX_RING_SIZE);
+    TEST_CHECK((st.received + st.ringDrops + st.fifoOverruns) >= overFrames);
+
+    Test_Exit("CanBusLoad");
+    return 0;
+}
@@ -0,0 +1,150 @@
+/**********************************************************
+ * @file    Test_CanFilter.c
+ * @brief   Test ngẫu nhiên bộ sinh filter bank bxCAN (Can_Filter.c)
+ * @details Sinh TEST_SETS tập CAN ID ngẫu nhiên (chỉ chuẩn, chỉ mở
+ *          rộng, trộn), 1..CAN_FILTER_MAX_IDS ID (có thể trùng), số
+ *          bank cho phép 1..CAN_MAX_FILTER_BANKS; với mỗi tập gọi
+ *          Can_BuildFilterLayout rồi kiểm bằng Can_FilterMatch:
+ *          - mọi ID cấu hình đều khớp;
+ *          - numBanks <= maxBanks, numIds[FIFO0] + numIds[FIFO1] = số
+ *            ID cấu hình (bỏ trùng);
+ *          - falseAcceptIds = số ID không cấu hình khớp đo được: quét
+ *            toàn bộ 2048 ID chuẩn và cửa sổ TEST_EXT_WINDOW ID mở rộng
+ *            quanh TEST_EXT_BASE (mọi ID mở rộng sinh ra chung phần
+ *            cao; bank mask mở rộng phải so hết phần cao → ngoài cửa
+ *            sổ không khớp gì);
+ *          - đủ bank để khớp đúng (4 ID chuẩn / 2 ID mở rộng mỗi bank)
+ *            thì falseAcceptIds = 0;
+ *          - frame chuẩn không lọt bank mở rộng và ngược lại.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Can.h"
+
+#define TEST_SETS        600u
+#define TEST_STD_IDS     0x800u
+#define TEST_EXT_BASE    0x18DA0000u
+#define TEST_EXT_WINDOW  0x1000u
+
+typedef enum {
+    TEST_SET_STD = 0,
+    TEST_SET_EXT,
+    TEST_SET_MIXED
+} Test_SetKind_e;
+
+static boolean test_configured(const Can_IdType *ids, uint8_t n, Can_IdType id)
+{
+    for (uint8_t i = 0u; i < n; i++) {
+        if (ids[i] == id) {
+            return TRUE;
+        }
+    }
+    return FALSE;
+}
+
+/* Bank mask 32-bit (mở rộng) chỉ được bỏ qua bit trong cửa sổ */
+static uint32_t test_ext_banks_outside_window(const Can_FilterLayoutType *l)
+{
+    uint32_t bad = 0u;
+    for (uint8_t b = 0u; b < l->numBanks; b++) {
+        const Can_FilterBankType *k = &l->bank[b];
+        if ((k->FilterScale != CAN_FilterScale_32bit) || (k->FilterMode != CAN_FilterMode_IdMask)) {
+            continue;
+        }
+        const uint32_t care = ((((uint32_t)k->FilterMaskIdHigh << 16) | k->FilterMaskIdLow) >> 3) | (TEST_EXT_WINDOW - 1u);
+        if ((care & 0x1FFFFFFFu) != 0x1FFFFFFFu) {
+            bad++;
+        }
+    }
+    return bad;
+}
+
+static void test_random_set(Test_SetKind_e kind)
+{
+    Can_IdType ids[CAN_FILTER_MAX_IDS];
+    Can_FilterLayoutType l;
+    const uint8_t n = (uint8_t)(1u + (Test_Rand() % CAN_FILTER_MAX_IDS));
+    /* tập trộn cần ít nhất một bank chuẩn và một bank mở rộng */
+    const uint8_t minBanks = (kind == TEST_SET_MIXED) ? 2u : 1u;
+    const uint8_t maxBanks = (uint8_t)(minBanks + (Test_Rand() % (CAN_MAX_FILTER_BANKS - minBanks + 1u)));
+    uint32_t unique = 0u, numStd = 0u, numExt = 0u;
+    uint32_t missed = 0u, falseAccepts = 0u, crossType = 0u;
+    uint8_t fifo;
+
+    for (uint8_t i = 0u; i < n; i++) {
+        const boolean ext = (kind == TEST_SET_EXT) || ((kind == TEST_SET_MIXED) && ((Test_Rand() & 1u) != 0u));
+        /* dải hẹp để có ID trùng và nhóm gộp được */
+        ids[i] = ext ? (Can_IdType)(TEST_EXT_BASE | (Test_Rand() % TEST_EXT_WINDOW))
+                     : (Can_IdType)(Test_Rand() % TEST_STD_IDS);
+        if (!test_configured(ids, i, ids[i])) {
+            unique++;
+            if (ext) {
+                numExt++;
+            } else {
+                numStd++;
+            }
+        }
+    }
+
+    TEST_CHECK_EQ(Can_BuildFilterLayout(ids, n, maxBanks, &l), E_OK);
+    TEST_CHECK(l.numBanks <= maxBanks);
+    TEST_CHECK_EQ((uint32_t)l.numIds[CAN_FIFO0] + l.numIds[CAN_FIFO1], unique);
+    TEST_CHECK_EQ(test_ext_banks_outside_window(&l), 0u);
+
+    for (uint8_t i = 0u; i < n; i++) {
+        const uint8_t ide = (ids[i] > 0x7FFu) ? CAN_Id_Extended : CAN_Id_Standard;
+        if (Can_FilterMatch(&l, ids[i], ide, &fifo) == FALSE) {
+            missed++;
+        }
+    }
+
+    for (Can_IdType id = 0u; id < TEST_STD_IDS; id++) {
+        if (Can_FilterMatch(&l, id, CAN_Id_Standard, NULL) && !test_configured(ids, n, id)) {
+            falseAccepts++;
+            crossType += (numStd == 0u) ? 1u : 0u;
+        }
+    }
+    for (Can_IdType id = TEST_EXT_BASE; id < (TEST_EXT_BASE + TEST_EXT_WINDOW); id++) {
+        if (Can_FilterMatch(&l, id, CAN_Id_Extended, NULL) && !test_configured(ids, n, id)) {
+            falseAccepts++;
+            crossType += (numExt == 0u) ? 1u : 0u;
+        }
+    }
+
+    TEST_CHECK_EQ(missed, 0u);
+    TEST_CHECK_EQ(l.falseAcceptIds, falseAccepts);
+    TEST_CHECK_EQ(crossType, 0u);
+    if ((((numStd + 3u) / 4u) + ((numExt + 1u) / 2u)) <= maxBanks) {
+        TEST_CHECK_EQ(l.falseAcceptIds, 0u);
+    }
+}
+
+/* Không xếp được (tập trộn, 1 bank) hoặc tham số sai: một bank nhận mọi frame */
+static void test_accept_all(void)
+{
+    static const Can_IdType ids[2] = { 0x123u, TEST_EXT_BASE };
+    Can_FilterLayoutType l;
+
+    TEST_CHECK_EQ(Can_BuildFilterLayout(ids, 2u, 1u, &l), E_NOT_OK);
+    TEST_CHECK_EQ(l.numBanks, 1u);
+    TEST_CHECK_EQ(l.falseAcceptIds, 0xFFFFFFFFu);
+    TEST_CHECK(Can_FilterMatch(&l, 0x7FFu, CAN_Id_Standard, NULL) == TRUE);
+    TEST_CHECK(Can_FilterMatch(&l, 0x1FFFFFFFu, CAN_Id_Extended, NULL) == TRUE);
+
+    TEST_CHECK_EQ(Can_BuildFilterLayout(ids, (uint8_t)(CAN_FILTER_MAX_IDS + 1u), CAN_MAX_FILTER_BANKS, &l), E_NOT_OK);
+    TEST_CHECK_EQ(Can_BuildFilterLayout(ids, 2u, 0u, &l), E_NOT_OK);
+    TEST_CHECK_EQ(Can_BuildFilterLayout(NULL, 1u, CAN_MAX_FILTER_BANKS, &l), E_NOT_OK);
+}
+
+int main(void)
+{
+    for (uint32_t t = 0u; t < TEST_SETS; t++) {
+        test_random_set((Test_SetKind_e)(t % 3u));
+    }
+    test_accept_all();
+    Test_Exit("CanFilter");
+    return 0;
+}
@@ -0,0 +1,254 @@
+/**********************************************************
+ * @file    Test_Com.c
+ * @brief   Test pack/unpack signal COM theo bảng layout (Com.c)
+ * @details Biên dịch Com.c ngay trong file này để gọi trực tiếp
+ *          prv_build_layout/prv_pack/prv_unpack/prv_to_raw/
+ *          prv_from_raw. Cấu hình I-PDU riêng của test (16 byte) thay
+ *          cho Com_Cfg.c để thử tín hiệu tới 64 bit.
+ *          - Intel và Motorola, độ dài 1..64, mọi bitPosition trong
+ *            I-PDU: layout hợp lệ đúng khi tín hiệu nằm trọn trong
+ *            I-PDU; byte pack ra khớp bản tham chiếu từng bit, bit
+ *            ngoài tín hiệu giữ nguyên, unpack trả lại giá trị.
+ *          - Mở rộng dấu: SINT8/16/32/64 với min, max, -1, 0 và ngẫu
+ *            nhiên trong khoảng của bitLength.
+ *          - factor/offset (kể cả factor âm): quét toàn bộ giá trị thô.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "../../bsw/communication/com/Com.c"
+
+#define TEST_PDU_LEN    16u
+#define TEST_VALUES     4u
+
+static uint8_t test_pdu_tx[TEST_PDU_LEN];
+static uint8_t test_pdu_rx[TEST_PDU_LEN];
+
+const Com_IPduCfgType Com_IPduCfg[COM_NUM_IPDUS] =
+{
+    [0] = { .PduId = 0u, .Length = TEST_PDU_LEN, .direction = COM_PDU_DIR_TX, .buffer = test_pdu_tx },
+    [1] = { .PduId = 1u, .Length = TEST_PDU_LEN, .direction = COM_PDU_DIR_RX, .buffer = test_pdu_rx }
+};
+
+void Os_Posix_DisableIrq(void) {}
+void Os_Posix_EnableIrq(void) {}
+
+static uint64_t test_rand64(void)
+{
+    return ((uint64_t)Test_Rand() << 32) | Test_Rand();
+}
+
+/* Tham chiếu từng bit: bit i của tín hiệu nằm ở bit (shift + i) tính từ
+ * byte LSB, đi lên (Intel) hoặc xuống (Motorola) một byte mỗi 8 bit */
+static void test_ref_pack(uint8_t *pdu, uint16_t bitPos, uint8_t bitLen, boolean motorola, uint64_t raw)
+{
+    for (uint8_t i = 0u; i < bitLen; i++) {
+        const uint32_t pos  = (bitPos & 7u) + i;
+        const int32_t  byte = (int32_t)(bitPos >> 3) + (motorola ? -(int32_t)(pos >> 3) : (int32_t)(pos >> 3));
+        const uint8_t  bit  = (uint8_t)(1u << (pos & 7u));
+        if (((raw >> i) & 1u) != 0u) {
+            pdu[byte] |= bit;
+        } else {
+            pdu[byte] &= (uint8_t)~bit;
+        }
+    }
+}
+
+static boolean test_fits(uint16_t bitPos, uint8_t bitLen, boolean motorola)
+{
+    const uint32_t lsb    = bitPos >> 3;
+    const uint32_t nBytes = ((bitPos & 7u) + bitLen + 7u) >> 3;
+    return motorola ? ((lsb < TEST_PDU_LEN) && (lsb >= (nBytes - 1u)))
+                    : ((lsb + nBytes) <= TEST_PDU_LEN);
+}
+
+static Com_SignalCfgType test_cfg(uint16_t bitPos, uint8_t bitLen, boolean motorola, Com_SignalType_e type)
+{
+    Com_SignalCfgType cfg = {
+        .PduId = 0u, .bitPosition = bitPos, .bitLength = bitLen,
+        .endianness = motorola ? COM_BIG_ENDIAN : COM_LITTLE_ENDIAN,
+        .type = type, .direction = COM_PDU_DIR_TX, .factor = 0, .offset = 0
+    };
+    return cfg;
+}
+
+/* 1) Mọi (byte order, độ dài, bitPosition): layout, byte, round-trip */
+static void test_layout_roundtrip(void)
+{
+    for (uint8_t be = 0u; be < 2u; be++) {
+        for (uint8_t len = 1u; len <= 64u; len++) {
+            uint32_t badValid = 0u;
+            uint32_t badBytes = 0u;
+            uint32_t badValue = 0u;
+            uint32_t tested   = 0u;
+            for (uint16_t pos = 0u; pos < (TEST_PDU_LEN * 8u); pos++) {
+                const Com_SignalCfgType cfg = test_cfg(pos, len, be, COM_SIGTYPE_UINT64);
+                Com_SignalLayoutType l;
+                const boolean ok = prv_build_layout(&cfg, &l);
+                if (ok != test_fits(pos, len, be)) {
+                    badValid++;
+                }
+                if (!ok) {
+                    continue;
+                }
+                tested++;
+                for (uint32_t n = 0u; n < TEST_VALUES; n++) {
+                    uint8_t ref[TEST_PDU_LEN];
+                    const uint64_t v = test_rand64() & l.mask;
+                    uint64_t out = 0u;
+
+                    for (uint32_t b = 0u; b < TEST_PDU_LEN; b++) {   /* nền ngẫu nhiên */
+                        test_pdu_tx[b] = (uint8_t)Test_Rand();
+                    }
+                    memcpy(ref, test_pdu_tx, sizeof(ref));
+                    test_ref_pack(ref, pos, len, be, v);
+                    prv_pack(l.pdu, &l, prv_to_raw(&cfg, &v));
+                    if (memcmp(ref, test_pdu_tx, sizeof(ref)) != 0) {
+                        badBytes++;
+                    }
+                    prv_from_raw(&cfg, prv_unpack(l.pdu, &l), &out);
+                    if (out != v) {
+                        badValue++;
+                    }
+                }
+            }
+            TEST_CHECK_EQ(badValid, 0u);
+            TEST_CHECK_EQ(badBytes, 0u);
+            TEST_CHECK_EQ(badValue, 0u);
+            TEST_CHECK(tested > 0u);
+        }
+    }
+}
+
+/* Tín hiệu có dấu: pack giá trị ứng dụng, nhận lại đúng giá trị */
+static int64_t test_signed_roundtrip(const Com_SignalCfgType *cfg, int64_t v)
+{
+    Com_SignalLayoutType l;
+    int64_t in64 = v, out64 = 0;
+    int32_t in32 = (int32_t)v, out32 = 0;
+    int16_t in16 = (int16_t)v, out16 = 0;
+    int8_t  in8  = (int8_t)v,  out8  = 0;
+    const void *in;
+    void *out;
+
+    switch (cfg->type) {
+    case COM_SIGTYPE_SINT8:  in = &in8;  out = &out8;  break;
+    case COM_SIGTYPE_SINT16: in = &in16; out = &out16; break;
+    case COM_SIGTYPE_SINT32: in = &in32; out = &out32; break;
+    default:                 in = &in64; out = &out64; break;
+    }
+    (void)prv_build_layout(cfg, &l);
+    prv_pack(l.pdu, &l, prv_to_raw(cfg, in));
+    prv_from_raw(cfg, prv_unpack(l.pdu, &l), out);
+    switch (cfg->type) {
+    case COM_SIGTYPE_SINT8:  return out8;
+    case COM_SIGTYPE_SINT16: return out16;
+    case COM_SIGTYPE_SINT32: return out32;
+    default:                 return out64;
+    }
+}
+
+/* 2) Mở rộng dấu từ bit cao nhất của tín hiệu */
+static void test_sign_extension(void)
+{
+    for (uint8_t be = 0u; be < 2u; be++) {
+        for (uint8_t len = 1u; len <= 64u; len++) {
+            const Com_SignalType_e type = (len <= 8u)  ? COM_SIGTYPE_SINT8  :
+                                          (len <= 16u) ? COM_SIGTYPE_SINT16 :
+                                          (len <= 32u) ? COM_SIGTYPE_SINT32 : COM_SIGTYPE_SINT64;
+            /* bitPosition lệch byte, nằm trọn trong I-PDU */
+            const uint16_t pos = be ? (uint16_t)((8u * 9u) + (len % 8u)) : (uint16_t)(len % 8u);
+            const Com_SignalCfgType cfg = test_cfg(pos, len, be, type);
+            const int64_t maxv = (len == 64u) ? INT64_MAX : (int64_t)(((uint64_t)1u << (len - 1u)) - 1u);
+            const int64_t minv = -maxv - 1;
+            int64_t vals[4u + TEST_VALUES] = { minv, maxv, -1, 0 };
+            uint32_t bad = 0u;
+
+            for (uint32_t n = 0u; n < TEST_VALUES; n++) {
+                const uint64_t r = test_rand64();
+                vals[4u + n] = (len == 64u) ? (int64_t)r
+                             : (int64_t)(r & (((uint64_t)1u << len) - 1u)) + minv;
+            }
+            for (uint32_t n = 0u; n < (sizeof(vals) / sizeof(vals[0])); n++) {
+                if (test_signed_roundtrip(&cfg, vals[n]) != vals[n]) {
+                    bad++;
+                }
+            }
+            TEST_CHECK_EQ(bad, 0u);
+        }
+    }
+}
+
+/* 3) factor/offset: vật lý = thô * factor + offset, quét hết giá trị thô */
+static void test_scaling(void)
+{
+    static const struct {
+        Com_SignalType_e type;
+        uint8_t  len;
+        boolean  motorola;
+        int32_t  factor;
+        int32_t  offset;
+    } cases[] = {
+        { COM_SIGTYPE_UINT16,  8u, FALSE,  32,      0 },
+        { COM_SIGTYPE_SINT32, 12u, TRUE,    5,  -1000 },
+        { COM_SIGTYPE_UINT32, 16u, FALSE,   1,    500 },
+        { COM_SIGTYPE_SINT16, 10u, TRUE,   -3,      7 },
+        { COM_SIGTYPE_SINT32, 13u, FALSE,   0,    -40 }    /* factor 0 = 1 */
+    };
+
+    for (uint32_t c = 0u; c < (sizeof(cases) / sizeof(cases[0])); c++) {
+        const uint16_t pos = cases[c].motorola ? (uint16_t)(8u * 5u + 3u) : 5u;
+        Com_SignalCfgType cfg = test_cfg(pos, cases[c].len, cases[c].motorola, cases[c].type);
+        Com_SignalLayoutType l;
+        uint32_t bad = 0u;
+
+        cfg.factor = cases[c].factor;
+        cfg.offset = cases[c].offset;
+        TEST_CHECK(prv_build_layout(&cfg, &l) == TRUE);
+        for (uint64_t raw = 0u; raw <= l.mask; raw++) {
+            int64_t s = (int64_t)raw;
+            if (prv_is_signed(cfg.type) && ((raw >> (cfg.bitLength - 1u)) & 1u)) {
+                s -= (int64_t)1 << cfg.bitLength;
+            }
+            const int64_t phys = (s * ((cfg.factor == 0) ? 1 : cfg.factor)) + cfg.offset;
+            int64_t v = 0;
+            uint32_t u32 = 0u;
+            uint16_t u16 = 0u;
+            int32_t s32 = 0;
+            int16_t s16 = 0;
+            void *out = (cfg.type == COM_SIGTYPE_UINT16) ? (void *)&u16 :
+                        (cfg.type == COM_SIGTYPE_UINT32) ? (void *)&u32 :
+                        (cfg.type == COM_SIGTYPE_SINT16) ? (void *)&s16 : (void *)&s32;
+
+            prv_pack(l.pdu, &l, raw);
+            prv_from_raw(&cfg, prv_unpack(l.pdu, &l), out);
+            switch (cfg.type) {
+            case COM_SIGTYPE_UINT16: v = u16; break;
+            case COM_SIGTYPE_UINT32: v = u32; break;
+            case COM_SIGTYPE_SINT16: v = s16; break;
+            default:                 v = s32; break;
+            }
+            if ((v != phys) || ((prv_to_raw(&cfg, out) & l.mask) != raw)) {
+                bad++;
+            }
+        }
+        TEST_CHECK_EQ(bad, 0u);
+    }
+
+    /* boolean: khác 0 → 1 */
+    const Com_SignalCfgType b = test_cfg(7u, 1u, FALSE, COM_SIGTYPE_BOOLEAN);
+    const boolean t = (boolean)5u, f = FALSE;
+    TEST_CHECK_EQ(prv_to_raw(&b, &t), 1u);
+    TEST_CHECK_EQ(prv_to_raw(&b, &f), 0u);
+}
+
+int main(void)
+{
+    test_layout_roundtrip();
+    test_sign_extension();
+    test_scaling();
+    Test_Exit("Com");
+    return 0;
+}
@@ -0,0 +1,127 @@
+/**********************************************************
+ * @file    Test_OsIoc.c
+ * @brief   Test kênh IOC unqueued/queued (Os_Ioc.c, Os_Ioc_Cfg.h)
+ * @details Không cần OS: SetEvent được thay bằng bản ghi lại lời gọi.
+ *          - Unqueued (Safe): IOC_E_NO_DATA trước lần ghi đầu, sau đó
+ *            luôn đọc bản mới nhất (last-is-best), đọc lại được.
+ *          - Queued (Speed, depth 4, receiver B/C): đầy → IOC_E_LIMIT,
+ *            bản tin bị bỏ với mọi receiver; lần đọc kế tiếp của mỗi
+ *            receiver trả IOC_E_LOST_DATA kèm dữ liệu hợp lệ, các lần
+ *            sau IOC_E_OK; thứ tự FIFO giữ nguyên; receiver chậm chặn
+ *            sender kể cả khi receiver kia còn chỗ.
+ *          - Zero-copy Peek/Release và SetEvent chỉ sau khi công bố.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "Os_Ioc_Cfg.h"
+
+static uint32_t ev_calls[OS_MAX_TASKS];
+
+StatusType SetEvent(TaskType tid, EventMaskType mask)
+{
+    TEST_CHECK_EQ(mask, EV_RX);
+    if (tid < OS_MAX_TASKS) {
+        ev_calls[tid]++;
+    }
+    return E_OK;
+}
+
+static void test_unqueued(void)
+{
+    Safe_s in = { .throttle_pct = 10u, .gear = GEAR_D, .driveMode = DRIVEMODE_NORMAL,
+                  .brakeActive = FALSE };
+    Safe_s out;
+
+    TEST_CHECK_EQ(IocRead_Safe(&out), IOC_E_NO_DATA);
+    for (uint8_t k = 1u; k <= 5u; k++) {
+        in.throttle_pct = k;
+        TEST_CHECK_EQ(IocWrite_Safe(&in), IOC_E_OK);
+    }
+    TEST_CHECK_EQ(IocRead_Safe(&out), IOC_E_OK);
+    TEST_CHECK_EQ(out.throttle_pct, 5u);
+    TEST_CHECK_EQ(out.gear, GEAR_D);
+    TEST_CHECK_EQ(IocRead_Safe(&out), IOC_E_OK);        /* không tiêu thụ */
+    TEST_CHECK_EQ(out.throttle_pct, 5u);
+
+    Safe_s *slot = IocWriteBegin_Safe();
+    TEST_CHECK(slot != NULL);
+    slot->throttle_pct = 77u;
+    TEST_CHECK_EQ(IocRead_Safe(&out), IOC_E_OK);        /* chưa công bố */
+    TEST_CHECK_EQ(out.throttle_pct, 5u);
+    TEST_CHECK_EQ(IocWriteCommit_Safe(), IOC_E_OK);
+    TEST_CHECK_EQ(IocRead_Safe(&out), IOC_E_OK);
+    TEST_CHECK_EQ(out.throttle_pct, 77u);
+    TEST_CHECK_EQ(ev_calls[TASK_B], 0u);                /* kênh không có event */
+}
+
+static void test_queued(void)
+{
+    const uint8_t rb = IOC_RX_Speed_TASK_B;
+    const uint8_t rc = IOC_RX_Speed_TASK_C;
+    uint16_t v;
+
+    TEST_CHECK_EQ(IocReceive_Speed(rb, &v), IOC_E_NO_DATA);
+    for (uint16_t k = 1u; k <= 4u; k++) {
+        TEST_CHECK_EQ(IocSend_Speed(&k), IOC_E_OK);
+    }
+    TEST_CHECK_EQ(ev_calls[TASK_B], 4u);
+    TEST_CHECK_EQ(ev_calls[TASK_C], 4u);
+
+    /* Cả hai đầy → bỏ bản tin 5 */
+    uint16_t k5 = 5u;
+    TEST_CHECK_EQ(IocSend_Speed(&k5), IOC_E_LIMIT);
+    TEST_CHECK_EQ(ev_calls[TASK_B], 4u);
+
+    /* B đọc 1 → B còn chỗ nhưng C đầy: sender vẫn bị chặn (bản tin 6) */
+    TEST_CHECK_EQ(IocReceive_Speed(rb, &v), IOC_E_LOST_DATA);
+    TEST_CHECK_EQ(v, 1u);
+    uint16_t k6 = 6u;
+    TEST_CHECK_EQ(IocSend_Speed(&k6), IOC_E_LIMIT);
+
+    /* B: mất bản 6 → LOST_DATA thêm một lần, FIFO 2,3,4 */
+    TEST_CHECK_EQ(IocReceive_Speed(rb, &v), IOC_E_LOST_DATA);
+    TEST_CHECK_EQ(v, 2u);
+    TEST_CHECK_EQ(IocReceive_Speed(rb, &v), IOC_E_OK);
+    TEST_CHECK_EQ(v, 3u);
+
+    /* C: zero-copy; hai lần bị bỏ gộp thành một LOST_DATA */
+    const uint16_t *p = IocReceivePeek_Speed(rc);
+    TEST_CHECK(p != NULL);
+    TEST_CHECK_EQ(*p, 1u);
+    TEST_CHECK_EQ(IocReceiveRelease_Speed(rc), IOC_E_LOST_DATA);
+    for (uint16_t k = 2u; k <= 4u; k++) {
+        TEST_CHECK_EQ(IocReceive_Speed(rc, &v), IOC_E_OK);
+        TEST_CHECK_EQ(v, k);
+    }
+    TEST_CHECK(IocReceivePeek_Speed(rc) == NULL);
+    TEST_CHECK_EQ(IocReceive_Speed(rc, &v), IOC_E_NO_DATA);
+
+    /* Hết đầy → gửi lại được; B còn bản 4 rồi tới 7 */
+    uint16_t k7 = 7u;
+    TEST_CHECK_EQ(IocSend_Speed(&k7), IOC_E_OK);
+    TEST_CHECK_EQ(IocReceive_Speed(rb, &v), IOC_E_OK);
+    TEST_CHECK_EQ(v, 4u);
+    TEST_CHECK_EQ(IocReceive_Speed(rb, &v), IOC_E_OK);
+    TEST_CHECK_EQ(v, 7u);
+    TEST_CHECK_EQ(IocReceive_Speed(rc, &v), IOC_E_OK);
+    TEST_CHECK_EQ(v, 7u);
+    TEST_CHECK_EQ(ev_calls[TASK_C], 5u);
+
+    /* Tham số sai */
+    TEST_CHECK_EQ(IocReceive_Speed(2u, &v), IOC_E_NOK);
+    TEST_CHECK_EQ(Ioc_Write(IOC_CH_COUNT, &v), IOC_E_NOK);
+    TEST_CHECK_EQ(Ioc_Read(IOC_CH_COUNT, 0u, &v), IOC_E_NOK);
+}
+
+int main(void)
+{
+    Ioc_Init();
+    test_unqueued();
+    test_queued();
+    Test_Exit("OsIoc");
+    return 0;
+}
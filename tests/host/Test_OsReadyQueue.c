@@ -0,0 +1,217 @@
+/**********************************************************
+ * @file    Test_OsReadyQueue.c
+ * @brief   Test hàng đợi READY bitmap 2 mức ở 256 mức ưu tiên (Os_Task.c)
+ * @details Biên dịch Os_Task.c ngay trong file này với OS_PRIO_LEVELS
+ *          = 256 (OS_RQ_GROUPS = 8, cấu hình thật chỉ có 1 nhóm) và
+ *          OS_MAX_TASKS = 254 để gọi thẳng các hàm rq_* (không StartOS).
+ *          - Lấp đầy: 254 task, mỗi task một mức (lượt 1: mức 0..253,
+ *            lượt 2: mức 2..255 → mọi mức đều từng có task); sau mỗi
+ *            rq_push kiểm rq_top_prio, rồi rq_pop_raw rút hết theo thứ
+ *            tự ưu tiên giảm dần, kiểm mức đỉnh sau mỗi lần rút.
+ *          - Ngẫu nhiên: push/push_front/pop trên mức bất kỳ 0..255 so
+ *            với mô hình FIFO theo từng mức (task, mức đỉnh, rỗng).
+ *          - Đo ns/lần rq_top_prio và rq_pop_raw + rq_push khi các task
+ *            READY nằm trong 32 mức đầu (một nhóm) và trải cả 256 mức
+ *            (8 nhóm): chi phí chọn task không được tăng theo số mức.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include <string.h>
+#include "Test.h"
+#include "Os_Cfg.h"
+#undef  OS_PRIO_LEVELS
+#define OS_PRIO_LEVELS          256u
+#undef  OS_MAX_TASKS
+#define OS_MAX_TASKS            254u
+#include "../../bsw/services/os/src/Os_Task.c"
+
+#define TEST_RANDOM_OPS         200000u
+#define TEST_BENCH_TASKS        16u
+#define TEST_BENCH_OPS          2000000u
+
+static volatile uint32_t sink;
+
+/* Mô hình: FIFO theo từng mức */
+static uint8_t  model_q[OS_PRIO_LEVELS][OS_MAX_TASKS];
+static uint8_t  model_n[OS_PRIO_LEVELS];
+static boolean  model_in[OS_MAX_TASKS];
+
+static int32_t model_top(void)
+{
+    for (int32_t p = (int32_t)OS_PRIO_LEVELS - 1; p >= 0; p--) {
+        if (model_n[p] != 0u) {
+            return p;
+        }
+    }
+    return -1;
+}
+
+static void test_push(uint8_t tid, uint8_t prio, boolean front)
+{
+    tcb[tid].prio = prio;
+    if (front) {
+        for (uint8_t i = model_n[prio]; i > 0u; i--) {
+            model_q[prio][i] = model_q[prio][i - 1u];
+        }
+        model_q[prio][0] = tid;
+        rq_push_front(tid);
+    } else {
+        model_q[prio][model_n[prio]] = tid;
+        rq_push(tid);
+    }
+    model_n[prio]++;
+    model_in[tid] = TRUE;
+}
+
+/* rq_pop_raw và mô hình phải ra cùng task; trả FALSE nếu lệch */
+static boolean test_pop(void)
+{
+    const int32_t top = model_top();
+    uint8_t tid = OS_RQ_NONE;
+    const bool got = rq_pop_raw(&tid);
+
+    if (top < 0) {
+        return (got == false) ? TRUE : FALSE;
+    }
+    const uint8_t want = model_q[top][0];
+    model_n[top]--;
+    for (uint8_t i = 0u; i < model_n[top]; i++) {
+        model_q[top][i] = model_q[top][i + 1u];
+    }
+    model_in[want] = FALSE;
+    return (got && (tid == want)) ? TRUE : FALSE;
+}
+
+static boolean test_top_ok(void)
+{
+    const int32_t top = model_top();
+    if (top < 0) {
+        return rq_empty() ? TRUE : FALSE;
+    }
+    return (!rq_empty() && (rq_top_prio() == (uint8_t)top)) ? TRUE : FALSE;
+}
+
+/* 1) Mỗi task một mức, push theo thứ tự ngẫu nhiên, rút hết */
+static void test_fill(uint8_t lowest)
+{
+    uint8_t order[OS_MAX_TASKS];
+    uint32_t badTop = 0u, badPop = 0u;
+
+    rq_reset();
+    for (uint8_t i = 0u; i < OS_MAX_TASKS; i++) {
+        order[i] = i;
+    }
+    for (uint8_t i = OS_MAX_TASKS - 1u; i > 0u; i--) {
+        const uint8_t j = (uint8_t)(Test_Rand() % (i + 1u));
+        const uint8_t t = order[i];
+        order[i] = order[j];
+        order[j] = t;
+    }
+    for (uint8_t i = 0u; i < OS_MAX_TASKS; i++) {
+        test_push(order[i], (uint8_t)(lowest + order[i]), FALSE);
+        badTop += test_top_ok() ? 0u : 1u;
+    }
+    TEST_CHECK_EQ(rq_top_prio(), lowest + OS_MAX_TASKS - 1u);
+    for (uint32_t g = 0u; g < OS_RQ_GROUPS; g++) {
+        TEST_CHECK((rdy_group >> g) & 1u);
+    }
+    for (uint8_t i = 0u; i < OS_MAX_TASKS; i++) {
+        badPop += test_pop() ? 0u : 1u;
+        badTop += test_top_ok() ? 0u : 1u;
+    }
+    TEST_CHECK_EQ(badTop, 0u);
+    TEST_CHECK_EQ(badPop, 0u);
+    TEST_CHECK(rq_empty());
+    TEST_CHECK_EQ(rdy_group, 0u);
+}
+
+/* 2) Thao tác ngẫu nhiên trên cả 256 mức, đối chiếu mô hình */
+static void test_random(void)
+{
+    uint32_t badTop = 0u, badPop = 0u;
+
+    rq_reset();
+    memset(model_n, 0, sizeof(model_n));
+    memset(model_in, 0, sizeof(model_in));
+    for (uint32_t op = 0u; op < TEST_RANDOM_OPS; op++) {
+        const uint32_t r = Test_Rand();
+        const uint8_t tid = (uint8_t)((r >> 8) % OS_MAX_TASKS);
+        if (((r & 3u) != 0u) && !model_in[tid]) {
+            /* vài mức lân cận để có FIFO dài trong cùng mức */
+            const uint8_t prio = ((r & 0x10u) != 0u) ? (uint8_t)(r >> 24) : (uint8_t)(0x7Eu + ((r >> 24) & 3u));
+            test_push(tid, prio, ((r & 4u) != 0u) ? TRUE : FALSE);
+        } else {
+            badPop += test_pop() ? 0u : 1u;
+        }
+        badTop += test_top_ok() ? 0u : 1u;
+    }
+    TEST_CHECK_EQ(badTop, 0u);
+    TEST_CHECK_EQ(badPop, 0u);
+}
+
+/* 3) ns/lần với TEST_BENCH_TASKS task READY trên 'levels' mức đầu */
+static void test_bench(uint32_t levels, double *topNs, double *popNs)
+{
+    static uint8_t prio_seq[4096];
+    uint64_t t0;
+    uint8_t tid = 0u;
+
+    rq_reset();
+    for (uint32_t i = 0u; i < (sizeof(prio_seq) / sizeof(prio_seq[0])); i++) {
+        prio_seq[i] = (uint8_t)(Test_Rand() % levels);
+    }
+    for (uint8_t t = 0u; t < TEST_BENCH_TASKS; t++) {
+        tcb[t].prio = prio_seq[t];
+        rq_push(t);
+    }
+
+    t0 = Test_NowNs();
+    for (uint32_t i = 0u; i < TEST_BENCH_OPS; i++) {
+        __asm volatile ("" ::: "memory");   /* chặn compiler đưa ra ngoài vòng lặp */
+        sink += rq_top_prio();
+    }
+    *topNs = (double)(Test_NowNs() - t0) / TEST_BENCH_OPS;
+
+    /* rút task đỉnh, gán mức mới, đưa lại: mức đỉnh và nhóm đổi liên tục */
+    t0 = Test_NowNs();
+    for (uint32_t i = 0u; i < TEST_BENCH_OPS; i++) {
+        (void)rq_pop_raw(&tid);
+        tcb[tid].prio = prio_seq[i & 4095u];
+        rq_push(tid);
+    }
+    *popNs = (double)(Test_NowNs() - t0) / TEST_BENCH_OPS;
+    sink += tid;
+}
+
+static void test_timing(void)
+{
+    double top32, pop32, top256, pop256;
+
+    test_bench(32u, &top32, &pop32);
+    test_bench(256u, &top256, &pop256);
+    printf("[test] ready queue (%u task READY): rq_top_prio %.2f / %.2f ns,"
+           " rq_pop_raw + rq_push %.2f / %.2f ns (32 / 256 mức)\n",
+           (unsigned)TEST_BENCH_TASKS, top32, top256, pop32, pop256);
+    /* cùng 2 CLZ + vài truy cập mảng: chỉ chặn trường hợp tăng theo số mức */
+    TEST_CHECK(top256 <= ((2.0 * top32) + 2.0));
+    TEST_CHECK(pop256 <= ((2.0 * pop32) + 2.0));
+}
+
+TASK(Task_Init) {}
+TASK(Task_A) {}
+TASK(Task_B) {}
+TASK(Task_C) {}
+TASK(Task_Com) {}
+TASK(Task_Idle) {}
+
+int main(void)
+{
+    test_fill(0u);
+    test_fill((uint8_t)(OS_PRIO_LEVELS - OS_MAX_TASKS));
+    test_random();
+    test_timing();
+    Test_Exit("OsReadyQueue");
+    return 0;
+}
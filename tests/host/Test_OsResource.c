@@ -0,0 +1,171 @@
+/**********************************************************
+ * @file    Test_OsResource.c
+ * @brief   Test priority ceiling GetResource/ReleaseResource (Os_Resource.c)
+ * @details OS bản POSIX; prio Init = B = C = 1, A = 2, Com = 3.
+ *          1) Ceiling: Task_B giữ res_ab (ceiling 2 = prio Task_A).
+ *             "ISR" tick kích A (2) và C (1): không ai preempt B tới khi
+ *             nhả; Com (3 > ceiling) vẫn preempt. ReleaseResource lập
+ *             lịch ngay: A chạy bên trong lời gọi Release, trước mọi
+ *             task prio 1 khác (không đảo ưu tiên). In thời gian bị
+ *             chặn của A (tick kích → tick chạy).
+ *          2) Lồng nhau: res_ab rồi res_y (ceiling 3) → prio 2 → 3;
+ *             nhả sai thứ tự → E_OS_NOFUNC; nhả LIFO khôi phục 3 → 2 → 1.
+ *             Lấy lặp → E_OS_ACCESS, quá MAX_RESOURCES → E_OS_LIMIT,
+ *             TerminateTask khi còn giữ → E_OS_RESOURCE.
+ *          3) RES_SCHEDULER: Task_C giữ → Com không preempt; nhả → Com
+ *             chạy ngay.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "Os_Arch.h"
+
+#define TEST_HOLD_TICKS     5u
+
+extern TCB_t tcb[OS_MAX_TASKS];
+
+static OsResource res_ab = { .ceilingPrio = 2u };
+static OsResource res_y  = { .ceilingPrio = 3u };
+static OsResource res_n[MAX_RESOURCES] = {
+    { .ceilingPrio = 1u }, { .ceilingPrio = 1u }, { .ceilingPrio = 1u }, { .ceilingPrio = 1u }
+};
+
+enum { ISR_NONE = 0, ISR_ACT_A_C, ISR_ACT_COM };
+static volatile uint32_t isr_req;
+static volatile boolean  a_ran;
+static volatile boolean  c_ran;
+static volatile uint32_t com_runs;
+static TickType a_act_tick;
+
+void Os_Posix_TickHook(TickType now)
+{
+    (void)now;
+    switch (isr_req) {
+    case ISR_ACT_A_C:
+        a_act_tick = OS_TickCount();
+        TEST_CHECK_EQ(ActivateTask(TASK_A), E_OK);
+        TEST_CHECK_EQ(ActivateTask(TASK_C), E_OK);
+        break;
+    case ISR_ACT_COM:
+        TEST_CHECK_EQ(ActivateTask(TASK_COM), E_OK);
+        break;
+    default:
+        break;
+    }
+    isr_req = ISR_NONE;
+}
+
+static void test_isr(uint32_t req)
+{
+    isr_req = req;
+    while (isr_req != ISR_NONE) {
+        __WFI();
+    }
+}
+
+static void test_wait_ticks(uint32_t n)
+{
+    for (uint32_t i = 0u; i < n; i++) {
+        __WFI();
+    }
+}
+
+TASK(Task_Init)
+{
+    Resource_Init(&res_ab);
+    Resource_Init(&res_y);
+    for (uint32_t i = 0u; i < MAX_RESOURCES; i++) {
+        Resource_Init(&res_n[i]);
+    }
+    TEST_CHECK_EQ(ActivateTask(TASK_B), E_OK);
+    TerminateTask();
+}
+
+TASK(Task_B)
+{
+    /* 1) Ceiling */
+    TEST_CHECK_EQ(GetResource(&res_ab), E_OK);
+    TEST_CHECK_EQ(tcb[TASK_B].prio, 2u);
+    test_isr(ISR_ACT_A_C);
+    test_wait_ticks(TEST_HOLD_TICKS);
+    TEST_CHECK(a_ran == FALSE);                 /* A (= ceiling) không preempt */
+    TEST_CHECK(c_ran == FALSE);
+    test_isr(ISR_ACT_COM);
+    TEST_CHECK_EQ(com_runs, 1u);                /* Com (> ceiling) preempt */
+    TEST_CHECK_EQ(ReleaseResource(&res_ab), E_OK);
+    TEST_CHECK(a_ran == TRUE);                  /* lập lịch ngay khi nhả */
+    TEST_CHECK(c_ran == FALSE);
+    TEST_CHECK_EQ(tcb[TASK_B].prio, 1u);
+
+    /* 2) Lồng nhau LIFO */
+    TEST_CHECK_EQ(GetResource(&res_ab), E_OK);
+    TEST_CHECK_EQ(GetResource(&res_ab), E_OS_ACCESS);
+    TEST_CHECK_EQ(GetResource(&res_y), E_OK);
+    TEST_CHECK_EQ(tcb[TASK_B].prio, 3u);
+    TEST_CHECK_EQ(ReleaseResource(&res_ab), E_OS_NOFUNC);
+    TEST_CHECK_EQ(TerminateTask(), E_OS_RESOURCE);
+    TEST_CHECK_EQ(ReleaseResource(&res_y), E_OK);
+    TEST_CHECK_EQ(tcb[TASK_B].prio, 2u);
+    TEST_CHECK_EQ(ReleaseResource(&res_ab), E_OK);
+    TEST_CHECK_EQ(tcb[TASK_B].prio, 1u);
+    TEST_CHECK_EQ(ReleaseResource(&res_ab), E_OS_NOFUNC);
+
+    for (uint32_t i = 0u; i < MAX_RESOURCES; i++) {
+        TEST_CHECK_EQ(GetResource(&res_n[i]), E_OK);
+    }
+    TEST_CHECK_EQ(GetResource(&res_y), E_OS_LIMIT);
+    for (uint32_t i = MAX_RESOURCES; i > 0u; i--) {
+        TEST_CHECK_EQ(ReleaseResource(&res_n[i - 1u]), E_OK);
+    }
+    TEST_CHECK(c_ran == FALSE);                 /* C cùng mức: chờ B kết thúc */
+    TerminateTask();
+}
+
+TASK(Task_A)
+{
+    a_ran = TRUE;
+    TEST_CHECK(c_ran == FALSE);
+    TEST_CHECK_EQ(GetResource(&res_ab), E_OK);  /* B đã nhả */
+    TEST_CHECK_EQ(ReleaseResource(&res_ab), E_OK);
+    printf("[test] resource: Task_A blocked %u tick(s) by ceiling (hold %u + preempt)\n",
+           (unsigned)(OS_TickCount() - a_act_tick), (unsigned)TEST_HOLD_TICKS);
+    TEST_CHECK((OS_TickCount() - a_act_tick) <= (TEST_HOLD_TICKS + 2u));
+    TerminateTask();
+}
+
+TASK(Task_C)
+{
+    /* 3) RES_SCHEDULER */
+    c_ran = TRUE;
+    TEST_CHECK(a_ran == TRUE);
+    TEST_CHECK_EQ(GetResource(RES_SCHEDULER), E_OK);
+    TEST_CHECK_EQ(tcb[TASK_C].prio, OS_PRIO_LEVELS - 1u);
+    test_isr(ISR_ACT_COM);
+    test_wait_ticks(2u);
+    TEST_CHECK_EQ(com_runs, 1u);                /* Com không preempt */
+    TEST_CHECK_EQ(ReleaseResource(RES_SCHEDULER), E_OK);
+    TEST_CHECK_EQ(com_runs, 2u);                /* chạy ngay khi nhả */
+    TEST_CHECK_EQ(tcb[TASK_C].prio, 1u);
+    Test_Exit("OsResource");
+}
+
+TASK(Task_Com)
+{
+    com_runs++;
+    TerminateTask();
+}
+
+TASK(Task_Idle)
+{
+    TEST_CHECK(0);
+    Test_Exit("OsResource");
+}
+
+int main(void)
+{
+    (void)StartOS(OSDEFAULTAPPMODE);
+    return 1;
+}
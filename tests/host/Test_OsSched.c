@@ -0,0 +1,126 @@
+/**********************************************************
+ * @file    Test_OsSched.c
+ * @brief   Test scheduler bitmap + FIFO theo mức ưu tiên (Os_Task.c)
+ * @details OS bản POSIX, task của test ghi thứ tự chạy vào trace:
+ *          prio Init = B = C = 1, A = 2, Com = 3 (Os_TaskConfig).
+ *          1) Từ Task_Init: B, C vào FIFO mức 1 (không preempt);
+ *             Com (3) preempt ngay; trong Com, A (2) được kích 2 lần
+ *             (OsTaskActivation = 2), lần 3 → E_OS_LIMIT.
+ *             Kỳ vọng "I M A A i B C": ưu tiên cao nhất trước, A chạy
+ *             lại từ entry cho lần kích thứ hai, Init bị preempt quay
+ *             về ĐẦU FIFO (rq_push_front) nên chạy tiếp trước B, C.
+ *          2) Từ "ISR" tick: khi B đang chạy, kích C (cùng mức → xếp
+ *             hàng) rồi A (cao hơn → preempt ngay trong tick đó).
+ *             Kỳ vọng "b A B C": B bị preempt vẫn chạy trước C dù C
+ *             vào hàng trước.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include <string.h>
+#include "Test.h"
+#include "Os.h"
+#include "Os_Arch.h"
+
+static char     trace[32];
+static uint32_t trace_len;
+static uint32_t phase;
+static volatile uint32_t isr_arm;       /* 1 = tick kế tiếp kích C rồi A */
+static TickType isr_tick;
+static volatile boolean a_ran;
+
+static void test_trace(char c)
+{
+    if (trace_len < (sizeof(trace) - 1u)) {
+        trace[trace_len++] = c;
+        trace[trace_len] = '\0';
+    }
+}
+
+void Os_Posix_TickHook(TickType now)
+{
+    if (isr_arm == 1u) {
+        isr_arm = 0u;
+        isr_tick = OS_TickCount();
+        TEST_CHECK_EQ(ActivateTask(TASK_C), E_OK);
+        TEST_CHECK_EQ(ActivateTask(TASK_A), E_OK);
+    }
+    (void)now;
+}
+
+TASK(Task_Init)
+{
+    test_trace('I');
+    TEST_CHECK_EQ(ActivateTask(TASK_B), E_OK);
+    TEST_CHECK_EQ(ActivateTask(TASK_C), E_OK);
+    TEST_CHECK(strcmp(trace, "I") == 0);        /* cùng mức: không preempt */
+    TEST_CHECK_EQ(ActivateTask(TASK_COM), E_OK);
+    TEST_CHECK(strcmp(trace, "IMAA") == 0);     /* Com rồi A x2 đã chạy xong */
+    test_trace('i');
+    TerminateTask();
+}
+
+TASK(Task_Com)
+{
+    test_trace('M');
+    TEST_CHECK_EQ(ActivateTask(TASK_A), E_OK);
+    TEST_CHECK_EQ(ActivateTask(TASK_A), E_OK);
+    TEST_CHECK_EQ(ActivateTask(TASK_A), E_OS_LIMIT);
+    TEST_CHECK_EQ(Os_GetActivationOverrun(TASK_A), 1u);
+    TEST_CHECK(strcmp(trace, "IM") == 0);       /* A thấp hơn Com: chờ */
+    TerminateTask();
+}
+
+TASK(Task_A)
+{
+    test_trace('A');
+    if (phase == 1u) {
+        TEST_CHECK_EQ(OS_TickCount(), isr_tick); /* chạy ngay trong tick kích */
+        a_ran = TRUE;
+    }
+    TerminateTask();
+}
+
+TASK(Task_B)
+{
+    if (phase == 0u) {
+        test_trace('B');
+        TerminateTask();
+    }
+    test_trace('b');
+    isr_arm = 1u;
+    while (a_ran == FALSE) {
+        __WFI();
+    }
+    test_trace('B');
+    TerminateTask();
+}
+
+TASK(Task_C)
+{
+    test_trace('C');
+    if (phase == 0u) {
+        TEST_CHECK(strcmp(trace, "IMAAiBC") == 0);
+        trace_len = 0u;
+        trace[0] = '\0';
+        phase = 1u;
+        TEST_CHECK_EQ(ActivateTask(TASK_B), E_OK);
+        TerminateTask();
+    }
+    TEST_CHECK(strcmp(trace, "bABC") == 0);
+    Test_Exit("OsSched");
+}
+
+TASK(Task_Idle)
+{
+    TEST_CHECK(0);                              /* chuỗi kích bị đứt */
+    printf("  trace '%s' phase %u\n", trace, (unsigned)phase);
+    Test_Exit("OsSched");
+}
+
+int main(void)
+{
+    (void)StartOS(OSDEFAULTAPPMODE);
+    return 1;
+}
@@ -0,0 +1,104 @@
+/**********************************************************
+ * @file    Test_OsTickless.c
+ * @brief   Test tickless idle: bù tick cho counter/alarm (Os_Task.c)
+ * @details OS bản POSIX, thời gian ảo: Task_Idle gọi Os_IdleSleep()
+ *          nên mọi tick giữa hai lần tới hạn bị gộp lại
+ *          (Os_Arch_TicklessSleep) và kernel phải bù:
+ *          1) ALARM_A (10 ms) và ALARM_COM (33 ms) chạy 1 s: task
+ *             được kích đúng tick tới hạn, OS_TickCount() == thời
+ *             gian mô phỏng, GetCounterValue() == tick % max, và số
+ *             tick thực sự phục vụ ít hơn hẳn số tick trôi qua.
+ *          2) Alarm tới hạn với delta = 0 (SetRelAlarm offset 0, chưa
+ *             xử lý): os_next_wakeup() không được coi là "không có
+ *             alarm" → Task_B chạy ở tick kế tiếp, không ngủ tối đa.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "Os_Arch.h"
+
+#define TEST_RUN_A      100u            /* 100 x 10 ms */
+
+static uint32_t runs_a;
+static uint32_t runs_com;
+static uint32_t serviced;               /* tick thật (không bị gộp) */
+static TickType t_delta0;
+
+void Os_Posix_TickHook(TickType now)
+{
+    (void)now;
+    serviced++;
+}
+
+static void test_check_clock(void)
+{
+    TickType cnt = 0u;
+    TEST_CHECK_EQ(OS_TickCount(), Os_Posix_Now());
+    TEST_CHECK_EQ(GetCounterValue(0, &cnt), E_OK);
+    TEST_CHECK_EQ(cnt, OS_TickCount() % 100u);
+}
+
+TASK(Task_A)
+{
+    runs_a++;
+    TEST_CHECK_EQ(OS_TickCount(), runs_a * 10u);
+    test_check_clock();
+
+    if (runs_a == TEST_RUN_A) {
+        /* ~130 điểm tới hạn trong 1000 tick */
+        TEST_CHECK(serviced < (TEST_RUN_A * 10u) / 4u);
+        TEST_CHECK_EQ(runs_com, (TEST_RUN_A * 10u) / 33u);
+
+        (void)CancelAlarm(ALARM_A);
+        (void)CancelAlarm(ALARM_COM);
+        t_delta0 = OS_TickCount();
+        TEST_CHECK_EQ(SetRelAlarm(ALARM_B, 0u, 0u), E_OK);
+    }
+    TerminateTask();
+}
+
+TASK(Task_Com)
+{
+    runs_com++;
+    TEST_CHECK_EQ(OS_TickCount(), runs_com * 33u);
+    test_check_clock();
+    TerminateTask();
+}
+
+TASK(Task_B)
+{
+    TEST_CHECK_EQ(OS_TickCount(), t_delta0 + 1u);
+    test_check_clock();
+    printf("[test] tickless: %u tick(s) serviced for %u simulated\n",
+           (unsigned)serviced, (unsigned)Os_Posix_Now());
+    Test_Exit("OsTickless");
+}
+
+TASK(Task_Init)
+{
+    TEST_CHECK_EQ(SetRelAlarm(ALARM_A, 10u, 10u), E_OK);
+    TEST_CHECK_EQ(SetRelAlarm(ALARM_COM, 33u, 33u), E_OK);
+    TerminateTask();
+}
+
+TASK(Task_C) { TerminateTask(); }
+
+TASK(Task_Idle)
+{
+    for (;;) {
+        Os_IdleSleep();
+        if (Os_Posix_Now() > 5000u) {
+            TEST_CHECK(0);              /* Task_B không bao giờ chạy */
+            Test_Exit("OsTickless");
+        }
+    }
+}
+
+int main(void)
+{
+    (void)StartOS(OSDEFAULTAPPMODE);
+    return 1;
+}
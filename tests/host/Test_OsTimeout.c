@@ -0,0 +1,143 @@
+/**********************************************************
+ * @file    Test_OsTimeout.c
+ * @brief   Test hàng đợi timeout: WaitEventTimeout, OS_Delay (Os_Task.c, Os_Event.c)
+ * @details OS bản POSIX, thời gian ảo, Task_Idle gọi Os_IdleSleep()
+ *          (tickless: hàng đợi timeout phải là một điểm tới hạn).
+ *          Task_B (Extended, prio 1) chạy lần lượt:
+ *          1) WaitEventTimeout không ai SetEvent → E_OS_TIMEOUT đúng
+ *             tick t0 + ticks; ticks = 0 → E_OS_TIMEOUT ngay.
+ *          2) ALARM_A kích Task_A (Basic) sau 2 tick, Task_A SetEvent →
+ *             E_OK ở t0 + 2; lần chờ kế tiếp dài hơn không bị timeout cũ
+ *             (đã gỡ khỏi hàng đợi) đánh thức sớm. Event đã có sẵn →
+ *             E_OK không chờ. Task Basic gọi → E_OS_STATE.
+ *          3) OS_Delay(3): Task_C cùng mức chạy trong lúc B ngủ, B
+ *             tiếp tục đúng t0 + 3; OS_Delay(0) trả về ngay.
+ *          4) B chờ 4 tick, C chờ 2 tick: C thức trước (hàng đợi sắp
+ *             theo tick thức), mỗi task đúng tick của mình.
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include <string.h>
+#include "Test.h"
+#include "Os.h"
+#include "Os_Arch.h"
+
+static uint32_t phase;
+static TickType t_set;                  /* tick Task_A SetEvent */
+static TickType t_c;                    /* tick Task_C chạy / thức */
+static boolean  c_ran;
+static char     order[4];
+static uint32_t order_len;
+
+TASK(Task_A)
+{
+    t_set = OS_TickCount();
+    TEST_CHECK_EQ(WaitEventTimeout(EV_RX, 1u), E_OS_STATE);       /* Basic Task */
+    TEST_CHECK_EQ(SetEvent(TASK_B, EV_RX), E_OK);
+    TerminateTask();
+}
+
+TASK(Task_C)
+{
+    t_c = OS_TickCount();
+    c_ran = TRUE;
+    if (phase == 4u) {
+        TEST_CHECK_EQ(WaitEventTimeout(EV_RX, 2u), E_OS_TIMEOUT);
+        TEST_CHECK_EQ(OS_TickCount(), t_c + 2u);
+        order[order_len++] = 'c';
+    }
+    TerminateTask();
+}
+
+TASK(Task_B)
+{
+    EventMaskType ev = 0u;
+    TickType t0;
+
+    /* 1) Hết hạn */
+    phase = 1u;
+    t0 = OS_TickCount();
+    TEST_CHECK_EQ(WaitEventTimeout(EV_RX, 5u), E_OS_TIMEOUT);
+    TEST_CHECK_EQ(OS_TickCount(), t0 + 5u);
+    TEST_CHECK_EQ(GetEvent(TASK_B, &ev), E_OK);
+    TEST_CHECK_EQ(ev, 0u);
+    t0 = OS_TickCount();
+    TEST_CHECK_EQ(WaitEventTimeout(EV_RX, 0u), E_OS_TIMEOUT);
+    TEST_CHECK_EQ(OS_TickCount(), t0);
+
+    /* 2) Event tới trước hạn, rồi hạn cũ không còn hiệu lực */
+    phase = 2u;
+    t0 = OS_TickCount();
+    TEST_CHECK_EQ(SetRelAlarm(ALARM_A, 2u, 0u), E_OK);
+    TEST_CHECK_EQ(WaitEventTimeout(EV_RX | EV_TX, 10u), E_OK);
+    TEST_CHECK_EQ(OS_TickCount(), t0 + 2u);
+    TEST_CHECK_EQ(t_set, t0 + 2u);
+    TEST_CHECK_EQ(GetEvent(TASK_B, &ev), E_OK);
+    TEST_CHECK_EQ(ev, EV_RX);
+    TEST_CHECK_EQ(ClearEvent(EV_RX), E_OK);
+    t0 = OS_TickCount();
+    TEST_CHECK_EQ(WaitEventTimeout(EV_TX, 20u), E_OS_TIMEOUT);
+    TEST_CHECK_EQ(OS_TickCount(), t0 + 20u);
+
+    TEST_CHECK_EQ(SetEvent(TASK_B, EV_TX), E_OK);
+    t0 = OS_TickCount();
+    TEST_CHECK_EQ(WaitEventTimeout(EV_TX, 5u), E_OK);
+    TEST_CHECK_EQ(OS_TickCount(), t0);
+    TEST_CHECK_EQ(ClearEvent(EV_TX), E_OK);
+
+    /* 3) OS_Delay nhường CPU cho task cùng mức */
+    phase = 3u;
+    c_ran = FALSE;
+    TEST_CHECK_EQ(ActivateTask(TASK_C), E_OK);
+    TEST_CHECK(c_ran == FALSE);                 /* cùng mức: chưa preempt */
+    t0 = OS_TickCount();
+    OS_Delay(3u);
+    TEST_CHECK_EQ(OS_TickCount(), t0 + 3u);
+    TEST_CHECK(c_ran == TRUE);
+    TEST_CHECK_EQ(t_c, t0);
+    t0 = OS_TickCount();
+    OS_Delay(0u);
+    TEST_CHECK_EQ(OS_TickCount(), t0);
+
+    /* 4) Hai task trong hàng đợi: hạn sớm thức trước */
+    phase = 4u;
+    TEST_CHECK_EQ(ActivateTask(TASK_C), E_OK);
+    t0 = OS_TickCount();
+    TEST_CHECK_EQ(WaitEventTimeout(EV_RX, 4u), E_OS_TIMEOUT);
+    TEST_CHECK_EQ(OS_TickCount(), t0 + 4u);
+    order[order_len++] = 'b';
+    order[order_len] = '\0';
+    TEST_CHECK(strcmp(order, "cb") == 0);
+
+    printf("[test] timeout: all waits woke on their deadline tick (t = %u)\n",
+           (unsigned)OS_TickCount());
+    Test_Exit("OsTimeout");
+}
+
+TASK(Task_Init)
+{
+    TEST_CHECK_EQ(ActivateTask(TASK_B), E_OK);
+    TerminateTask();
+}
+
+TASK(Task_Com) { TerminateTask(); }
+
+TASK(Task_Idle)
+{
+    for (;;) {
+        Os_IdleSleep();
+        if (Os_Posix_Now() > 1000u) {
+            TEST_CHECK(0);                      /* task chờ không bao giờ thức */
+            printf("  phase %u\n", (unsigned)phase);
+            Test_Exit("OsTimeout");
+        }
+    }
+}
+
+int main(void)
+{
+    (void)StartOS(OSDEFAULTAPPMODE);
+    return 1;
+}
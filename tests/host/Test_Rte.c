@@ -0,0 +1,158 @@
+/**********************************************************
+ * @file    Test_Rte.c
+ * @brief   Test nhất quán dữ liệu RTE khi bị preempt (Rte.c)
+ * @details Chạy trên OS bản POSIX với task riêng của test:
+ *          - Task_A (prio 2) là consumer: Rte_Task_Begin() rồi
+ *            nhường CPU (WFI) giữa hai lần Rte_IRead_*; tick hook
+ *            ("ISR") kích Task_Com (prio 3) ghi giá trị mới vào mọi
+ *            cổng. Ảnh implicit phải giữ nguyên trong cả chu kỳ,
+ *            còn Rte_Read_* explicit thấy ngay giá trị mới.
+ *          - Safe_s (seqlock): mọi trường suy ra từ cùng một số thứ
+ *            tự k → bản đọc được luôn khớp một lần ghi trọn vẹn.
+ *          - Rte_IStatus_*: RTE_E_NEVER_RECEIVED trước lần ghi đầu;
+ *            sau đó mọi cổng của hai producer (prio 2 và 3) đều E_OK
+ *            (bit Rte_Received không bị mất).
+ *
+ * @version  1.0
+ * @date     2025-09-10
+ * @author   Nguyễn Tuấn Khoa
+ **********************************************************/
+#include "Test.h"
+#include "Os.h"
+#include "Os_Arch.h"
+#include "Rte.h"
+#include "Rte_Main.h"
+
+#define TEST_RTE_CYCLES     200u
+
+static volatile uint32_t writer_k;        /* số lần Task_Com đã ghi */
+static volatile boolean  inject;
+
+static Safe_s test_safe_of(uint32_t k)
+{
+    Safe_s s;
+    s.throttle_pct = (uint8_t)(k % 101u);
+    s.gear         = (Gear_e)(k % 4u);
+    s.driveMode    = (DriveMode_e)(k % 2u);
+    s.brakeActive  = ((k & 1u) != 0u) ? TRUE : FALSE;
+    return s;
+}
+
+static boolean test_safe_eq(const Safe_s *a, const Safe_s *b)
+{
+    return (a->throttle_pct == b->throttle_pct) && (a->gear == b->gear) &&
+           (a->driveMode == b->driveMode) && (a->brakeActive == b->brakeActive);
+}
+
+/* "ISR" tick: producer ưu tiên cao chen vào giữa runnable của Task_A */
+void Os_Posix_TickHook(TickType now)
+{
+    (void)now;
+    if (inject == TRUE) {
+        (void)ActivateTask(TASK_COM);
+    }
+}
+
+TASK(Task_Com)
+{
+    const uint32_t k = writer_k + 1u;
+    const Safe_s s = test_safe_of(k);
+
+    (void)Rte_Write_GearSelector_GearOut(s.gear);
+    (void)Rte_Write_DriveModeMgr_DriveModeOut(s.driveMode);
+    (void)Rte_Write_SafetyManager_SafeOut(&s);
+    writer_k = k;
+    TerminateTask();
+}
+
+TASK(Task_A)
+{
+    for (uint32_t c = 0u; c < TEST_RTE_CYCLES; c++) {
+        Rte_Task_Begin();
+        (void)Rte_Write_PedalAcq_PedalOut((uint8_t)(c % 101u));
+        (void)Rte_Write_BrakeAcq_BrakeOut(((c & 1u) != 0u) ? TRUE : FALSE);
+
+        const uint8_t     p0 = Rte_IRead_SafetyManager_PedalOut();
+        const boolean     b0 = Rte_IRead_SafetyManager_BrakeOut();
+        const Gear_e      g0 = Rte_IRead_SafetyManager_GearOut();
+        const DriveMode_e m0 = Rte_IRead_SafetyManager_DriveModeOut();
+        const Safe_s      s0 = Rte_IRead_CmdComposer_SafeOut();
+        const uint32_t    k0 = writer_k;
+
+        /* Ảnh chụp là một bản ghi trọn vẹn của Task_Com */
+        const Safe_s ref0 = test_safe_of(k0);
+        TEST_CHECK(test_safe_eq(&s0, &ref0));
+        if (k0 != 0u) {
+            TEST_CHECK_EQ(g0, ref0.gear);
+            TEST_CHECK_EQ(m0, ref0.driveMode);
+        }
+
+        /* Nhường CPU: tick → Task_Com ghi (1 + c % 3) lần */
+        inject = TRUE;
+        for (uint32_t i = 0u; i <= (c % 3u); i++) {
+            __WFI();
+        }
+        inject = FALSE;
+        TEST_CHECK(writer_k > k0);
+
+        /* Implicit: cùng giá trị trong cả chu kỳ (kể cả cổng tự ghi) */
+        TEST_CHECK_EQ(Rte_IRead_SafetyManager_PedalOut(), p0);
+        TEST_CHECK_EQ(Rte_IRead_SafetyManager_BrakeOut(), b0);
+        TEST_CHECK_EQ(Rte_IRead_SafetyManager_GearOut(), g0);
+        TEST_CHECK_EQ(Rte_IRead_SafetyManager_DriveModeOut(), m0);
+        const Safe_s s1 = Rte_IRead_CmdComposer_SafeOut();
+        TEST_CHECK(test_safe_eq(&s1, &s0));
+
+        /* Explicit: thấy ngay lần ghi mới nhất, trọn vẹn */
+        const Safe_s ref1 = test_safe_of(writer_k);
+        Safe_s s2;
+        Gear_e g2;
+        DriveMode_e m2;
+        TEST_CHECK_EQ(Rte_Read_CmdComposer_SafeOut(&s2), RTE_E_OK);
+        TEST_CHECK(test_safe_eq(&s2, &ref1));
+        TEST_CHECK_EQ(Rte_Read_SafetyManager_GearOut(&g2), RTE_E_OK);
+        TEST_CHECK_EQ(g2, ref1.gear);
+        TEST_CHECK_EQ(Rte_Read_SafetyManager_DriveModeOut(&m2), RTE_E_OK);
+        TEST_CHECK_EQ(m2, ref1.driveMode);
+
+        /* Cổng của cả hai producer đã nhận (không mất bit) */
+        TEST_CHECK_EQ(Rte_IStatus_SafetyManager_PedalOut(), RTE_E_OK);
+        TEST_CHECK_EQ(Rte_IStatus_SafetyManager_BrakeOut(), RTE_E_OK);
+        TEST_CHECK_EQ(Rte_IStatus_SafetyManager_GearOut(), RTE_E_OK);
+        TEST_CHECK_EQ(Rte_IStatus_SafetyManager_DriveModeOut(), RTE_E_OK);
+        TEST_CHECK_EQ(Rte_IStatus_CmdComposer_SafeOut(), RTE_E_OK);
+        Rte_Task_End();
+    }
+    Test_Exit("Rte");
+}
+
+TASK(Task_Init)
+{
+    uint8_t pct;
+    Gear_e gear;
+
+    (void)Rte_Start();
+    TEST_CHECK_EQ(Rte_Read_SafetyManager_PedalOut(&pct), RTE_E_NEVER_RECEIVED);
+    TEST_CHECK_EQ(pct, 0u);
+    TEST_CHECK_EQ(Rte_Read_SafetyManager_GearOut(&gear), RTE_E_NEVER_RECEIVED);
+    TEST_CHECK_EQ(gear, GEAR_P);
+    TEST_CHECK_EQ(Rte_IStatus_CmdComposer_SafeOut(), RTE_E_NEVER_RECEIVED);
+
+    (void)ActivateTask(TASK_A);
+    TerminateTask();
+}
+
+TASK(Task_B) { TerminateTask(); }
+TASK(Task_C) { TerminateTask(); }
+
+TASK(Task_Idle)
+{
+    TEST_CHECK(0);                        /* Task_A không được kết thúc sớm */
+    Test_Exit("Rte");
+}
+
+int main(void)
+{
+    (void)StartOS(OSDEFAULTAPPMODE);
+    return 1;
+}